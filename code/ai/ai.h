@@ -603,6 +603,9 @@ extern int find_enemy(int objnum, float range, int max_attackers, int ship_info_
 float ai_get_weapon_speed(ship_weapon *swp);
 void set_predicted_enemy_pos_turret(vec3d *predicted_enemy_pos, vec3d *gun_pos, object *pobjp, vec3d *enemy_pos, vec3d *enemy_vel, float weapon_speed, float time_enemy_in_range);
 
+// Forces the turret targeting index to be rebuilt, needed when the class of an existing object changes
+void turret_target_index_invalidate();
+
 // function to change rearm status for ai ships (called from sexpression code)
 extern void ai_set_rearm_status( int team, int new_status );
 extern void ai_good_secondary_time( int team, int weapon_index, int num_weapons, const char *shipname );
@@ -23,6 +23,7 @@
 #include "ai/aigoals.h"
 #include "ai/aiinternal.h"
 #include "ai/ailua.h"
+#include "ai/aischeduler.h"
 #include "asteroid/asteroid.h"
 #include "autopilot/autopilot.h"
 #include "cmeasure/cmeasure.h"
@@ -71,6 +72,7 @@
 #include "ship/shipfx.h"
 #include "ship/shiphit.h"
 #include "ship/subsysdamage.h"
+#include "tracing/tracing.h"
 #include "utils/Random.h"
 #include "weapon/beam.h"
 #include "weapon/flak.h"
@@ -203,6 +205,10 @@ object *En_objp;
 #define	STEALTH_MAX_VIEW_DIST	400		// dist at which 1) stealth no longer visible 2) firing inaccuracy is greatest
 #define	STEALTH_VIEW_CONE_DOT	0.707		// (half angle of 45 degrees)
 
+// defines for holding fire when there are lots of weapons, these were 75% and 90% of the old fixed weapon limit of 3000
+#define	AI_UNLINK_PRIMARIES_NUM_WEAPONS	2250	// ships stop linking their primaries above this many weapons
+#define	AI_FIRE_LESS_NUM_WEAPONS			2700	// ships fire half as often above this many weapons
+
 ai_class *Ai_classes = NULL;
 int	Ai_firing_enabled = 1;
 int	Num_ai_classes;
@@ -986,6 +992,8 @@ void ai_level_init()
 	ai_init_secondary_info();
 
 	Ai_last_arrive_path=0;
+
+	ai_scheduler_level_init();
 }
 
 // BEGIN STEALTH
@@ -4894,11 +4902,12 @@ void ai_fly_to_ship()
 		return;
 	}
 
-	for (int j = 0; j < MAX_SHIPS; j++)
+	for (auto so : list_range(&Ship_obj_list))
 	{
-		if (Ships[j].objnum != -1 && !stricmp(aip->goals[aip->active_goal].target_name, Ships[j].ship_name))
+		auto objp = &Objects[so->objnum];
+		if (!stricmp(aip->goals[aip->active_goal].target_name, Ships[objp->instance].ship_name))
 		{
-			target_p = &Objects[Ships[j].objnum];
+			target_p = objp;
 			break;
 		}
 	}
@@ -5802,7 +5811,7 @@ void set_primary_weapon_linkage(object *objp)
 
 	shipp = &Ships[objp->instance];
 
-	if (Num_weapons > (int) (MAX_WEAPONS * 0.75f)) {
+	if (Num_weapons > AI_UNLINK_PRIMARIES_NUM_WEAPONS) {
 		if (shipp->flags[Ship::Ship_Flags::Primary_linked]) {
 			nprintf(("AI", "Frame %i, ship %s: Unlinking primaries.\n", Framecount, shipp->ship_name));
 			shipp->flags.remove(Ship::Ship_Flags::Primary_linked);
@@ -6076,7 +6085,7 @@ int ai_fire_primary_weapon(object *objp)
 	aip = &Ai_info[shipp->ai_index];
 
 	//	If low on slots, fire a little less often.
-	if (Num_weapons > (int) (0.9f * MAX_WEAPONS)) {
+	if (Num_weapons > AI_FIRE_LESS_NUM_WEAPONS) {
 		if (frand() > 0.5f) {
 			nprintf(("AI", "Frame %i, %s not fire.\n", Framecount, shipp->ship_name));
 			return 0;
@@ -14784,8 +14793,16 @@ void ai_frame(int objnum)
 			return;
 	}
 
+	// Decisions may be spread over multiple frames by the AI scheduler, steering always runs
+	bool run_decisions = ai_scheduler_should_decide(objnum);
+
 	ai_maybe_self_destruct(Pl_objp, aip);
-	ai_process_mission_orders( objnum, aip );
+	if (run_decisions) {
+		TRACE_SCOPE(tracing::AIDecisions);
+		ai_decision_timer timer(objnum);
+
+		ai_process_mission_orders( objnum, aip );
+	}
 
 	//	Avoid a shockwave, if necessary.  If a shockwave and rearming, stop rearming.
 	if (aip->mode != AIM_PLAY_DEAD && aip->ai_flags[AI::AI_Flags::Avoid_shockwave_ship, AI::AI_Flags::Avoid_shockwave_weapon]) {
@@ -14843,15 +14860,23 @@ void ai_frame(int objnum)
 		} else if (aip->resume_goal_time == -1) {
 			// AL 12-9-97: Don't allow cargo and navbuoys to set their aip->target_objnum
 			if ( Ship_info[shipp->ship_info_index].class_type > -1 && (Ship_types[Ship_info[shipp->ship_info_index].class_type].flags[Ship::Type_Info_Flags::AI_auto_attacks]) ) {
-				target_objnum = find_enemy(objnum, MAX_ENEMY_DISTANCE, The_mission.ai_profile->max_attackers[Game_skill_level]);		//	Attack up to 2.5K units away.
-				if (target_objnum != -1) {
-					if (aip->target_objnum != target_objnum)
-						aip->aspect_locked_time = 0.0f;
-					target_objnum = set_target_objnum(aip, target_objnum);
+				if (!run_decisions) {
+					// Pick a new target as soon as the scheduler allows it
+					ai_scheduler_request_decision(objnum);
+				} else {
+					TRACE_SCOPE(tracing::AIDecisions);
+					ai_decision_timer timer(objnum);
 
-					if (target_objnum >= 0)
-					{
-						En_objp = &Objects[target_objnum];
+					target_objnum = find_enemy(objnum, MAX_ENEMY_DISTANCE, The_mission.ai_profile->max_attackers[Game_skill_level]);		//	Attack up to 2.5K units away.
+					if (target_objnum != -1) {
+						if (aip->target_objnum != target_objnum)
+							aip->aspect_locked_time = 0.0f;
+						target_objnum = set_target_objnum(aip, target_objnum);
+
+						if (target_objnum >= 0)
+						{
+							En_objp = &Objects[target_objnum];
+						}
 					}
 				}
 			}
@@ -15100,7 +15125,9 @@ void ai_process( object * obj, int ai_index, float frametime )
 	AI_ci.bank = 0.0f;
 	AI_ci.heading = 0.0f;
 
+	auto frame_start = timer_get_microseconds();
 	ai_frame(OBJ_INDEX(obj));
+	ai_scheduler_add_frame_time(timer_get_microseconds() - frame_start);
 
 	// the ships maximum velocity now depends on the energy flowing to engines
 	obj->phys_info.max_vel.xyz.z = shipp->current_max_speed;
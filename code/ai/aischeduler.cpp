@@ -0,0 +1,214 @@
+
+#include "ai/aischeduler.h"
+
+#include "ai/ai.h"
+#include "cmdline/cmdline.h"
+#include "debugconsole/console.h"
+#include "globalincs/systemvars.h"
+#include "io/timer.h"
+#include "math/vecmat.h"
+#include "object/object.h"
+#include "ship/ship.h"
+#include "tracing/Monitor.h"
+#include "tracing/tracing.h"
+
+#include <algorithm>
+
+namespace {
+
+// Estimated decision time of a ship which was not measured yet
+const float DEFAULT_DECISION_COST_US = 50.0f;
+
+// Weight of a new measurement in the moving average of the decision time
+const float DECISION_COST_SMOOTHING = 0.2f;
+
+float Ai_max_decision_latency = 250.0f;
+float Ai_near_player_radius = 1000.0f;
+
+DCF_FLOAT2(ai_budget, Cmdline_ai_budget, 0.0f, 100.0f, "Sets the time in ms AI decisions may take per frame, 0 disables the AI scheduler (Default is 0)");
+DCF_FLOAT2(ai_max_latency, Ai_max_decision_latency, 0.0f, 5000.0f, "Sets the maximum time in ms between two decisions of the same AI ship (Default is 250)");
+DCF_FLOAT2(ai_near_radius, Ai_near_player_radius, 0.0f, 100000.0f, "Sets the distance to the player within which AI ships decide every frame (Default is 1000)");
+
+struct ai_schedule_info {
+	int signature = -1;
+
+	int last_decision_stamp = 0;
+	int scheduled_frame = -1;
+	bool urgent = true;
+
+	float avg_cost_us = DEFAULT_DECISION_COST_US;
+	std::uint64_t frame_cost_us = 0;
+	int cost_frame = -1;
+};
+
+struct ai_schedule_candidate {
+	int objnum;
+	float priority;
+};
+
+ai_schedule_info Ai_schedule[MAX_OBJECTS];
+
+int Ai_schedule_planned_frame = -1;
+
+int Ai_frame_time_frame = -1;
+std::uint64_t Ai_frame_time_us = 0;
+
+tracing::Monitor<float> Ai_frame_time_monitor("AIFrameTime", 0.0f);
+tracing::Monitor<float> Ai_decision_latency_monitor("AIDecisionLatency", 0.0f);
+tracing::Monitor<int> Ai_deferred_ships_monitor("AIDeferredShips", 0);
+
+bool scheduler_enabled()
+{
+	return Cmdline_ai_budget > 0.0f && !(Game_mode & GM_MULTIPLAYER);
+}
+
+ai_schedule_info& get_schedule_info(int objnum)
+{
+	auto& info = Ai_schedule[objnum];
+
+	if (info.signature != Objects[objnum].signature) {
+		info = ai_schedule_info();
+		info.signature = Objects[objnum].signature;
+	}
+
+	return info;
+}
+
+// Folds the decision time measured in the last frame the ship ran into its cost estimate
+void update_cost_estimate(ai_schedule_info& info)
+{
+	if (info.cost_frame < 0 || info.cost_frame == Framecount) {
+		return;
+	}
+
+	info.avg_cost_us += (static_cast<float>(info.frame_cost_us) - info.avg_cost_us) * DECISION_COST_SMOOTHING;
+	info.frame_cost_us = 0;
+	info.cost_frame = -1;
+}
+
+void plan_frame()
+{
+	TRACE_SCOPE(tracing::AIScheduler);
+
+	static SCP_vector<ai_schedule_candidate> candidates;
+	candidates.clear();
+
+	auto budget_us = Cmdline_ai_budget * 1000.0f;
+	auto near_radius = std::max(Ai_near_player_radius, 1.0f);
+	auto max_latency = fl2i(Ai_max_decision_latency);
+
+	float spent_us = 0.0f;
+	int max_wait = 0;
+
+	for (auto so = GET_FIRST(&Ship_obj_list); so != END_OF_LIST(&Ship_obj_list); so = GET_NEXT(so)) {
+		auto objp = &Objects[so->objnum];
+		if (objp->flags[Object::Object_Flags::Should_be_dead] || Ships[objp->instance].ai_index < 0) {
+			continue;
+		}
+
+		auto& info = get_schedule_info(so->objnum);
+		update_cost_estimate(info);
+
+		auto waited = info.urgent ? 0 : timestamp_since(info.last_decision_stamp);
+		auto dist = (Player_obj != nullptr && Player_obj != objp) ? vm_vec_dist_quick(&Player_obj->pos, &objp->pos) : 0.0f;
+
+		if (info.urgent || objp == Player_obj || dist < near_radius || waited >= max_latency) {
+			info.scheduled_frame = Framecount;
+			spent_us += info.avg_cost_us;
+			max_wait = std::max(max_wait, waited);
+			continue;
+		}
+
+		// Ships close to the player get a higher weight so their decisions are more responsive
+		candidates.push_back({so->objnum, waited * (1.0f + near_radius / dist)});
+	}
+
+	std::sort(candidates.begin(), candidates.end(),
+		[](const ai_schedule_candidate& left, const ai_schedule_candidate& right) { return left.priority > right.priority; });
+
+	size_t scheduled = 0;
+	for (; scheduled < candidates.size(); ++scheduled) {
+		auto& info = Ai_schedule[candidates[scheduled].objnum];
+		if (spent_us + info.avg_cost_us > budget_us) {
+			break;
+		}
+
+		info.scheduled_frame = Framecount;
+		spent_us += info.avg_cost_us;
+		max_wait = std::max(max_wait, timestamp_since(info.last_decision_stamp));
+	}
+
+	Ai_decision_latency_monitor = static_cast<float>(max_wait);
+	Ai_deferred_ships_monitor = static_cast<int>(candidates.size() - scheduled);
+
+	Ai_schedule_planned_frame = Framecount;
+}
+
+} // namespace
+
+void ai_scheduler_level_init()
+{
+	for (auto& info : Ai_schedule) {
+		info = ai_schedule_info();
+	}
+
+	Ai_schedule_planned_frame = -1;
+	Ai_frame_time_frame = -1;
+	Ai_frame_time_us = 0;
+}
+
+bool ai_scheduler_should_decide(int objnum)
+{
+	if (!scheduler_enabled()) {
+		return true;
+	}
+
+	if (Ai_schedule_planned_frame != Framecount) {
+		plan_frame();
+	}
+
+	auto& info = get_schedule_info(objnum);
+	if (!info.urgent && info.scheduled_frame != Framecount) {
+		return false;
+	}
+
+	info.urgent = false;
+	info.last_decision_stamp = timestamp();
+	return true;
+}
+
+void ai_scheduler_request_decision(int objnum)
+{
+	if (!scheduler_enabled()) {
+		return;
+	}
+
+	get_schedule_info(objnum).urgent = true;
+}
+
+void ai_scheduler_add_frame_time(std::uint64_t microseconds)
+{
+	if (Ai_frame_time_frame != Framecount) {
+		if (Ai_frame_time_frame >= 0) {
+			Ai_frame_time_monitor = Ai_frame_time_us / 1000.0f;
+		}
+
+		Ai_frame_time_frame = Framecount;
+		Ai_frame_time_us = 0;
+	}
+
+	Ai_frame_time_us += microseconds;
+}
+
+ai_decision_timer::ai_decision_timer(int objnum) : _objnum(objnum), _start(timer_get_microseconds()) {}
+
+ai_decision_timer::~ai_decision_timer()
+{
+	if (!scheduler_enabled()) {
+		return;
+	}
+
+	auto& info = get_schedule_info(_objnum);
+	info.frame_cost_us += timer_get_microseconds() - _start;
+	info.cost_frame = Framecount;
+}
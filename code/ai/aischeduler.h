@@ -0,0 +1,56 @@
+#pragma once
+
+#include "globalincs/pstypes.h"
+
+/** @file
+ *  Spreads the expensive AI decisions over multiple frames.
+ *
+ *  Every AI ship still steers and fires each frame but the decision parts of ai_frame (goal evaluation and target
+ *  selection) are only executed for the ships the scheduler picked for the current frame. Ships are picked by how long
+ *  they have been waiting, weighted by their distance to the player, until the estimated cost of their decisions
+ *  exceeds the per-frame budget. Ships close to the player and ships which waited longer than the maximum latency are
+ *  always picked so no ship is starved.
+ *
+ *  The scheduler is disabled by default. It is enabled with -ai_budget or the ai_budget debug command.
+ */
+
+/**
+ * @brief Resets the scheduling state, called at the start of a mission
+ */
+void ai_scheduler_level_init();
+
+/**
+ * @brief Checks if the decision logic of the specified ship should run this frame
+ *
+ * Always returns @c true if the scheduler is disabled.
+ *
+ * @param objnum The object number of the AI ship
+ */
+bool ai_scheduler_should_decide(int objnum);
+
+/**
+ * @brief Makes sure the specified ship will be picked in the next frame, e.g. because it needs a new target
+ */
+void ai_scheduler_request_decision(int objnum);
+
+/**
+ * @brief Records the time taken by one call of ai_frame, used for the per-frame AI time statistics
+ */
+void ai_scheduler_add_frame_time(std::uint64_t microseconds);
+
+/**
+ * @brief Measures the time spent in the decision logic of an AI ship
+ *
+ * The measurements are used to estimate how many ships fit into the budget of a frame.
+ */
+class ai_decision_timer {
+	int _objnum;
+	std::uint64_t _start;
+
+  public:
+	explicit ai_decision_timer(int objnum);
+	~ai_decision_timer();
+
+	ai_decision_timer(const ai_decision_timer&) = delete;
+	ai_decision_timer& operator=(const ai_decision_timer&) = delete;
+};
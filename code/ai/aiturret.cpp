@@ -16,6 +16,7 @@
 #include "object/objectdock.h"
 #include "scripting/global_hooks.h"
 #include "scripting/scripting.h"
+#include "tracing/tracing.h"
 #include "render/3d.h"
 #include "ship/ship.h"
 #include "ship/shipfx.h"
@@ -26,6 +27,7 @@
 #include "weapon/swarm.h"
 #include "weapon/weapon.h"
 
+#include <algorithm>
 #include <climits>
 
 
@@ -753,6 +755,215 @@ void evaluate_obj_as_target(object *objp, eval_enemy_obj_struct *eeo)
 	} // end asteroid selection
 }
 
+// Per-frame index of the objects turrets may target. Only ships, weapons and asteroids can pass valid_turret_enemy() so
+// everything else is left out. Ships and weapons are bucketed by their class so that a targeting priority group only
+// has to look at the classes it matches.
+struct turret_target_index {
+	int framecount = -1;
+	object* list_tail = nullptr;
+	int list_tail_signature = -1;
+	bool dirty = true;
+
+	struct entry {
+		int objnum;
+		int signature;
+	};
+
+	SCP_vector<int> list_order; // position of each object in obj_used_list
+	SCP_vector<SCP_vector<entry>> ships_by_class;
+	SCP_vector<SCP_vector<entry>> weapons_by_class;
+	SCP_vector<entry> asteroids;
+
+	// The classes matched by every priority group in Ai_tp_list
+	struct priority_group {
+		SCP_vector<int> ship_classes;
+		SCP_vector<int> weapon_classes;
+		bool asteroids = false;
+	};
+	SCP_vector<priority_group> priority_groups;
+};
+
+static turret_target_index Turret_target_index;
+
+void turret_target_index_invalidate()
+{
+	Turret_target_index.dirty = true;
+}
+
+static bool target_priority_matches_ship_class(ai_target_priority* tt, int ship_class)
+{
+	if (tt->obj_type == OBJ_SHIP)
+		return true;
+
+	auto sip = &Ship_info[ship_class];
+	if (std::find(tt->ship_type.begin(), tt->ship_type.end(), sip->class_type) != tt->ship_type.end())
+		return true;
+
+	if (std::find(tt->ship_class.begin(), tt->ship_class.end(), ship_class) != tt->ship_class.end())
+		return true;
+
+	return tt->sif_flags.any_set() && ((sip->flags & tt->sif_flags) == tt->sif_flags);
+}
+
+static bool target_priority_matches_weapon_class(ai_target_priority* tt, int weapon_class)
+{
+	if (tt->obj_type == OBJ_WEAPON)
+		return true;
+
+	if (std::find(tt->weapon_class.begin(), tt->weapon_class.end(), weapon_class) != tt->weapon_class.end())
+		return true;
+
+	return tt->wif_flags.any_set() && ((Weapon_info[weapon_class].wi_flags & tt->wif_flags) == tt->wif_flags);
+}
+
+// The used list only changes while objects are moved if an object is deleted, which is caught when the candidates are
+// collected, or if newly created objects are merged into it, which changes the tail of the list.
+static void turret_target_index_update()
+{
+	auto& index = Turret_target_index;
+	auto tail = GET_LAST(&obj_used_list);
+	auto tail_signature = tail != END_OF_LIST(&obj_used_list) ? tail->signature : -1;
+
+	if (!index.dirty && index.framecount == Framecount && index.list_tail == tail && index.list_tail_signature == tail_signature)
+		return;
+
+	TRACE_SCOPE(tracing::TurretTargetIndex);
+
+	index.framecount = Framecount;
+	index.list_tail = tail;
+	index.list_tail_signature = tail_signature;
+	index.dirty = false;
+
+	index.list_order.resize(MAX_OBJECTS);
+	index.ships_by_class.resize(Ship_info.size());
+	index.weapons_by_class.resize(Weapon_info.size());
+	for (auto& bucket : index.ships_by_class)
+		bucket.clear();
+	for (auto& bucket : index.weapons_by_class)
+		bucket.clear();
+	index.asteroids.clear();
+
+	int order = 0;
+	for (auto objp : list_range(&obj_used_list)) {
+		auto objnum = OBJ_INDEX(objp);
+		index.list_order[objnum] = order++;
+
+		switch (objp->type) {
+		case OBJ_SHIP:
+			index.ships_by_class[Ships[objp->instance].ship_info_index].push_back({objnum, objp->signature});
+			break;
+		case OBJ_WEAPON:
+			index.weapons_by_class[Weapons[objp->instance].weapon_info_index].push_back({objnum, objp->signature});
+			break;
+		case OBJ_ASTEROID:
+			index.asteroids.push_back({objnum, objp->signature});
+			break;
+		default:
+			break;
+		}
+	}
+
+	// Group membership only depends on the tables but those may be changed by scripts so it is redone with the index
+	index.priority_groups.resize(Ai_tp_list.size());
+	for (size_t i = 0; i < Ai_tp_list.size(); ++i) {
+		auto tt = &Ai_tp_list[i];
+		auto& group = index.priority_groups[i];
+
+		group.ship_classes.clear();
+		for (int ship_class = 0; ship_class < static_cast<int>(Ship_info.size()); ++ship_class) {
+			if (!index.ships_by_class[ship_class].empty() && target_priority_matches_ship_class(tt, ship_class))
+				group.ship_classes.push_back(ship_class);
+		}
+
+		group.weapon_classes.clear();
+		for (int weapon_class = 0; weapon_class < static_cast<int>(Weapon_info.size()); ++weapon_class) {
+			if (!index.weapons_by_class[weapon_class].empty() && target_priority_matches_weapon_class(tt, weapon_class))
+				group.weapon_classes.push_back(weapon_class);
+		}
+
+		group.asteroids = tt->obj_type == OBJ_ASTEROID;
+	}
+}
+
+/**
+ * Collects the objects which belong to a targeting priority group, in the order in which they appear in obj_used_list.
+ *
+ * Objects which evaluate_obj_as_target() would reject before doing anything else (wrong type, weapons while the weapons
+ * subsystem is destroyed, ships of a team which isn't targeted) are left out.
+ */
+static void turret_collect_priority_candidates(int tp_index, int enemy_team_mask, bool include_weapons, SCP_vector<int>& candidates)
+{
+	auto& index = Turret_target_index;
+	auto tt = &Ai_tp_list[tp_index];
+	auto& group = index.priority_groups[tp_index];
+
+	candidates.clear();
+
+	auto is_live = [](const turret_target_index::entry& e) {
+		auto objp = &Objects[e.objnum];
+		return objp->signature == e.signature && objp->type != OBJ_NONE && !objp->flags[Object::Object_Flags::Should_be_dead];
+	};
+
+	// Objects lacking any of the object flags of the group match regardless of their class so in that case every
+	// object has to be checked
+	if (tt->obj_flags.any_set()) {
+		auto flag_match = [tt](int objnum) {
+			return !((Objects[objnum].flags & tt->obj_flags) == tt->obj_flags);
+		};
+
+		for (int ship_class = 0; ship_class < static_cast<int>(index.ships_by_class.size()); ++ship_class) {
+			bool class_match = std::binary_search(group.ship_classes.begin(), group.ship_classes.end(), ship_class);
+			for (auto& e : index.ships_by_class[ship_class]) {
+				if (is_live(e) && iff_matches_mask(Ships[Objects[e.objnum].instance].team, enemy_team_mask) &&
+					(class_match || flag_match(e.objnum)))
+					candidates.push_back(e.objnum);
+			}
+		}
+
+		if (include_weapons) {
+			for (int weapon_class = 0; weapon_class < static_cast<int>(index.weapons_by_class.size()); ++weapon_class) {
+				bool class_match = std::binary_search(group.weapon_classes.begin(), group.weapon_classes.end(), weapon_class);
+				for (auto& e : index.weapons_by_class[weapon_class]) {
+					if (is_live(e) && (class_match || flag_match(e.objnum)))
+						candidates.push_back(e.objnum);
+				}
+			}
+		}
+
+		for (auto& e : index.asteroids) {
+			if (is_live(e) && (group.asteroids || flag_match(e.objnum)))
+				candidates.push_back(e.objnum);
+		}
+	} else {
+		for (auto ship_class : group.ship_classes) {
+			for (auto& e : index.ships_by_class[ship_class]) {
+				if (is_live(e) && iff_matches_mask(Ships[Objects[e.objnum].instance].team, enemy_team_mask))
+					candidates.push_back(e.objnum);
+			}
+		}
+
+		if (include_weapons) {
+			for (auto weapon_class : group.weapon_classes) {
+				for (auto& e : index.weapons_by_class[weapon_class]) {
+					if (is_live(e))
+						candidates.push_back(e.objnum);
+				}
+			}
+		}
+
+		if (group.asteroids) {
+			for (auto& e : index.asteroids) {
+				if (is_live(e))
+					candidates.push_back(e.objnum);
+			}
+		}
+	}
+
+	// Keep the order of obj_used_list so that ties and the random stealth checks come out the same as before
+	std::sort(candidates.begin(), candidates.end(),
+		[&index](int a, int b) { return index.list_order[a] < index.list_order[b]; });
+}
+
 /**
  * Given an object and an enemy team, return the index of the nearest enemy object.
  *
@@ -857,77 +1068,20 @@ int get_nearest_turret_objnum(int turret_parent_objnum, ship_subsys *turret_subs
 
 	if (n_tgt_priorities > 0) 
     {
+		turret_target_index_update();
+
+		static SCP_vector<int> candidates;
 		for(int i = 0; i < n_tgt_priorities; i++) {
 			// courtesy of WMC...
-			ai_target_priority *tt;
+			int tp_index;
 			if (priority_weapon_idx == -1)
-				tt = &Ai_tp_list[turret_subsys->target_priority[i]];
+				tp_index = turret_subsys->target_priority[i];
 			else
-				tt = &Ai_tp_list[Weapon_info[priority_weapon_idx].targeting_priorities[i]];
-
-			int n_types = (int)tt->ship_type.size();
-			int n_s_classes = (int)tt->ship_class.size();
-			int n_w_classes = (int)tt->weapon_class.size();
-			
-			bool found_something;
-			for (auto ptr: list_range(&obj_used_list)) {
-				if (ptr->flags[Object::Object_Flags::Should_be_dead])
-					continue;
-
-				found_something = false;
-
-				if(tt->obj_type > -1 && (ptr->type == tt->obj_type)) {
-					found_something = true;
-				}
-
-				if( ( n_types > 0 ) && ( ptr->type == OBJ_SHIP ) ) {
-					for (int j = 0; j < n_types; j++) {
-						if ( Ship_info[Ships[ptr->instance].ship_info_index].class_type == tt->ship_type[j] ) {
-							found_something = true;
-						}
-					}
-				}
-
-				if( ( n_s_classes > 0 ) && ( ptr->type == OBJ_SHIP ) ) {
-					for (int j = 0; j < n_s_classes; j++) {
-						if ( Ships[ptr->instance].ship_info_index == tt->ship_class[j] ) {
-							found_something = true;
-						}
-					}
-				}
-
-				if( ( n_w_classes > 0 ) && ( ptr->type == OBJ_WEAPON ) ) {
-					for (int j = 0; j < n_w_classes; j++) {
-						if ( Weapons[ptr->instance].weapon_info_index == tt->weapon_class[j] ) {
-							found_something = true;
-						}
-					}
-				}
-
-				if( (tt->wif_flags.any_set()) && (ptr->type == OBJ_WEAPON) ) {
-					if( ( (Weapon_info[Weapons[ptr->instance].weapon_info_index].wi_flags & tt->wif_flags ) == tt->wif_flags) ) {
-							found_something = true;
-					}
-				}
-
-				if( ( tt->sif_flags.any_set() && (ptr->type == OBJ_SHIP) ) ) {
-					if( (Ship_info[Ships[ptr->instance].ship_info_index].flags & tt->sif_flags) == tt->sif_flags)
-	                {
-    					found_something = true;
-					}
-				}
-
-                if ((tt->obj_flags.any_set()) && !((ptr->flags & tt->obj_flags) == tt->obj_flags)) {
-					found_something = true;
-				}
-
-				if(!(found_something)) {
-					//we didnt find this object within this priority group
-					//skip to next without evaluating the object as target
-					continue;
-				}
+				tp_index = Weapon_info[priority_weapon_idx].targeting_priorities[i];
 
-				evaluate_obj_as_target(ptr, &eeo);
+			turret_collect_priority_candidates(tp_index, enemy_team_mask, weapon_system_ok != 0, candidates);
+			for (auto objnum : candidates) {
+				evaluate_obj_as_target(&Objects[objnum], &eeo);
 			}
 
 			//homing weapon entry...
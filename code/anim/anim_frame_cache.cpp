@@ -0,0 +1,210 @@
+
+#include "anim/anim_frame_cache.h"
+
+#include <chrono>
+
+bool anim_frame_cache::frame_key::operator==(const frame_key& other) const
+{
+	return same_stream(other) && offset == other.offset;
+}
+
+bool anim_frame_cache::frame_key::same_stream(const frame_key& other) const
+{
+	return ani == other.ani && bpp == other.bpp && aabitmap == other.aabitmap && xlate_pal == other.xlate_pal;
+}
+
+size_t anim_frame_cache::frame_key_hash::operator()(const frame_key& key) const
+{
+	auto hash = std::hash<const anim*>()(key.ani);
+	hash ^= std::hash<int>()(key.offset) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+	hash ^= std::hash<int>()((key.bpp << 2) | (key.aabitmap ? 2 : 0) | (key.xlate_pal ? 1 : 0)) + 0x9e3779b9 + (hash << 6) +
+	        (hash >> 2);
+
+	return hash;
+}
+
+anim_frame_cache::~anim_frame_cache()
+{
+	clear();
+}
+
+bool anim_frame_cache::make_room(size_t needed)
+{
+	if (needed > Budget) {
+		return false;
+	}
+
+	auto lru_it = Lru_frames.begin();
+	while (Stats.bytes + needed > Budget) {
+		// Frames which are referenced elsewhere are in use right now
+		while (lru_it != Lru_frames.end() && Frames.find(*lru_it)->second.data.use_count() > 1) {
+			++lru_it;
+		}
+
+		if (lru_it == Lru_frames.end()) {
+			return false;
+		}
+
+		auto oldest = Frames.find(*lru_it);
+		++lru_it;
+
+		erase(oldest);
+		++Stats.evictions;
+	}
+
+	return true;
+}
+
+anim_frame_cache::frame_map::iterator anim_frame_cache::erase(frame_map::iterator it)
+{
+	Stats.bytes -= it->second.data->pixels.size();
+	Lru_frames.erase(it->second.lru_pos);
+
+	return Frames.erase(it);
+}
+
+void anim_frame_cache::add(const frame_key& key, frame_ptr data)
+{
+	if (!make_room(data->pixels.size())) {
+		return;
+	}
+
+	auto& new_entry = Frames[key];
+	new_entry.data = std::move(data);
+	new_entry.lru_pos = Lru_frames.insert(Lru_frames.end(), key);
+
+	Stats.bytes += new_entry.data->pixels.size();
+	Stats.num_frames = Frames.size();
+}
+
+void anim_frame_cache::set_budget(size_t bytes)
+{
+	Budget = bytes;
+
+	if (Budget == 0) {
+		clear();
+	} else {
+		make_room(0);
+		Stats.num_frames = Frames.size();
+	}
+}
+
+size_t anim_frame_cache::get_budget() const
+{
+	return Budget;
+}
+
+anim_frame_cache::frame_ptr anim_frame_cache::find(const frame_key& key)
+{
+	auto it = Frames.find(key);
+	if (it == Frames.end()) {
+		++Stats.misses;
+		return nullptr;
+	}
+
+	++Stats.hits;
+	Lru_frames.splice(Lru_frames.end(), Lru_frames, it->second.lru_pos);
+	return it->second.data;
+}
+
+anim_frame_cache::frame_ptr anim_frame_cache::insert(const frame_key& key, frame&& new_frame)
+{
+	frame_ptr data = std::make_shared<frame>(std::move(new_frame));
+
+	if (Budget > 0 && Frames.find(key) == Frames.end()) {
+		add(key, data);
+	}
+
+	return data;
+}
+
+bool anim_frame_cache::contains(const frame_key& key) const
+{
+	return Frames.find(key) != Frames.end();
+}
+
+bool anim_frame_cache::is_prefetching(const frame_key& key) const
+{
+	for (auto& job : Pending) {
+		if (job.start.same_stream(key)) {
+			return true;
+		}
+	}
+
+	return false;
+}
+
+void anim_frame_cache::add_pending(const frame_key& start, std::future<prefetch_result>&& result)
+{
+	pending_job job;
+	job.start = start;
+	job.result = std::move(result);
+
+	Pending.push_back(std::move(job));
+}
+
+void anim_frame_cache::collect()
+{
+	for (auto it = Pending.begin(); it != Pending.end();) {
+		if (it->result.wait_for(std::chrono::seconds(0)) != std::future_status::ready) {
+			++it;
+			continue;
+		}
+
+		auto frames = it->result.get();
+		it = Pending.erase(it);
+
+		if (Budget == 0) {
+			continue;
+		}
+
+		for (auto& decoded : frames) {
+			if (contains(decoded.first)) {
+				continue;
+			}
+
+			add(decoded.first, std::make_shared<frame>(std::move(decoded.second)));
+			++Stats.prefetched;
+		}
+	}
+}
+
+void anim_frame_cache::remove_anim(const anim* ani)
+{
+	for (auto it = Pending.begin(); it != Pending.end();) {
+		if (it->start.ani == ani) {
+			it->result.wait();
+			it = Pending.erase(it);
+		} else {
+			++it;
+		}
+	}
+
+	for (auto it = Frames.begin(); it != Frames.end();) {
+		if (it->first.ani == ani) {
+			it = erase(it);
+		} else {
+			++it;
+		}
+	}
+
+	Stats.num_frames = Frames.size();
+}
+
+void anim_frame_cache::clear()
+{
+	for (auto& job : Pending) {
+		job.result.wait();
+	}
+	Pending.clear();
+
+	Frames.clear();
+	Lru_frames.clear();
+	Stats.bytes = 0;
+	Stats.num_frames = 0;
+}
+
+const anim_frame_cache::stats& anim_frame_cache::get_stats() const
+{
+	return Stats;
+}
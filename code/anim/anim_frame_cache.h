@@ -0,0 +1,149 @@
+#pragma once
+
+#include "globalincs/pstypes.h"
+
+#include <future>
+#include <memory>
+
+struct anim;
+
+/**
+ * @brief Shares decoded ANI frames between all instances of an animation
+ *
+ * Frames are identified by the offset of their compressed data. Delta frames only contain the pixels which changed
+ * since the previous frame but animations are always decoded in order starting at a key frame, so the data at an offset
+ * always results in the same image. An entry holds the whole image and the offset of the following frame.
+ *
+ * Frames are handed out as shared pointers. Frames which are still referenced elsewhere are never evicted and the
+ * memory of an evicted frame stays valid until the last reference is gone.
+ *
+ * Upcoming frames can be decoded in the background. The results of those jobs are only added to the cache by
+ * collect() so the cache itself is only ever used from the main thread.
+ */
+class anim_frame_cache {
+  public:
+	struct frame_key {
+		const anim* ani = nullptr;
+		int offset = 0; //!< Offset of the compressed data relative to the start of the frame data
+		int bpp = 0;
+		bool aabitmap = false;
+		bool xlate_pal = false;
+
+		bool operator==(const frame_key& other) const;
+
+		/**
+		 * @brief Checks if both keys belong to the same animation decoded in the same format
+		 */
+		bool same_stream(const frame_key& other) const;
+	};
+
+	struct frame {
+		SCP_vector<ubyte> pixels;
+		int next_offset = -1; //!< Offset of the following frame
+	};
+
+	typedef std::shared_ptr<const frame> frame_ptr;
+	typedef SCP_vector<std::pair<frame_key, frame>> prefetch_result;
+
+	struct stats {
+		size_t num_frames = 0;
+		size_t bytes = 0;
+		size_t hits = 0;
+		size_t misses = 0;
+		size_t evictions = 0;
+		size_t prefetched = 0; //!< Frames which were added by background jobs
+	};
+
+  private:
+	struct frame_key_hash {
+		size_t operator()(const frame_key& key) const;
+	};
+
+	typedef SCP_list<frame_key> lru_list;
+
+	struct entry {
+		frame_ptr data;
+		lru_list::iterator lru_pos; //!< The position of this frame in Lru_frames
+	};
+
+	struct pending_job {
+		frame_key start;
+		std::future<prefetch_result> result;
+	};
+
+	typedef SCP_unordered_map<frame_key, entry, frame_key_hash> frame_map;
+
+	frame_map Frames;
+	lru_list Lru_frames; //!< The least recently used frame first
+	SCP_vector<pending_job> Pending;
+
+	size_t Budget = 0;
+
+	stats Stats;
+
+	bool make_room(size_t needed);
+
+	frame_map::iterator erase(frame_map::iterator it);
+
+	void add(const frame_key& key, frame_ptr data);
+
+  public:
+	anim_frame_cache() = default;
+	~anim_frame_cache();
+
+	anim_frame_cache(const anim_frame_cache&) = delete;
+	anim_frame_cache& operator=(const anim_frame_cache&) = delete;
+
+	/**
+	 * @brief Sets how many bytes the decoded frames may use, 0 turns the cache off
+	 */
+	void set_budget(size_t bytes);
+
+	size_t get_budget() const;
+
+	/**
+	 * @return The frame or nullptr if it is not cached
+	 */
+	frame_ptr find(const frame_key& key);
+
+	/**
+	 * @brief Adds a frame which was decoded by the caller
+	 *
+	 * If the frame doesn't fit into the budget it is not cached but the returned pointer can still be used.
+	 */
+	frame_ptr insert(const frame_key& key, frame&& new_frame);
+
+	/**
+	 * @brief Checks if a frame is cached without counting it as a use
+	 */
+	bool contains(const frame_key& key) const;
+
+	/**
+	 * @brief Checks if a background job is decoding frames of the same animation in the same format
+	 */
+	bool is_prefetching(const frame_key& key) const;
+
+	/**
+	 * @brief Registers a background job which decodes the frames starting at the key
+	 */
+	void add_pending(const frame_key& start, std::future<prefetch_result>&& result);
+
+	/**
+	 * @brief Adds the frames of all finished background jobs to the cache
+	 */
+	void collect();
+
+	/**
+	 * @brief Removes all frames of an animation, waits for its background jobs to finish
+	 *
+	 * This has to be called before the compressed data of the animation is freed.
+	 */
+	void remove_anim(const anim* ani);
+
+	/**
+	 * @brief Removes all frames, waits for all background jobs to finish
+	 */
+	void clear();
+
+	const stats& get_stats() const;
+};
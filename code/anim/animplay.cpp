@@ -57,6 +57,8 @@ void anim_init()
 		list_append(&anim_free_list, &anim_render_instance[i]);
 	}
 	
+	anim_frame_cache_set_budget((size_t)Cmdline_anim_cache * 1024 * 1024);
+
 	Anim_paused = 0;
 	Anim_inited = TRUE;
 }
@@ -406,44 +408,21 @@ int anim_show_next_frame(anim_instance *instance, float frametime)
 				}
 			}
 
-			ubyte *temp = NULL;
-			int temp_file_offset = -1;			
-
 			// if we're using bitmap polys
 			BM_SELECT_TEX_FORMAT();
 
-			if ( anim_instance_is_streamed(instance) ) {
-				if ( instance->xlate_pal ){
-					temp_file_offset = unpack_frame_from_file(instance, instance->frame, instance->parent->width*instance->parent->height, instance->parent->palette_translation, aabitmap, bpp);
-				} else {
-					temp_file_offset = unpack_frame_from_file(instance, instance->frame, instance->parent->width*instance->parent->height, NULL, aabitmap, bpp);
-				}
-			} else {
-				if ( instance->xlate_pal ){
-					temp = unpack_frame(instance, instance->data, instance->frame, instance->parent->width*instance->parent->height, instance->parent->palette_translation, aabitmap, bpp);
-				} else {
-					temp = unpack_frame(instance, instance->data, instance->frame, instance->parent->width*instance->parent->height, NULL, aabitmap, bpp);
-				}
-			}
+			bool decoded = anim_instance_decode_frame(instance, instance->frame, instance->xlate_pal, aabitmap, bpp);
 
 			// always go back to screen format
 			BM_SELECT_SCREEN_FORMAT();
 
 			// see if we had an error during decode (corrupted anim stream)
-			if ( (temp == NULL) && (temp_file_offset < 0) ) {
+			if ( !decoded ) {
 				mprintf(("ANI: Fatal ERROR at frame %i!!  Aborting playback of \"%s\"...\n", instance->frame_num, instance->parent->name));
 
 				// return -1 to end all playing of this anim instanc
 				return -1;
 			}
-
-			if(instance->direction == ANIM_DIRECT_FORWARD){
-				if ( anim_instance_is_streamed(instance) ) {
-					instance->file_offset = temp_file_offset;
-				} else {
-					instance->data = temp;
-				}
-			}			
 		}
 		t2 = timer_get_fixed_seconds();
 	}
@@ -740,6 +719,7 @@ anim *anim_load(const char *real_filename, int cf_dir_type, int file_mapped)
 
 		cfread(&count, 4, 1, fp);	// size of compressed data
 		count = INTEL_INT( count );
+		ptr->data_size = count;
 
 		ptr->cfile_ptr = NULL;
 
@@ -823,6 +803,8 @@ int anim_free(anim *ptr)
 	if ( ptr->instance_count > 0 )
 		return -1;
 
+	anim_frame_cache_remove(ptr);
+
 	if(ptr->keys != NULL){
 		vm_free(ptr->keys);
 		ptr->keys = NULL;
@@ -9,15 +9,27 @@
 
 
 
+#include "anim/anim_frame_cache.h"
 #include "anim/animplay.h"
 #include "anim/packunpack.h"
 #include "bmpman/bmpman.h"
 #include "graphics/2d.h"
+#include "tracing/Monitor.h"
+#include "utils/ThreadPool.h"
 
 
 const int packer_code = PACKER_CODE;
 const int transparent_code = 254;
 
+/// How many frames a background job decodes ahead of the frame that was just shown
+const int ANIM_PREFETCH_FRAMES = 4;
+
+static anim_frame_cache Anim_frame_cache;
+
+MONITOR(AnimFrameCacheKB)
+MONITOR(AnimFrameCacheHits)
+MONITOR(AnimFrameCacheMisses)
+
 anim_instance *init_anim_instance(anim *ptr, int bpp)
 {
 	anim_instance *inst;
@@ -724,3 +736,168 @@ void anim_set_palette(anim *ptr)
 		ptr->flags &= ~ANF_XPARENT;
 	}
 }
+
+/**
+ * @brief Decodes frames following a cached frame, runs on a worker thread
+ *
+ * Only in-memory animations are decoded here. Streamed animations read through cfile and 16 bit frames which aren't
+ * anti-aliased bitmaps depend on the currently selected bitmap format, neither of which may be used by other threads.
+ */
+static anim_frame_cache::prefetch_result anim_prefetch_frames(anim_frame_cache::frame_key key, anim_frame_cache::frame_ptr previous)
+{
+	anim_frame_cache::prefetch_result result;
+	anim *parent = const_cast<anim*>(key.ani);
+
+	anim_instance inst;
+	memset(&inst, 0, sizeof(inst));
+	inst.parent = parent;
+
+	SCP_vector<ubyte> pixels(previous->pixels);
+	auto pal_translate = key.xlate_pal ? parent->palette_translation : nullptr;
+
+	for (int i = 0; i < ANIM_PREFETCH_FRAMES && key.offset < parent->data_size; i++) {
+		auto next = unpack_frame(&inst, parent->data + key.offset, pixels.data(), parent->width * parent->height, pal_translate, key.aabitmap ? 1 : 0, key.bpp);
+		if (next == nullptr) {
+			break;
+		}
+
+		anim_frame_cache::frame decoded;
+		decoded.pixels = pixels;
+		decoded.next_offset = (int)(next - parent->data);
+		result.emplace_back(key, std::move(decoded));
+
+		key.offset = (int)(next - parent->data);
+	}
+
+	return result;
+}
+
+/**
+ * @brief Starts decoding the frames after the passed frame in the background if they aren't cached yet
+ */
+static void anim_maybe_prefetch(const anim_frame_cache::frame_key &key, const anim_frame_cache::frame_ptr &frame)
+{
+	if ( (key.ani->flags & ANF_STREAMED) || (!key.aabitmap && key.bpp <= 16) ) {
+		return;
+	}
+
+	if ( util::get_thread_pool().numThreads() == 0 ) {
+		return;
+	}
+
+	anim_frame_cache::frame_key next = key;
+	next.offset = frame->next_offset;
+
+	if ( (next.offset < 0) || (next.offset >= key.ani->data_size) ) {
+		return;
+	}
+
+	if ( Anim_frame_cache.contains(next) || Anim_frame_cache.is_prefetching(next) ) {
+		return;
+	}
+
+	Anim_frame_cache.add_pending(next, util::get_thread_pool().submit([next, frame]() { return anim_prefetch_frames(next, frame); }));
+}
+
+/**
+ * @brief Decodes the next frame of an instance
+ *
+ * The frame buffer has to contain the previous frame unless the next frame is a key frame. Afterwards the instance
+ * points to the compressed data of the following frame. Frames are shared between all instances of an animation
+ * through the decoded frame cache and the frames after the decoded one may be decoded in the background.
+ *
+ * 16 bit frames which aren't anti-aliased bitmaps are cached in the selected bitmap format so BM_SELECT_TEX_FORMAT()
+ * has to be active like it is for every other user of the cache.
+ *
+ * @param inst Animation instance
+ * @param frame Where to store the frame, has to hold a frame of the animation in the requested bpp
+ * @param xlate_pal Whether the palette translation of the animation should be used
+ * @param aabitmap
+ * @param bpp
+ * @return @c false if the frame data is corrupted
+ */
+bool anim_instance_decode_frame(anim_instance *inst, ubyte *frame, int xlate_pal, int aabitmap, int bpp)
+{
+	anim *parent = inst->parent;
+	bool streamed = anim_instance_is_streamed(inst) != 0;
+	int size = parent->width * parent->height;
+	auto pal_translate = xlate_pal ? parent->palette_translation : nullptr;
+
+	Anim_frame_cache.collect();
+
+	anim_frame_cache::frame_key key;
+	key.ani = parent;
+	key.offset = streamed ? (inst->file_offset - parent->file_offset) : (int)(inst->data - parent->data);
+	key.bpp = bpp;
+	key.aabitmap = aabitmap != 0;
+	key.xlate_pal = xlate_pal != 0;
+
+	anim_frame_cache::frame_ptr cached;
+	if ( Anim_frame_cache.get_budget() > 0 ) {
+		cached = Anim_frame_cache.find(key);
+	}
+
+	if ( cached ) {
+		memcpy(frame, cached->pixels.data(), cached->pixels.size());
+		MONITOR_INC(AnimFrameCacheHits, 1);
+	} else {
+		int next_offset;
+
+		if ( streamed ) {
+			next_offset = unpack_frame_from_file(inst, frame, size, pal_translate, aabitmap, bpp);
+			if ( next_offset < 0 ) {
+				return false;
+			}
+			next_offset -= parent->file_offset;
+		} else {
+			auto next = unpack_frame(inst, inst->data, frame, size, pal_translate, aabitmap, bpp);
+			if ( next == nullptr ) {
+				return false;
+			}
+			next_offset = (int)(next - parent->data);
+		}
+
+		if ( Anim_frame_cache.get_budget() == 0 ) {
+			if ( streamed ) {
+				inst->file_offset = parent->file_offset + next_offset;
+			} else {
+				inst->data = parent->data + next_offset;
+			}
+			return true;
+		}
+
+		anim_frame_cache::frame decoded;
+		decoded.pixels.assign(frame, frame + size * (bpp >> 3));
+		decoded.next_offset = next_offset;
+		cached = Anim_frame_cache.insert(key, std::move(decoded));
+		MONITOR_INC(AnimFrameCacheMisses, 1);
+	}
+
+	if ( streamed ) {
+		inst->file_offset = parent->file_offset + cached->next_offset;
+	} else {
+		inst->data = parent->data + cached->next_offset;
+	}
+
+	anim_maybe_prefetch(key, cached);
+
+	mon_AnimFrameCacheKB = static_cast<int>(Anim_frame_cache.get_stats().bytes / 1024);
+
+	return true;
+}
+
+/**
+ * @brief Sets how much memory the decoded frames of all animations may use, 0 turns the cache off
+ */
+void anim_frame_cache_set_budget(size_t bytes)
+{
+	Anim_frame_cache.set_budget(bytes);
+}
+
+/**
+ * @brief Drops the decoded frames of an animation, has to be called before its compressed data is freed
+ */
+void anim_frame_cache_remove(anim *ptr)
+{
+	Anim_frame_cache.remove_anim(ptr);
+}
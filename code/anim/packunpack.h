@@ -51,6 +51,7 @@ typedef struct anim {
 	ubyte			palette[768];
 	ubyte			palette_translation[256];
 	ubyte			*data;		// points to compressed data
+	int			data_size;	// size of the compressed data in bytes
 	CFILE*		cfile_ptr;
 	int			version;
 	int			fps;
@@ -103,6 +104,9 @@ void	anim_init();
 anim_instance *init_anim_instance(anim *ptr, int bpp);
 void	free_anim_instance(anim_instance *inst);
 ubyte *anim_get_next_raw_buffer(anim_instance *inst, int xlate_pal, int aabitmap, int bpp);
+bool	anim_instance_decode_frame(anim_instance *inst, ubyte *frame, int xlate_pal, int aabitmap, int bpp);
+void	anim_frame_cache_set_budget(size_t bytes);
+void	anim_frame_cache_remove(anim *ptr);
 void	anim_set_palette(anim *a);
 
 
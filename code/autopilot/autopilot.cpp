@@ -309,7 +309,7 @@ bool StartAutopilot()
 		vm_vector_2_matrix(&Player_obj->orient, &norm1, NULL, NULL);
 	}
 
-	for (i = 0; i < MAX_SHIPS; i++)
+	for (i = 0; i < static_cast<int>(Ships.size()); i++)
 	{
 		if (Ships[i].objnum != -1 && 
 				(Ships[i].flags[Ship::Ship_Flags::Navpoint_carry] || 
@@ -342,7 +342,7 @@ bool StartAutopilot()
 	// when assigning goals to individual ships only do so if Ships[shipnum].wingnum != -1 
 	// we will assign wing goals below
 
-	for (i = 0; i < MAX_SHIPS; i++)
+	for (i = 0; i < static_cast<int>(Ships.size()); i++)
 	{
 		if (Ships[i].objnum != -1 && 
 				(Ships[i].flags[Ship::Ship_Flags::Navpoint_carry] || 
@@ -513,7 +513,7 @@ bool StartAutopilot()
 	}
 
 	// fixup has to go down here because ships are assigned goals during wing goals as well
-	for (i = 0; i < MAX_SHIPS; i++)
+	for (i = 0; i < static_cast<int>(Ships.size()); i++)
 	{
 		if (Ships[i].objnum != -1)
 		{
@@ -887,7 +887,7 @@ void EndAutoPilot()
 	// we will assign wing goals below
 	int i, j;
 
-	for (i = 0; i < MAX_SHIPS; i++)
+	for (i = 0; i < static_cast<int>(Ships.size()); i++)
 
 	{
 		if (Ships[i].objnum != -1 && 
@@ -1012,7 +1012,7 @@ void nav_warp(bool prewarp=false)
 
 	// Find all ships that are supposed to autopilot with the player and move them
 	// to the cinimatic location or the final destination
-	for (int i = 0; i < MAX_SHIPS; i++)
+	for (int i = 0; i < static_cast<int>(Ships.size()); i++)
 	{
 		if (Ships[i].objnum != -1
 			&& (Ships[i].flags[Ship::Ship_Flags::Navpoint_carry] 
@@ -1159,7 +1159,7 @@ void NavSystem_Do()
 	enough.  Always done by the player because: "making sure the AI fighters 
 	are where they're supposed to be at all times is like herding cats" -Woolie Wool
 	*/
-	for (int i = 0; i < MAX_SHIPS; i++)
+	for (int i = 0; i < static_cast<int>(Ships.size()); i++)
 	{
 		if (Ships[i].objnum != -1 && Ships[i].flags[Ship::Ship_Flags::Navpoint_needslink])
 		{
@@ -1387,7 +1387,7 @@ bool AddNav_Ship(const char *Nav, const char *TargetName, int flags)
 	Assert(!(tnav.flags & NP_WAYPOINT));
 
 
-	for (i = 0; i < MAX_SHIPS; i++)
+	for (i = 0; i < static_cast<int>(Ships.size()); i++)
 	{
 		if (Ships[i].objnum != -1 && !stricmp(TargetName, Ships[i].ship_name))
 		{
@@ -0,0 +1,348 @@
+
+#include "bmpman/bm_convert.h"
+#include "utils/ThreadPool.h"
+
+#include <algorithm>
+
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#define BM_CONVERT_SSE2
+#include <emmintrin.h>
+#endif
+
+#if defined(BM_CONVERT_SSE2) && (defined(__SSSE3__) || defined(__AVX__))
+#define BM_CONVERT_SSSE3
+#include <tmmintrin.h>
+#endif
+
+size_t Bm_convert_parallel_pixels = 1024 * 1024;
+
+namespace {
+
+// Splitting an image into smaller pieces than this costs more than it gains
+const size_t MIN_PIXELS_PER_TASK = 64 * 1024;
+
+/**
+ * @brief Calls func(begin, end) for ranges which cover [0, count), large images are split across the worker pool
+ * @param count The number of items, e.g. pixels or rows
+ * @param pixels_per_item How many pixels one item has
+ * @param func The function which converts a range of items
+ */
+template <typename Func>
+void convert_ranges(size_t count, size_t pixels_per_item, const Func& func)
+{
+	auto total = count * pixels_per_item;
+	auto& pool = util::get_thread_pool();
+
+	if (Bm_convert_parallel_pixels == 0 || total <= Bm_convert_parallel_pixels || pool.numThreads() == 0 || count < 2) {
+		func(static_cast<size_t>(0), count);
+		return;
+	}
+
+	auto num_tasks = std::min(pool.numThreads() + 1, total / MIN_PIXELS_PER_TASK);
+	num_tasks = std::min(count, std::max(num_tasks, static_cast<size_t>(2)));
+	auto per_task = (count + num_tasks - 1) / num_tasks;
+
+	util::parallel_for(0, num_tasks, [&](size_t task) {
+		auto begin = task * per_task;
+		auto end = std::min(count, begin + per_task);
+
+		if (begin < end) {
+			func(begin, end);
+		}
+	});
+}
+
+inline ubyte mul_div_255(int value, int alpha)
+{
+	// Exact rounding of value * alpha / 255
+	auto temp = value * alpha + 128;
+	return static_cast<ubyte>((temp + (temp >> 8)) >> 8);
+}
+
+inline ushort convert_1555_to_tex(ushort pixel)
+{
+	if ((pixel & 0x7fff) == 0x03e0) {
+		return 0;
+	}
+
+	return static_cast<ushort>(pixel | 0x8000);
+}
+
+void swap_red_blue_24(ubyte* pixels, size_t begin, size_t end)
+{
+	auto i = begin;
+
+#ifdef BM_CONVERT_SSSE3
+	// Four pixels at a time, the last four bytes of the register are written back unchanged
+	const auto shuffle = _mm_setr_epi8(2, 1, 0, 5, 4, 3, 8, 7, 6, 11, 10, 9, 12, 13, 14, 15);
+	for (; (i * 3) + 16 <= end * 3; i += 4) {
+		auto ptr = reinterpret_cast<__m128i*>(pixels + i * 3);
+		_mm_storeu_si128(ptr, _mm_shuffle_epi8(_mm_loadu_si128(ptr), shuffle));
+	}
+#endif
+
+	for (; i < end; ++i) {
+		std::swap(pixels[i * 3], pixels[i * 3 + 2]);
+	}
+}
+
+void swap_red_blue_32(ubyte* pixels, size_t begin, size_t end)
+{
+	auto i = begin;
+
+#ifdef BM_CONVERT_SSE2
+	const auto green_alpha = _mm_set1_epi32(static_cast<int>(0xff00ff00));
+	const auto red_blue = _mm_set1_epi32(0x00ff00ff);
+	for (; i + 4 <= end; i += 4) {
+		auto ptr = reinterpret_cast<__m128i*>(pixels + i * 4);
+		auto value = _mm_loadu_si128(ptr);
+
+		auto swapped = _mm_and_si128(value, red_blue);
+		swapped = _mm_or_si128(_mm_slli_epi32(swapped, 16), _mm_srli_epi32(swapped, 16));
+
+		_mm_storeu_si128(ptr, _mm_or_si128(_mm_and_si128(value, green_alpha), swapped));
+	}
+#endif
+
+	for (; i < end; ++i) {
+		std::swap(pixels[i * 4], pixels[i * 4 + 2]);
+	}
+}
+
+void expand_24_to_32(ubyte* dst, const ubyte* src, size_t begin, size_t end)
+{
+	auto i = begin;
+
+#ifdef BM_CONVERT_SSSE3
+	const auto shuffle = _mm_setr_epi8(0, 1, 2, -1, 3, 4, 5, -1, 6, 7, 8, -1, 9, 10, 11, -1);
+	const auto alpha = _mm_set1_epi32(static_cast<int>(0xff000000));
+	for (; (i * 3) + 16 <= end * 3; i += 4) {
+		auto value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 3));
+		value = _mm_or_si128(_mm_shuffle_epi8(value, shuffle), alpha);
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i * 4), value);
+	}
+#endif
+
+	for (; i < end; ++i) {
+		dst[i * 4] = src[i * 3];
+		dst[i * 4 + 1] = src[i * 3 + 1];
+		dst[i * 4 + 2] = src[i * 3 + 2];
+		dst[i * 4 + 3] = 255;
+	}
+}
+
+#ifdef BM_CONVERT_SSE2
+inline __m128i premultiply_two(__m128i pixels)
+{
+	// Alpha is multiplied with 255 so it stays the same
+	const auto color_mask = _mm_set_epi16(0, -1, -1, -1, 0, -1, -1, -1);
+	const auto alpha_factor = _mm_set_epi16(255, 0, 0, 0, 255, 0, 0, 0);
+	const auto rounding = _mm_set1_epi16(128);
+
+	auto factors = _mm_shufflehi_epi16(_mm_shufflelo_epi16(pixels, _MM_SHUFFLE(3, 3, 3, 3)), _MM_SHUFFLE(3, 3, 3, 3));
+	factors = _mm_or_si128(_mm_and_si128(factors, color_mask), alpha_factor);
+
+	auto temp = _mm_add_epi16(_mm_mullo_epi16(pixels, factors), rounding);
+	return _mm_srli_epi16(_mm_add_epi16(temp, _mm_srli_epi16(temp, 8)), 8);
+}
+#endif
+
+void premultiply_alpha(ubyte* pixels, size_t begin, size_t end)
+{
+	auto i = begin;
+
+#ifdef BM_CONVERT_SSE2
+	const auto zero = _mm_setzero_si128();
+	for (; i + 4 <= end; i += 4) {
+		auto ptr = reinterpret_cast<__m128i*>(pixels + i * 4);
+		auto value = _mm_loadu_si128(ptr);
+
+		auto low = premultiply_two(_mm_unpacklo_epi8(value, zero));
+		auto high = premultiply_two(_mm_unpackhi_epi8(value, zero));
+
+		_mm_storeu_si128(ptr, _mm_packus_epi16(low, high));
+	}
+#endif
+
+	for (; i < end; ++i) {
+		auto pixel = pixels + i * 4;
+		pixel[0] = mul_div_255(pixel[0], pixel[3]);
+		pixel[1] = mul_div_255(pixel[1], pixel[3]);
+		pixel[2] = mul_div_255(pixel[2], pixel[3]);
+	}
+}
+
+void convert_1555_to_tex(ushort* dst, const ubyte* src, size_t begin, size_t end)
+{
+	auto i = begin;
+
+#ifdef BM_CONVERT_SSE2
+	const auto color_mask = _mm_set1_epi16(0x7fff);
+	const auto xparent = _mm_set1_epi16(0x03e0);
+	const auto alpha = _mm_set1_epi16(static_cast<short>(0x8000));
+	for (; i + 8 <= end; i += 8) {
+		auto value = _mm_loadu_si128(reinterpret_cast<const __m128i*>(src + i * 2));
+		auto is_xparent = _mm_cmpeq_epi16(_mm_and_si128(value, color_mask), xparent);
+
+		value = _mm_andnot_si128(is_xparent, _mm_or_si128(value, alpha));
+		_mm_storeu_si128(reinterpret_cast<__m128i*>(dst + i), value);
+	}
+#endif
+
+	for (; i < end; ++i) {
+		dst[i] = convert_1555_to_tex(static_cast<ushort>(src[i * 2] | (src[i * 2 + 1] << 8)));
+	}
+}
+
+void replace_16(ushort* pixels, size_t begin, size_t end, ushort from, ushort to)
+{
+	auto i = begin;
+
+#ifdef BM_CONVERT_SSE2
+	const auto from_value = _mm_set1_epi16(static_cast<short>(from));
+	const auto to_value = _mm_set1_epi16(static_cast<short>(to));
+	for (; i + 8 <= end; i += 8) {
+		auto ptr = reinterpret_cast<__m128i*>(pixels + i);
+		auto value = _mm_loadu_si128(ptr);
+		auto matches = _mm_cmpeq_epi16(value, from_value);
+
+		value = _mm_or_si128(_mm_andnot_si128(matches, value), _mm_and_si128(matches, to_value));
+		_mm_storeu_si128(ptr, value);
+	}
+#endif
+
+	for (; i < end; ++i) {
+		if (pixels[i] == from) {
+			pixels[i] = to;
+		}
+	}
+}
+
+/**
+ * @brief Computes the rows [begin, end) of a mipmap level from the previous level
+ */
+void downsample_rows(ubyte* dst, int dst_w, const ubyte* src, int src_w, int src_h, int bytes_per_pixel, size_t begin,
+	size_t end)
+{
+	for (auto y = static_cast<int>(begin); y < static_cast<int>(end); ++y) {
+		auto row0 = src + static_cast<size_t>(std::min(2 * y, src_h - 1)) * src_w * bytes_per_pixel;
+		auto row1 = src + static_cast<size_t>(std::min(2 * y + 1, src_h - 1)) * src_w * bytes_per_pixel;
+		auto out = dst + static_cast<size_t>(y) * dst_w * bytes_per_pixel;
+
+		auto x = 0;
+
+#ifdef BM_CONVERT_SSE2
+		if (bytes_per_pixel == 4 && src_w >= 2) {
+			// Two output pixels from four input pixels of both rows
+			const auto zero = _mm_setzero_si128();
+			const auto rounding = _mm_set1_epi16(2);
+			for (; x + 2 <= dst_w; x += 2) {
+				auto top = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row0 + x * 8));
+				auto bottom = _mm_loadu_si128(reinterpret_cast<const __m128i*>(row1 + x * 8));
+
+				auto low = _mm_add_epi16(_mm_unpacklo_epi8(top, zero), _mm_unpacklo_epi8(bottom, zero));
+				auto high = _mm_add_epi16(_mm_unpackhi_epi8(top, zero), _mm_unpackhi_epi8(bottom, zero));
+
+				low = _mm_add_epi16(low, _mm_srli_si128(low, 8));
+				high = _mm_add_epi16(high, _mm_srli_si128(high, 8));
+
+				auto sum = _mm_add_epi16(_mm_unpacklo_epi64(low, high), rounding);
+				sum = _mm_srli_epi16(sum, 2);
+
+				_mm_storel_epi64(reinterpret_cast<__m128i*>(out + x * 4), _mm_packus_epi16(sum, zero));
+			}
+		}
+#endif
+
+		for (; x < dst_w; ++x) {
+			auto x0 = std::min(2 * x, src_w - 1) * bytes_per_pixel;
+			auto x1 = std::min(2 * x + 1, src_w - 1) * bytes_per_pixel;
+
+			for (auto c = 0; c < bytes_per_pixel; ++c) {
+				out[x * bytes_per_pixel + c] = static_cast<ubyte>((row0[x0 + c] + row0[x1 + c] + row1[x0 + c] + row1[x1 + c] + 2) >> 2);
+			}
+		}
+	}
+}
+
+} // namespace
+
+void bm_swap_red_blue(ubyte* pixels, size_t num_pixels, int bytes_per_pixel)
+{
+	Assertion(bytes_per_pixel == 3 || bytes_per_pixel == 4, "Can't swap the colors of %d byte pixels!", bytes_per_pixel);
+
+	convert_ranges(num_pixels, 1, [=](size_t begin, size_t end) {
+		if (bytes_per_pixel == 3) {
+			swap_red_blue_24(pixels, begin, end);
+		} else {
+			swap_red_blue_32(pixels, begin, end);
+		}
+	});
+}
+
+void bm_expand_24_to_32(ubyte* dst, const ubyte* src, size_t num_pixels)
+{
+	convert_ranges(num_pixels, 1, [=](size_t begin, size_t end) { expand_24_to_32(dst, src, begin, end); });
+}
+
+void bm_premultiply_alpha(ubyte* pixels, size_t num_pixels)
+{
+	convert_ranges(num_pixels, 1, [=](size_t begin, size_t end) { premultiply_alpha(pixels, begin, end); });
+}
+
+void bm_convert_1555_to_tex(ushort* dst, const ubyte* src, size_t num_pixels)
+{
+	convert_ranges(num_pixels, 1, [=](size_t begin, size_t end) { convert_1555_to_tex(dst, src, begin, end); });
+}
+
+void bm_replace_16(ushort* pixels, size_t num_pixels, ushort from, ushort to)
+{
+	convert_ranges(num_pixels, 1, [=](size_t begin, size_t end) { replace_16(pixels, begin, end, from, to); });
+}
+
+int bm_get_mipmap_levels(int w, int h)
+{
+	auto levels = 1;
+
+	while (w > 1 || h > 1) {
+		w = std::max(1, w / 2);
+		h = std::max(1, h / 2);
+		++levels;
+	}
+
+	return levels;
+}
+
+size_t bm_get_mipmap_chain_size(int w, int h, int bytes_per_pixel, int levels)
+{
+	size_t size = 0;
+
+	for (auto i = 0; i < levels; ++i) {
+		size += static_cast<size_t>(w) * h * bytes_per_pixel;
+
+		w = std::max(1, w / 2);
+		h = std::max(1, h / 2);
+	}
+
+	return size;
+}
+
+void bm_generate_mipmaps(ubyte* data, int w, int h, int bytes_per_pixel, int levels)
+{
+	Assertion(bytes_per_pixel == 3 || bytes_per_pixel == 4, "Can't generate mipmaps for %d byte pixels!", bytes_per_pixel);
+
+	auto src = data;
+	for (auto i = 1; i < levels; ++i) {
+		auto dst = src + static_cast<size_t>(w) * h * bytes_per_pixel;
+		auto dst_w = std::max(1, w / 2);
+		auto dst_h = std::max(1, h / 2);
+
+		convert_ranges(static_cast<size_t>(dst_h), static_cast<size_t>(dst_w), [=](size_t begin, size_t end) {
+			downsample_rows(dst, dst_w, src, w, h, bytes_per_pixel, begin, end);
+		});
+
+		src = dst;
+		w = dst_w;
+		h = dst_h;
+	}
+}
@@ -0,0 +1,76 @@
+#pragma once
+
+#include "globalincs/pstypes.h"
+
+/**
+ * @file
+ * @brief Pixel conversion and mipmap kernels for decoded images
+ *
+ * The kernels work on tightly packed pixels in the BGR(A) byte order bmpman uses. They use SSE2 and SSSE3 if the
+ * compiler targets those instruction sets and plain loops otherwise. Images with more than Bm_convert_parallel_pixels
+ * pixels are split across the worker pool, so large images should only be converted on the main thread. The kernels
+ * don't use any other global state.
+ */
+
+/**
+ * @brief Images with more pixels than this are converted by the worker pool, 0 never uses the worker pool
+ */
+extern size_t Bm_convert_parallel_pixels;
+
+/**
+ * @brief Converts between BGR(A) and RGB(A) in place
+ * @param pixels The pixels to convert
+ * @param num_pixels The number of pixels
+ * @param bytes_per_pixel 3 or 4
+ */
+void bm_swap_red_blue(ubyte* pixels, size_t num_pixels, int bytes_per_pixel);
+
+/**
+ * @brief Expands 24 bit pixels to 32 bit pixels with an opaque alpha channel
+ */
+void bm_expand_24_to_32(ubyte* dst, const ubyte* src, size_t num_pixels);
+
+/**
+ * @brief Multiplies the color channels of 32 bit BGRA pixels with their alpha value in place
+ */
+void bm_premultiply_alpha(ubyte* pixels, size_t num_pixels);
+
+/**
+ * @brief Converts little endian X1R5G5B5 pixels to the 16 bit texture format
+ *
+ * Produces the same result as bm_set_components_argb_16_tex(): pure green becomes transparent and every other pixel
+ * becomes opaque.
+ *
+ * @param dst The converted pixels
+ * @param src The source pixels, does not need to be aligned
+ * @param num_pixels The number of pixels
+ */
+void bm_convert_1555_to_tex(ushort* dst, const ubyte* src, size_t num_pixels);
+
+/**
+ * @brief Replaces every 16 bit pixel with the value @c from by the value @c to
+ */
+void bm_replace_16(ushort* pixels, size_t num_pixels, ushort from, ushort to);
+
+/**
+ * @brief The number of mipmap levels down to 1x1 for an image of the specified size
+ */
+int bm_get_mipmap_levels(int w, int h);
+
+/**
+ * @brief The size of an image including its mipmap levels, the levels are stored one after another
+ */
+size_t bm_get_mipmap_chain_size(int w, int h, int bytes_per_pixel, int levels);
+
+/**
+ * @brief Generates the mipmap levels of an uncompressed image with a box filter
+ *
+ * Every level is half the size of the previous one, rounded down, like the levels the graphics APIs use.
+ *
+ * @param data The image, has to be bm_get_mipmap_chain_size() bytes big. The first level has to contain the image.
+ * @param w The width of the image
+ * @param h The height of the image
+ * @param bytes_per_pixel 3 or 4
+ * @param levels The number of levels including the image itself
+ */
+void bm_generate_mipmaps(ubyte* data, int w, int h, int bytes_per_pixel, int levels);
@@ -0,0 +1,85 @@
+
+#include "bmpman/bm_name_index.h"
+
+#include "utils/boost/hash_combine.h"
+
+#include <algorithm>
+#include <cctype>
+
+bool bm_name_index::key::operator==(const key& other) const
+{
+	return dir_type == other.dir_type && animated == other.animated && name == other.name;
+}
+
+size_t bm_name_index::key_hash::operator()(const key& k) const
+{
+	size_t seed = 0;
+	boost::hash_combine(seed, k.name);
+	boost::hash_combine(seed, k.dir_type);
+	boost::hash_combine(seed, k.animated);
+	return seed;
+}
+
+bm_name_index::key bm_name_index::make_key(const char* filename, int dir_type, bool animated)
+{
+	// Same rules as strextcmp(): everything before the last '.' without considering case
+	auto end = strrchr(filename, '.');
+	auto len = end != nullptr ? static_cast<size_t>(end - filename) : strlen(filename);
+
+	key k;
+	k.name.assign(filename, len);
+	std::transform(k.name.begin(), k.name.end(), k.name.begin(),
+		[](char c) { return static_cast<char>(tolower(static_cast<unsigned char>(c))); });
+	k.dir_type = dir_type;
+	k.animated = animated;
+	return k;
+}
+
+void bm_name_index::add(const char* filename, int dir_type, bool animated, int handle)
+{
+	auto& handles = Handles[make_key(filename, dir_type, animated)];
+
+	handles.insert(std::upper_bound(handles.begin(), handles.end(), handle), handle);
+}
+
+void bm_name_index::remove(const char* filename, int dir_type, bool animated, int handle)
+{
+	auto iter = Handles.find(make_key(filename, dir_type, animated));
+	if (iter == Handles.end()) {
+		return;
+	}
+
+	auto& handles = iter->second;
+	auto pos = std::find(handles.begin(), handles.end(), handle);
+	if (pos != handles.end()) {
+		handles.erase(pos);
+	}
+
+	if (handles.empty()) {
+		Handles.erase(iter);
+	}
+}
+
+int bm_name_index::find(const char* filename, int dir_type, bool animated) const
+{
+	auto iter = Handles.find(make_key(filename, dir_type, animated));
+	if (iter == Handles.end()) {
+		return -1;
+	}
+
+	return iter->second.front();
+}
+
+void bm_name_index::clear()
+{
+	Handles.clear();
+}
+
+size_t bm_name_index::size() const
+{
+	size_t count = 0;
+	for (auto& entry : Handles) {
+		count += entry.second.size();
+	}
+	return count;
+}
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "globalincs/pstypes.h"
+
+/**
+ * @brief Finds the handles of loaded bitmaps by their filename
+ *
+ * Bitmaps are identified by their filename without the extension (ignoring case), the directory type they were loaded
+ * from and whether they are an animation. This is the same identity bm_load() and bm_load_animation() use to detect that
+ * a bitmap is already loaded, so looking up a duplicate does not need to check every bitmap slot.
+ *
+ * If a name is registered for more than one handle (e.g. by bm_load_duplicate()) the lowest handle is found, which is the
+ * same one a search through all slots would find first.
+ */
+class bm_name_index {
+	struct key {
+		SCP_string name;
+		int dir_type;
+		bool animated;
+
+		bool operator==(const key& other) const;
+	};
+	struct key_hash {
+		size_t operator()(const key& k) const;
+	};
+
+	SCP_unordered_map<key, SCP_vector<int>, key_hash> Handles;
+
+	static key make_key(const char* filename, int dir_type, bool animated);
+
+  public:
+	void add(const char* filename, int dir_type, bool animated, int handle);
+
+	void remove(const char* filename, int dir_type, bool animated, int handle);
+
+	/**
+	 * @brief Finds a bitmap by its name
+	 * @return The handle or -1 if there is no such bitmap
+	 */
+	int find(const char* filename, int dir_type, bool animated) const;
+
+	void clear();
+
+	/**
+	 * @brief The number of registered handles
+	 */
+	size_t size() const;
+};
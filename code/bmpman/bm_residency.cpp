@@ -0,0 +1,189 @@
+
+#include "bmpman/bm_residency.h"
+
+#include <algorithm>
+#include <cmath>
+#include <functional>
+
+size_t bm_residency::level_size(const texture& tex, int level)
+{
+	// Every mipmap level has a quarter of the pixels of the previous one
+	return std::max(tex.full_size >> (2 * level), static_cast<size_t>(1));
+}
+
+void bm_residency::change_level(int handle, texture& tex, int level, SCP_vector<level_change>& changes)
+{
+	Stats.resident_bytes -= level_size(tex, tex.base_level);
+	tex.base_level = level;
+	Stats.resident_bytes += level_size(tex, tex.base_level);
+
+	changes.push_back({handle, level});
+}
+
+void bm_residency::set_budget(size_t bytes)
+{
+	Budget = bytes;
+}
+
+void bm_residency::set_min_resident_size(int pixels)
+{
+	Min_resident_size = std::max(pixels, 1);
+}
+
+void bm_residency::set_max_upgrades_per_update(size_t count)
+{
+	Max_upgrades_per_update = count;
+}
+
+int bm_residency::add(int handle, int width, int height, int num_mipmaps, size_t full_size, bool all_levels_resident)
+{
+	Assertion(!contains(handle), "Texture %d is already tracked!", handle);
+
+	texture tex;
+	tex.size = std::max(width, height);
+	tex.num_mipmaps = std::max(num_mipmaps, 1);
+	tex.full_size = full_size;
+
+	while (tex.min_level < tex.num_mipmaps - 1 && (tex.size >> tex.min_level) > Min_resident_size) {
+		++tex.min_level;
+	}
+	tex.base_level = all_levels_resident ? 0 : tex.min_level;
+	tex.wanted_level = tex.base_level;
+	tex.last_used_frame = Frame;
+
+	Stats.resident_bytes += level_size(tex, tex.base_level);
+	Textures.emplace(handle, tex);
+	Stats.num_textures = Textures.size();
+
+	return tex.base_level;
+}
+
+void bm_residency::remove(int handle)
+{
+	auto iter = Textures.find(handle);
+	if (iter == Textures.end()) {
+		return;
+	}
+
+	Stats.resident_bytes -= level_size(iter->second, iter->second.base_level);
+	Textures.erase(iter);
+	Stats.num_textures = Textures.size();
+}
+
+void bm_residency::clear()
+{
+	Textures.clear();
+	Stats = stats();
+}
+
+bool bm_residency::contains(int handle) const
+{
+	return Textures.find(handle) != Textures.end();
+}
+
+int bm_residency::base_level(int handle) const
+{
+	auto iter = Textures.find(handle);
+	return iter != Textures.end() ? iter->second.base_level : -1;
+}
+
+void bm_residency::request(int handle, float screen_size)
+{
+	auto iter = Textures.find(handle);
+	if (iter == Textures.end() || screen_size <= 0.0f) {
+		return;
+	}
+
+	auto& tex = iter->second;
+
+	// Use the smallest level that still has at least as many texels as there are pixels on screen
+	auto level = 0;
+	if (screen_size < tex.size) {
+		level = std::min(static_cast<int>(std::floor(std::log2(tex.size / screen_size))), tex.min_level);
+	}
+
+	if (tex.wanted_frame != Frame || level < tex.wanted_level) {
+		tex.wanted_level = level;
+	}
+	tex.wanted_frame = Frame;
+	tex.last_used_frame = Frame;
+}
+
+void bm_residency::update(SCP_vector<level_change>& changes)
+{
+	Stats.upgrades = 0;
+	Stats.evictions = 0;
+
+	// The textures which were seen in more detail than they have this frame, the biggest difference first
+	SCP_vector<std::pair<int, int>> upgrades;
+	for (auto& entry : Textures) {
+		auto& tex = entry.second;
+		if (tex.wanted_frame == Frame && tex.wanted_level < tex.base_level) {
+			upgrades.emplace_back(tex.wanted_level - tex.base_level, entry.first);
+		}
+	}
+	std::sort(upgrades.begin(), upgrades.end());
+
+	// Only built if the budget is exceeded, the least recently used textures are at the back
+	SCP_vector<std::pair<int, int>> evictable;
+	bool evictable_built = false;
+
+	auto make_room = [&](size_t needed) {
+		if (Budget == 0) {
+			return true;
+		}
+
+		if (!evictable_built) {
+			for (auto& entry : Textures) {
+				auto& tex = entry.second;
+				// Never drop textures that are in use right now
+				if (tex.base_level < tex.min_level && tex.last_used_frame < Frame) {
+					evictable.emplace_back(tex.last_used_frame, entry.first);
+				}
+			}
+			std::sort(evictable.begin(), evictable.end(), std::greater<std::pair<int, int>>());
+			evictable_built = true;
+		}
+
+		while (Stats.resident_bytes + needed > Budget && !evictable.empty()) {
+			auto handle = evictable.back().second;
+			evictable.pop_back();
+
+			auto& tex = Textures[handle];
+			change_level(handle, tex, tex.min_level, changes);
+			++Stats.evictions;
+		}
+
+		return Stats.resident_bytes + needed <= Budget;
+	};
+
+	for (auto& upgrade : upgrades) {
+		if (Stats.upgrades >= Max_upgrades_per_update) {
+			break;
+		}
+
+		auto handle = upgrade.second;
+		auto& tex = Textures[handle];
+
+		auto needed = level_size(tex, tex.wanted_level) - level_size(tex, tex.base_level);
+		if (!make_room(needed)) {
+			// The budget is full with textures that are used right now
+			break;
+		}
+
+		change_level(handle, tex, tex.wanted_level, changes);
+		++Stats.upgrades;
+	}
+
+	// The budget may have been lowered since the last update
+	if (Budget != 0 && Stats.resident_bytes > Budget) {
+		make_room(0);
+	}
+
+	++Frame;
+}
+
+const bm_residency::stats& bm_residency::get_stats() const
+{
+	return Stats;
+}
@@ -0,0 +1,104 @@
+#pragma once
+
+#include "globalincs/pstypes.h"
+
+/**
+ * @brief Decides which mipmap levels of streamed textures are kept in video memory
+ *
+ * Textures are tracked once model rendering reports how big they appear on screen with request(). From then on update()
+ * raises the resident level of textures that are shown bigger than their resident mipmaps. If that would exceed the
+ * memory budget, the textures which have not been used for the longest time are dropped back to their low mipmap levels
+ * first and are created with only those levels from then on.
+ *
+ * This class only does the bookkeeping, the changes returned by update() have to be applied by recreating the
+ * textures in the renderer.
+ */
+class bm_residency {
+  public:
+	struct level_change {
+		int handle;
+		int base_level; //!< The first mipmap level that should be resident
+	};
+
+	struct stats {
+		size_t resident_bytes = 0;
+		size_t num_textures = 0;
+		size_t upgrades = 0;  //!< Textures which got more mipmap levels in the last update
+		size_t evictions = 0; //!< Textures which were dropped to their low mipmap levels in the last update
+	};
+
+  private:
+	struct texture {
+		int size = 0;          //!< The bigger dimension of the top mipmap level
+		int num_mipmaps = 1;
+		size_t full_size = 0;  //!< Bytes of all mipmap levels
+		int min_level = 0;     //!< The level which is resident if the texture is not needed in more detail
+		int base_level = 0;
+		int wanted_level = 0;
+		int wanted_frame = -1; //!< The frame in which wanted_level was requested
+		int last_used_frame = -1;
+	};
+
+	SCP_unordered_map<int, texture> Textures;
+
+	size_t Budget = 0;
+	int Min_resident_size = 256;
+	size_t Max_upgrades_per_update = 8;
+
+	int Frame = 0;
+	stats Stats;
+
+	static size_t level_size(const texture& tex, int level);
+
+	void change_level(int handle, texture& tex, int level, SCP_vector<level_change>& changes);
+
+  public:
+	/**
+	 * @brief Sets how many bytes the resident textures may use, 0 means that there is no limit
+	 */
+	void set_budget(size_t bytes);
+
+	/**
+	 * @brief Sets how big the top resident mipmap level of a texture is before it is requested in more detail
+	 */
+	void set_min_resident_size(int pixels);
+
+	/**
+	 * @brief Sets how many textures may get more mipmap levels in one update
+	 */
+	void set_max_upgrades_per_update(size_t count);
+
+	/**
+	 * @brief Starts tracking a texture
+	 *
+	 * @param all_levels_resident @c true if the texture was already created with all of its mipmap levels, otherwise it
+	 * starts with its low levels
+	 * @return The first mipmap level the texture should be created with
+	 */
+	int add(int handle, int width, int height, int num_mipmaps, size_t full_size, bool all_levels_resident = false);
+
+	void remove(int handle);
+
+	void clear();
+
+	bool contains(int handle) const;
+
+	/**
+	 * @brief The first resident mipmap level of a texture or -1 if it is not tracked
+	 */
+	int base_level(int handle) const;
+
+	/**
+	 * @brief Records that a texture is drawn with the specified size in pixels
+	 */
+	void request(int handle, float screen_size);
+
+	/**
+	 * @brief Decides which textures should change their resident mipmap levels and starts the next frame
+	 *
+	 * @param[out] changes The textures which have to be recreated with a different base level
+	 */
+	void update(SCP_vector<level_change>& changes);
+
+	const stats& get_stats() const;
+};
@@ -15,7 +15,11 @@
 
 #include "anim/animplay.h"
 #include "anim/packunpack.h"
+#include "bmpman/bm_convert.h"
 #include "bmpman/bm_internal.h"
+#include "bmpman/bm_name_index.h"
+#include "bmpman/bm_residency.h"
+#include "cmdline/cmdline.h"
 #include "ddsutils/ddsutils.h"
 #include "debugconsole/console.h"
 #include "globalincs/systemvars.h"
@@ -49,6 +53,10 @@
 // Monitor variables
 MONITOR(NumBitmapPage)
 MONITOR(SizeBitmapPage)
+MONITOR(NumStreamedTextures)
+MONITOR(StreamedTextureKB)
+MONITOR(StreamedTextureUpgrades)
+MONITOR(StreamedTextureEvictions)
 
 // --------------------------------------------------------------------------------------------------------------------
 // Definition of public variables (declared as extern in bmpman.h).
@@ -96,6 +104,18 @@ static int Bm_max_ram = 0;
 static int Bm_ignore_duplicates = 0;
 static int Bm_ignore_load_count = 0;
 
+/**
+ * All filled bitmap slots by their filename so bm_load_sub_fast() does not have to check every slot.
+ *
+ * @note Every place that gives a slot a filename or clears a slot has to keep this up to date.
+ */
+static bm_name_index Bm_name_index;
+
+/**
+ * The mipmap levels of streamed textures, only used if a texture budget was set with -texture_budget.
+ */
+static bm_residency Bm_residency;
+
 // This needs to be declared somewhere and bm_internal.h has no own source file
 gr_bitmap_info::~gr_bitmap_info() = default;
 
@@ -109,6 +129,16 @@ static bool bm_is_anim(bitmap_entry* entry)
 		(entry->type == BM_TYPE_PNG && entry->info.ani.apng.is_apng));
 }
 
+static void bm_index_add(bitmap_entry* entry)
+{
+	Bm_name_index.add(entry->filename, entry->dir_type, bm_is_anim(entry), entry->handle);
+}
+
+static void bm_index_remove(bitmap_entry* entry)
+{
+	Bm_name_index.remove(entry->filename, entry->dir_type, bm_is_anim(entry), entry->handle);
+}
+
 bitmap_slot* bm_get_slot(int handle, bool separate_ani_frames) {
 	Assertion(handle >= 0, "Invalid handle %d passed to bm_get_slot!", handle);
 
@@ -197,7 +227,7 @@ float bitmap_lookup::get_channel_alpha(float u, float v)
 
 void clear_bm_lookup_cache() {
 	for(auto &iter: bm_lookup_cache) {
-		free(iter.second);
+		vm_free(iter.second);
 	}
 	bm_lookup_cache.clear();
 }
@@ -525,6 +555,8 @@ void bm_close() {
 			}
 		}
 		bm_blocks.clear();
+		Bm_name_index.clear();
+		Bm_residency.clear();
 		bm_inited = false;
 	}
 }
@@ -578,6 +610,8 @@ int bm_create(int bpp, int w, int h, void *data, int flags) {
 
 	entry->load_count++;
 
+	bm_index_add(entry);
+
 	bm_update_memory_used(n, (int)entry->mem_taken);
 
 	gr_bm_create(bm_get_slot(n));
@@ -586,8 +620,6 @@ int bm_create(int bpp, int w, int h, void *data, int flags) {
 }
 
 void bm_convert_format(bitmap *bmp, ushort flags) {
-	int idx;
-
 	// no transparency for 24 bpp images
 	if (!(flags & BMP_AABITMAP) && (bmp->bpp == 24))
 		return;
@@ -601,12 +633,8 @@ void bm_convert_format(bitmap *bmp, ushort flags) {
 
 	// maybe swizzle to be an xparent texture
 	if (!(bmp->flags & BMP_TEX_XPARENT) && (flags & BMP_TEX_XPARENT)) {
-		for (idx = 0; idx<bmp->w*bmp->h; idx++) {
-			// if the pixel is transparent
-			if (((ushort*)bmp->data)[idx] == Gr_t_green.mask) {
-				((ushort*)bmp->data)[idx] = 0;
-			}
-		}
+		// make the transparent pixels black
+		bm_replace_16((ushort*)bmp->data, (size_t)(bmp->w * bmp->h), (ushort)Gr_t_green.mask, 0);
 
 		bmp->flags |= BMP_TEX_XPARENT;
 	}
@@ -621,6 +649,10 @@ void bm_free_data(bitmap_slot* bs, bool release)
 
 	gr_bm_free_data(bs, release);
 
+	if (release && be->type != BM_TYPE_NONE) {
+		Bm_residency.remove(be->handle);
+	}
+
 	// If there isn't a bitmap in this structure, don't
 	// do anything but clear out the bitmap info
 	if (be->type==BM_TYPE_NONE)
@@ -901,6 +933,22 @@ int bm_get_num_mipmaps(int num) {
 	return entry->num_mipmaps;
 }
 
+size_t bm_get_data_size(int handle) {
+	if (!bm_is_valid(handle)) {
+		return 0;
+	}
+
+	int nframes;
+	auto first_frame = bm_get_info(handle, nullptr, nullptr, nullptr, &nframes);
+
+	size_t size = 0;
+	for (int i = 0; i < nframes; ++i) {
+		size += bm_get_entry(first_frame + i)->mem_taken;
+	}
+
+	return size;
+}
+
 void bm_get_palette(int handle, ubyte *pal, char *name) {
 	int w, h;
 
@@ -916,6 +964,15 @@ void bm_get_palette(int handle, ubyte *pal, char *name) {
 	}
 }
 
+int bm_get_resident_base_level(int handle) {
+	if (Cmdline_texture_budget <= 0) {
+		return 0;
+	}
+
+	// Textures which were never requested by model rendering are not streamed
+	return std::max(Bm_residency.base_level(handle), 0);
+}
+
 int bm_get_tcache_type(int num) {
 	if (bm_is_compressed(num))
 		return TCACHE_TYPE_COMPRESSED;
@@ -1199,6 +1256,13 @@ int bm_load(const char *real_filename, int dir_type) {
 	if ((bm_size <= 0) && (w) && (h) && (bpp))
 		bm_size = (w * h * (bpp >> 3));
 
+	// uncompressed images don't have mipmaps, those are generated when the image is locked
+	if (Cmdline_generate_mipmaps && !Is_standalone && (mm_lvl <= 1) && ((type == BM_TYPE_PNG) || (type == BM_TYPE_TGA) || (type == BM_TYPE_JPG))
+		&& ((bpp == 24) || (bpp == 32))) {
+		mm_lvl = bm_get_mipmap_levels(w, h);
+		bm_size = bm_get_mipmap_chain_size(w, h, bpp >> 3, mm_lvl);
+	}
+
 
 	handle = free_slot;
 
@@ -1228,6 +1292,8 @@ int bm_load(const char *real_filename, int dir_type) {
 
 	entry->load_count++;
 
+	bm_index_add(entry);
+
 	if (img_cfp != nullptr)
 		cfclose(img_cfp);
 
@@ -1754,6 +1820,10 @@ int bm_load_animation(const char *real_filename, int *nframes, int *fps, int *ke
 	// Set array flag of first frame
 	first_entry->info.ani.is_array = is_array;
 
+	for (i = 0; i < anim_frames; i++) {
+		bm_index_add(bm_get_entry(n + i));
+	}
+
 	if (nframes != nullptr)
 		*nframes = anim_frames;
 
@@ -1806,32 +1876,19 @@ int bm_load_sub_fast(const char *real_filename, int *handle, int dir_type, bool
 	if (Bm_ignore_duplicates)
 		return 0;
 
-	for (auto& block : bm_blocks) {
-		for (auto& slot : block) {
-			auto& entry = slot.entry;
-			if (entry.type == BM_TYPE_NONE)
-				continue;
-
-			if (entry.dir_type != dir_type)
-				continue;
-
-			bool animated = bm_is_anim(&entry);
-
-			if (animated_type && !animated)
-				continue;
-			else if (!animated_type && animated)
-				continue;
-
-			if (!strextcmp(real_filename, entry.filename)) {
-				entry.load_count++;
-				*handle = entry.handle;
-				return 1;
-			}
-		}
+	auto found = Bm_name_index.find(real_filename, dir_type, animated_type);
+	if (found < 0) {
+		// not found to be loaded already
+		return 0;
 	}
 
-	// not found to be loaded already
-	return 0;
+	auto entry = bm_get_entry(found);
+	Assertion(entry->type != BM_TYPE_NONE && entry->handle == found && !strextcmp(real_filename, entry->filename),
+		"Bitmap name index is out of date for %s!", real_filename);
+
+	entry->load_count++;
+	*handle = entry->handle;
+	return 1;
 }
 
 int bm_load_sub_slow(const char *real_filename, const int num_ext, const char **ext_list, CFILE **img_cfp, int dir_type) {
@@ -2128,6 +2185,17 @@ void bm_lock_apng(int /*handle*/, bitmap_slot *bs, bitmap *bmp, int bpp, ushort
 }
 
 
+/**
+ * @brief Fills in the mipmap levels that bm_load() added to an uncompressed image
+ */
+static void bm_lock_generate_mipmaps(bitmap_entry *be, bitmap *bmp) {
+	if ((be->num_mipmaps <= 1) || ((bmp->bpp != 24) && (bmp->bpp != 32))) {
+		return;
+	}
+
+	bm_generate_mipmaps((ubyte*)bmp->data, bmp->w, bmp->h, bmp->bpp >> 3, be->num_mipmaps);
+}
+
 void bm_lock_dds(int handle, bitmap_slot *bs, bitmap *bmp, int /*bpp*/, ushort /*flags*/) {
 	ubyte *data = NULL;
 	int error;
@@ -2234,6 +2302,8 @@ void bm_lock_jpg(int handle, bitmap_slot *bs, bitmap *bmp, int bpp, ushort /*fla
 		return;
 	}
 
+	bm_lock_generate_mipmaps(be, bmp);
+
 #ifdef BMPMAN_NDEBUG
 	Assert(be->data_size > 0);
 #endif
@@ -2303,10 +2373,11 @@ void bm_lock_png(int handle, bitmap_slot *bs, bitmap *bmp, int /*bpp*/, ushort /
 	bmp->bpp = 32;
 	d_size = bmp->bpp >> 3;
 	//we waste memory if it turns out to be 24-bit, but the way this whole thing works is dodgy anyway
-	data = (ubyte*)bm_malloc(handle, bmp->w * bmp->h * d_size);
+	auto data_size = bm_get_mipmap_chain_size(bmp->w, bmp->h, d_size, std::max(be->num_mipmaps, 1));
+	data = (ubyte*)bm_malloc(handle, data_size);
 	if (data == NULL)
 		return;
-	memset(data, 0, bmp->w * bmp->h * d_size);
+	memset(data, 0, data_size);
 	bmp->data = (ptr_u)data;
 	bmp->palette = NULL;
 
@@ -2324,6 +2395,8 @@ void bm_lock_png(int handle, bitmap_slot *bs, bitmap *bmp, int /*bpp*/, ushort /
 		return;
 	}
 
+	bm_lock_generate_mipmaps(be, bmp);
+
 #ifdef BMPMAN_NDEBUG
 	Assert(be->data_size > 0);
 #endif
@@ -2353,7 +2426,7 @@ void bm_lock_tga(int handle, bitmap_slot *bs, bitmap *bmp, int bpp, ushort flags
 	Assert(byte_size);
 	Assert(be->mem_taken > 0);
 
-	data = (ubyte*)bm_malloc(handle, static_cast<size_t>(bmp->w * bmp->h * byte_size));
+	data = (ubyte*)bm_malloc(handle, bm_get_mipmap_chain_size(bmp->w, bmp->h, byte_size, std::max(be->num_mipmaps, 1)));
 
 	if (data) {
 		memset(data, 0, be->mem_taken);
@@ -2383,6 +2456,8 @@ void bm_lock_tga(int handle, bitmap_slot *bs, bitmap *bmp, int bpp, ushort flags
 		return;
 	}
 
+	bm_lock_generate_mipmaps(be, bmp);
+
 	bmp->flags = 0;
 
 	bm_convert_format(bmp, flags);
@@ -2488,6 +2563,8 @@ int bm_make_render_target(int width, int height, int flags) {
 
 	entry->handle = n;
 
+	bm_index_add(entry);
+
 	if (entry->mem_taken) {
 		entry->bm.data = (ptr_u)bm_malloc(n, entry->mem_taken);
 	}
@@ -2506,6 +2583,7 @@ void *bm_malloc(int n, size_t size) {
 	bm_texture_ram += size;
 #endif
 
+	memory::TagScope tag(memory::Tag::Bitmaps);
 	return vm_malloc(size);
 }
 
@@ -2806,6 +2884,7 @@ int bm_release(int handle, int clear_render_targets) {
 		for (i = 0; i < total; i++) {
 			auto entry = bm_get_entry(first + i);
 
+			bm_index_remove(entry);
 			memset(entry, 0, sizeof(bitmap_entry));
 
 			entry->type = BM_TYPE_NONE;
@@ -2831,7 +2910,7 @@ int bm_release(int handle, int clear_render_targets) {
 
 		bm_free_data(slot, true);		// clears flags, bbp, data, etc
 
-
+		bm_index_remove(entry);
 		memset(entry, 0, sizeof(bitmap_entry));
 
 		entry->type = BM_TYPE_NONE;
@@ -2894,7 +2973,9 @@ int bm_reload(int bitmap_handle, const char* filename) {
 		return -1;
 	}
 
+	bm_index_remove(entry);
 	strcpy_s(entry->filename, filename);
+	bm_index_add(entry);
 	return bitmap_handle;
 }
 
@@ -2931,6 +3012,27 @@ void BM_SELECT_TEX_FORMAT() {
 	bm_set_components = bm_set_components_argb_16_tex;
 }
 
+void bm_request_texture_size(int handle, float screen_size) {
+	if (Cmdline_texture_budget <= 0 || handle < 0) {
+		return;
+	}
+
+	if (!Bm_residency.contains(handle)) {
+		auto entry = bm_get_entry(handle);
+
+		// Only textures which bring their own mipmaps can be streamed, the renderer can't create the higher levels later
+		if (entry->num_mipmaps <= 1 || bm_is_anim(entry) || entry->type == BM_TYPE_USER
+			|| entry->type == BM_TYPE_RENDER_TARGET_STATIC || entry->type == BM_TYPE_RENDER_TARGET_DYNAMIC) {
+			return;
+		}
+
+		// The texture was created before it was requested so it has all of its levels until it is evicted
+		Bm_residency.add(handle, entry->bm.w, entry->bm.h, entry->num_mipmaps, entry->mem_taken, true);
+	}
+
+	Bm_residency.request(handle, screen_size);
+}
+
 void bm_set_components_argb_16_screen(ubyte *pixel, ubyte *rv, ubyte *gv, ubyte *bv, ubyte *av) {
 	if (*av == 0) {
 		*((unsigned short*)pixel) = (unsigned short)Gr_current_green->mask;
@@ -3165,6 +3267,28 @@ void bm_unlock(int handle) {
 	Assert(be->ref_count >= 0);		// Trying to unlock data more times than lock was called!!!
 }
 
+void bm_update_residency() {
+	if (Cmdline_texture_budget <= 0) {
+		return;
+	}
+
+	Bm_residency.set_budget(static_cast<size_t>(Cmdline_texture_budget) * 1024 * 1024);
+
+	SCP_vector<bm_residency::level_change> changes;
+	Bm_residency.update(changes);
+
+	// The renderer creates the texture again with the new base level the next time it is used
+	for (auto& change : changes) {
+		gr_bm_free_data(bm_get_slot(change.handle), true);
+	}
+
+	auto& stats = Bm_residency.get_stats();
+	mon_NumStreamedTextures = static_cast<int>(stats.num_textures);
+	mon_StreamedTextureKB = static_cast<int>(stats.resident_bytes / 1024);
+	mon_StreamedTextureUpgrades = static_cast<int>(stats.upgrades);
+	mon_StreamedTextureEvictions = static_cast<int>(stats.evictions);
+}
+
 void bm_update_memory_used(int n, size_t size)
 {
 #ifdef BMPMAN_NDEBUG
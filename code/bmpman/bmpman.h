@@ -558,12 +558,44 @@ int bm_is_compressed(int handle);
  */
 int bm_get_tcache_type(int handle);
 
+/**
+ * @brief Gets the first mipmap level of a texture that should be uploaded to the graphics card
+ *
+ * @details With a texture budget (-texture_budget) textures with mipmaps which are drawn by model rendering are
+ * streamed: once they were requested with bm_request_texture_size() they can be dropped to their low mipmap levels and
+ * get more detail again when they are requested at a bigger size. All other textures are always uploaded completely.
+ *
+ * @returns 0 if the whole texture should be uploaded
+ */
+int bm_get_resident_base_level(int handle);
+
+/**
+ * @brief Reports the size of a texture on screen so streamed textures can load the mipmap levels they need
+ *
+ * @param handle The texture
+ * @param screen_size The size of the textured object on screen in pixels
+ */
+void bm_request_texture_size(int handle, float screen_size);
+
+/**
+ * @brief Applies the requested texture sizes of this frame to the streamed textures
+ *
+ * @details Should be called once per frame. Textures that need a different set of mipmap levels are freed from the
+ * graphics card and created again the next time they are used.
+ */
+void bm_update_residency();
+
 
 /**
  * @brief Gets the number of mipmaps of the indexed texture
  */
 int bm_get_num_mipmaps(int handle);
 
+/**
+ * @brief Gets how many bytes the data of a bitmap needs, for animations this includes all frames
+ */
+size_t bm_get_data_size(int handle);
+
 /**
  * @brief Checks to see if the indexed bitmap has an alpha channel
  *
@@ -30,6 +30,7 @@
 
 #include "cfile/cfile.h"
 #include "cfile/cfilearchive.h"
+#include "cfile/cfilecompression.h"
 #include "cfile/cfilesystem.h"
 #include "osapi/osapi.h"
 #include "parse/encrypt.h"
@@ -102,6 +103,24 @@ std::array<CFILE, MAX_CFILE_BLOCKS> Cfile_block_list;
 
 static const char *Cfile_cdrom_dir = NULL;
 
+// Read-only mapping of a VP archive or a loose file. All CFILEs reading from the same file share the mapping so the
+// data only exists once in memory and the pages are shared with other processes reading the same files.
+struct cf_file_mapping {
+	SCP_string path;
+	const ubyte* base = nullptr;
+	size_t length = 0;
+	int ref_count = 0;
+	bool keep_mapped = false; // VP archives stay mapped until cfile_close() since they are opened all the time
+};
+
+static SCP_unordered_map<SCP_string, std::unique_ptr<cf_file_mapping>> Cfile_mappings;
+
+// Loose files smaller than this are read through stdio since setting up a mapping costs more than copying the data
+static const size_t CF_MAP_LOOSE_FILE_MIN_SIZE = 64 * 1024;
+
+// Mapping complete VP archives needs a lot of address space so this is only done for 64-bit builds
+static const bool CF_MAP_PACK_FILES = sizeof(void*) >= 8;
+
 //
 // Function prototypes for internally-called functions
 //
@@ -109,6 +128,9 @@ static int cfget_cfile_block();
 static CFILE *cf_open_fill_cfblock(const char* source, int line, const char* original_filename, FILE * fp, int type);
 static CFILE *cf_open_packed_cfblock(const char* source, int line, const char* original_filename, FILE *fp, int type, size_t offset, size_t size);
 static CFILE *cf_open_memory_fill_cfblock(const char* source, int line, const char* original_filename, const void* data, size_t size, int dir_type);
+static CFILE *cf_open_shared_mapped_cfblock(const char* source, int line, const CFileLocation &res, int dir_type);
+static void cf_release_mapping(cf_file_mapping* mapping);
+static void cf_unmap_file(const ubyte* base, size_t length);
 
 #if defined _WIN32
 static CFILE *cf_open_mapped_fill_cfblock(const char* source, int line, const char* original_filename, HANDLE hFile, int type);
@@ -135,6 +157,16 @@ void cfile_close()
 
 	cf_free_secondary_filelist();
 
+	// Files which are still open keep their mapping alive
+	for (auto iter = Cfile_mappings.begin(); iter != Cfile_mappings.end();) {
+		if (iter->second->ref_count == 0) {
+			cf_unmap_file(iter->second->base, iter->second->length);
+			iter = Cfile_mappings.erase(iter);
+		} else {
+			++iter;
+		}
+	}
+
 	cfile_inited = 0;
 }
 
@@ -804,6 +836,12 @@ CFILE *_cfopen_special(const char* source, int line, const CFileLocation &res, c
 		return cf_open_memory_fill_cfblock(source, line, res.name_ext.c_str(), res.data_ptr, res.size, dir_type);
 	}
 	else {
+		// Read straight from a shared mapping if possible. This avoids going through stdio for every read.
+		auto cfp = cf_open_shared_mapped_cfblock(source, line, res, dir_type);
+		if (cfp != nullptr) {
+			return cfp;
+		}
+
 		// "file_path" should already be a fully qualified path, so just try to open it
 		FILE *fp = fopen(res.full_name.c_str(), "rb");
 
@@ -860,6 +898,7 @@ static int cfget_cfile_block()
 		if (cfile->type == CFILE_BLOCK_UNUSED) {
 			cfile->data = nullptr;
 			cfile->fp = nullptr;
+			cfile->mapping = nullptr;
 			cfile->type = CFILE_BLOCK_USED;
 			cf_clear_compression_info(cfile);
 			return i;
@@ -911,6 +950,10 @@ int cfclose( CFILE * cfile )
 			result = fclose(cfile->fp);
 #endif
 
+	} else if ( cfile->mapping != nullptr ) {
+		// shared mapping of a VP or loose file
+		cf_release_mapping(cfile->mapping);
+		cfile->mapping = nullptr;
 	} else if ( cfile->fp != nullptr )	{
 		Assert(cfile->fp != nullptr);
 		result = fclose(cfile->fp);
@@ -1101,6 +1144,172 @@ static CFILE *cf_open_memory_fill_cfblock(const char* source, int line, const ch
 	}
 }
 
+// Maps the complete file read-only. The file handles are closed again right away since the mapping stays valid
+// without them.
+static bool cf_map_file(const char* path, const ubyte** base, size_t* length)
+{
+#if defined _WIN32
+	HANDLE hFile = CreateFile(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING, FILE_ATTRIBUTE_NORMAL, NULL);
+	if (hFile == INVALID_HANDLE_VALUE) {
+		return false;
+	}
+
+	LARGE_INTEGER size;
+	if (!GetFileSizeEx(hFile, &size) || size.QuadPart <= 0 ||
+		static_cast<ULONGLONG>(size.QuadPart) > std::numeric_limits<size_t>::max()) {
+		CloseHandle(hFile);
+		return false;
+	}
+
+	HANDLE hMapFile = CreateFileMapping(hFile, NULL, PAGE_READONLY, 0, 0, NULL);
+	CloseHandle(hFile);
+	if (hMapFile == NULL) {
+		return false;
+	}
+
+	auto view = MapViewOfFile(hMapFile, FILE_MAP_READ, 0, 0, 0);
+	CloseHandle(hMapFile);
+	if (view == NULL) {
+		return false;
+	}
+
+	*base = reinterpret_cast<const ubyte*>(view);
+	*length = static_cast<size_t>(size.QuadPart);
+	return true;
+#elif defined SCP_UNIX
+	FILE* fp = fopen(path, "rb");
+	if (fp == nullptr) {
+		return false;
+	}
+
+	auto size = filelength(fileno(fp));
+	if (size <= 0) {
+		fclose(fp);
+		return false;
+	}
+
+	auto view = mmap(nullptr, static_cast<size_t>(size), PROT_READ, MAP_SHARED, fileno(fp), 0);
+	fclose(fp);
+	if (view == MAP_FAILED) {
+		return false;
+	}
+
+	*base = reinterpret_cast<const ubyte*>(view);
+	*length = static_cast<size_t>(size);
+	return true;
+#else
+	SCP_UNUSED(path);
+	SCP_UNUSED(base);
+	SCP_UNUSED(length);
+	return false;
+#endif
+}
+
+static void cf_unmap_file(const ubyte* base, size_t length)
+{
+	if (base == nullptr) {
+		return;
+	}
+
+#if defined _WIN32
+	SCP_UNUSED(length);
+	UnmapViewOfFile(base);
+#elif defined SCP_UNIX
+	// This const_cast is safe since the pointer returned by mmap was also non-const
+	munmap(const_cast<ubyte*>(base), length);
+#endif
+}
+
+// Gets the mapping of the specified file, creating it if necessary. Returns nullptr if the file can't be mapped.
+static cf_file_mapping* cf_acquire_mapping(const SCP_string& path, bool keep_mapped)
+{
+	auto iter = Cfile_mappings.find(path);
+	if (iter == Cfile_mappings.end()) {
+		std::unique_ptr<cf_file_mapping> mapping(new cf_file_mapping());
+		mapping->path = path;
+		mapping->keep_mapped = keep_mapped;
+
+		if (!cf_map_file(path.c_str(), &mapping->base, &mapping->length)) {
+			nprintf(("CFileDebug", "Could not map %s, falling back to normal file access.\n", path.c_str()));
+
+			// Remember the failure for archives so that we don't retry every time a file is opened from them
+			if (!keep_mapped) {
+				return nullptr;
+			}
+		}
+
+		iter = Cfile_mappings.emplace(path, std::move(mapping)).first;
+	}
+
+	auto mapping = iter->second.get();
+	if (mapping->base == nullptr) {
+		return nullptr;
+	}
+
+	++mapping->ref_count;
+	return mapping;
+}
+
+static void cf_release_mapping(cf_file_mapping* mapping)
+{
+	Assertion(mapping->ref_count > 0, "Mapping of %s was released more often than it was acquired!", mapping->path.c_str());
+
+	--mapping->ref_count;
+	if (mapping->ref_count == 0 && !mapping->keep_mapped) {
+		// Loose files are unmapped as soon as possible so that they can be overwritten again
+		cf_unmap_file(mapping->base, mapping->length);
+		Cfile_mappings.erase(mapping->path);
+	}
+}
+
+// cf_open_shared_mapped_cfblock() will fill up a Cfile_block element in the Cfile_block_list[] array
+// for a file which is read from a shared mapping of the file or of the VP containing it
+//
+// returns:   success ==> ptr to CFILE structure.
+//            error   ==> NULL if the file can not be read from a mapping, the caller should use stdio instead
+//
+static CFILE *cf_open_shared_mapped_cfblock(const char* source, int line, const CFileLocation &res, int dir_type)
+{
+	bool packed = res.offset != 0;
+
+	if (packed ? !CF_MAP_PACK_FILES : (res.size < CF_MAP_LOOSE_FILE_MIN_SIZE)) {
+		return nullptr;
+	}
+
+	auto mapping = cf_acquire_mapping(res.full_name, packed);
+	if (mapping == nullptr) {
+		return nullptr;
+	}
+
+	// Loose files may have changed since the file list was built so their current length is used
+	size_t size = packed ? res.size : mapping->length;
+	if (res.offset > mapping->length || size > mapping->length - res.offset) {
+		cf_release_mapping(mapping);
+		return nullptr;
+	}
+
+	auto data = mapping->base + res.offset;
+
+	// The decompression code reads from the file pointer so compressed files need to use stdio
+	if (size > 16) {
+		int header;
+		memcpy(&header, data, sizeof(header));
+		if (comp_check_header(INTEL_INT(header)) == COMP_HEADER_MATCH) {
+			cf_release_mapping(mapping);
+			return nullptr;
+		}
+	}
+
+	auto cfp = cf_open_memory_fill_cfblock(source, line, res.name_ext.c_str(), data, size, dir_type);
+	if (cfp == nullptr) {
+		cf_release_mapping(mapping);
+		return nullptr;
+	}
+
+	cfp->mapping = mapping;
+	return cfp;
+}
+
 const char *cf_get_filename(const CFILE *cfile)
 {
 	return cfile->original_filename.c_str();
@@ -1618,6 +1827,26 @@ static int cf_chksum_do(CFILE *cfile, ushort *chk_short, uint *chk_long, int max
 		max_size = cfilelength(cfile);
 	}
 	
+	// Files backed by memory can be checksummed in place. The data is still processed in blocks since the short
+	// checksum depends on the block size.
+	auto span_size = MIN(max_size, static_cast<int>(cfile->size - cfile->raw_position));
+	auto span = static_cast<const ubyte*>(cfread_span(cfile, static_cast<size_t>(span_size)));
+	if (span != nullptr) {
+		for (cf_total = 0; cf_total < span_size; cf_total += read_size) {
+			read_size = MIN(CF_CHKSUM_SAMPLE_SIZE, span_size - cf_total);
+
+			// the checksum functions don't modify the buffer
+			auto block = const_cast<ubyte*>(span + cf_total);
+			if(is_long){
+				*chk_long = cf_add_chksum_long(*chk_long, block, read_size);
+			} else {
+				*chk_short = cf_add_chksum_short(*chk_short, block, read_size);
+			}
+		}
+
+		return 1;
+	}
+
 	cf_total = 0;
 	do {
 		// determine how much we want to read
@@ -233,6 +233,11 @@ int cfilelength(CFILE *fp);
 // Reads data
 int cfread(void *buf, int elsize, int nelem, CFILE *fp);
 
+// Returns a pointer to the next len bytes and advances the position without copying the data. This only works for files
+// backed by memory (files read from a mapping of their VP or loose file and in-memory files), otherwise NULL is
+// returned and cfread() has to be used. The pointer stays valid until the file is closed.
+const void *cfread_span(CFILE *fp, size_t len);
+
 // cfwrite() writes to the file
 int cfwrite(const void *buf, int elsize, int nelem, CFILE *cfile);
 
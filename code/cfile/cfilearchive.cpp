@@ -71,14 +71,14 @@ void cf_clear_compression_info(CFILE* cfile)
 	if (cfile->compression_info.header != 0)
 	{
 		free(cfile->compression_info.offsets);
-		free(cfile->compression_info.decoder_buffer);
 		cfile->compression_info.offsets = nullptr;
-		cfile->compression_info.decoder_buffer = nullptr;
 		cfile->compression_info.header = 0;
 		cfile->compression_info.block_size = 0;
-		cfile->compression_info.last_decoded_block_pos = 0;
-		cfile->compression_info.last_decoded_block_bytes = 0;
 		cfile->compression_info.num_offsets = 0;
+		cfile->compression_info.block_cache.clear();
+		cfile->compression_info.block_cache.shrink_to_fit();
+		cfile->compression_info.block_cache_clock = 0;
+		cfile->compression_info.last_read_block = -1;
 	}
 }
 
@@ -261,6 +261,39 @@ int cfread(void *buf, int elsize, int nelem, CFILE *cfile)
 	return (int)(bytes_read / elsize);
 }
 
+// cfread_span() returns a pointer to the next bytes of a file which is backed by memory
+//
+// returns:   success ==> pointer to len bytes of data, valid until the file is closed
+//            error   ==> NULL if the file is not backed by memory or less than len bytes are left
+//
+const void *cfread_span(CFILE *cfile, size_t len)
+{
+	if(!cf_is_valid(cfile))
+		return nullptr;
+
+	// Compressed files and files read through stdio have to be copied with cfread()
+	if (cfile->data == nullptr || cfile->compression_info.header != 0)
+		return nullptr;
+
+	Assertion(cfile->raw_position <= cfile->size, "Invalid raw_position value detected!");
+	if (len > cfile->size - cfile->raw_position)
+		return nullptr;
+
+	if (cfile->max_read_len) {
+		if ( cfile->raw_position+len > cfile->max_read_len ) {
+			std::ostringstream s_buf;
+			s_buf << "Attempted to read " << len << "-byte(s) beyond length limit";
+
+			throw cfile::max_read_length(s_buf.str());
+		}
+	}
+
+	auto span = reinterpret_cast<const char*>(cfile->data) + cfile->raw_position;
+	cfile->raw_position += len;
+
+	return span;
+}
+
 int cfread_lua_number(double *buf, CFILE *cfile)
 {
 	if(!cf_is_valid(cfile))
@@ -269,29 +302,24 @@ int cfread_lua_number(double *buf, CFILE *cfile)
 	if(buf == NULL)
 		return 0;
 
-	// cfread() not supported for memory-mapped files
-	if(cfile->data != nullptr)
-	{
-		Warning(LOCATION, "Writing is not supported for mem-mapped files");
-		return 0;
-	}
-
 	size_t advance = 0;
 	int items_read;
-	if (cfile->fp) {
+	if (cfile->data != nullptr) {
+		// The data is not null terminated so the number is scanned from a bounded copy
+		char number_buf[64];
+		auto len = MIN(sizeof(number_buf) - 1, cfile->size - cfile->raw_position);
+		memcpy(number_buf, reinterpret_cast<const char*>(cfile->data) + cfile->raw_position, len);
+		number_buf[len] = '\0';
+
+		// %n returns the number of bytes currently read so we append that to the scan format at the end so it will return
+		// how many bytes we have consumed. It does not count towards the number of items read.
+		int read = 0;
+		items_read = sscanf(number_buf, LUA_NUMBER_SCAN "%n", buf, &read);
+		advance = (size_t) read;
+	} else {
 		long orig_pos = ftell(cfile->fp);
 		items_read = fscanf(cfile->fp, LUA_NUMBER_SCAN, buf);
 		advance = (size_t) (ftell(cfile->fp)-orig_pos);
-	} else {
-		int read;
-		// %n returns the number of bytes currently read so we append that to the scan format at the end so it will return
-		// how many bytes we have consumed
-		items_read = sscanf(reinterpret_cast<const char*>(cfile->data), LUA_NUMBER_SCAN "%n", buf, &read);
-		if (items_read == 2) {
-			// We need to correct the items read counter since we read one additional item
-			items_read = 1;
-		}
-		advance = (size_t) read;
 	}
 	cfile->raw_position += advance;
 	Assertion(cfile->raw_position <= cfile->size, "Invalid raw_position value detected!");
@@ -22,17 +22,27 @@
 #define CFILE_BLOCK_UNUSED		0
 #define CFILE_BLOCK_USED		1
 
+struct COMPRESSION_CACHED_BLOCK {
+	int block = -1;    // index of the decoded block, -1 if this entry is unused
+	int bytes = 0;     // number of decoded bytes
+	uint last_used = 0;
+	SCP_vector<char> data;
+};
+
 struct COMPRESSION_INFO {
 	int header = 0;
 	size_t compressed_size = 0;
 	int block_size = 0;
 	int num_offsets = 0;
 	int* offsets = nullptr;
-	char* decoder_buffer = nullptr;
-	int last_decoded_block_pos = 0;
-	int last_decoded_block_bytes = 0;
+	SCP_vector<COMPRESSION_CACHED_BLOCK> block_cache; // recently decoded blocks, see cfilecompression.cpp
+	uint block_cache_clock = 0;
+	int last_read_block = -1; // last block of the previous read, used for detecting sequential reads
 };
 
+// A read-only mapping of a file which may be shared by several CFILEs, see cfile.cpp
+struct cf_file_mapping;
+
 struct CFILE {
 	int type = CFILE_BLOCK_UNUSED;                // CFILE_BLOCK_UNUSED, CFILE_BLOCK_USED
 	int dir_type;        // directory location
@@ -45,6 +55,7 @@ struct CFILE {
 #else
 	size_t data_length;    // length of data for mmap
 #endif
+	cf_file_mapping* mapping = nullptr; // Shared mapping backing data, released when the file is closed
 	size_t lib_offset;
 	size_t raw_position;
 	size_t size;                // for packed files
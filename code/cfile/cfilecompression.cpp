@@ -14,12 +14,19 @@
 #include "lz4.h"
 #include "cfilecompression.h"
 #include "cfilearchive.h"
+#include "utils/ThreadPool.h"
+
+/*LZ41 block cache*/
+#define LZ41_BLOCK_CACHE_SIZE 8
+#define LZ41_READ_AHEAD_BLOCKS 2
 
 /*INTERNAL FUNCTIONS*/
 /*LZ41*/
 void lz41_load_offsets(CFILE* cf);
 size_t lz41_stream_random_access(CFILE* cf, char* bytes_out, size_t offset, size_t length);
 void lz41_create_ci(CFILE* cf, int header);
+COMPRESSION_CACHED_BLOCK* lz41_find_cached_block(CFILE* cf, int block);
+COMPRESSION_CACHED_BLOCK* lz41_get_free_cache_block(CFILE* cf);
 /*MISC*/
 int fso_fseek(CFILE* cfile, int offset, int where);
 /*END OF INTERNAL FUNCTIONS*/
@@ -130,9 +137,9 @@ void lz41_create_ci(CFILE* cf, int header)
 	Assertion(fBsize == 1, "Error while reading block size, compressed file is possibly in the wrong format or corrupted.");
 	#endif
 
-	cf->compression_info.decoder_buffer = (char*)malloc(LZ4_compressBound(cf->compression_info.block_size));
-	cf->compression_info.last_decoded_block_pos = 0;
-	cf->compression_info.last_decoded_block_bytes = 0;
+	cf->compression_info.block_cache.resize(LZ41_BLOCK_CACHE_SIZE);
+	cf->compression_info.block_cache_clock = 0;
+	cf->compression_info.last_read_block = -1;
 	lz41_load_offsets(cf);
 }
 
@@ -151,56 +158,169 @@ void lz41_load_offsets(CFILE* cf)
 	}
 }
 
-size_t lz41_stream_random_access(CFILE* cf, char* bytes_out, size_t offset, size_t length)
+COMPRESSION_CACHED_BLOCK* lz41_find_cached_block(CFILE* cf, int block)
 {
-	LZ4_streamDecode_t lz4_stream_decode_body;
-	LZ4_streamDecode_t* lz4_stream_decode = &lz4_stream_decode_body;
-	/* The blocks (current_block to end_block) contain the data we want */
-	size_t current_block = offset / cf->compression_info.block_size;
-	size_t end_block = ((offset + length - 1) / cf->compression_info.block_size) + 1;
-	size_t written_bytes = 0;
+	for (auto& entry : cf->compression_info.block_cache)
+	{
+		if (entry.block == block)
+			return &entry;
+	}
+	return nullptr;
+}
+
+/* Returns the least recently used entry. Entries used during the current read are never returned. */
+COMPRESSION_CACHED_BLOCK* lz41_get_free_cache_block(CFILE* cf)
+{
+	COMPRESSION_CACHED_BLOCK* result = nullptr;
+	for (auto& entry : cf->compression_info.block_cache)
+	{
+		if (entry.block >= 0 && entry.last_used == cf->compression_info.block_cache_clock)
+			continue;
+
+		if (result == nullptr || entry.block < 0 || (result->block >= 0 && entry.last_used < result->last_used))
+			result = &entry;
+	}
+	return result;
+}
 
-	if (cf->compression_info.num_offsets <= (int)end_block)
+size_t lz41_stream_random_access(CFILE* cf, char* bytes_out, size_t offset, size_t length)
+{
+	struct decode_job {
+		int block;
+		char* dest;
+		int dest_size;
+		COMPRESSION_CACHED_BLOCK* cache_entry;
+		int result;
+	};
+
+	auto& ci = cf->compression_info;
+	auto block_size = (size_t)ci.block_size;
+
+	/* The blocks first_block to last_block contain the data we want */
+	int first_block = (int)(offset / block_size);
+	int last_block = (int)((offset + length - 1) / block_size);
+
+	if (ci.num_offsets <= last_block + 1)
 		return (size_t)LZ41_OFFSETS_MISMATCH;
 
-	/* Seek to the first block to read, if it matches the cached block, search the next one instead */
-	if (cf->compression_info.last_decoded_block_pos == cf->compression_info.offsets[current_block] && current_block + 1 <= end_block)
-		fso_fseek(cf, cf->compression_info.offsets[current_block+1], SEEK_SET);
-	else
-		fso_fseek(cf, cf->compression_info.offsets[current_block], SEEK_SET);
-	
-	offset = offset % cf->compression_info.block_size;
-	char* cmp_buf = (char*)malloc(LZ4_compressBound(cf->compression_info.block_size));
+	/* Large reads decode the blocks which are completely covered by the request directly into the output buffer */
+	bool bulk_read = last_block - first_block + 1 > LZ41_BLOCK_CACHE_SIZE;
 
-	/* Start decoding */
-	for (; current_block < end_block; ++current_block)
+	/* If this read continues where the last one stopped, decode the next blocks ahead of time */
+	int decode_end_block = last_block;
+	if (!bulk_read && (first_block == ci.last_read_block || first_block == ci.last_read_block + 1))
 	{
-		/* Only read and decode if the requested block is not the cached one */
-		if (cf->compression_info.last_decoded_block_pos != cf->compression_info.offsets[current_block])
+		decode_end_block = MIN(last_block + LZ41_READ_AHEAD_BLOCKS, ci.num_offsets - 2);
+		decode_end_block = MIN(decode_end_block, first_block + LZ41_BLOCK_CACHE_SIZE - 1);
+	}
+
+	/* Blocks which are decoded straight into the output buffer instead of going through the cache */
+	const size_t read_start = offset;
+	const size_t read_end = offset + length;
+	auto decode_in_place = [&](int block) {
+		size_t block_start = block * block_size;
+		return bulk_read && block_start >= read_start && MIN(block_start + block_size, cf->size) <= read_end;
+	};
+
+	/* Find out which blocks need to be decoded. Cache entries touched by this read are marked with the current clock value so they don't get replaced. */
+	++ci.block_cache_clock;
+	SCP_vector<decode_job> jobs;
+	for (int block = first_block; block <= decode_end_block; ++block)
+	{
+		size_t block_start = block * block_size;
+
+		decode_job job;
+		job.block = block;
+		job.dest_size = (int)MIN(block_size, cf->size - block_start);
+		job.result = 0;
+
+		if (decode_in_place(block))
 		{
-			cf->compression_info.last_decoded_block_pos = cf->compression_info.offsets[current_block];
+			job.dest = bytes_out + (block_start - read_start);
+			job.cache_entry = nullptr;
+		}
+		else
+		{
+			auto cached = lz41_find_cached_block(cf, block);
+			if (cached != nullptr)
+			{
+				cached->last_used = ci.block_cache_clock;
+				continue;
+			}
 
-			/* The difference in offsets is the size of the block */
-			int cmp_bytes = cf->compression_info.offsets[current_block + 1] - cf->compression_info.offsets[current_block];
-			auto bytes_read = fread(cmp_buf, cmp_bytes, 1, cf->fp);
-			Assertion(bytes_read == 1, "Error reading from compressed file.");
+			job.cache_entry = lz41_get_free_cache_block(cf);
+			Assertion(job.cache_entry != nullptr, "No free entry in the block cache, this should not be possible.");
+			job.cache_entry->block = block;
+			job.cache_entry->bytes = 0;
+			job.cache_entry->last_used = ci.block_cache_clock;
+			job.cache_entry->data.resize(block_size);
+			job.dest = job.cache_entry->data.data();
+		}
 
-			cf->compression_info.last_decoded_block_bytes = LZ4_decompress_safe_continue(lz4_stream_decode, cmp_buf, cf->compression_info.decoder_buffer, cmp_bytes, cf->compression_info.block_size);
-			if (cf->compression_info.last_decoded_block_bytes <= 0)
+		jobs.push_back(job);
+	}
+
+	if (!jobs.empty())
+	{
+		/* The blocks are stored one after another so the compressed data of all of them is read at once */
+		int cmp_start = ci.offsets[jobs.front().block];
+		int cmp_end = ci.offsets[jobs.back().block + 1];
+		SCP_vector<char> cmp_buf(cmp_end - cmp_start);
+
+		fso_fseek(cf, cmp_start, SEEK_SET);
+		auto bytes_read = fread(cmp_buf.data(), cmp_buf.size(), 1, cf->fp);
+		Assertion(bytes_read == 1, "Error reading from compressed file.");
+
+		util::parallel_for(0, jobs.size(), [&](size_t i) {
+			auto& job = jobs[i];
+			int cmp_bytes = ci.offsets[job.block + 1] - ci.offsets[job.block];
+			job.result = LZ4_decompress_safe(cmp_buf.data() + (ci.offsets[job.block] - cmp_start), job.dest, cmp_bytes, job.dest_size);
+		});
+
+		bool failed = false;
+		for (auto& job : jobs)
+		{
+			if (job.result <= 0)
+				failed = true;
+
+			if (job.cache_entry != nullptr)
 			{
-				free(cmp_buf);
-				return (size_t)LZ41_DECOMPRESSION_ERROR;
+				if (job.result <= 0)
+					job.cache_entry->block = -1;
+				else
+					job.cache_entry->bytes = job.result;
 			}
 		}
 
-		/* Write out the part of the data we care about from buffer */
-		size_t block_length = (length < (cf->compression_info.last_decoded_block_bytes - offset) ? length : (cf->compression_info.last_decoded_block_bytes - offset));
-		memcpy(bytes_out + written_bytes, cf->compression_info.decoder_buffer + offset, (size_t)block_length);
+		if (failed)
+			return (size_t)LZ41_DECOMPRESSION_ERROR;
+	}
+
+	/* Write out the part of the data we care about from the cached blocks, the other ones were decoded in place */
+	size_t written_bytes = 0;
+	offset = offset % block_size;
+	for (int block = first_block; block <= last_block; ++block)
+	{
+		size_t block_length;
+		if (decode_in_place(block))
+		{
+			block_length = MIN(length, block_size);
+		}
+		else
+		{
+			auto cached = lz41_find_cached_block(cf, block);
+			if (cached == nullptr || (size_t)cached->bytes <= offset)
+				return (size_t)LZ41_DECOMPRESSION_ERROR;
+
+			block_length = MIN(length, cached->bytes - offset);
+			memcpy(bytes_out + written_bytes, cached->data.data() + offset, block_length);
+		}
+
 		written_bytes += block_length;
 		offset = 0;
 		length -= block_length;
 	}
 
-	free(cmp_buf);
+	ci.last_read_block = last_block;
 	return written_bytes;
 }
@@ -5,9 +5,11 @@ ShivanSpS - Compressed files support for FSO. Many thanks to ngld, taylor and ev
 -The header ID can be used to add diferent revisions to LZ41 decompression system or to add other compression format supports whiout breaking compatibility.
 -The system uses a offset list to record the position of every block in file, this list, along with the number of offsets, original filesize,
 and block size, must be written by the compressor app.
--A decoder cache is used to store the last decoded block, this ensures each block is read and decoded only once in sequential reads. This cache
-is a little bit bigger than the block size, a higher block size means less overhead added to the file, but it also means a little more ram will
-be used during decompression.
+-Every block is compressed independently. A small LRU cache of decoded blocks is kept per file so seeking back and forth between nearby
+positions does not decode the same blocks again. Sequential reads also decode the next few blocks ahead of time. A higher block size means
+less overhead added to the file, but it also means more ram will be used by the cache.
+-Reads which span more blocks than the cache can hold (e.g. reading the whole file) decode the blocks in parallel directly into the
+destination buffer.
 -All this dynamic memory is assigned at cfopen() and it is cleared on cfclose().
 
 ................................char[4]..........(n ints)...(int)..........(int)..........(int)
@@ -173,6 +173,8 @@ Flag exe_params[] =
 	{ "-no_deferred",		"Disable Deferred Lighting",				true,	EASY_DEFAULT | EASY_HI_MEM_OFF,		EASY_ALL_ON | EASY_HI_MEM_ON,	"Graphics",		"http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-no_deferred"},
 	{ "-enable_shadows",	"Enable Shadows",							true,	EASY_ALL_ON  | EASY_HI_MEM_ON,		EASY_DEFAULT | EASY_HI_MEM_OFF,	"Graphics",		"http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-enable_shadows"},
 	{ "-deferred_cockpit",	"Enable Deferred Lighting for Cockpits",	true,	EASY_ALL_ON	 | EASY_HI_MEM_ON,		EASY_DEFAULT | EASY_HI_MEM_OFF,	"Graphics",		"http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-deferred_cockpit"},
+	{ "-generate_mipmaps",	"Generate mipmaps for PNG, TGA and JPG",	true,	0,									EASY_DEFAULT,					"Graphics",		"http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-generate_mipmaps"},
+	{ "-glyph_atlas",		"Draw TrueType text from glyph atlases",	true,	0,									EASY_DEFAULT,					"Graphics",		"http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-glyph_atlas"},
 
 	//flag					launcher text								FSO		on_flags							off_flags						category		reference URL
 	{ "-no_vsync",			"Disable vertical sync",					true,	0,									EASY_DEFAULT,					"Game Speed",	"http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-no_vsync", },
@@ -267,6 +269,7 @@ Flag exe_params[] =
 	{ "-profile_frame_time","Profile frame time",						true,	0,									EASY_DEFAULT,					"Dev Tool",		"http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-profile_frame_time", },
 	{ "-profile_write_file", "Write profiling information to file",		true,	0,									EASY_DEFAULT,					"Dev Tool",		"http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-profile_write_file", },
 	{ "-json_profiling",	"Generate JSON profiling output",			true,	0,									EASY_DEFAULT,					"Dev Tool",		"http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-json_profiling", },
+	{ "-perf_stats",		"Show rolling performance statistics",		true,	0,									EASY_DEFAULT,					"Dev Tool",		"http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-perf_stats", },
 	{ "-debug_window",		"Enable the debug window",					true,	0,									EASY_DEFAULT,					"Dev Tool",		"http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-debug_window", },
 	{ "-gr_debug",		"Output graphics debug information",			true,	0,									EASY_DEFAULT,					"Dev Tool",		"http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-gr_debug", },
 	{ "-stdout_log",		"Output log file to stdout",				true,	0,									EASY_DEFAULT,					"Dev Tool",		"http://www.hard-light.net/wiki/index.php/Command-Line_Reference#-stdout_log", },
@@ -360,6 +363,10 @@ cmdline_parm enable_shadows_arg("-enable_shadows", NULL, AT_NONE);
 cmdline_parm no_deferred_lighting_arg("-no_deferred", NULL, AT_NONE);	// Cmdline_no_deferred
 cmdline_parm deferred_lighting_cockpit_arg("-deferred_cockpit", nullptr, AT_NONE);
 cmdline_parm anisotropy_level_arg("-anisotropic_filter", NULL, AT_INT);
+cmdline_parm texture_budget_arg("-texture_budget", "Video memory in MB for streamed textures", AT_INT);	// Cmdline_texture_budget
+cmdline_parm generate_mipmaps_arg("-generate_mipmaps", NULL, AT_NONE);	// Cmdline_generate_mipmaps
+cmdline_parm anim_cache_arg("-anim_cache", "Memory in MB for decoded ANI frames, the cache is off without it", AT_INT);	// Cmdline_anim_cache
+cmdline_parm glyph_atlas_arg("-glyph_atlas", NULL, AT_NONE);	// Cmdline_glyph_atlas
 
 float Cmdline_clip_dist = Default_min_draw_distance;
 float Cmdline_ambient_power = 1.0f;
@@ -380,13 +387,21 @@ bool Cmdline_force_lightshaft_off = false;
 int Cmdline_no_deferred_lighting = 0;
 bool Cmdline_deferred_lighting_cockpit = false;
 int Cmdline_aniso_level = 0;
+int Cmdline_texture_budget = 0;
+bool Cmdline_generate_mipmaps = false;
+int Cmdline_anim_cache = 0;
+bool Cmdline_glyph_atlas = false;
 
 // Game Speed related
 cmdline_parm no_fpscap("-no_fps_capping", "Don't limit frames-per-second", AT_NONE);	// Cmdline_NoFPSCap
 cmdline_parm no_vsync_arg("-no_vsync", NULL, AT_NONE);		// Cmdline_no_vsync
+cmdline_parm ai_budget_arg("-ai_budget", "Time in ms AI decisions may take per frame", AT_FLOAT);	// Cmdline_ai_budget
+cmdline_parm asset_retention_arg("-asset_retention", "Memory in MB for assets kept loaded between missions", AT_INT);	// Cmdline_asset_retention
 
 int Cmdline_NoFPSCap = 0; // Disable FPS capping - kazan
 int Cmdline_no_vsync = 0;
+float Cmdline_ai_budget = 0.0f;
+int Cmdline_asset_retention = 0;
 
 // HUD related
 cmdline_parm ballistic_gauge("-ballistic_gauge", NULL, AT_NONE);	// Cmdline_ballistic_gauge
@@ -520,6 +535,8 @@ cmdline_parm noninteractive_arg("-noninteractive", NULL, AT_NONE); //Cmdline_non
 cmdline_parm json_profiling("-json_profiling", NULL, AT_NONE); //Cmdline_json_profiling
 cmdline_parm show_video_info("-show_video_info", NULL, AT_NONE); //Cmdline_show_video_info
 cmdline_parm frame_profile_arg("-profile_frame_time", NULL, AT_NONE); //Cmdline_frame_profile
+cmdline_parm perf_stats_arg("-perf_stats", nullptr, AT_NONE); // Cmdline_perf_stats
+cmdline_parm perf_stats_export_arg("-perf_stats_export", "Interval in seconds for writing perf_stats.csv and perf_stats.json", AT_INT); // Cmdline_perf_stats_export
 cmdline_parm debug_window_arg("-debug_window", NULL, AT_NONE);	// Cmdline_debug_window
 cmdline_parm graphics_debug_output_arg("-gr_debug", nullptr, AT_NONE); // Cmdline_graphics_debug_output
 cmdline_parm log_to_stdout_arg("-stdout_log", nullptr, AT_NONE); // Cmdline_log_to_stdout
@@ -556,6 +573,8 @@ const char *Cmdline_pilot = nullptr;
 bool Cmdline_noninteractive = false;
 bool Cmdline_json_profiling = false;
 bool Cmdline_frame_profile = false;
+bool Cmdline_perf_stats = false;
+int Cmdline_perf_stats_export = 0;
 bool Cmdline_show_video_info = false;
 bool Cmdline_debug_window = false;
 bool Cmdline_graphics_debug_output = false;
@@ -1545,6 +1564,18 @@ bool SetCmdlineParams()
 		Cmdline_NoFPSCap = 1;
 	}
 
+	if (ai_budget_arg.found())
+	{
+		auto val = ai_budget_arg.get_float();
+		Cmdline_ai_budget = val > 0.0f ? val : 0.0f;
+	}
+
+	if (asset_retention_arg.found())
+	{
+		auto val = asset_retention_arg.get_int();
+		Cmdline_asset_retention = val > 0 ? val : 0;
+	}
+
 	if(loadallweapons_arg.found())
 	{
 		Cmdline_load_all_weapons = 1;
@@ -2143,6 +2174,28 @@ bool SetCmdlineParams()
 		Cmdline_aniso_level = anisotropy_level_arg.get_int();
 	}
 
+	if (texture_budget_arg.found())
+	{
+		auto val = texture_budget_arg.get_int();
+		Cmdline_texture_budget = val > 0 ? val : 0;
+	}
+
+	if (generate_mipmaps_arg.found())
+	{
+		Cmdline_generate_mipmaps = true;
+	}
+
+	if (anim_cache_arg.found())
+	{
+		auto val = anim_cache_arg.get_int();
+		Cmdline_anim_cache = val > 0 ? val : 0;
+	}
+
+	if (glyph_atlas_arg.found())
+	{
+		Cmdline_glyph_atlas = true;
+	}
+
 	if (frame_profile_write_file.found())
 	{
 		Cmdline_profile_write_file = true;
@@ -2178,6 +2231,17 @@ bool SetCmdlineParams()
 		Cmdline_frame_profile = true;
 	}
 
+	if (perf_stats_arg.found())
+	{
+		Cmdline_perf_stats = true;
+	}
+
+	if (perf_stats_export_arg.found())
+	{
+		auto val = perf_stats_export_arg.get_int();
+		Cmdline_perf_stats_export = val > 0 ? val : 0;
+	}
+
 	if (debug_window_arg.found()) {
 		Cmdline_debug_window = true;
 	}
@@ -70,10 +70,16 @@ extern int Cmdline_no_deferred_lighting;
 extern bool Cmdline_deferred_lighting_cockpit;
 extern int Cmdline_emissive;
 extern int Cmdline_aniso_level;
+extern int Cmdline_texture_budget;
+extern bool Cmdline_generate_mipmaps;
+extern int Cmdline_anim_cache;
+extern bool Cmdline_glyph_atlas;
 
 // Game Speed related
 extern int Cmdline_NoFPSCap;
 extern int Cmdline_no_vsync;
+extern float Cmdline_ai_budget;
+extern int Cmdline_asset_retention;
 
 // HUD related
 extern int Cmdline_ballistic_gauge;
@@ -149,6 +155,8 @@ extern const char *Cmdline_pilot;
 extern bool Cmdline_noninteractive;
 extern bool Cmdline_json_profiling;
 extern bool Cmdline_frame_profile;
+extern bool Cmdline_perf_stats;
+extern int Cmdline_perf_stats_export;
 extern bool Cmdline_show_video_info;
 extern bool Cmdline_debug_window;
 extern bool Cmdline_graphics_debug_output;
@@ -26,22 +26,40 @@ bool Decoder::tryPopSubtitleData(SubtitleFramePtr& out) {
 }
 
 bool Decoder::tryPopVideoFrame(VideoFramePtr& out) {
-	auto res = m_videoQueue->try_pull_front(out);
-	return res == queue_op_status::success;
+	if (!m_videoQueue->pop(out)) {
+		return false;
+	}
+
+	{
+		// The decoder thread checks the queue size while holding the lock so it can't miss this notification
+		std::lock_guard<std::mutex> lock(m_videoSpaceMutex);
+	}
+	m_videoSpaceAvailable.notify_one();
+
+	return true;
 }
 
 void Decoder::initializeQueues(size_t queueSize) {
 	m_queueSize = queueSize;
 
-	m_videoQueue.reset(new sync_bounded_queue<VideoFramePtr>(m_queueSize));
+	// The lock free queue needs a power of two, the frames above the requested size are never used
+	size_t capacity = 1;
+	while (capacity < m_queueSize) {
+		capacity <<= 1;
+	}
+
+	m_videoQueue.reset(new util::SpscQueue<VideoFramePtr>(capacity));
 	m_audioQueue.reset(new sync_bounded_queue<AudioFramePtr>(m_queueSize));
 	m_subtitleQueue.reset(new sync_bounded_queue<SubtitleFramePtr>(m_queueSize));
 }
 
 void Decoder::stopDecoder() {
-	m_decoding = false;
+	{
+		std::lock_guard<std::mutex> lock(m_videoSpaceMutex);
+		m_decoding = false;
+	}
+	m_videoSpaceAvailable.notify_all();
 
-	m_videoQueue->close();
 	m_audioQueue->close();
 	m_subtitleQueue->close();
 }
@@ -71,11 +89,19 @@ void Decoder::pushSubtitleData(SubtitleFramePtr&& data) {
 void Decoder::pushFrameData(VideoFramePtr&& frame) {
 	Assertion(frame, "Invalid video data passed!");
 
-	try {
-		m_videoQueue->push_back(std::move(frame));
+	{
+		// Only the decoder thread pushes frames so the size can't grow while we wait
+		std::unique_lock<std::mutex> lock(m_videoSpaceMutex);
+		m_videoSpaceAvailable.wait(lock, [this]() { return !m_decoding || m_videoQueue->size() < m_queueSize; });
 	}
-	catch (sync_queue_is_closed&) {
-		// Ignore
+
+	if (!m_decoding) {
+		return;
+	}
+
+	if (!m_videoQueue->push(std::move(frame))) {
+		// The queue is larger than m_queueSize so this means that something else pushed frames
+		mprintf(("Cutscene: Video frame queue is full, dropping a frame!\n"));
 	}
 }
 }
@@ -1,8 +1,12 @@
 #pragma once
 
+#include <atomic>
+#include <condition_variable>
 #include <memory>
+#include <mutex>
 
 #include "globalincs/pstypes.h"
+#include "utils/SpscQueue.h"
 #include "utils/boost/syncboundedqueue.h"
 
 namespace cutscene {
@@ -83,16 +87,23 @@ struct PlaybackProperties {
  *
  * A decoder maintaines two queues of decoded audio and video frames which are filled from a background thread and
  * retrieved by the main thread.
+ *
+ * Video frames are big and may arrive faster than the main thread renders, so they use a lock free queue. The decoder
+ * thread sleeps while it is full until the main thread signals that it took a frame out.
  */
 class Decoder {
  private:
-	std::unique_ptr<sync_bounded_queue<VideoFramePtr>> m_videoQueue;
+	std::unique_ptr<util::SpscQueue<VideoFramePtr>> m_videoQueue;
 	std::unique_ptr<sync_bounded_queue<AudioFramePtr>> m_audioQueue;
 	std::unique_ptr<sync_bounded_queue<SubtitleFramePtr>> m_subtitleQueue;
 
-	bool m_decoding;
+	std::atomic<bool> m_decoding;
 	size_t m_queueSize = 0;
 
+	// Wakes up the decoder thread when there is space in the video queue or when decoding stops
+	std::mutex m_videoSpaceMutex;
+	std::condition_variable m_videoSpaceAvailable;
+
  protected:
 	Decoder();
 
@@ -148,7 +159,7 @@ class Decoder {
 
 	bool tryPopSubtitleData(SubtitleFramePtr&);
 
-	bool isVideoQueueFull() { return m_videoQueue->size() == m_queueSize; }
+	bool isVideoQueueFull() { return m_videoQueue->size() >= m_queueSize; }
 
 	bool isVideoFrameAvailable() { return !m_videoQueue->empty(); }
 
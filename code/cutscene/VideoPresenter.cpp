@@ -68,26 +68,36 @@ VideoPresenter::~VideoPresenter() {
 void VideoPresenter::uploadVideoFrame(const VideoFramePtr& frame) {
 	GR_DEBUG_SCOPE("Update video frame");
 
+	int bpp = 0;
+	switch (_properties.pixelFormat) {
+	case FramePixelFormat::YUV420:
+		bpp = 8;
+		break;
+	case FramePixelFormat::BGR:
+		bpp = 24;
+		break;
+	case FramePixelFormat::BGRA:
+		bpp = 32;
+		break;
+	default:
+		UNREACHABLE("Unhandled enum value!");
+		break;
+	}
+
 	for (size_t i = 0; i < frame->getPlaneNumber(); ++i) {
 		auto size = frame->getPlaneSize(i);
-		auto data = frame->getPlaneData(i);
-
-		memcpy(_planeTextureBuffers[i].get(), data, size.stride * size.height);
-
-		int bpp = 0;
-		switch (_properties.pixelFormat) {
-		case FramePixelFormat::YUV420:
-			bpp = 8;
-			break;
-		case FramePixelFormat::BGR:
-			bpp = 24;
-			break;
-		case FramePixelFormat::BGRA:
-			bpp = 32;
-			break;
-		default:
-			UNREACHABLE("Unhandled enum value!");
-			break;
+		auto data = static_cast<const uint8_t*>(frame->getPlaneData(i));
+
+		auto row_size = size.width * (bpp / 8);
+		auto buffer = _planeTextureBuffers[i].get();
+
+		if (size.stride == row_size) {
+			memcpy(buffer, data, row_size * size.height);
+		} else {
+			// Frames straight from the decoder have padded rows but the texture data has to be tightly packed
+			for (size_t y = 0; y < size.height; ++y) {
+				memcpy(buffer + y * row_size, data + y * size.stride, row_size);
+			}
 		}
 
 		gr_update_texture(_planeTextureHandles[i], bpp, _planeTextureBuffers[i].get(), static_cast<int>(size.width),
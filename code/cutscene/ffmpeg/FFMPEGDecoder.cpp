@@ -352,6 +352,11 @@ std::unique_ptr<DecoderStatus> initializeStatus(std::unique_ptr<InputStream>& st
 	status->videoCodecCtx = status->videoStream->codec;
 #endif
 
+	// Let FFmpeg pick the number of threads. Frame threading delays the output by a few frames but that is nothing
+	// compared to the two seconds the frame queue holds.
+	status->videoCodecCtx->thread_count = 0;
+	status->videoCodecCtx->thread_type  = FF_THREAD_FRAME | FF_THREAD_SLICE;
+
 	err = avcodec_open2(status->videoCodecCtx, status->videoCodec, nullptr);
 	if (err < 0) {
 		char errorStr[512];
@@ -360,8 +365,9 @@ std::unique_ptr<DecoderStatus> initializeStatus(std::unique_ptr<InputStream>& st
 		return nullptr;
 	}
 
-	mprintf(("FFmpeg: Using video codec %s (%s).\n", status->videoCodec->long_name ? status->videoCodec->long_name : "<Unknown>",
-		status->videoCodec->name ? status->videoCodec->name : "<Unknown>"));
+	mprintf(("FFmpeg: Using video codec %s (%s) with %d threads.\n",
+		status->videoCodec->long_name ? status->videoCodec->long_name : "<Unknown>",
+		status->videoCodec->name ? status->videoCodec->name : "<Unknown>", status->videoCodecCtx->thread_count));
 
 	// Now initialize audio, if this fails it's not a fatal error
 	if (audioStream >= 0) {
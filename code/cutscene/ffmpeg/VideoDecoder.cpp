@@ -19,13 +19,19 @@ class FFMPEGVideoFrame: public VideoFrame {
 	size_t _width;
 	size_t _height;
 	AVFrame* _frame;
+	bool _ownsData; // false if the frame references the buffers of the decoder
 
   public:
-	FFMPEGVideoFrame(size_t width, size_t height, AVFrame* frame) : _width(width), _height(height), _frame(frame) {}
+	FFMPEGVideoFrame(size_t width, size_t height, AVFrame* frame, bool ownsData)
+	    : _width(width), _height(height), _frame(frame), _ownsData(ownsData)
+	{
+	}
 
 	~FFMPEGVideoFrame() override {
 		if (_frame != nullptr) {
-			av_freep(&_frame->data[0]);
+			if (_ownsData) {
+				av_freep(&_frame->data[0]);
+			}
 			av_frame_free(&_frame);
 		}
 	}
@@ -70,26 +76,32 @@ VideoDecoder::~VideoDecoder() {
 }
 
 void VideoDecoder::convertAndPushPicture(const AVFrame* frame) {
-	// Allocate a picture to hold the destination data
-	AVFrame* yuvFrame = av_frame_alloc();
-	av_frame_copy(yuvFrame, frame);
-	yuvFrame->format = m_destinationFormat;
+	AVFrame* yuvFrame;
+	bool ownsData;
+
+	if (frame->format == m_destinationFormat) {
+		// The presenter can use the decoded data as it is (the movie shader does the YUV conversion) so just keep a
+		// reference to the buffers of the decoder instead of copying them
+		yuvFrame = av_frame_clone(frame);
+		ownsData = false;
+	} else {
+		// Allocate a picture to hold the destination data
+		yuvFrame = av_frame_alloc();
+		av_frame_copy(yuvFrame, frame);
+		yuvFrame->format = m_destinationFormat;
 
-	av_image_alloc(yuvFrame->data, yuvFrame->linesize, m_status->videoCodecPars.width, m_status->videoCodecPars.height,
-	               m_destinationFormat, 1);
+		av_image_alloc(yuvFrame->data, yuvFrame->linesize, m_status->videoCodecPars.width,
+		               m_status->videoCodecPars.height, m_destinationFormat, 1);
 
-	if (m_status->videoCodecPars.pixel_format == m_destinationFormat) {
-		av_image_copy(yuvFrame->data, yuvFrame->linesize, (const uint8_t**)(frame->data), frame->linesize,
-		              m_destinationFormat, m_status->videoCodecPars.width, m_status->videoCodecPars.height);
-	} else {
 		// Convert frame to destination format
 		sws_scale(m_swsCtx, (uint8_t const* const*)frame->data, frame->linesize, 0, m_status->videoCodecPars.height,
 		          yuvFrame->data, yuvFrame->linesize);
+		ownsData = true;
 	}
 
 	std::unique_ptr<FFMPEGVideoFrame> videoFramePtr(
 	    new FFMPEGVideoFrame(static_cast<size_t>(m_status->videoCodecPars.width),
-	                         static_cast<size_t>(m_status->videoCodecPars.height), yuvFrame));
+	                         static_cast<size_t>(m_status->videoCodecPars.height), yuvFrame, ownsData));
 	videoFramePtr->id = ++m_frameId;
 #if LIBAVCODEC_VERSION_INT > AV_VERSION_INT(58, 3, 102)
 	videoFramePtr->frameTime = getFrameTime(frame->best_effort_timestamp, m_status->videoStream->time_base);
@@ -1,6 +1,8 @@
 
 #include "Executor.h"
 
+#include "executor/IExecutionContext.h"
+
 #include "utils/finally.h"
 
 namespace executor {
@@ -19,6 +21,23 @@ void Executor::post(Executor::Callback cb)
 	m_pendingWorkItems.push_back(std::move(cb));
 }
 
+void Executor::postAt(TIMESTAMP deadline, Executor::Callback cb)
+{
+	postAt(deadline, std::move(cb), nullptr);
+}
+
+void Executor::postAt(TIMESTAMP deadline, Executor::Callback cb, std::shared_ptr<IExecutionContext> context)
+{
+	Assertion(deadline.isValid(), "Invalid timestamp passed to postAt!");
+
+	if (deadline.isNever()) {
+		return;
+	}
+
+	std::unique_lock<std::mutex> lock(m_pendingWorkItemsMutex);
+	m_pendingTimedWorkItems.push_back(PendingTimedWorkItem{deadline, std::move(cb), std::move(context)});
+}
+
 void Executor::process()
 {
 	// Ensure that no deadlocks happen when this is called from multiple threads
@@ -37,8 +56,35 @@ void Executor::process()
 		// Now move the pending items over to the actual work list
 		std::move(m_pendingWorkItems.begin(), m_pendingWorkItems.end(), std::back_inserter(m_workItems));
 		m_pendingWorkItems.clear();
+
+		for (auto& item : m_pendingTimedWorkItems) {
+			auto id = m_timedWorkItems.schedule(item.deadline.value(), std::move(item.cb));
+			if (item.context) {
+				m_contextTimedWorkItems.emplace_back(std::move(item.context), id);
+			}
+		}
+		m_pendingTimedWorkItems.clear();
 	}
 
+	// Timed work items whose context became invalid must not wait for their deadline since the context may never come
+	// back. They are executed right away so that they can clean up after themselves.
+	for (auto iter = m_contextTimedWorkItems.begin(); iter != m_contextTimedWorkItems.end();) {
+		Callback cb;
+		if (!m_timedWorkItems.isScheduled(iter->second)) {
+			// Already dispatched normally
+			iter = m_contextTimedWorkItems.erase(iter);
+		} else if (iter->first->determineContextState() == IExecutionContext::State::Invalid &&
+				   m_timedWorkItems.cancel(iter->second, cb)) {
+			m_workItems.push_back(std::move(cb));
+			iter = m_contextTimedWorkItems.erase(iter);
+		} else {
+			++iter;
+		}
+	}
+
+	// Timed work items join the normal work items once their time has come
+	m_timedWorkItems.advance(timestamp(), [this](Callback&& cb) { m_workItems.push_back(std::move(cb)); });
+
 	for (auto iter = m_workItems.begin(); iter != m_workItems.end();) {
 		auto& cb = *iter;
 		if (cb() == CallbackResult::Done) {
@@ -1,11 +1,16 @@
 #pragma once
 
 #include "globalincs/pstypes.h"
+#include "io/timer.h"
+#include "utils/TimerWheel.h"
 
+#include <memory>
 #include <mutex>
 
 namespace executor {
 
+class IExecutionContext;
+
 /**
  * @brief A class that collects work that should be executed repeatedly.
  *
@@ -13,7 +18,9 @@ namespace executor {
  * specific points of the engine code. External code can then post() work items to be executed when that point of the
  * code is reached without introducing a hard dependency between the two code modules.
  *
- * Work items have the option of specifying that they should be rescheduled for the next execution round.
+ * Work items have the option of specifying that they should be rescheduled for the next execution round. Work that
+ * should only happen once some time has passed should be posted with postAt() instead of rescheduling itself until that
+ * time is reached.
  *
  * @note This class is thread safe and work items can be posted to the executor from different threads without risking
  * data corruption.
@@ -36,6 +43,30 @@ class Executor {
 	 */
 	void post(Callback cb);
 
+	/**
+	 * @brief Adds a work item to this executor which is executed once the specified timestamp has elapsed
+	 *
+	 * Until then the work item does not cost anything when process() is called. Once the timestamp elapsed the work item
+	 * behaves as if it was added with post().
+	 *
+	 * @param deadline The game time at which the work item should start to execute. Work items with a timestamp that
+	 * never elapses are never executed.
+	 * @param cb The work item
+	 */
+	void postAt(TIMESTAMP deadline, Callback cb);
+
+	/**
+	 * @brief Adds a timed work item which belongs to the specified execution context
+	 *
+	 * This behaves like postAt() but the context is checked every time process() is called. If it becomes invalid
+	 * before the timestamp elapsed then the work item is executed right away so that it can react to that.
+	 *
+	 * @param deadline The game time at which the work item should start to execute
+	 * @param cb The work item, usually created by runInContext() with the same context
+	 * @param context The context the work item depends on
+	 */
+	void postAt(TIMESTAMP deadline, Callback cb, std::shared_ptr<IExecutionContext> context);
+
 	/**
 	 * @brief Executes one round of work items
 	 */
@@ -44,9 +75,17 @@ class Executor {
   private:
 	std::mutex m_mainMutex;
 	SCP_vector<Callback> m_workItems;
+	util::TimerWheel<Callback> m_timedWorkItems;
+	SCP_vector<std::pair<std::shared_ptr<IExecutionContext>, util::TimerWheel<Callback>::TimerId>> m_contextTimedWorkItems;
 
 	std::mutex m_pendingWorkItemsMutex;
 	SCP_vector<Callback> m_pendingWorkItems;
+	struct PendingTimedWorkItem {
+		TIMESTAMP deadline;
+		Callback cb;
+		std::shared_ptr<IExecutionContext> context;
+	};
+	SCP_vector<PendingTimedWorkItem> m_pendingTimedWorkItems;
 };
 
 Executor* currentExecutor();
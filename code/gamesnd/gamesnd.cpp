@@ -544,16 +544,22 @@ void gamesnd_preload_common_sounds()
 		return;
 
 	Assert( Snds.size() <= INT_MAX );
+	SCP_vector<snd_load_request> requests;
 	for (auto& gs: Snds) {
 		if ( gs.preload ) {
 			for (auto& entry : gs.sound_entries) {
 				if ( entry.filename[0] != 0 && strnicmp(entry.filename, NOX("none.wav"), 4) != 0 ) {
-					game_busy( NOX("** preloading common game sounds **") );	// Animate loading cursor... does nothing if loading screen not active.
-					entry.id = snd_load(&entry, &gs.flags);
+					requests.push_back({&entry, &gs.flags});
 				}
 			}
 		}
 	}
+
+	// Animate loading cursor... does nothing if loading screen not active.
+	auto ids = snd_load_all(requests, []() { game_busy(NOX("** preloading common game sounds **")); });
+	for (size_t i = 0; i < requests.size(); ++i) {
+		requests[i].entry->id = ids[i];
+	}
 }
 
 /**
@@ -565,16 +571,22 @@ void gamesnd_load_gameplay_sounds()
 		return;
 
 	Assert( Snds.size() <= INT_MAX );
+	SCP_vector<snd_load_request> requests;
 	for (auto& gs: Snds) {
 		if ( !gs.preload ) { // don't try to load anything that's already preloaded
 			for (auto& entry : gs.sound_entries) {
 				if (entry.filename[0] != 0 && strnicmp(entry.filename, NOX("none.wav"), 4) != 0) {
-					game_busy(NOX("** preloading gameplay sounds **"));        // Animate loading cursor... does nothing if loading screen not active.
-					entry.id = snd_load(&entry, &gs.flags);
+					requests.push_back({&entry, &gs.flags});
 				}
 			}
 		}
 	}
+
+	// Animate loading cursor... does nothing if loading screen not active.
+	auto ids = snd_load_all(requests, []() { game_busy(NOX("** preloading gameplay sounds **")); });
+	for (size_t i = 0; i < requests.size(); ++i) {
+		requests[i].entry->id = ids[i];
+	}
 }
 
 /**
@@ -593,6 +605,28 @@ void gamesnd_unload_gameplay_sounds()
 	}
 }
 
+/**
+ * Get the memory used by the loaded ingame sounds, sounds which are shared by several entries are counted once
+ */
+size_t gamesnd_get_gameplay_sounds_size()
+{
+	SCP_unordered_set<int> counted;
+	size_t total = 0;
+
+	for (auto& gs: Snds) {
+		for (auto& entry : gs.sound_entries) {
+			if (entry.id.isValid() && counted.insert(entry.id.value()).second) {
+				int size;
+				if (snd_size(entry.id, &size) == 0) {
+					total += size;
+				}
+			}
+		}
+	}
+
+	return total;
+}
+
 /**
  * Load the interface sounds into memory
  */
@@ -361,6 +361,7 @@ void gamesnd_unload_interface_sounds();
 void gamesnd_preload_common_sounds();
 void gamesnd_load_gameplay_sounds();
 void gamesnd_unload_gameplay_sounds();
+size_t gamesnd_get_gameplay_sounds_size();
 void gamesnd_play_iface(interface_snd_id n);
 void gamesnd_play_error_beep();
 gamesnd_id gamesnd_get_by_name(const char* name);
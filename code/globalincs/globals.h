@@ -61,7 +61,7 @@
 #define MAX_COMPLETE_ESCORT_LIST	20
              
 // from weapon.h
-#define MAX_WEAPONS	3000		//Increased from 2000 to 3000 in 2022
+#define MAX_WEAPONS	MAX_OBJECTS	// Weapons are only limited by the objects, their pool grows with the mission (was 3000)
 
 #define MAX_WEAPON_TYPES				500
 
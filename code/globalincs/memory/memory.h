@@ -5,6 +5,7 @@
 #include <cstdlib>
 
 #include "globalincs/pstypes.h"
+#include "globalincs/memory/tracking.h"
 
 namespace memory
 {
@@ -14,8 +15,13 @@ namespace memory
 	void out_of_memory();
 }
 
+#ifdef SCP_MEMORY_TRACKING
+inline void *vm_malloc(size_t size, const memory::quiet_alloc_t &)
+{ return memory::tracked_malloc(size); }
+#else
 inline void *vm_malloc(size_t size, const memory::quiet_alloc_t &)
 { return std::malloc(size); }
+#endif
 
 inline void *vm_malloc(size_t size)
 {
@@ -29,11 +35,19 @@ inline void *vm_malloc(size_t size)
 	return ptr;
 }
 
+#ifdef SCP_MEMORY_TRACKING
+inline void vm_free(void *ptr)
+{ memory::tracked_free(ptr); }
+
+inline void *vm_realloc(void *ptr, size_t size, const memory::quiet_alloc_t &)
+{ return memory::tracked_realloc(ptr, size); }
+#else
 inline void vm_free(void *ptr)
 { std::free(ptr); }
 
 inline void *vm_realloc(void *ptr, size_t size, const memory::quiet_alloc_t &)
 { return std::realloc(ptr, size); }
+#endif
 
 inline void *vm_realloc(void *ptr, size_t size)
 {
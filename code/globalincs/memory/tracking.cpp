@@ -0,0 +1,383 @@
+
+#include "globalincs/memory/tracking.h"
+
+#include "debugconsole/console.h"
+#include "globalincs/pstypes.h"
+#include "io/timer.h"
+#include "tracing/Monitor.h"
+
+#include <algorithm>
+#include <atomic>
+#include <climits>
+#include <cstdlib>
+#include <new>
+
+namespace {
+
+const char* Tag_names[] = {"Untagged", "Models", "Bitmaps", "Particles", "Sound", "Scripting"};
+static_assert(sizeof(Tag_names) / sizeof(Tag_names[0]) == static_cast<size_t>(memory::Tag::NUM_TAGS),
+	"Every memory tag needs a name!");
+
+} // namespace
+
+#ifdef SCP_MEMORY_TRACKING
+
+namespace {
+
+const size_t NUM_TAGS = static_cast<size_t>(memory::Tag::NUM_TAGS);
+
+const std::uint32_t HEADER_MAGIC = 0x4d454d54;
+
+// Stored in front of every tracked allocation. The alignment keeps the returned pointer as aligned as one from malloc.
+struct alignas(16) allocation_header {
+	size_t size;
+	std::uint32_t magic;
+	memory::Tag tag;
+};
+
+// Only zero-initialized atomics so allocations during static initialization are safe
+struct tag_counters {
+	std::atomic<size_t> live_bytes;
+	std::atomic<size_t> peak_bytes;
+	std::atomic<std::uint64_t> allocations;
+};
+
+tag_counters Tag_counters[NUM_TAGS];
+
+// Hot spots are only reported once in a while so a scope which allocates every frame does not flood the log
+const int HOT_SPOT_REPORT_INTERVAL = 10000;
+
+const size_t MAX_ALLOCATION_SITES = 256;
+
+struct allocation_site {
+	const char* name;
+	std::uint32_t allocations;
+	std::uint64_t bytes;
+	int last_reported;
+};
+
+// A small open addressing table keyed by the site name pointer. It is per thread so counting needs no synchronization.
+struct allocation_site_table {
+	allocation_site sites[MAX_ALLOCATION_SITES];
+
+	void count(const char* name, size_t size)
+	{
+		auto hash = reinterpret_cast<std::uintptr_t>(name) >> 3;
+		for (size_t i = 0; i < MAX_ALLOCATION_SITES; ++i) {
+			auto& site = sites[(hash + i) % MAX_ALLOCATION_SITES];
+			if (site.name == name || site.name == nullptr) {
+				site.name = name;
+				++site.allocations;
+				site.bytes += size;
+				return;
+			}
+		}
+		// The table is full, there are not that many traced scopes so this should never happen
+	}
+};
+
+thread_local memory::Tag Current_tag = memory::Tag::Untagged;
+thread_local const char* Current_site = nullptr;
+thread_local allocation_site_table Allocation_sites;
+
+int Hot_spot_allocations = 500;
+
+DCF_INT2(mem_hotspot_allocs, Hot_spot_allocations, 0, INT_MAX, "Sets the number of allocations per frame which makes a traced scope a hot spot, 0 disables the report (Default is 500)");
+
+struct tag_monitors {
+	tracing::Monitor<float> live_kb;
+	tracing::Monitor<float> peak_kb;
+	tracing::Monitor<int> frame_allocations;
+};
+
+tag_monitors Tag_monitors[NUM_TAGS] = {
+	{{"MemUntaggedLiveKB", 0.0f}, {"MemUntaggedPeakKB", 0.0f}, {"MemUntaggedAllocs", 0}},
+	{{"MemModelsLiveKB", 0.0f}, {"MemModelsPeakKB", 0.0f}, {"MemModelsAllocs", 0}},
+	{{"MemBitmapsLiveKB", 0.0f}, {"MemBitmapsPeakKB", 0.0f}, {"MemBitmapsAllocs", 0}},
+	{{"MemParticlesLiveKB", 0.0f}, {"MemParticlesPeakKB", 0.0f}, {"MemParticlesAllocs", 0}},
+	{{"MemSoundLiveKB", 0.0f}, {"MemSoundPeakKB", 0.0f}, {"MemSoundAllocs", 0}},
+	{{"MemScriptingLiveKB", 0.0f}, {"MemScriptingPeakKB", 0.0f}, {"MemScriptingAllocs", 0}},
+};
+
+// The heap allocations of all tags in the last frame, this should stay close to zero once a mission is running
+tracing::Monitor<int> Frame_allocations_monitor("MemFrameAllocs", 0);
+
+// Only touched by the main thread
+std::uint64_t Last_frame_allocations[NUM_TAGS];
+std::uint64_t Frame_allocations[NUM_TAGS];
+int Tracking_frame = 0;
+
+void account_allocation(memory::Tag tag, size_t size)
+{
+	auto& counters = Tag_counters[static_cast<size_t>(tag)];
+
+	auto live = counters.live_bytes.fetch_add(size, std::memory_order_relaxed) + size;
+	auto peak = counters.peak_bytes.load(std::memory_order_relaxed);
+	while (live > peak && !counters.peak_bytes.compare_exchange_weak(peak, live, std::memory_order_relaxed)) {
+	}
+
+	counters.allocations.fetch_add(1, std::memory_order_relaxed);
+
+	if (Current_site != nullptr) {
+		Allocation_sites.count(Current_site, size);
+	}
+}
+
+void account_free(memory::Tag tag, size_t size)
+{
+	Tag_counters[static_cast<size_t>(tag)].live_bytes.fetch_sub(size, std::memory_order_relaxed);
+}
+
+allocation_header* get_header(void* ptr)
+{
+	auto header = static_cast<allocation_header*>(ptr) - 1;
+
+	// This is most likely memory from plain malloc or new[] which was freed with vm_free or the other way around
+	Assertion(header->magic == HEADER_MAGIC, "Freeing memory which was not allocated by the tracking allocator!");
+
+	return header;
+}
+
+void report_hot_spots()
+{
+	if (Hot_spot_allocations <= 0) {
+		return;
+	}
+
+	for (auto& site : Allocation_sites.sites) {
+		if (site.name == nullptr || site.allocations == 0) {
+			continue;
+		}
+
+		if (site.allocations >= static_cast<std::uint32_t>(Hot_spot_allocations) &&
+			(site.last_reported == 0 || Tracking_frame - site.last_reported >= HOT_SPOT_REPORT_INTERVAL)) {
+			mprintf(("Memory: '%s' made %u allocations (%" PRIu64 " bytes) in one frame.\n", site.name,
+				site.allocations, site.bytes));
+			site.last_reported = Tracking_frame;
+		}
+
+		site.allocations = 0;
+		site.bytes = 0;
+	}
+}
+
+} // namespace
+
+namespace memory {
+
+void* tracked_malloc(size_t size)
+{
+	auto header = static_cast<allocation_header*>(std::malloc(sizeof(allocation_header) + size));
+	if (header == nullptr) {
+		return nullptr;
+	}
+
+	header->size = size;
+	header->magic = HEADER_MAGIC;
+	header->tag = Current_tag;
+	account_allocation(header->tag, size);
+
+	return header + 1;
+}
+
+void tracked_free(void* ptr)
+{
+	if (ptr == nullptr) {
+		return;
+	}
+
+	auto header = get_header(ptr);
+	account_free(header->tag, header->size);
+
+	header->magic = 0;
+	std::free(header);
+}
+
+void* tracked_realloc(void* ptr, size_t size)
+{
+	if (ptr == nullptr) {
+		return tracked_malloc(size);
+	}
+
+	auto header = get_header(ptr);
+	auto old_size = header->size;
+	auto old_tag = header->tag;
+
+	auto new_header = static_cast<allocation_header*>(std::realloc(header, sizeof(allocation_header) + size));
+	if (new_header == nullptr) {
+		// The old block is still valid and accounted for
+		return nullptr;
+	}
+
+	account_free(old_tag, old_size);
+
+	new_header->size = size;
+	new_header->tag = Current_tag;
+	account_allocation(new_header->tag, size);
+
+	return new_header + 1;
+}
+
+TagScope::TagScope(Tag tag) : _previous(Current_tag)
+{
+	Current_tag = tag;
+}
+
+TagScope::~TagScope()
+{
+	Current_tag = _previous;
+}
+
+AllocationSite::AllocationSite(const char* name) : _previous(Current_site)
+{
+	Current_site = name;
+}
+
+AllocationSite::~AllocationSite()
+{
+	Current_site = _previous;
+}
+
+bool tracking_enabled()
+{
+	return true;
+}
+
+tag_stats get_tag_stats(Tag tag)
+{
+	auto index = static_cast<size_t>(tag);
+	auto& counters = Tag_counters[index];
+
+	tag_stats stats;
+	stats.live_bytes = counters.live_bytes.load(std::memory_order_relaxed);
+	stats.peak_bytes = counters.peak_bytes.load(std::memory_order_relaxed);
+	stats.total_allocations = counters.allocations.load(std::memory_order_relaxed);
+	stats.frame_allocations = Frame_allocations[index];
+
+	return stats;
+}
+
+void tracking_frame()
+{
+	++Tracking_frame;
+
+	std::uint64_t total_allocations = 0;
+	for (size_t i = 0; i < NUM_TAGS; ++i) {
+		auto& counters = Tag_counters[i];
+
+		auto allocations = counters.allocations.load(std::memory_order_relaxed);
+		Frame_allocations[i] = allocations - Last_frame_allocations[i];
+		Last_frame_allocations[i] = allocations;
+
+		Tag_monitors[i].live_kb = counters.live_bytes.load(std::memory_order_relaxed) / 1024.0f;
+		Tag_monitors[i].peak_kb = counters.peak_bytes.load(std::memory_order_relaxed) / 1024.0f;
+		Tag_monitors[i].frame_allocations = static_cast<int>(Frame_allocations[i]);
+
+		total_allocations += Frame_allocations[i];
+	}
+	Frame_allocations_monitor = static_cast<int>(total_allocations);
+
+	report_hot_spots();
+}
+
+} // namespace memory
+
+// All allocations of the standard containers end up here
+void* operator new(size_t size)
+{
+	auto ptr = memory::tracked_malloc(size == 0 ? 1 : size);
+	if (ptr == nullptr) {
+		throw std::bad_alloc();
+	}
+	return ptr;
+}
+
+void* operator new[](size_t size)
+{
+	return ::operator new(size);
+}
+
+void* operator new(size_t size, const std::nothrow_t&) noexcept
+{
+	return memory::tracked_malloc(size == 0 ? 1 : size);
+}
+
+void* operator new[](size_t size, const std::nothrow_t&) noexcept
+{
+	return memory::tracked_malloc(size == 0 ? 1 : size);
+}
+
+void operator delete(void* ptr) noexcept
+{
+	memory::tracked_free(ptr);
+}
+
+void operator delete[](void* ptr) noexcept
+{
+	memory::tracked_free(ptr);
+}
+
+void operator delete(void* ptr, const std::nothrow_t&) noexcept
+{
+	memory::tracked_free(ptr);
+}
+
+void operator delete[](void* ptr, const std::nothrow_t&) noexcept
+{
+	memory::tracked_free(ptr);
+}
+
+#else
+
+namespace memory {
+
+bool tracking_enabled()
+{
+	return false;
+}
+
+tag_stats get_tag_stats(Tag)
+{
+	return tag_stats();
+}
+
+void tracking_frame()
+{
+}
+
+} // namespace memory
+
+#endif
+
+namespace memory {
+
+const char* tag_name(Tag tag)
+{
+	return Tag_names[static_cast<size_t>(tag)];
+}
+
+} // namespace memory
+
+DCF(mem_stats, "Shows the heap memory usage per subsystem")
+{
+	if (dc_optional_string_either("help", "--help")) {
+		dc_printf("Displays the live and peak heap usage and the allocations of the last frame of every subsystem.\n");
+		dc_printf("Requires a build with FSO_MEMORY_TRACKING.\n\n");
+		return;
+	}
+
+	if (!memory::tracking_enabled()) {
+		dc_printf("Memory tracking is not available in this build, it requires FSO_MEMORY_TRACKING.\n");
+		return;
+	}
+
+	dc_printf("%-12s %12s %12s %16s %12s\n", "Subsystem", "Live KB", "Peak KB", "Allocations", "Last frame");
+	for (size_t i = 0; i < static_cast<size_t>(memory::Tag::NUM_TAGS); ++i) {
+		auto tag = static_cast<memory::Tag>(i);
+		auto stats = memory::get_tag_stats(tag);
+
+		dc_printf("%-12s %12" PRIu64 " %12" PRIu64 " %16" PRIu64 " %12" PRIu64 "\n", memory::tag_name(tag),
+			static_cast<std::uint64_t>(stats.live_bytes / 1024), static_cast<std::uint64_t>(stats.peak_bytes / 1024),
+			stats.total_allocations, stats.frame_allocations);
+	}
+}
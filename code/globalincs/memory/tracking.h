@@ -0,0 +1,120 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+/** @file
+ *  Optional accounting of heap allocations per subsystem.
+ *
+ *  Builds configured with FSO_MEMORY_TRACKING (which defines SCP_MEMORY_TRACKING) route vm_malloc and the global
+ *  operator new through a tracking allocator. Every allocation is attributed to the tag which is active on the
+ *  allocating thread, see memory::TagScope. The live bytes, peak bytes and allocations per frame of every tag are
+ *  published through tracing monitors and the mem_stats debug command. The MemFrameAllocs monitor has the heap
+ *  allocations of all tags in the last frame.
+ *
+ *  Allocations on the main thread are additionally counted per traced scope (TRACE_SCOPE) so scopes which allocate a
+ *  lot every frame can be found. Scopes which exceed the threshold of the mem_hotspot_allocs debug command are written
+ *  to the log.
+ *
+ *  In normal builds all of this compiles to nothing.
+ */
+
+namespace memory {
+
+/**
+ * @brief The subsystems allocations are attributed to
+ */
+enum class Tag : std::uint8_t {
+	Untagged,
+	Models,
+	Bitmaps,
+	Particles,
+	Sound,
+	Scripting,
+
+	NUM_TAGS
+};
+
+/**
+ * @brief The accounting data of one tag
+ */
+struct tag_stats {
+	size_t live_bytes = 0;
+	size_t peak_bytes = 0;
+	std::uint64_t total_allocations = 0;
+	std::uint64_t frame_allocations = 0; //!< The allocations made in the last frame
+};
+
+/**
+ * @brief Checks if this build tracks allocations
+ */
+bool tracking_enabled();
+
+/**
+ * @brief Gets the name of a tag
+ */
+const char* tag_name(Tag tag);
+
+/**
+ * @brief Gets the current accounting data of a tag, all values are zero if tracking is disabled
+ */
+tag_stats get_tag_stats(Tag tag);
+
+/**
+ * @brief Updates the per-frame statistics and monitors and reports allocation hot spots
+ *
+ * Must be called once per frame from the main thread.
+ */
+void tracking_frame();
+
+#ifdef SCP_MEMORY_TRACKING
+
+void* tracked_malloc(size_t size);
+void tracked_free(void* ptr);
+void* tracked_realloc(void* ptr, size_t size);
+
+/**
+ * @brief Attributes all allocations of the current thread to a tag until the scope is left
+ */
+class TagScope {
+	Tag _previous;
+
+  public:
+	explicit TagScope(Tag tag);
+	~TagScope();
+
+	TagScope(const TagScope&) = delete;
+	TagScope& operator=(const TagScope&) = delete;
+};
+
+/**
+ * @brief Counts the allocations of the current thread for the hot spot report until the scope is left
+ *
+ * @param name The name of the site, the pointer is used as the identity of the site so it must stay valid
+ */
+class AllocationSite {
+	const char* _previous;
+
+  public:
+	explicit AllocationSite(const char* name);
+	~AllocationSite();
+
+	AllocationSite(const AllocationSite&) = delete;
+	AllocationSite& operator=(const AllocationSite&) = delete;
+};
+
+#else
+
+class TagScope {
+  public:
+	explicit TagScope(Tag) {}
+};
+
+class AllocationSite {
+  public:
+	explicit AllocationSite(const char*) {}
+};
+
+#endif
+
+} // namespace memory
@@ -27,6 +27,7 @@
 #include "executor/global_executors.h"
 #include "graphics/paths/PathRenderer.h"
 #include "graphics/post_processing.h"
+#include "graphics/software/FontManager.h"
 #include "graphics/util/GPUMemoryHeap.h"
 #include "graphics/util/UniformBuffer.h"
 #include "graphics/util/UniformBufferManager.h"
@@ -77,6 +78,7 @@ char Gr_current_palette_name[128] = NOX("none");
 io::mouse::Cursor* Web_cursor = NULL;
 
 int Gr_inited = 0;
+int Gr_draw_calls = 0;
 
 float Gr_gamma = 1.0f;
 
@@ -2566,6 +2568,14 @@ void gr_flip(bool execute_scripting)
 	// Use this opportunity for retiring the uniform buffers
 	uniform_buffer_managers_retire_buffers();
 
+	// Stream in the textures that were drawn bigger than their resident mipmaps this frame
+	bm_update_residency();
+
+	// Text layouts which weren't drawn in this frame are most likely not needed anymore
+	font::FontManager::nextFrame();
+
+	Gr_draw_calls = 0;
+
 	TRACE_SCOPE(tracing::PageFlip);
 	gr_screen.gf_flip();
 }
@@ -40,6 +40,9 @@ extern float Min_draw_distance;
 extern float Max_draw_distance;
 extern int Gr_inited;
 
+// Number of draw calls submitted to the graphics API since the last page flip
+extern int Gr_draw_calls;
+
 // z-buffering stuff
 extern int gr_zbuffering, gr_zbuffering_mode;
 extern int gr_global_zbuffering;
@@ -422,12 +422,7 @@ void generic_render_ani_stream(generic_anim *ga)
 		} else {
 			ga->ani.instance->data = ga->ani.animation->data + ga->ani.animation->keys[ga->current_frame].offset;
 		}
-		if(ga->ani.animation->flags & ANF_STREAMED) {
-			ga->ani.instance->file_offset = unpack_frame_from_file(ga->ani.instance, ga->buffer, ga->width * ga->height, (ga->ani.instance->xlate_pal) ? ga->ani.animation->palette_translation : NULL, (bpp==8)?1:0, bpp);
-		}
-		else {
-			ga->ani.instance->data = unpack_frame(ga->ani.instance, ga->ani.instance->data, ga->buffer, ga->width * ga->height, (ga->ani.instance->xlate_pal) ? ga->ani.animation->palette_translation : NULL, (bpp==8)?1:0, bpp);
-		}
+		anim_instance_decode_frame(ga->ani.instance, ga->buffer, ga->ani.instance->xlate_pal, (bpp==8)?1:0, bpp);
 	}
 	else {
 		//looping back
@@ -453,12 +448,7 @@ void generic_render_ani_stream(generic_anim *ga)
 				mprintf(("previous frame: %d\n", ga->previous_frame));
 		#endif
 		for(i = ga->previous_frame + 1; i <= ga->current_frame; i++) {
-			if(ga->ani.animation->flags & ANF_STREAMED) {
-				ga->ani.instance->file_offset = unpack_frame_from_file(ga->ani.instance, ga->buffer, ga->width * ga->height, (ga->ani.instance->xlate_pal) ? ga->ani.animation->palette_translation : NULL, (bpp==8)?1:0, bpp);
-			}
-			else {
-				ga->ani.instance->data = unpack_frame(ga->ani.instance, ga->ani.instance->data, ga->buffer, ga->width * ga->height, (ga->ani.instance->xlate_pal) ? ga->ani.animation->palette_translation : NULL, (bpp==8)?1:0, bpp);
-			}
+			anim_instance_decode_frame(ga->ani.instance, ga->buffer, ga->ani.instance->xlate_pal, (bpp==8)?1:0, bpp);
 		}
 	}
 	// always go back to screen format
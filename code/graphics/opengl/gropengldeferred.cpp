@@ -592,6 +592,7 @@ void opengl_draw_sphere()
 
 	opengl_bind_vertex_layout(vertex_declare, deferred_light_sphere_vbo, deferred_light_sphere_ibo);
 
+	Gr_draw_calls++;
 	glDrawRangeElements(GL_TRIANGLES, 0, deferred_light_sphere_vcount, deferred_light_sphere_icount, GL_UNSIGNED_SHORT, 0);
 }
 
@@ -607,6 +608,7 @@ void gr_opengl_draw_deferred_light_cylinder(const vec3d *position, const matrix
 
 	opengl_bind_vertex_layout(vertex_declare, deferred_light_cylinder_vbo, deferred_light_cylinder_ibo);
 
+	Gr_draw_calls++;
 	glDrawRangeElements(GL_TRIANGLES, 0, deferred_light_cylinder_vcount, deferred_light_cylinder_icount, GL_UNSIGNED_SHORT, 0);
 
 	g3_done_instance(true);
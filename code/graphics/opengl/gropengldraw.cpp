@@ -749,6 +749,7 @@ void opengl_render_primitives(primitive_type prim_type,
 
 	opengl_bind_vertex_layout(*layout, opengl_buffer_get_id(GL_ARRAY_BUFFER, buffer_handle), 0, byte_offset);
 
+	Gr_draw_calls++;
 	glDrawArrays(opengl_primitive_type(prim_type), (GLint)vert_offset, n_verts);
 }
 
@@ -875,6 +876,7 @@ void gr_opengl_render_rocket_primitives(interface_material* material_info,
 		opengl_buffer_get_id(GL_ARRAY_BUFFER, vertex_buffer),
 		opengl_buffer_get_id(GL_ELEMENT_ARRAY_BUFFER, index_buffer));
 
+	Gr_draw_calls++;
 	glDrawElements(opengl_primitive_type(prim_type), n_indices, GL_UNSIGNED_INT, nullptr);
 
 	gr_end_2d_matrix();
@@ -934,6 +936,7 @@ void gr_opengl_render_decals(decal_material* material_info,
 							  opengl_buffer_get_id(GL_ARRAY_BUFFER, binding.Vbuffer_handle),
 							  opengl_buffer_get_id(GL_ELEMENT_ARRAY_BUFFER, binding.Ibuffer_handle));
 
+	Gr_draw_calls++;
 	glDrawElements(opengl_primitive_type(prim_type), num_elements, GL_UNSIGNED_INT, nullptr);
 }
 
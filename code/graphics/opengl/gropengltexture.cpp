@@ -884,9 +884,15 @@ int opengl_create_texture(int bitmap_handle, int bitmap_type, tcache_slot_opengl
 
 	auto max_levels = bm_get_num_mipmaps(bitmap_handle);
 
+	// Streamed textures only get the mipmap levels they are currently needed with
+	auto stream_level = 0;
+	if ( (bitmap_type != TCACHE_TYPE_AABITMAP) && (bitmap_type != TCACHE_TYPE_INTERFACE) && (bitmap_type != TCACHE_TYPE_CUBEMAP) ) {
+		stream_level = bm_get_resident_base_level(bitmap_handle);
+	}
+
 	auto base_level = 0;
 	auto resize = false;
-	if ( (Detail.hardware_textures < 4) && (bitmap_type != TCACHE_TYPE_AABITMAP) && (bitmap_type != TCACHE_TYPE_INTERFACE)
+	if ( ((Detail.hardware_textures < 4) || (stream_level > 0)) && (bitmap_type != TCACHE_TYPE_AABITMAP) && (bitmap_type != TCACHE_TYPE_INTERFACE)
 		&& (bitmap_type != TCACHE_TYPE_CUBEMAP)
 		&& ((bitmap_type != TCACHE_TYPE_COMPRESSED) || ((bitmap_type == TCACHE_TYPE_COMPRESSED) && (max_levels > 1))) )
 	{
@@ -902,7 +908,7 @@ int opengl_create_texture(int bitmap_handle, int bitmap_type, tcache_slot_opengl
 			resize = true;
 		} else {
 			// we have mipmap levels so use those as a resize point (image should already be power-of-2)
-			base_level = -(Detail.hardware_textures - 4);
+			base_level = std::max(-(Detail.hardware_textures - 4), stream_level);
 			Assert(base_level >= 0);
 
 			if (base_level >= max_levels) {
@@ -923,7 +929,8 @@ int opengl_create_texture(int bitmap_handle, int bitmap_type, tcache_slot_opengl
 	}
 
 	// there should only ever be one mipmap level for interface graphics!!!
-	if ( (bitmap_type == TCACHE_TYPE_INTERFACE) && (max_levels > 1) ) {
+	// aabitmaps only upload their first level either
+	if ( ((bitmap_type == TCACHE_TYPE_INTERFACE) || (bitmap_type == TCACHE_TYPE_AABITMAP)) && (max_levels > 1) ) {
 		max_levels = 1;
 	}
 
@@ -1453,6 +1460,9 @@ void gr_opengl_update_texture(int bitmap_handle, int bpp, const ubyte* data, int
 	if (byte_mult == 1) {
 		texFormat = GL_UNSIGNED_BYTE;
 		glFormat = GL_RED;
+	}
+	// 8 bit data for an 8 bit texture (e.g. the planes of a movie) can be uploaded as it is
+	if (byte_mult == 1 && true_byte_mult > 1) {
 		texmem = (ubyte *) vm_malloc (width*height*byte_mult);
 		ubyte* texmemp = texmem;
 
@@ -596,6 +596,8 @@ void opengl_render_model_program(model_material* material_info, indexed_vertex_s
 		opengl_buffer_get_id(GL_ARRAY_BUFFER, vert_source->Vbuffer_handle),
 		opengl_buffer_get_id(GL_ELEMENT_ARRAY_BUFFER, vert_source->Ibuffer_handle));
 
+	Gr_draw_calls++;
+
 	// If GL_ARB_gpu_shader5 is supprted then the instancing is handled by the geometry shader
 	if (!GLAD_GL_ARB_gpu_shader5 && Rendering_to_shadow_map) {
 		glDrawElementsInstancedBaseVertex(GL_TRIANGLES,
@@ -1,6 +1,7 @@
 
 #include "graphics/render.h"
 
+#include "cmdline/cmdline.h"
 #include "graphics/material.h"
 #include "graphics/matrix.h"
 #include "graphics/paths/PathRenderer.h"
@@ -775,6 +776,158 @@ void endDrawing(graphics::paths::PathRenderer* path) {
 }
 }
 
+namespace {
+// The vertices of the string which is currently drawn from a glyph atlas
+SCP_vector<v4> Atlas_text_verts;
+
+void render_atlas_text(int bitmap, const color* clr, SCP_vector<v4>& verts) {
+	material render_mat;
+	render_mat.set_blend_mode(ALPHA_BLEND_ALPHA_BLEND_ALPHA);
+	render_mat.set_depth_mode(ZBUFFER_TYPE_NONE);
+	render_mat.set_texture_map(TM_BASE_TYPE, bitmap);
+	render_mat.set_color(clr->red, clr->green, clr->blue, clr->alpha);
+	render_mat.set_cull_mode(false);
+	render_mat.set_texture_type(material::TEX_TYPE_AABITMAP);
+
+	vertex_layout vert_def;
+	vert_def.add_vertex_component(vertex_format_data::POSITION2, sizeof(v4), (int) offsetof(v4, x));
+	vert_def.add_vertex_component(vertex_format_data::TEX_COORD2, sizeof(v4), (int) offsetof(v4, u));
+
+	gr_render_primitives_2d_immediate(&render_mat,
+									  PRIM_TYPE_TRIS,
+									  &vert_def,
+									  (int) verts.size(),
+									  verts.data(),
+									  sizeof(v4) * verts.size());
+}
+
+void add_atlas_quad(SCP_vector<v4>& verts, float x1, float y1, float x2, float y2, const font::GlyphQuad& quad) {
+	v4 v;
+
+	v.x = x1; v.y = y1; v.u = quad.u0; v.v = quad.v0;
+	verts.push_back(v);
+	v.x = x1; v.y = y2; v.u = quad.u0; v.v = quad.v1;
+	verts.push_back(v);
+	v.x = x2; v.y = y1; v.u = quad.u1; v.v = quad.v0;
+	verts.push_back(v);
+	v.x = x1; v.y = y2; v.u = quad.u0; v.v = quad.v1;
+	verts.push_back(v);
+	v.x = x2; v.y = y1; v.u = quad.u1; v.v = quad.v0;
+	verts.push_back(v);
+	v.x = x2; v.y = y2; v.u = quad.u1; v.v = quad.v1;
+	verts.push_back(v);
+}
+}
+
+/**
+ * @brief Draws a string of a TrueType font from the glyph atlas of its size
+ *
+ * This places the glyphs on the same pixels NanoVG would but draws the whole string with a single draw call and
+ * reuses the layout of strings which were already drawn in the last frame.
+ *
+ * @return @c false if the string contains something which is not in the atlas, nothing was drawn in that case
+ */
+static bool gr_string_atlas(float sx, float sy, const char* s, size_t length, font::NVGFont* nvgFont, int resize_mode) {
+	using namespace font;
+
+	if (!Unicode_text_mode) {
+		// Special characters come from the old font, the NanoVG path handles those
+		for (size_t i = 0; i < length; ++i) {
+			if (s[i] >= Lcl_special_chars || s[i] < 0) {
+				return false;
+			}
+		}
+	}
+
+	float tx = 0.0f;
+	float ty = 0.0f;
+	float scaleX = 1.0f;
+	float scaleY = 1.0f;
+	bool do_resize = gr_resize_screen_posf(&tx, &ty, &scaleX, &scaleY, resize_mode);
+
+	float offset_x = i2fl((do_resize) ? gr_screen.offset_x_unscaled : gr_screen.offset_x);
+	float offset_y = i2fl((do_resize) ? gr_screen.offset_y_unscaled : gr_screen.offset_y);
+
+	// NanoVG rasterizes the glyphs at the size they have on the screen, see nvg__getFontScale
+	float fontScale = ((int) ((fabsf(scaleX) + fabsf(scaleY)) * 0.5f / 0.01f + 0.5f)) * 0.01f;
+	fontScale = MIN(fontScale, 4.0f);
+	float invscale = 1.0f / fontScale;
+	float invscaleX = 1.f / scaleX;
+
+	float fontSize = nvgFont->getSize() * fontScale;
+	int size = (short) (fontSize * 10.0f);
+	float spacing = nvgFont->getLetterSpacing() * fontScale;
+
+	int bitmap = -1;
+	Atlas_text_verts.clear();
+
+	const char* text = s;
+	size_t textLen = length;
+	float x = 0.0f;
+	float y = 0.0f;
+
+	size_t tokenLength;
+	while ((tokenLength = NVGFont::getTokenLength(text, textLen)) > 0) {
+		textLen -= tokenLength;
+
+		bool doRender = true;
+		if (tokenLength == 1) {
+			switch (*text) {
+				case '\n':
+					doRender = false;
+
+					y += nvgFont->getHeight();
+					x = 0;
+					break;
+				case '\t':
+					doRender = false;
+
+					x += nvgFont->getTabWidth();
+					break;
+				case '\r':
+					doRender = false;
+					break;
+				default:
+					break;
+			}
+		}
+
+		if (doRender) {
+			auto layout = nvgFont->getGlyphLayout(size, spacing, text, tokenLength, &bitmap);
+			if (layout == nullptr) {
+				return false;
+			}
+
+			float penX = x * scaleX * fontScale;
+			float penY = (y + nvgFont->getTopOffset()) * fontScale;
+
+			for (auto& quad : layout->quads) {
+				float x1 = tx + scaleX * (offset_x + sx + (penX + quad.x0) * invscale);
+				float y1 = ty + scaleY * (offset_y + sy + (penY + quad.y0) * invscale);
+				float x2 = tx + scaleX * (offset_x + sx + (penX + quad.x1) * invscale);
+				float y2 = ty + scaleY * (offset_y + sy + (penY + quad.y1) * invscale);
+
+				add_atlas_quad(Atlas_text_verts, roundf(x1), roundf(y1), roundf(x2), roundf(y2), quad);
+			}
+
+			float advance = layout->advance * invscale;
+			x += advance * invscaleX;
+		}
+
+		text = text + tokenLength;
+	}
+
+	if (Atlas_text_verts.empty()) {
+		return true;
+	}
+
+	GR_DEBUG_SCOPE("Render TTF string from atlas");
+
+	render_atlas_text(bitmap, &gr_screen.current_color, Atlas_text_verts);
+
+	return true;
+}
+
 void gr_string(float sx, float sy, const char* s, int resize_mode, int in_length) {
 	if (gr_screen.mode == GR_STUB) {
 		return;
@@ -807,13 +960,17 @@ void gr_string(float sx, float sy, const char* s, int resize_mode, int in_length
 
 		gr_string_old(sx, sy, s, s + length, fontData, fnt->getHeight(), resize_mode);
 	} else if (currentFont->getType() == NVG_FONT) {
+		auto nvgFont = static_cast<NVGFont*>(currentFont);
+
+		if (Cmdline_glyph_atlas && gr_string_atlas(sx, sy, s, length, nvgFont, resize_mode)) {
+			return;
+		}
+
 		GR_DEBUG_SCOPE("Render TTF string");
 
 		auto path = beginDrawing(resize_mode);
 		path->translate(sx, sy);
 
-		auto nvgFont = static_cast<NVGFont*>(currentFont);
-
 		path->fontFaceId(nvgFont->getHandle());
 		path->fontSize(nvgFont->getSize());
 		path->textLetterSpacing(nvgFont->getLetterSpacing());
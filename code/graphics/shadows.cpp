@@ -448,7 +448,7 @@ void shadows_render_all(float fov, matrix *eye_orient, vec3d *eye_pos)
 	matrix light_matrix = shadows_start_render(eye_orient, eye_pos, fov, gr_screen.clip_aspect, std::get<0>(Shadow_distances), std::get<1>(Shadow_distances), std::get<2>(Shadow_distances), std::get<3>(Shadow_distances));
 
 	model_draw_list scene;
-	object *objp = Objects;
+	object *objp = Objects.begin();
 
 	for ( int i = 0; i <= Highest_object_index; i++, objp++ ) {
 		bool cull = true;
@@ -342,6 +342,7 @@ namespace font
 		std::unique_ptr<NVGFont> nvgFont(new NVGFont());
 		nvgFont->setHandle(handle);
 		nvgFont->setSize(fontSize);
+		nvgFont->setFontData(data->data.get(), data->size);
 
 		auto ptr = nvgFont.get();
 
@@ -354,6 +355,17 @@ namespace font
 	{
 	}
 
+	void FontManager::nextFrame()
+	{
+		for (auto& fnt : fonts)
+		{
+			if (fnt->getType() == NVG_FONT)
+			{
+				static_cast<NVGFont*>(fnt.get())->nextFrame();
+			}
+		}
+	}
+
 	void FontManager::close()
 	{
 		allocatedData.clear();
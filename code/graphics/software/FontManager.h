@@ -191,6 +191,11 @@ namespace font {
 		*/
 		static void init();
 
+		/**
+		* @brief Lets the fonts discard cached text layouts which were not used in the last frame
+		*/
+		static void nextFrame();
+
 		/**
 		* @brief Disposes the fonts saved in the class
 		*
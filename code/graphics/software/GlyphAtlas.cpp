@@ -0,0 +1,403 @@
+
+#include "graphics/software/GlyphAtlas.h"
+
+#include "cfile/cfile.h"
+
+#include "graphics/paths/nanovg/stb_truetype.h"
+
+extern "C" {
+#include "graphics/paths/nanovg/fontstash.h"
+}
+
+namespace
+{
+	const uint ATLAS_MAGIC = 0x414C4746; // "FGLA"
+	const int ATLAS_VERSION = 1;
+
+	const int MIN_ATLAS_SIZE = 256;
+	const int MAX_ATLAS_SIZE = 4096;
+
+	const uint MAX_CODEPOINT = 256;
+
+	bool is_atlas_codepoint(uint codepoint)
+	{
+		return (codepoint >= 32 && codepoint < 127) || (codepoint >= 160 && codepoint < MAX_CODEPOINT);
+	}
+
+	template<typename T>
+	void write_value(SCP_vector<ubyte>& out, T value)
+	{
+		auto offset = out.size();
+		out.resize(offset + sizeof(T));
+		memcpy(out.data() + offset, &value, sizeof(T));
+	}
+
+	class atlas_reader
+	{
+		const ubyte* _data;
+		size_t _size;
+		size_t _offset = 0;
+
+	public:
+		atlas_reader(const ubyte* data, size_t size) : _data(data), _size(size) {}
+
+		template<typename T>
+		bool read(T& value)
+		{
+			if (_size - _offset < sizeof(T)) {
+				return false;
+			}
+
+			memcpy(&value, _data + _offset, sizeof(T));
+			_offset += sizeof(T);
+			return true;
+		}
+
+		bool read(ubyte* out, size_t size)
+		{
+			if (_size - _offset < size) {
+				return false;
+			}
+
+			memcpy(out, _data + _offset, size);
+			_offset += size;
+			return true;
+		}
+	};
+}
+
+namespace font
+{
+	bool GlyphAtlas::build(const ubyte* fontData, size_t dataSize, int size)
+	{
+		Assertion(fontData != nullptr, "Invalid font data passed!");
+
+		m_size = size;
+		m_fontChecksum = computeFontChecksum(fontData, dataSize);
+
+		stbtt_fontinfo info;
+		if (!stbtt_InitFont(&info, fontData, 0)) {
+			return false;
+		}
+		m_scale = stbtt_ScaleForPixelHeight(&info, (float)m_size / 10.0f);
+
+		// Start small and grow the atlas until all glyphs fit
+		bool success = false;
+		for (int atlasSize = MIN_ATLAS_SIZE; atlasSize <= MAX_ATLAS_SIZE; atlasSize *= 2) {
+			if (rasterize(fontData, dataSize, atlasSize)) {
+				success = true;
+				break;
+			}
+		}
+
+		if (!success) {
+			m_glyphs.clear();
+			m_pixels.clear();
+			return false;
+		}
+
+		m_kerning.clear();
+		for (auto& first : m_glyphs) {
+			if (first.index < 0) {
+				continue;
+			}
+
+			for (auto& second : m_glyphs) {
+				if (second.index < 0) {
+					continue;
+				}
+
+				auto kerning = stbtt_GetGlyphKernAdvance(&info, first.index, second.index);
+				if (kerning != 0) {
+					m_kerning[((uint)first.index << 16) | (uint)second.index] = kerning;
+				}
+			}
+		}
+
+		return true;
+	}
+
+	bool GlyphAtlas::rasterize(const ubyte* fontData, size_t dataSize, int atlasSize)
+	{
+		FONSparams params;
+		memset(&params, 0, sizeof(params));
+		params.width = atlasSize;
+		params.height = atlasSize;
+		params.flags = FONS_ZERO_TOPLEFT;
+
+		// Without render callbacks fontstash only rasterizes into its memory buffer
+		auto stash = fonsCreateInternal(&params);
+		if (stash == nullptr) {
+			return false;
+		}
+
+		auto handle = fonsAddFontMem(stash, "atlas", const_cast<ubyte*>(fontData), (int)dataSize, 0);
+		if (handle == FONS_INVALID) {
+			fonsDeleteInternal(stash);
+			return false;
+		}
+
+		fonsSetFont(stash, handle);
+		// fontstash truncates the size so this needs to be slightly bigger to end up with the right value
+		fonsSetSize(stash, ((float)m_size + 0.5f) / 10.0f);
+		fonsSetAlign(stash, FONS_ALIGN_LEFT | FONS_ALIGN_BASELINE);
+
+		fonsVertMetrics(stash, &m_ascender, nullptr, nullptr);
+
+		m_glyphs.assign(MAX_CODEPOINT, Glyph());
+
+		bool complete = true;
+		for (uint codepoint = 0; codepoint < MAX_CODEPOINT; ++codepoint) {
+			if (!is_atlas_codepoint(codepoint)) {
+				continue;
+			}
+
+			char text[2];
+			size_t length;
+			if (codepoint < 0x80) {
+				text[0] = (char)codepoint;
+				length = 1;
+			} else {
+				text[0] = (char)(0xC0 | (codepoint >> 6));
+				text[1] = (char)(0x80 | (codepoint & 0x3F));
+				length = 2;
+			}
+
+			FONStextIter iter;
+			FONSquad quad;
+			if (!fonsTextIterInit(stash, &iter, 0.0f, 0.0f, text, text + length) || !fonsTextIterNext(stash, &iter, &quad)
+				|| iter.prevGlyphIndex == -1) {
+				// The atlas is full
+				complete = false;
+				break;
+			}
+
+			auto& glyph = m_glyphs[codepoint];
+			glyph.codepoint = codepoint;
+			glyph.index = iter.prevGlyphIndex;
+			glyph.xoff = (short)quad.x0;
+			glyph.yoff = (short)quad.y0;
+			glyph.x0 = (short)(quad.s0 * atlasSize + 0.5f);
+			glyph.y0 = (short)(quad.t0 * atlasSize + 0.5f);
+			glyph.x1 = (short)(quad.s1 * atlasSize + 0.5f);
+			glyph.y1 = (short)(quad.t1 * atlasSize + 0.5f);
+			glyph.advance = iter.nextx;
+		}
+
+		if (complete) {
+			int width, height;
+			auto data = fonsGetTextureData(stash, &width, &height);
+
+			m_width = width;
+			m_height = height;
+			m_pixels.assign(data, data + width * height);
+		}
+
+		fonsDeleteInternal(stash);
+
+		return complete;
+	}
+
+	const GlyphAtlas::Glyph* GlyphAtlas::findGlyph(uint codepoint) const
+	{
+		if (codepoint >= m_glyphs.size() || m_glyphs[codepoint].index < 0) {
+			return nullptr;
+		}
+
+		return &m_glyphs[codepoint];
+	}
+
+	float GlyphAtlas::getKerning(const Glyph* first, const Glyph* second) const
+	{
+		if (m_kerning.empty()) {
+			return 0.0f;
+		}
+
+		auto it = m_kerning.find(((uint)first->index << 16) | (uint)second->index);
+		if (it == m_kerning.end()) {
+			return 0.0f;
+		}
+
+		return it->second * m_scale;
+	}
+
+	void GlyphAtlas::serialize(SCP_vector<ubyte>& out) const
+	{
+		write_value(out, ATLAS_MAGIC);
+		write_value(out, ATLAS_VERSION);
+		write_value(out, m_size);
+		write_value(out, m_fontChecksum);
+		write_value(out, m_scale);
+		write_value(out, m_ascender);
+		write_value(out, m_width);
+		write_value(out, m_height);
+
+		write_value(out, (uint)getNumGlyphs());
+		for (auto& glyph : m_glyphs) {
+			if (glyph.index < 0) {
+				continue;
+			}
+
+			write_value(out, glyph.codepoint);
+			write_value(out, glyph.index);
+			write_value(out, glyph.xoff);
+			write_value(out, glyph.yoff);
+			write_value(out, glyph.x0);
+			write_value(out, glyph.y0);
+			write_value(out, glyph.x1);
+			write_value(out, glyph.y1);
+			write_value(out, glyph.advance);
+		}
+
+		write_value(out, (uint)m_kerning.size());
+		for (auto& pair : m_kerning) {
+			write_value(out, pair.first);
+			write_value(out, pair.second);
+		}
+
+		out.insert(out.end(), m_pixels.begin(), m_pixels.end());
+	}
+
+	bool GlyphAtlas::deserialize(const ubyte* data, size_t dataSize)
+	{
+		atlas_reader reader(data, dataSize);
+
+		uint magic;
+		int version;
+		if (!reader.read(magic) || magic != ATLAS_MAGIC || !reader.read(version) || version != ATLAS_VERSION) {
+			return false;
+		}
+
+		if (!reader.read(m_size) || !reader.read(m_fontChecksum) || !reader.read(m_scale) || !reader.read(m_ascender)
+			|| !reader.read(m_width) || !reader.read(m_height)) {
+			return false;
+		}
+
+		if (m_width <= 0 || m_width > MAX_ATLAS_SIZE || m_height <= 0 || m_height > MAX_ATLAS_SIZE) {
+			return false;
+		}
+
+		uint numGlyphs;
+		if (!reader.read(numGlyphs)) {
+			return false;
+		}
+
+		m_glyphs.assign(MAX_CODEPOINT, Glyph());
+		for (uint i = 0; i < numGlyphs; ++i) {
+			Glyph glyph;
+			if (!reader.read(glyph.codepoint) || !reader.read(glyph.index) || !reader.read(glyph.xoff)
+				|| !reader.read(glyph.yoff) || !reader.read(glyph.x0) || !reader.read(glyph.y0) || !reader.read(glyph.x1)
+				|| !reader.read(glyph.y1) || !reader.read(glyph.advance)) {
+				return false;
+			}
+
+			if (!is_atlas_codepoint(glyph.codepoint) || glyph.index < 0) {
+				return false;
+			}
+
+			m_glyphs[glyph.codepoint] = glyph;
+		}
+
+		uint numKerningPairs;
+		if (!reader.read(numKerningPairs)) {
+			return false;
+		}
+
+		m_kerning.clear();
+		for (uint i = 0; i < numKerningPairs; ++i) {
+			uint key;
+			int kerning;
+			if (!reader.read(key) || !reader.read(kerning)) {
+				return false;
+			}
+
+			m_kerning[key] = kerning;
+		}
+
+		m_pixels.resize((size_t)m_width * m_height);
+		return reader.read(m_pixels.data(), m_pixels.size());
+	}
+
+	bool GlyphAtlas::layout(const char* text, const char* end, float x, float y, float spacing,
+		SCP_vector<GlyphQuad>& quads, float* advance) const
+	{
+		// This follows fonsTextIterNext and fons__getQuad so the quads end up on the same pixels. Only the rounding error of
+		// the right and bottom edges differs since fontstash computes those from the position in its own atlas.
+		auto invWidth = 1.0f / m_width;
+		auto invHeight = 1.0f / m_height;
+
+		y += m_ascender;
+
+		const Glyph* previous = nullptr;
+		while (text < end) {
+			auto c = (ubyte)*text;
+
+			uint codepoint;
+			if (c < 0x80) {
+				codepoint = c;
+				++text;
+			} else if (c >= 0xC2 && c < 0xE0 && end - text >= 2 && ((ubyte)text[1] & 0xC0) == 0x80) {
+				codepoint = ((c & 0x1Fu) << 6) | ((ubyte)text[1] & 0x3Fu);
+				text += 2;
+			} else {
+				// Everything else is either invalid or not in the atlas
+				return false;
+			}
+
+			auto glyph = findGlyph(codepoint);
+			if (glyph == nullptr) {
+				return false;
+			}
+
+			if (previous != nullptr) {
+				x += getKerning(previous, glyph) + spacing;
+			}
+
+			auto x0 = (float)glyph->x0;
+			auto y0 = (float)glyph->y0;
+			auto x1 = (float)glyph->x1;
+			auto y1 = (float)glyph->y1;
+
+			// Glyphs without pixels (e.g. spaces) only move the pen
+			if (glyph->x1 > glyph->x0 && glyph->y1 > glyph->y0) {
+				GlyphQuad quad;
+				quad.x0 = x + glyph->xoff;
+				quad.y0 = y + glyph->yoff;
+				quad.x1 = quad.x0 + (x1 - x0);
+				quad.y1 = quad.y0 + (y1 - y0);
+				quad.u0 = x0 * invWidth;
+				quad.v0 = y0 * invHeight;
+				quad.u1 = x1 * invWidth;
+				quad.v1 = y1 * invHeight;
+
+				quads.push_back(quad);
+			}
+
+			x += glyph->advance;
+			previous = glyph;
+		}
+
+		if (advance != nullptr) {
+			*advance = x;
+		}
+
+		return true;
+	}
+
+	uint GlyphAtlas::computeFontChecksum(const ubyte* fontData, size_t dataSize)
+	{
+		return cf_add_chksum_long(0, const_cast<ubyte*>(fontData), dataSize);
+	}
+
+	size_t GlyphAtlas::getNumGlyphs() const
+	{
+		size_t count = 0;
+		for (auto& glyph : m_glyphs) {
+			if (glyph.index >= 0) {
+				++count;
+			}
+		}
+
+		return count;
+	}
+}
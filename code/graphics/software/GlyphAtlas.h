@@ -0,0 +1,109 @@
+#pragma once
+
+#include "globalincs/pstypes.h"
+
+namespace font
+{
+	/**
+	 * @brief A quad of a glyph in the coordinate space of the text renderer
+	 */
+	struct GlyphQuad
+	{
+		float x0, y0, x1, y1;
+		float u0, v0, u1, v1;
+	};
+
+	/**
+	 * @brief The pre-rasterized glyphs of a TrueType font at one size
+	 *
+	 * The atlas is built with the same rasterizer and packing code NanoVG uses for its own glyph cache so text laid out
+	 * with an atlas ends up on exactly the same pixels as text drawn by NanoVG. It contains the printable ASCII and
+	 * Latin-1 characters, strings with other characters have to be drawn by NanoVG.
+	 *
+	 * Building an atlas doesn't need a graphics context. The atlas can be serialized so it only needs to be built once.
+	 */
+	class GlyphAtlas
+	{
+	public:
+		struct Glyph
+		{
+			uint codepoint = 0;
+			int index = -1;		//!< The glyph index in the font, -1 if this entry is unused
+			short xoff = 0;		//!< Offset of the quad from the pen position
+			short yoff = 0;
+			short x0 = 0;		//!< The rectangle of the glyph in the atlas
+			short y0 = 0;
+			short x1 = 0;
+			short y1 = 0;
+			float advance = 0.0f;
+		};
+
+	private:
+		int m_size = 0;			//!< The font size times 10, the same value NanoVG uses for identifying a size
+		uint m_fontChecksum = 0;
+		float m_scale = 0.0f;		//!< Scale from font units to pixels
+		float m_ascender = 0.0f;	//!< Distance from the top of a line to the base line
+
+		int m_width = 0;
+		int m_height = 0;
+		SCP_vector<ubyte> m_pixels;
+
+		SCP_vector<Glyph> m_glyphs;	//!< Indexed by code point
+		SCP_unordered_map<uint, int> m_kerning; //!< Kerning in font units, the key is (first glyph << 16) | second glyph
+
+		bool rasterize(const ubyte* fontData, size_t dataSize, int atlasSize);
+
+		const Glyph* findGlyph(uint codepoint) const;
+
+		float getKerning(const Glyph* first, const Glyph* second) const;
+
+	public:
+		/**
+		 * @brief Builds the atlas for a font
+		 *
+		 * @param fontData The TrueType font file
+		 * @param dataSize The size of the font file
+		 * @param size The font size times 10
+		 * @return @c true if the atlas was built, @c false if the font could not be read
+		 */
+		bool build(const ubyte* fontData, size_t dataSize, int size);
+
+		/**
+		 * @brief Writes the atlas to a buffer
+		 */
+		void serialize(SCP_vector<ubyte>& out) const;
+
+		/**
+		 * @brief Reads an atlas written by serialize()
+		 * @return @c false if the data is invalid or was written by a different version of the engine
+		 */
+		bool deserialize(const ubyte* data, size_t dataSize);
+
+		/**
+		 * @brief Lays out a single line of text the way NanoVG would draw it with top left alignment
+		 *
+		 * @param text The UTF-8 text
+		 * @param end The end of the text
+		 * @param x The position of the pen in pixels of the atlas size
+		 * @param y The top of the line in pixels of the atlas size
+		 * @param spacing The additional space between letters in pixels of the atlas size
+		 * @param quads The quads of the glyphs are appended to this
+		 * @param advance The pen position after the text
+		 * @return @c false if the text contains a character which is not in the atlas or is not valid UTF-8
+		 */
+		bool layout(const char* text, const char* end, float x, float y, float spacing, SCP_vector<GlyphQuad>& quads,
+			float* advance) const;
+
+		/**
+		 * @brief Computes the checksum which identifies the font data an atlas was built from
+		 */
+		static uint computeFontChecksum(const ubyte* fontData, size_t dataSize);
+
+		int getSize() const { return m_size; }
+		uint getFontChecksum() const { return m_fontChecksum; }
+		int getWidth() const { return m_width; }
+		int getHeight() const { return m_height; }
+		const SCP_vector<ubyte>& getPixels() const { return m_pixels; }
+		size_t getNumGlyphs() const;
+	};
+}
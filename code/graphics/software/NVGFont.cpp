@@ -2,7 +2,11 @@
 #include "graphics/software/NVGFont.h"
 #include "graphics/paths/PathRenderer.h"
 
+#include "bmpman/bmpman.h"
+#include "cfile/cfile.h"
+#include "cmdline/cmdline.h"
 #include "mod_table/mod_table.h"
+#include "parse/parselo.h"
 
 #include "localization/localize.h"
 
@@ -75,6 +79,20 @@ namespace font
 		return length;
 	}
 
+	bool NVGFont::StringSizeKey::operator==(const StringSizeKey& other) const
+	{
+		return scaleX == other.scaleX && scaleY == other.scaleY && text == other.text;
+	}
+
+	size_t NVGFont::StringSizeKeyHash::operator()(const StringSizeKey& key) const
+	{
+		auto hash = std::hash<SCP_string>()(key.text);
+		hash ^= std::hash<float>()(key.scaleX) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+		hash ^= std::hash<float>()(key.scaleY) + 0x9e3779b9 + (hash << 6) + (hash >> 2);
+
+		return hash;
+	}
+
 	NVGFont::NVGFont() : m_handle(-1), m_letterSpacing(0.0f), m_size(12.0f), m_tabWidth(20.0f)
 	{
 
@@ -82,7 +100,12 @@ namespace font
 
 	NVGFont::~NVGFont()
 	{
-
+		// The atlas bitmaps use the pixels of their atlas so they have to go before the atlas data
+		for (auto& pair : m_atlases) {
+			if (pair.second && bm_is_valid(pair.second->bitmap)) {
+				bm_release(pair.second->bitmap);
+			}
+		}
 	}
 	
 	void NVGFont::setHandle(int handle)
@@ -95,24 +118,170 @@ namespace font
 	{
 		Assertion(size > 0.f, "Invalid size %f passed!", size);
 		m_size = size;
+
+		clearCaches();
 	}
 
 	void NVGFont::setLetterSpacing(float spacing)
 	{
 		Assertion(spacing >= 0.0f, "Invalid letter spacing passed!");
 		m_letterSpacing = spacing;
+
+		clearCaches();
 	}
 
 	void NVGFont::setTabWidth(float tabWidth)
 	{
 		Assertion(tabWidth >= 0.0f, "Invalid tab width passed!");
 		m_tabWidth = tabWidth;
+
+		clearCaches();
 	}
 
 	void NVGFont::setSpecialCharacterFont(font* fontData)
 	{
 		Assertion(fontData != nullptr, "Invalid font data pointer passed!");
 		m_specialCharacters = fontData;
+
+		clearCaches();
+	}
+
+	void NVGFont::setFontData(const ubyte* data, size_t size)
+	{
+		Assertion(data != nullptr, "Invalid font data pointer passed!");
+		m_fontData = data;
+		m_fontDataSize = size;
+	}
+
+	void NVGFont::clearCaches()
+	{
+		for (auto& pair : m_atlases) {
+			if (pair.second) {
+				pair.second->layouts.clear();
+				pair.second->lastLayouts.clear();
+			}
+		}
+
+		m_stringSizes.clear();
+		m_lastStringSizes.clear();
+	}
+
+	void NVGFont::nextFrame()
+	{
+		for (auto& pair : m_atlases) {
+			if (pair.second) {
+				std::swap(pair.second->layouts, pair.second->lastLayouts);
+				pair.second->layouts.clear();
+			}
+		}
+
+		std::swap(m_stringSizes, m_lastStringSizes);
+		m_stringSizes.clear();
+	}
+
+	NVGFont::AtlasData* NVGFont::getAtlas(int size) const
+	{
+		auto it = m_atlases.find(size);
+		if (it != m_atlases.end()) {
+			return it->second.get();
+		}
+
+		// If anything fails this stays empty so the atlas is only built once
+		auto& entry = m_atlases[size];
+
+		if (m_fontData == nullptr) {
+			return nullptr;
+		}
+
+		std::unique_ptr<AtlasData> data(new AtlasData());
+
+		auto checksum = GlyphAtlas::computeFontChecksum(m_fontData, m_fontDataSize);
+
+		SCP_string filename;
+		sprintf(filename, "font_atlas-%08x-%d.bin", checksum, size);
+
+		bool loaded = false;
+		auto fp = cfopen(filename.c_str(), "rb", CFILE_NORMAL, CF_TYPE_CACHE, false,
+		                 CF_LOCATION_ROOT_USER | CF_LOCATION_ROOT_GAME | CF_LOCATION_TYPE_ROOT);
+		if (fp != nullptr) {
+			SCP_vector<ubyte> buffer(static_cast<size_t>(cfilelength(fp)));
+			if (!buffer.empty() && cfread(buffer.data(), static_cast<int>(buffer.size()), 1, fp) == 1) {
+				loaded = data->atlas.deserialize(buffer.data(), buffer.size()) && data->atlas.getSize() == size &&
+				         data->atlas.getFontChecksum() == checksum;
+			}
+			cfclose(fp);
+
+			if (!loaded) {
+				mprintf(("Glyph atlas cache %s is invalid, rebuilding it.\n", filename.c_str()));
+			}
+		}
+
+		if (!loaded) {
+			if (!data->atlas.build(m_fontData, m_fontDataSize, size)) {
+				mprintf(("Failed to build the glyph atlas of font %s at size %.1f.\n", getName().c_str(), size / 10.0f));
+				return nullptr;
+			}
+
+			SCP_vector<ubyte> buffer;
+			data->atlas.serialize(buffer);
+
+			fp = cfopen(filename.c_str(), "wb", CFILE_NORMAL, CF_TYPE_CACHE, false,
+			            CF_LOCATION_ROOT_USER | CF_LOCATION_ROOT_GAME | CF_LOCATION_TYPE_ROOT);
+			if (fp != nullptr) {
+				cfwrite(buffer.data(), static_cast<int>(buffer.size()), 1, fp);
+				cfclose(fp);
+			} else {
+				mprintf(("Could not write glyph atlas cache %s.\n", filename.c_str()));
+			}
+		}
+
+		// bmpman doesn't copy the data so the pixels have to stay alive as long as the font exists
+		auto& pixels = data->atlas.getPixels();
+		data->bitmap = bm_create(8, data->atlas.getWidth(), data->atlas.getHeight(),
+		                         const_cast<ubyte*>(pixels.data()), BMP_AABITMAP);
+		if (data->bitmap < 0) {
+			mprintf(("Could not create the glyph atlas bitmap of font %s.\n", getName().c_str()));
+			return nullptr;
+		}
+
+		entry = std::move(data);
+		return entry.get();
+	}
+
+	const NVGFont::GlyphLayout* NVGFont::getGlyphLayout(int size, float spacing, const char* text, size_t textLen,
+		int* bitmap) const
+	{
+		auto atlasData = getAtlas(size);
+		if (atlasData == nullptr) {
+			return nullptr;
+		}
+
+		*bitmap = atlasData->bitmap;
+
+		SCP_string key(text, textLen);
+
+		auto it = atlasData->layouts.find(key);
+		if (it != atlasData->layouts.end() && it->second.spacing == spacing) {
+			return &it->second;
+		}
+
+		auto& layout = atlasData->layouts[key];
+
+		auto last = atlasData->lastLayouts.find(key);
+		if (last != atlasData->lastLayouts.end() && last->second.spacing == spacing) {
+			layout = std::move(last->second);
+			atlasData->lastLayouts.erase(last);
+			return &layout;
+		}
+
+		layout.spacing = spacing;
+		layout.quads.clear();
+		if (!atlasData->atlas.layout(text, text + textLen, 0.0f, 0.0f, spacing, layout.quads, &layout.advance)) {
+			atlasData->layouts.erase(key);
+			return nullptr;
+		}
+
+		return &layout;
 	}
 	
 	float NVGFont::getTextHeight() const
@@ -122,6 +291,49 @@ namespace font
 
 	extern int get_char_width_old(font* fnt, ubyte c1, ubyte c2, int *width, int* spacing);
 	void NVGFont::getStringSize(const char *text, size_t textLen, int resize_mode, float *width, float *height) const
+	{
+		if (!Cmdline_glyph_atlas)
+		{
+			computeStringSize(text, textLen, resize_mode, width, height);
+			return;
+		}
+
+		// HUD gauges measure the same strings every frame so the sizes of the last two frames are kept around
+		StringSizeKey key;
+		key.text.assign(text, textLen);
+		key.scaleX = 1.0f;
+		key.scaleY = 1.0f;
+
+		if (resize_mode != -1)
+		{
+			gr_resize_screen_posf(nullptr, nullptr, &key.scaleX, &key.scaleY, resize_mode);
+		}
+
+		auto it = m_stringSizes.find(key);
+		if (it == m_stringSizes.end())
+		{
+			auto last = m_lastStringSizes.find(key);
+			if (last != m_lastStringSizes.end())
+			{
+				it = m_stringSizes.insert(std::make_pair(key, last->second)).first;
+			}
+			else
+			{
+				StringSize size;
+				computeStringSize(text, textLen, resize_mode, &size.width, &size.height);
+
+				it = m_stringSizes.insert(std::make_pair(std::move(key), size)).first;
+			}
+		}
+
+		if (width)
+			*width = it->second.width;
+
+		if (height)
+			*height = it->second.height;
+	}
+
+	void NVGFont::computeStringSize(const char *text, size_t textLen, int resize_mode, float *width, float *height) const
 	{
 		using namespace graphics::paths;
 
@@ -246,6 +458,9 @@ namespace font
 
 		_height = m_lineHeight + this->offsetTop + this->offsetBottom;
 
+		m_stringSizes.clear();
+		m_lastStringSizes.clear();
+
 		checkFontMetrics();
 	}
 }
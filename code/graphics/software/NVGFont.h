@@ -2,6 +2,9 @@
 
 #include "globalincs/pstypes.h"
 #include "graphics/software/FSFont.h"
+#include "graphics/software/GlyphAtlas.h"
+
+#include <memory>
 
 namespace font
 {
@@ -18,6 +21,63 @@ namespace font
 
 		float m_lineHeight = 0.0f;
 
+		const ubyte* m_fontData = nullptr;
+		size_t m_fontDataSize = 0;
+
+	public:
+		/**
+		 * @brief A line of text laid out with a glyph atlas
+		 *
+		 * The quads are relative to the pen position at the top of the line, in the pixels of the atlas size.
+		 */
+		struct GlyphLayout
+		{
+			float spacing = 0.0f;
+			float advance = 0.0f;
+			SCP_vector<GlyphQuad> quads;
+		};
+
+	private:
+		struct AtlasData
+		{
+			GlyphAtlas atlas;
+			int bitmap = -1;
+
+			// Layouts used in the current frame and in the last frame, everything older is discarded
+			SCP_unordered_map<SCP_string, GlyphLayout> layouts;
+			SCP_unordered_map<SCP_string, GlyphLayout> lastLayouts;
+		};
+
+		struct StringSizeKey
+		{
+			SCP_string text;
+			float scaleX;
+			float scaleY;
+
+			bool operator==(const StringSizeKey& other) const;
+		};
+		struct StringSizeKeyHash
+		{
+			size_t operator()(const StringSizeKey& key) const;
+		};
+		struct StringSize
+		{
+			float width;
+			float height;
+		};
+
+		// nullptr if the atlas for that size could not be built
+		mutable SCP_unordered_map<int, std::unique_ptr<AtlasData>> m_atlases;
+
+		mutable SCP_unordered_map<StringSizeKey, StringSize, StringSizeKeyHash> m_stringSizes;
+		mutable SCP_unordered_map<StringSizeKey, StringSize, StringSizeKeyHash> m_lastStringSizes;
+
+		AtlasData* getAtlas(int size) const;
+
+		void computeStringSize(const char* text, size_t textLen, int resize_mode, float* width, float* height) const;
+
+		void clearCaches();
+
 	public:
 		NVGFont();
 		~NVGFont() override;
@@ -34,6 +94,32 @@ namespace font
 		void setTabWidth(float tabWidth);
 		void setSpecialCharacterFont(font* fontData);
 
+		/**
+		 * @brief Sets the TrueType data of this font, needed for building glyph atlases
+		 * @warning The data must stay valid as long as this font exists
+		 */
+		void setFontData(const ubyte* data, size_t size);
+
+		/**
+		 * @brief Gets the layout of a line of text from the glyph atlas of the specified size
+		 *
+		 * The atlas is built or loaded from the cache the first time a size is used. Layouts of strings which were
+		 * drawn in the current or the last frame are reused.
+		 *
+		 * @param size The font size times 10 as NanoVG computes it for the current transformation
+		 * @param spacing The letter spacing in pixels of that size
+		 * @param text The text, must not contain line breaks or tabs
+		 * @param textLen The length of the text
+		 * @param bitmap The bitmap handle of the atlas
+		 * @return The layout or @c nullptr if the text can't be drawn with an atlas
+		 */
+		const GlyphLayout* getGlyphLayout(int size, float spacing, const char* text, size_t textLen, int* bitmap) const;
+
+		/**
+		 * @brief Discards the cached layouts and string sizes which were not used since the last frame
+		 */
+		void nextFrame();
+
 		FontType getType() const override { return NVG_FONT; };
 
 		float getTextHeight() const override;
@@ -5400,7 +5400,7 @@ SCP_string hud_get_ship_callsign(const ship *shipp)
 
 	// try to get callsign
 	if (Fred_running) {
-		ship_callsign_text = Fred_callsigns[shipp-Ships];
+		ship_callsign_text = Fred_callsigns[SHIP_INDEX(shipp)];
 	} else {
 		if (shipp->callsign_index >= 0) {
 			ship_callsign_text = mission_parse_lookup_callsign_index(shipp->callsign_index);
@@ -5437,7 +5437,7 @@ SCP_string hud_get_ship_class(const ship *shipp)
 
 	// try to get alt name
 	if (Fred_running) {
-		ship_class_text = Fred_alt_names[shipp-Ships];
+		ship_class_text = Fred_alt_names[SHIP_INDEX(shipp)];
 
 		if (ship_class_text.empty()) {
 			ship_class_text = Ship_info[shipp->ship_info_index].get_display_name();
@@ -26,6 +26,7 @@ static bool Timer_inited = false;
 
 static long double Timer_to_microseconds;
 static long double Timer_to_nanoseconds;
+static double Timer_ticks_to_nanoseconds;
 
 
 static uint64_t Timestamp_offset_from_counter = 0;
@@ -64,6 +65,7 @@ void timer_init()
 		Timer_base_value = SDL_GetPerformanceCounter();
 		Timer_to_nanoseconds = (long double) NANOSECONDS_PER_SECOND / (long double) Timer_perf_counter_freq;
 		Timer_to_microseconds = (long double) MICROSECONDS_PER_SECOND / (long double) Timer_perf_counter_freq;
+		Timer_ticks_to_nanoseconds = (double) NANOSECONDS_PER_SECOND / (double) Timer_perf_counter_freq;
 		Timer_inited = true;
 
 		// set up the config so that timestamps are usable
@@ -129,6 +131,21 @@ std::uint64_t timer_get_nanoseconds()
     return static_cast<uint64_t>(time * Timer_to_nanoseconds);
 }
 
+std::uint64_t timer_get_ticks()
+{
+	return SDL_GetPerformanceCounter();
+}
+
+std::uint64_t timer_ticks_to_nanoseconds(std::uint64_t ticks)
+{
+	// SDL uses a nanosecond counter on most Unix platforms
+	if (Timer_perf_counter_freq == NANOSECONDS_PER_SECOND) {
+		return ticks;
+	}
+
+	return static_cast<uint64_t>(ticks * Timer_ticks_to_nanoseconds);
+}
+
 static uint64_t timestamp_get_raw()
 {
 	uint64_t timestamp_raw;
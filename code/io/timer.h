@@ -103,6 +103,10 @@ extern fix timer_get_approx_seconds();		// Returns time since program started...
 extern int timer_get_milliseconds();		//
 extern std::uint64_t timer_get_microseconds();
 extern std::uint64_t timer_get_nanoseconds();
+// Raw value of the high resolution counter. Cheaper than the functions above since nothing is converted, only the
+// difference of two values is meaningful. Use timer_ticks_to_nanoseconds() to convert such a difference.
+extern std::uint64_t timer_get_ticks();
+extern std::uint64_t timer_ticks_to_nanoseconds(std::uint64_t ticks);
 extern int timer_get_seconds();				// seconds since program started... not accurate, but good for long
 											//     runtimes with second-based timeouts
 
@@ -16,6 +16,7 @@
 #include "globalincs/pstypes.h"
 #include "jpgutils/jpgutils.h"
 #include "cfile/cfile.h"
+#include "bmpman/bm_convert.h"
 #include "bmpman/bmpman.h"
 #include "graphics/2d.h"
 
@@ -234,12 +235,7 @@ int jpeg_read_bitmap(const char *real_filename, ubyte *image_data, ubyte * /*pal
 			// NOTE: assumes only one scanline is being read at a time. If
 			// multiple lines are read this needs updating
 			// also note that this doesn't deal with jpegs that are greyscale
-			JSAMPLE tmp;
-			for (int k = 2; k < size; k += 3) {
-				tmp = buffer[0][k - 2];
-				buffer[0][k - 2] = buffer[0][k];
-				buffer[0][k] = tmp;
-			}
+			bm_swap_red_blue(buffer[0], jpeg_info.output_width, 3);
 
 			memcpy(image_data, *buffer, size);
 			image_data += size;
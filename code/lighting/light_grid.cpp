@@ -0,0 +1,241 @@
+
+#include "lighting/light_grid.h"
+
+#include "lighting/lighting.h"
+#include "math/vecmat.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+// Below this testing every light is cheaper than building the grid
+const size_t GRID_MIN_LIGHTS = 16;
+
+const std::int64_t MAX_CELLS_PER_LIGHT = 27;
+const std::int64_t MAX_QUERY_CELLS = 64;
+
+const std::uint32_t MIN_BUCKETS = 64;
+
+const float MIN_CELL_SIZE = 1.0f;
+
+// Keeps the cell coordinates of far away positions from overflowing
+const float MAX_CELL_COORD = 1000000000.0f;
+
+std::int64_t cell_count(int min_x, int min_y, int min_z, int max_x, int max_y, int max_z)
+{
+	// The extents are widened first since the coordinates may span almost the whole int range
+	auto x = static_cast<std::int64_t>(max_x) - min_x + 1;
+	auto y = static_cast<std::int64_t>(max_y) - min_y + 1;
+	auto z = static_cast<std::int64_t>(max_z) - min_z + 1;
+
+	// Two extents still fit into 64 bits but all three may not
+	auto xy = x * y;
+	if (z > 0 && xy > std::numeric_limits<std::int64_t>::max() / z) {
+		return std::numeric_limits<std::int64_t>::max();
+	}
+	return xy * z;
+}
+
+} // namespace
+
+bool light_affects_sphere(const light& l, const vec3d* pos, float rad)
+{
+	float max_dist_squared = l.radb + rad;
+	max_dist_squared *= max_dist_squared;
+
+	switch (l.type) {
+		case Light_Type::Point: {
+			vec3d to_light;
+			vm_vec_sub(&to_light, &l.vec, pos);
+
+			return vm_vec_mag_squared(&to_light) < max_dist_squared;
+		}
+		case Light_Type::Tube: {
+			vec3d nearest;
+			float dist_squared;
+			vm_vec_dist_squared_to_line(pos, &l.vec, &l.vec2, &nearest, &dist_squared);
+
+			return dist_squared < max_dist_squared;
+		}
+		default:
+			return false;
+	}
+}
+
+int light_grid::cell_coord(float value) const
+{
+	auto coord = std::floor(value / Cell_size);
+	return static_cast<int>(std::max(-MAX_CELL_COORD, std::min(coord, MAX_CELL_COORD)));
+}
+
+std::uint32_t light_grid::bucket(int x, int y, int z) const
+{
+	auto hash = (static_cast<std::uint32_t>(x) * 73856093u) ^ (static_cast<std::uint32_t>(y) * 19349663u) ^
+	            (static_cast<std::uint32_t>(z) * 83492791u);
+	return hash & Bucket_mask;
+}
+
+void light_grid::build(const light* lights, size_t num_lights)
+{
+	Lights = lights;
+	Num_lights = num_lights;
+
+	Bucket_starts.clear();
+	Bucket_lights.clear();
+	Unbounded_lights.clear();
+
+	Use_grid = false;
+	if (num_lights < GRID_MIN_LIGHTS) {
+		return;
+	}
+
+	float total_range = 0.0f;
+	size_t num_point_lights = 0;
+	for (size_t i = 0; i < num_lights; ++i) {
+		if (lights[i].type == Light_Type::Point) {
+			total_range += lights[i].radb;
+			++num_point_lights;
+		}
+	}
+
+	if (num_point_lights == 0) {
+		return;
+	}
+
+	Use_grid = true;
+	Cell_size = std::max(2.0f * total_range / num_point_lights, MIN_CELL_SIZE);
+
+	std::uint32_t num_buckets = MIN_BUCKETS;
+	while (num_buckets < 2 * num_point_lights) {
+		num_buckets *= 2;
+	}
+	Bucket_mask = num_buckets - 1;
+
+	Bucket_starts.assign(num_buckets + 1, 0);
+
+	// The lights are sorted into the buckets in two passes, the first one counts the lights of every bucket
+	for (int pass = 0; pass < 2; ++pass) {
+		for (size_t i = 0; i < num_lights; ++i) {
+			auto& l = lights[i];
+
+			if (l.type == Light_Type::Tube) {
+				if (pass == 0) {
+					Unbounded_lights.push_back(static_cast<std::uint32_t>(i));
+				}
+				continue;
+			} else if (l.type != Light_Type::Point) {
+				continue;
+			}
+
+			auto min_x = cell_coord(l.vec.xyz.x - l.radb);
+			auto min_y = cell_coord(l.vec.xyz.y - l.radb);
+			auto min_z = cell_coord(l.vec.xyz.z - l.radb);
+			auto max_x = cell_coord(l.vec.xyz.x + l.radb);
+			auto max_y = cell_coord(l.vec.xyz.y + l.radb);
+			auto max_z = cell_coord(l.vec.xyz.z + l.radb);
+
+			if (cell_count(min_x, min_y, min_z, max_x, max_y, max_z) > MAX_CELLS_PER_LIGHT) {
+				if (pass == 0) {
+					Unbounded_lights.push_back(static_cast<std::uint32_t>(i));
+				}
+				continue;
+			}
+
+			for (auto x = min_x; x <= max_x; ++x) {
+				for (auto y = min_y; y <= max_y; ++y) {
+					for (auto z = min_z; z <= max_z; ++z) {
+						auto b = bucket(x, y, z);
+						if (pass == 0) {
+							++Bucket_starts[b + 1];
+						} else {
+							Bucket_lights[Bucket_starts[b]++] = static_cast<std::uint32_t>(i);
+						}
+					}
+				}
+			}
+		}
+
+		if (pass == 0) {
+			for (std::uint32_t b = 0; b < num_buckets; ++b) {
+				Bucket_starts[b + 1] += Bucket_starts[b];
+			}
+			Bucket_lights.resize(Bucket_starts[num_buckets]);
+		}
+	}
+
+	// Filling the buckets moved every start to the end of its bucket which is the start of the next one
+	for (auto b = num_buckets; b > 0; --b) {
+		Bucket_starts[b] = Bucket_starts[b - 1];
+	}
+	Bucket_starts[0] = 0;
+
+	Query_marks.assign(num_lights, 0);
+	Query_mark = 0;
+}
+
+size_t light_grid::num_lights() const
+{
+	return Num_lights;
+}
+
+void light_grid::query(const vec3d* pos, float rad, util::FrameVector<size_t>& out)
+{
+	int min_x = 0, min_y = 0, min_z = 0, max_x = 0, max_y = 0, max_z = 0;
+
+	if (Use_grid) {
+		min_x = cell_coord(pos->xyz.x - rad);
+		min_y = cell_coord(pos->xyz.y - rad);
+		min_z = cell_coord(pos->xyz.z - rad);
+		max_x = cell_coord(pos->xyz.x + rad);
+		max_y = cell_coord(pos->xyz.y + rad);
+		max_z = cell_coord(pos->xyz.z + rad);
+	}
+
+	if (!Use_grid || cell_count(min_x, min_y, min_z, max_x, max_y, max_z) > MAX_QUERY_CELLS) {
+		for (size_t i = 0; i < Num_lights; ++i) {
+			if (light_affects_sphere(Lights[i], pos, rad)) {
+				out.push_back(i);
+			}
+		}
+		return;
+	}
+
+	++Query_mark;
+	if (Query_mark == 0) {
+		std::fill(Query_marks.begin(), Query_marks.end(), 0);
+		Query_mark = 1;
+	}
+
+	auto first = out.size();
+
+	for (auto index : Unbounded_lights) {
+		if (light_affects_sphere(Lights[index], pos, rad)) {
+			out.push_back(index);
+		}
+	}
+
+	for (auto x = min_x; x <= max_x; ++x) {
+		for (auto y = min_y; y <= max_y; ++y) {
+			for (auto z = min_z; z <= max_z; ++z) {
+				auto b = bucket(x, y, z);
+
+				for (auto i = Bucket_starts[b]; i < Bucket_starts[b + 1]; ++i) {
+					auto index = Bucket_lights[i];
+					if (Query_marks[index] == Query_mark) {
+						continue;
+					}
+					Query_marks[index] = Query_mark;
+
+					if (light_affects_sphere(Lights[index], pos, rad)) {
+						out.push_back(index);
+					}
+				}
+			}
+		}
+	}
+
+	// Keep the order of testing every light so the same lights are used if there are more than the renderer supports
+	std::sort(out.begin() + first, out.end());
+}
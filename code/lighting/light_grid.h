@@ -0,0 +1,66 @@
+#pragma once
+
+#include "globalincs/pstypes.h"
+#include "utils/FrameArena.h"
+
+struct light;
+
+/**
+ * @brief Checks if a light may affect a sphere
+ *
+ * Directional lights affect everything so they are never included, cone lights are not filtered per object.
+ */
+bool light_affects_sphere(const light& l, const vec3d* pos, float rad);
+
+/**
+ * @brief A spatial hash of the point lights of a scene
+ *
+ * Every point light is stored in the grid cells its range overlaps so finding the lights which affect a sphere only needs
+ * to look at the lights in the cells of that sphere. The cell size follows the average light range of the scene. Lights
+ * which would cover too many cells and tube lights, which are tested against their infinite line, are checked for every
+ * query. Small scenes and very large spheres skip the grid and test all lights.
+ *
+ * The grid is made of frame temporaries so it must be built and used on one thread within a frame.
+ */
+class light_grid
+{
+	float Cell_size = 1.0f;
+	std::uint32_t Bucket_mask = 0;
+
+	util::FrameVector<std::uint32_t> Bucket_starts;
+	util::FrameVector<std::uint32_t> Bucket_lights;
+	util::FrameVector<std::uint32_t> Unbounded_lights;
+
+	// Lights are in more than one cell so every query marks the lights it has seen
+	util::FrameVector<std::uint32_t> Query_marks;
+	std::uint32_t Query_mark = 0;
+
+	const light* Lights = nullptr;
+	size_t Num_lights = 0;
+	bool Use_grid = false;
+
+	int cell_coord(float value) const;
+	std::uint32_t bucket(int x, int y, int z) const;
+
+public:
+	/**
+	 * @brief Indexes the lights of a scene, the lights must stay valid and unchanged while the grid is used
+	 */
+	void build(const light* lights, size_t num_lights);
+
+	/**
+	 * @brief The number of lights the grid was built with
+	 */
+	size_t num_lights() const;
+
+	/**
+	 * @brief Finds the lights which affect a sphere
+	 *
+	 * The result is the same as testing every light with light_affects_sphere.
+	 *
+	 * @param pos The center of the sphere
+	 * @param rad The radius of the sphere
+	 * @param out The indices of the lights are appended to this in ascending order
+	 */
+	void query(const vec3d* pos, float rad, util::FrameVector<size_t>& out);
+};
@@ -12,6 +12,8 @@
 
 #include "globalincs/pstypes.h"
 #include "graphics/color.h"
+#include "lighting/light_grid.h"
+#include "utils/FrameArena.h"
 
 // Light stuff works like this:
 // At the start of the frame, call light_reset.
@@ -62,13 +64,16 @@ struct light_indexing_info
 
 class scene_lights
 {
-	SCP_vector<light> AllLights;
+	util::FrameVector<light> AllLights;
 	
-	SCP_vector<size_t> StaticLightIndices;
+	util::FrameVector<size_t> StaticLightIndices;
 
-	SCP_vector<size_t> FilteredLights;
+	util::FrameVector<size_t> FilteredLights;
 
-	SCP_vector<size_t> BufferedLights;
+	util::FrameVector<size_t> BufferedLights;
+
+	// Built on the first filter after lights were added
+	light_grid Light_grid;
 
 	size_t current_light_index;
 	size_t current_num_lights;
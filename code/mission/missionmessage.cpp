@@ -2325,14 +2325,35 @@ void message_pagein_mission_messages()
 		return;
 	}
 
-	char *sound_filename;
+	if ( !Sound_enabled ) {
+		return;
+	}
 
+	// collect the waves first so that they can be decoded in parallel
+	SCP_vector<int> wave_indices;
 	for (i=Num_builtin_messages; i<Num_messages; i++) {
-		if (Messages[i].wave_info.index != -1) {
-			sound_filename = Message_waves[Messages[i].wave_info.index].name;
-			message_load_wave(Messages[i].wave_info.index, sound_filename);
+		auto index = Messages[i].wave_info.index;
+		if (index != -1 && !Message_waves[index].num.isValid()
+			&& std::find(wave_indices.begin(), wave_indices.end(), index) == wave_indices.end()) {
+			wave_indices.push_back(index);
 		}
 	}
+
+	SCP_vector<game_snd_entry> entries(wave_indices.size());
+	SCP_vector<snd_load_request> requests;
+	for (size_t j = 0; j < wave_indices.size(); ++j) {
+		strcpy_s(entries[j].filename, Message_waves[wave_indices[j]].name);
+		requests.push_back({&entries[j], nullptr});
+	}
+
+	auto ids = snd_load_all(requests);
+	for (size_t j = 0; j < wave_indices.size(); ++j) {
+		auto index = wave_indices[j];
+		Message_waves[index].num = ids[j];
+
+		if (!Message_waves[index].num.isValid())
+			nprintf(("messaging", "Cannot load message wave: %s.  Will not play\n", Message_waves[index].name));
+	}
 }
 
 // ---------------------------------------------------
@@ -6142,7 +6142,7 @@ bool post_process_mission(mission *pm)
 				Warning(LOCATION, "Ship name \"%s\" referenced, but this ship doesn't exist", Parse_names[i]);
 		}
 
-		for (i=0; i<MAX_SHIPS; i++) {
+		for (i=0; i<static_cast<int>(Ships.size()); i++) {
 			if ((Ships[i].objnum >= 0) && (Ships[i].arrival_anchor >= 0) && (Ships[i].arrival_anchor < SPECIAL_ARRIVAL_ANCHOR_FLAG))
 				Ships[i].arrival_anchor = indices[Ships[i].arrival_anchor];
 
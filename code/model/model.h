@@ -960,6 +960,9 @@ void model_free(polymodel* pm);
 void model_free_all();
 void model_instance_free_all();
 
+// Sets how much memory models may use which are kept loaded although the current mission doesn't use them, 0 unloads them right away
+void model_set_retention_budget(size_t bytes);
+
 // Alias to model_load, checks if a pof tech model exists and loads it if specified, otherwise loads the default pof. --wookieejedi
 int model_load(ship_info* sip, bool prefer_tech_model);
 
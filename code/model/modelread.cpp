@@ -39,6 +39,7 @@
 #include "starfield/starfield.h"
 #include "weapon/weapon.h"
 #include "tracing/tracing.h"
+#include "utils/AssetRetention.h"
 
 #include <algorithm>
 #include <stack>
@@ -68,6 +69,14 @@ SCP_vector<bsp_collision_tree> Bsp_collision_tree_list;
 
 static int model_initted = 0;
 
+// models which are kept loaded for later missions although the current mission does not use them
+static util::AssetRetention Model_retention;
+// the models which were loaded when the current page-in started
+static SCP_unordered_set<int> Model_page_in_previous;
+// the models which had to be read from disk during the current page-in and how long that took in microseconds
+static int Model_page_in_loads = 0;
+static std::uint64_t Model_page_in_load_time = 0;
+
 #ifndef NDEBUG
 CFILE *ss_fp = NULL;			// file pointer used to dump subsystem information
 char  model_filename[_MAX_PATH];		// temp used to store filename
@@ -353,6 +362,8 @@ void model_unload(int modelnum, int force)
 
 	mprintf(("Unloading model '%s' from slot '%i'\n", pm->filename, num));
 
+	Model_retention.remove(pm->id);
+
 	// so that the textures can be released
 	pm->used_this_mission = 0;
 
@@ -436,10 +447,35 @@ void model_page_in_start()
 
 	mprintf(( "Starting model page in...\n" ));
 
+	Model_retention.startGeneration();
+	Model_page_in_previous.clear();
+	Model_page_in_loads = 0;
+	Model_page_in_load_time = 0;
+
 	for (i=0; i<MAX_POLYGON_MODELS; i++) {
-		if (Polygon_models[i] != NULL)
+		if (Polygon_models[i] != NULL) {
 			Polygon_models[i]->used_this_mission = 0;
+			Model_page_in_previous.insert(Polygon_models[i]->id);
+		}
+	}
+}
+
+// the memory a model keeps in use while it is loaded, shared textures are counted for every model
+static size_t model_get_retained_size(polymodel *pm)
+{
+	size_t size = (size_t)pm->sldc_size;
+
+	for (int i = 0; i < pm->n_models; i++) {
+		size += (size_t)pm->submodel[i].bsp_data_size;
+	}
+
+	for (int i = 0; i < pm->n_textures; i++) {
+		for (auto& tinfo : pm->maps[i].textures) {
+			size += bm_get_data_size(tinfo.GetTexture());
+		}
 	}
+
+	return size;
 }
 
 void model_page_in_stop()
@@ -450,15 +486,49 @@ void model_page_in_stop()
 
 	mprintf(( "Stopping model page in...\n" ));
 
+	int num_shared = 0;
+
 	for (i=0; i<MAX_POLYGON_MODELS; i++) {
 		if (Polygon_models[i] == NULL)
 			continue;
 
-		if (Polygon_models[i]->used_this_mission)
+		if (Polygon_models[i]->used_this_mission) {
+			if (Model_page_in_previous.count(Polygon_models[i]->id))
+				num_shared++;
+			continue;
+		}
+
+		// keep it around in case one of the next missions needs it again
+		if (Model_retention.getBudget() > 0) {
+			Model_retention.retain(Polygon_models[i]->id, model_get_retained_size(Polygon_models[i]));
 			continue;
+		}
 	
 		model_unload(i);
 	}
+
+	SCP_vector<int> evicted;
+	Model_retention.evict(evicted);
+
+	for (auto id : evicted) {
+		model_unload(id);
+	}
+
+	Model_page_in_previous.clear();
+
+	// compare this between runs with and without -asset_retention
+	mprintf(("Model page in: %d models were loaded from disk in %.1f ms\n", Model_page_in_loads, Model_page_in_load_time / 1000.0));
+
+	if (Model_retention.getBudget() > 0) {
+		auto& stats = Model_retention.getStats();
+		mprintf(("Model page in: %d models shared with the last mission, %d reused from earlier missions, %d retained using %d KB, %d evicted\n",
+			num_shared - (int)stats.reused, (int)stats.reused, (int)stats.num_retained, (int)(stats.retained_bytes / 1024), (int)stats.evictions));
+	}
+}
+
+void model_set_retention_budget(size_t bytes)
+{
+	Model_retention.setBudget(bytes);
 }
 
 void model_init()
@@ -3177,6 +3247,8 @@ int model_load(ship_info* sip, bool prefer_tech_model)
 //returns the number of this model
 int model_load(const  char* filename, int n_subsystems, model_subsystem* subsystems, int ferror, int duplicate)
 {
+	memory::TagScope tag(memory::Tag::Models);
+
 	int i, num;
 	polymodel *pm = NULL;
 
@@ -3190,6 +3262,7 @@ int model_load(const  char* filename, int n_subsystems, model_subsystem* subsyst
 			if (!stricmp(filename , Polygon_models[i]->filename) && !duplicate) {
 				// Model already loaded; just return.
 				Polygon_models[i]->used_this_mission++;
+				Model_retention.markUsed(Polygon_models[i]->id);
 				return Polygon_models[i]->id;
 			}
 		} else if ( num == -1 )	{
@@ -3198,6 +3271,13 @@ int model_load(const  char* filename, int n_subsystems, model_subsystem* subsyst
 		}
 	}
 
+	// No empty slot, make room by dropping a model which is only kept for later missions
+	int retained_id;
+	if ( (num == -1) && Model_retention.evictOldest(retained_id) ) {
+		num = retained_id % MAX_POLYGON_MODELS;
+		model_unload(retained_id);
+	}
+
 	// No empty slot
 	if ( num == -1 )	{
 		Error( LOCATION, "Too many models" );
@@ -3205,6 +3285,7 @@ int model_load(const  char* filename, int n_subsystems, model_subsystem* subsyst
 	}
 
 	TRACE_SCOPE(tracing::LoadModelFile);
+	auto load_start = timer_get_microseconds();
 
 	nprintf(("Model", "Loading model '%s' into slot '%i'\n", filename, num ));
 
@@ -3439,6 +3520,9 @@ int model_load(const  char* filename, int n_subsystems, model_subsystem* subsyst
 	model_set_subsys_path_nums(pm, n_subsystems, subsystems);
 	model_set_bay_path_nums(pm);
 
+	Model_page_in_loads++;
+	Model_page_in_load_time += timer_get_microseconds() - load_start;
+
 	return pm->id;
 }
 
@@ -53,6 +53,9 @@ int model_render_determine_elapsed_time(int objnum, uint flags);
 
 model_batch_buffer TransformBufferHandler;
 
+// The size in pixels of the model that is currently being queued, used to stream in the texture detail it needs
+static float Model_texture_screen_size = 0.0f;
+
 model_render_params::model_render_params() :
 	Model_flags(MR_NORMAL),
 	Debug_flags(0),
@@ -946,6 +949,19 @@ float model_render_determine_depth(int obj_num, int model_num, matrix* orient, v
 	return depth;
 }
 
+static float model_render_determine_screen_size(float radius, float depth)
+{
+	auto tan_half_fov = tanf(Proj_fov * 0.5f);
+
+	// The camera is inside the model so every bit of detail may be visible
+	if (depth <= 0.0f || tan_half_fov <= 0.0f) {
+		return FLT_MAX;
+	}
+
+	// The diameter of the bounding sphere as a fraction of the screen height
+	return radius / (depth * tan_half_fov) * i2fl(gr_screen.max_h);
+}
+
 int model_render_determine_detail(float depth, int  /*obj_num*/, int model_num, matrix*  /*orient*/, vec3d*  /*pos*/, int  /*flags*/, int detail_level_locked)
 {
 	int tmp_detail_level = Game_detail_level;
@@ -1254,6 +1270,12 @@ void model_render_buffers(model_draw_list* scene, model_material *rendering_mate
 			rendering_material->set_texture_map(TM_HEIGHT_TYPE, texture_maps[TM_HEIGHT_TYPE]);
 			rendering_material->set_texture_map(TM_AMBIENT_TYPE, texture_maps[TM_AMBIENT_TYPE]);
 			rendering_material->set_texture_map(TM_MISC_TYPE,	texture_maps[TM_MISC_TYPE]);
+
+			for (auto texture : texture_maps) {
+				if (texture >= 0) {
+					bm_request_texture_size(texture, Model_texture_screen_size);
+				}
+			}
 		}
 
 		scene->add_buffer_draw(rendering_material, &pm->vert_source, buffer, i, tmap_flags);
@@ -2797,6 +2819,8 @@ void model_render_queue(model_render_params* interp, model_draw_list* scene, int
 	float depth = model_render_determine_depth(objnum, model_num, orient, pos, interp->get_detail_level_lock());
 	int detail_level = model_render_determine_detail(depth, objnum, model_num, orient, pos, model_flags, interp->get_detail_level_lock());
 
+	Model_texture_screen_size = model_render_determine_screen_size(pm->rad, depth);
+
 	// If we're rendering attached weapon models, check against the ships' tabled Weapon Model Draw Distance (which defaults to 200)
 	if ( model_flags & MR_ATTACHED_MODEL && shipp != NULL ) {
 		if (depth > Ship_info[shipp->ship_info_index].weapon_model_draw_distance) {
@@ -16,6 +16,7 @@
 #include "model/model.h"
 #include "mission/missionparse.h"
 #include "graphics/util/UniformBuffer.h"
+#include "utils/FrameArena.h"
 
 extern SCP_vector<light> Lights;
 extern int Num_lights;
@@ -244,12 +245,12 @@ class model_draw_list
 	void render_outline(outline_draw &outline_info);
 	void render_buffer(queued_buffer_draw &render_elements);
 	
-	SCP_vector<queued_buffer_draw> Render_elements;
-	SCP_vector<int> Render_keys;
+	util::FrameVector<queued_buffer_draw> Render_elements;
+	util::FrameVector<int> Render_keys;
 
-	SCP_vector<arc_effect> Arcs;
-	SCP_vector<insignia_draw_data> Insignias;
-	SCP_vector<outline_draw> Outlines;
+	util::FrameVector<arc_effect> Arcs;
+	util::FrameVector<insignia_draw_data> Insignias;
+	util::FrameVector<outline_draw> Outlines;
 
 	graphics::util::UniformBuffer _dataBuffer;
 
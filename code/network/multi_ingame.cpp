@@ -984,7 +984,7 @@ void process_ingame_ships_packet( ubyte *data, header *hinfo )
 		Player_ai = NULL;
 
 		// delete all ships
-		for(idx=0; idx<MAX_SHIPS; idx++){
+		for(idx=0; idx<static_cast<int>(Ships.size()); idx++){
 			if((Ships[idx].objnum >= 0) && (Ships[idx].objnum < MAX_OBJECTS)){
 				obj_delete(Ships[idx].objnum);
 			}
@@ -1071,7 +1071,7 @@ void process_ingame_ships_packet( ubyte *data, header *hinfo )
 		obj_merge_created_list();
 
 		// fixup player ship stuff
-		for(idx=0; idx<MAX_SHIPS; idx++){
+		for(idx=0; idx<static_cast<int>(Ships.size()); idx++){
 			if(Ships[idx].objnum < 0){	
 				continue;
 			}
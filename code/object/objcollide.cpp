@@ -15,6 +15,7 @@
 #include "object/objectdock.h"
 #include "ship/ship.h"
 #include "tracing/tracing.h"
+#include "utils/FrameArena.h"
 #include "weapon/beam.h"
 #include "weapon/weapon.h"
 #include "tracing/Monitor.h"
@@ -487,16 +488,17 @@ void crw_check_weapon( int weapon_num, int collide_next_check )
 	weapon *wp = &Weapons[weapon_num];
 
 	// if this weapons life left > time before next collision, then we cannot remove it
-	crw_status[WEAPON_INDEX(wp)] = CRW_IN_PAIR;
+	crw_status[weapon_num] = CRW_IN_PAIR;
 	const float next_check_time = ((float)(timestamp_until(collide_next_check)) / 1000.0f);
 	if ( wp->lifeleft < next_check_time )
-		crw_status[WEAPON_INDEX(wp)] = CRW_CAN_DELETE;
+		crw_status[weapon_num] = CRW_CAN_DELETE;
 }
 
 int collide_remove_weapons( )
 {
 	// setup remove_weapon array.  assume we can remove it.
-	for (int i = 0; i < MAX_WEAPONS; i++ ) {
+	auto num_slots = static_cast<int>(Weapons.size());
+	for (int i = 0; i < num_slots; i++ ) {
 		if ( Weapons[i].objnum == -1 )
 			crw_status[i] = CRW_NO_OBJECT;
 		else
@@ -530,7 +532,7 @@ int collide_remove_weapons( )
 
 	// for each weapon which could be removed, delete the object
 	int num_deleted = 0;
-	for (int i = 0; i < MAX_WEAPONS; i++ ) {
+	for (int i = 0; i < num_slots; i++ ) {
 		if ( crw_status[i] == CRW_CAN_DELETE ) {
 			Assert( Weapons[i].objnum != -1 );
 			obj_delete( Weapons[i].objnum );
@@ -849,6 +851,7 @@ void obj_collide_pair(object *A, object *B)
     uint key = (OBJ_INDEX(A) << 12) + OBJ_INDEX(B);
 
     collider_pair* collision_info = &Collision_cached_pairs[key];
+    Num_pairs++;
 
     if ( collision_info->initialized ) {
         // make sure we're referring to the correct objects in case the original pair was deleted
@@ -959,7 +962,7 @@ void obj_find_overlap_colliders(SCP_vector<int> &overlap_list_out, SCP_vector<in
     TRACE_SCOPE(tracing::FindOverlapColliders);
 
     bool first_not_added = true;
-    SCP_vector<int> overlappers;
+    util::FrameVector<int> overlappers;
 
     for (int in_index : list){
         bool overlapped = false;
@@ -1007,6 +1010,11 @@ static SCP_vector<int> sort_list_z;
 
 void obj_sort_and_collide(SCP_vector<int>* Collision_list)
 {
+	// Only the main collision pass starts a new frame of the pair statistics
+	if (Collision_list == nullptr) {
+		Num_pairs = 0;
+	}
+
 	if (Cmdline_dis_collisions)
 		return;
 
@@ -59,6 +59,9 @@ struct obj_pair	{
 
 extern SCP_vector<int> Collision_sort_list;
 
+// Number of object pairs that were checked for collisions in the current frame
+extern int Num_pairs;
+
 #define COLLISION_OF(a,b) (((a)<<8)|(b))
 
 void set_hit_struct_info(collision_info_struct *hit, mc_info *mc, bool submodel_move_hit);
@@ -68,7 +68,10 @@ object *Player_obj = NULL;
 object *Viewer_obj = NULL;
 
 //Data for objects
-object Objects[MAX_OBJECTS];
+util::ChunkedPool<object> Objects(MAX_OBJECTS);
+
+// The slots from this one on have not been used since obj_init(), the pool grows once they are needed
+static int Object_next_unused = 0;
 
 #ifdef OBJECT_CHECK 
 checkobject CheckObjects[MAX_OBJECTS];
@@ -197,7 +200,7 @@ int free_object_slots(int target_num_used)
 	olind = 0;
 
 	// calc num_already_free by walking the obj_free_list
-	num_already_free = 0;
+	num_already_free = MAX_OBJECTS - Object_next_unused;
 	for ( objp = GET_FIRST(&obj_free_list); objp != END_OF_LIST(&obj_free_list); objp = GET_NEXT(objp) )
 		num_already_free++;
 
@@ -361,24 +364,21 @@ static void on_script_state_destroy(lua_State*) {
  */
 void obj_init()
 {
-	int i;
-	object *objp;
-	
 	Object_inited = 1;
-	for (i = 0; i < MAX_OBJECTS; ++i)
-		Objects[i].clear();
+	// The slots of the last mission are cleared instead of destroyed so handles to their objects see that they are gone,
+	// the first slot always exists since Highest_object_index starts at 0
+	if (Objects.size() == 0)
+		Objects.grow();
+	for (auto& obj : Objects)
+		obj.clear();
 	Viewer_obj = NULL;
 
 	list_init( &obj_free_list );
 	list_init( &obj_used_list );
 	list_init( &obj_create_list );
 
-	// Link all object slots into the free list
-	objp = Objects;
-	for (i=0; i<MAX_OBJECTS; i++)	{
-		list_append(&obj_free_list, objp);
-		objp++;
-	}
+	// The slots are handed out in order before the freed ones are reused from the free list
+	Object_next_unused = 0;
 
 	Object_next_signature = 1;	//0 is invalid, others start at 1
 	Num_objects = 0;
@@ -430,11 +430,22 @@ int obj_allocate(bool essential)
 	}
 
 	// Find next available object
-	objp = GET_FIRST(&obj_free_list);
-	Assert ( objp != &obj_free_list );		// shouldn't have the dummy element
+	if (Object_next_unused < MAX_OBJECTS) {
+		if (Object_next_unused == static_cast<int>(Objects.size())) {
+			auto first = Objects.size();
+			Objects.grow();
+			for (auto i = first; i < Objects.size(); ++i)
+				Objects[i].clear();
+		}
+
+		objp = &Objects[Object_next_unused++];
+	} else {
+		objp = GET_FIRST(&obj_free_list);
+		Assert ( objp != &obj_free_list );		// shouldn't have the dummy element
 
-	// remove objp from the free list
-	list_remove( &obj_free_list, objp );
+		// remove objp from the free list
+		list_remove( &obj_free_list, objp );
+	}
 	
 	// insert objp onto the end of create list
 	list_append( &obj_create_list, objp );
@@ -556,7 +567,7 @@ int obj_create(ubyte type,int parent_obj,int instance, matrix * orient,
 void obj_delete_all() 
 {
 	int counter = 0;
-	for (int i = 0; i < MAX_OBJECTS; ++i) 
+	for (int i = 0; i < static_cast<int>(Objects.size()); ++i) 
 	{
 		if (Objects[i].type == OBJ_NONE)
 			continue;
@@ -1462,7 +1473,7 @@ void obj_move_all(float frametime)
 	TRACE_SCOPE(tracing::MoveObjects);
 
 	object *objp;	
-	SCP_vector<object*> cmeasure_list;
+	util::FrameVector<object*> cmeasure_list;
 	const bool global_cmeasure_timer = (Cmeasures_homing_check > 0);
 
 	Assertion(Cmeasures_homing_check >= 0, "Cmeasures_homing_check is %d in obj_move_all(); it should never be negative. Get a coder!\n", Cmeasures_homing_check);
@@ -1733,7 +1744,7 @@ void obj_queue_render(object* obj, model_draw_list* scene)
 	switch ( obj->type ) {
 	case OBJ_NONE:
 #ifndef NDEBUG
-		mprintf(( "ERROR!!!! Bogus obj " PTRDIFF_T_ARG " is rendering!\n", obj-Objects ));
+		mprintf(( "ERROR!!!! Bogus obj %d is rendering!\n", OBJ_INDEX(obj) ));
 		Int3();
 #endif
 		break;
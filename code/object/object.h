@@ -18,6 +18,7 @@
 #include "object/object.h"
 #include "object/object_flags.h"
 #include "physics/physics.h"
+#include "utils/ChunkedPool.h"
 #include "utils/event.h"
 #include "network/multi_interpolate.h"
 
@@ -167,7 +168,7 @@ private:
 };
 
 extern int Num_objects;
-extern object Objects[];
+extern util::ChunkedPool<object> Objects;
 
 struct object_h {
 	object *objp;
@@ -179,7 +180,7 @@ struct object_h {
 
 	object_h(int objnum)
 	{
-		if (objnum >= 0 && objnum < MAX_OBJECTS)
+		if (objnum >= 0 && objnum < static_cast<int>(Objects.size()))
 		{
 			objp = &Objects[objnum];
 			sig = objp->signature;
@@ -235,8 +236,7 @@ extern object *Player_obj;	// Which object is the player. Has to be valid.
 // Use this instead of "objp - Objects" to get an object number
 // given it's pointer.  This way, we can replace it with a macro
 // to check that the pointer is valid for debugging.
-// This code will break in 64 bit builds when we have more than 2^31 objects but that will probably never happen
-#define OBJ_INDEX(objp) static_cast<int>(objp-Objects)
+#define OBJ_INDEX(objp) Objects.indexOf(objp)
 
 /*
  *		FUNCTIONS
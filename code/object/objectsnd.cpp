@@ -683,7 +683,11 @@ void obj_snd_do_frame()
 			}
 		}
 
-		ds3d_update_buffer(channel, i2fl(gs->min), i2fl(gs->max), &source_pos, &vel);
+		if (ds_is_voice(osp->instance)) {
+			ds_voice_update_3d(osp->instance, i2fl(gs->min), i2fl(gs->max), &source_pos, &vel);
+		} else {
+			ds3d_update_buffer(channel, i2fl(gs->min), i2fl(gs->max), &source_pos, &vel);
+		}
 		snd_get_3d_vol_and_pan(gs, &source_pos, &osp->vol, &osp->pan, add_distance);
 	}	// end for
 
@@ -180,7 +180,7 @@ void obj_render_all(const std::function<void(object*)>& render_function, bool *d
 	int i;
 	float fog_near, fog_far, fog_density;
 
-	objp = Objects;
+	objp = Objects.begin();
 
 	for (i=0;i<=Highest_object_index;i++,objp++) {
 		if ( (objp->type != OBJ_NONE) && (objp->flags[Object::Object_Flags::Renders]) )	{
@@ -301,7 +301,7 @@ void obj_render_queue_all()
 	int i;
 	model_draw_list scene;
 
-	objp = Objects;
+	objp = Objects.begin();
 
 	gr_deferred_lighting_begin(false);
 
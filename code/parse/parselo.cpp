@@ -25,8 +25,10 @@
 #include "ship/ship.h"
 #include "weapon/weapon.h"
 #include "mod_table/mod_table.h"
+#include "io/timer.h"
 
 #include "utils/encoding.h"
+#include "utils/ThreadPool.h"
 #include "utils/unicode.h"
 
 #include <utf8.h>
@@ -59,6 +61,23 @@ SCP_vector<Bookmark> Bookmarks;	// Stack of all our previously paused parsing
 void allocate_parse_text(size_t size);
 static size_t Parse_text_size = 0;
 
+// Modular tables which have already been read and preprocessed ahead of time by parse_modular_table().
+// read_file_text() takes the text from here instead of reading the file again.
+struct preprocessed_file_text {
+	SCP_vector<char> raw_text;
+	SCP_vector<char> processed_text;
+};
+static SCP_unordered_map<SCP_string, preprocessed_file_text> Preprocessed_file_texts;
+
+static SCP_string preprocessed_file_key(const char *filename, int mode)
+{
+	SCP_string key = filename;
+	SCP_tolower(key);
+	key += '|';
+	key += std::to_string(mode);
+	return key;
+}
+
 
 //	Return true if this character is white space, else false.
 int is_white_space(char ch)
@@ -2063,6 +2082,21 @@ void read_file_text(const char *filename, int mode, char *processed_text, char *
 		Error(LOCATION, "ERROR: Neither processed_text nor raw_text may be NULL when parsing is paused!!\n");
 	}
 
+	// maybe the text was already read and processed ahead of time
+	if ((processed_text == nullptr) && (raw_text == nullptr) && !Preprocessed_file_texts.empty()) {
+		auto iter = Preprocessed_file_texts.find(preprocessed_file_key(filename, mode));
+		if (iter != Preprocessed_file_texts.end()) {
+			const auto& preprocessed = iter->second;
+
+			allocate_parse_text(std::max(preprocessed.raw_text.size(), preprocessed.processed_text.size()));
+			memcpy(Parse_text_raw, preprocessed.raw_text.data(), preprocessed.raw_text.size());
+			memcpy(Parse_text, preprocessed.processed_text.data(), preprocessed.processed_text.size());
+
+			Preprocessed_file_texts.erase(iter);
+			return;
+		}
+	}
+
 	// read the raw text
 	read_raw_file_text(filename, mode, raw_text);
 
@@ -4311,6 +4345,50 @@ void parse_string_map(SCP_map<SCP_string, SCP_string>& outMap, const char* end_m
 	required_string(end_marker);
 }
 
+// Reads the specified files and strips their comments ahead of time. Reading has to happen on this thread since
+// cfile is not thread safe but the text processing of all the files is distributed across the worker threads.
+static void preprocess_file_texts(const SCP_vector<SCP_string> &filenames, int path_type)
+{
+	// read_raw_file_text() uses the global parse buffers, which may not be touched while parsing is paused
+	if (!Bookmarks.empty() || filenames.size() < 2) {
+		return;
+	}
+
+	auto start_time = timer_get_microseconds();
+
+	SCP_vector<preprocessed_file_text*> pending;
+	pending.reserve(filenames.size());
+
+	for (const auto &filename : filenames) {
+		try {
+			read_raw_file_text(filename.c_str(), path_type);
+		} catch (const parse::ParseException &) {
+			// The parse callback will report the error when it tries to read the file
+			continue;
+		}
+
+		auto &entry = Preprocessed_file_texts[preprocessed_file_key(filename.c_str(), path_type)];
+
+		// include the terminating null character
+		auto raw_len = strlen(Parse_text_raw) + 1;
+		entry.raw_text.assign(Parse_text_raw, Parse_text_raw + raw_len);
+
+		// Stripping comments never increases the length of the text but converting foreign characters may
+		auto processed_len = (Unicode_text_mode ? raw_len - 1 : get_converted_string_length(Parse_text_raw)) + 1;
+		entry.processed_text.assign(processed_len, '\0');
+
+		pending.push_back(&entry);
+	}
+
+	util::parallel_for(0, pending.size(), [&pending](size_t i) {
+		auto entry = pending[i];
+		process_raw_file_text(entry->processed_text.data(), entry->raw_text.data());
+	});
+
+	mprintf(("TBM  =>  Preprocessed " SIZE_T_ARG " files in %.3f ms\n", pending.size(),
+		(timer_get_microseconds() - start_time) / 1000.0));
+}
+
 // parse a modular table of type "name_check" and parse it using the specified function callback
 int parse_modular_table(const char *name_check, void (*parse_callback)(const char *filename), int path_type, int sort_type)
 {
@@ -4328,14 +4406,22 @@ int parse_modular_table(const char *name_check, void (*parse_callback)(const cha
 
 	const auto ext = strrchr(name_check, '.');
 
-	for (i = 0; i < num_files; i++){
-		if (ext != nullptr) {
-			tbl_file_names[i] += ext;
+	if (ext != nullptr) {
+		for (auto &tbl_file_name : tbl_file_names) {
+			tbl_file_name += ext;
 		}
+	}
+
+	preprocess_file_texts(tbl_file_names, path_type);
+
+	for (i = 0; i < num_files; i++){
 		mprintf(("TBM  =>  Starting parse of '%s' ...\n", tbl_file_names[i].c_str()));
 		(*parse_callback)(tbl_file_names[i].c_str());
 	}
 
+	// Discard anything that was not requested by the callback
+	Preprocessed_file_texts.clear();
+
 	Parsing_modular_table = false;
 
 	return num_files;
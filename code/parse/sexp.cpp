@@ -32482,7 +32482,7 @@ std::pair<int, sexp_src> query_referenced_in_sexp(sexp_ref_type  /*type*/, const
 	node = n;
 
 	// so we know it's being used somewhere..  Time to find out where..
-	for (i=0; i<MAX_SHIPS; i++)
+	for (i=0; i<static_cast<int>(Ships.size()); i++)
 		if (Ships[i].objnum >= 0) {
 			if (query_node_in_sexp(n, Ships[i].arrival_cue)){
 				return std::make_pair(i, sexp_src::SHIP_ARRIVAL);
@@ -233,12 +233,15 @@ namespace particle
 			return;
 		}
 
+		memory::TagScope tag(memory::Tag::Particles);
 		Particles.push_back(part);
 	}
 
 	// Creates a single particle. See the PARTICLE_?? defines for types.
 	WeakParticlePtr createPersistent(particle_info* pinfo)
 	{
+		memory::TagScope tag(memory::Tag::Particles);
+
 		ParticlePtr new_particle = std::make_shared<particle>();
 
 		if (!init_particle(new_particle.get(), pinfo)) {
@@ -394,6 +397,11 @@ namespace particle
 		Persistent_particles.clear();
 	}
 
+	size_t get_num_particles()
+	{
+		return Particles.size() + Persistent_particles.size();
+	}
+
 	/**
 	 * @brief Renders a single particle
 	 * @param part The particle to render
@@ -38,6 +38,9 @@ namespace particle
 	// kill all active particles
 	void kill_all();
 
+	// The number of active particles
+	size_t get_num_particles();
+
 
 	//============================================================================
 	//=============== LOW-LEVEL SINGLE PARTICLE CREATION CODE ====================
@@ -632,35 +632,32 @@ void HudGaugeRadarDradis::doBeeps()
 	bool arrival_happened = false;
 	bool stealth_arrival_happened = false;
 	
-	for (int i = 0; i < MAX_SHIPS; i++)
+	for (auto so : list_range(&Ship_obj_list))
 	{
-		ship * shipp = &Ships[i];
+		ship * shipp = &Ships[Objects[so->objnum].instance];
 
-		if (shipp->objnum >= 0)
+		if (shipp->radar_visible_since >= 0 || shipp->radar_last_contact >= 0)
 		{
-			if (shipp->radar_visible_since >= 0 || shipp->radar_last_contact >= 0)
+			if (shipp->radar_visible_since == Missiontime)
 			{
-				if (shipp->radar_visible_since == Missiontime)
+				if (shipp->radar_current_status == DISTORTED)
 				{
-					if (shipp->radar_current_status == DISTORTED)
-					{
-						stealth_arrival_happened = true;
-					}
-					else
-					{
-						arrival_happened = true;
-					}
+					stealth_arrival_happened = true;
 				}
-				else if (shipp->radar_visible_since < 0 && shipp->radar_last_contact == Missiontime)
+				else
 				{
-					if (shipp->radar_last_status == DISTORTED)
-					{
-						stealth_departure_happened = true;
-					}
-					else
-					{
-						departure_happened = true;
-					}
+					arrival_happened = true;
+				}
+			}
+			else if (shipp->radar_visible_since < 0 && shipp->radar_last_contact == Missiontime)
+			{
+				if (shipp->radar_last_status == DISTORTED)
+				{
+					stealth_departure_happened = true;
+				}
+				else
+				{
+					departure_happened = true;
 				}
 			}
 		}
@@ -9,6 +9,7 @@
 #include "scripting/api/objs/tracing_category.h"
 #include "scripting/scripting.h"
 #include "scripting/hook_api.h"
+#include "scripting/lua_profiler.h"
 
 extern int cache_condition(ConditionalType type, const SCP_string& value);
 
@@ -159,6 +160,53 @@ ADE_FUNC(createTracingCategory,
 	return ade_set_args(L, "o", l_TracingCategory.Set(tracing::Category(name, gpu_category)));
 }
 
+ADE_FUNC(startLuaProfiler,
+	l_Engine,
+	"[number sampleInterval = 1000]",
+	"Starts the sampling Lua profiler. Every <i>sampleInterval</i> Lua instructions the current call stack is recorded "
+	"and attributed to the hook that is currently running. Higher intervals reduce the overhead of the profiler but "
+	"also its accuracy. Any previously collected samples are discarded.",
+	"boolean",
+	"true if the profiler was started, false if it was already running")
+{
+	int interval = profiler::DEFAULT_SAMPLE_INTERVAL;
+	if (!ade_get_args(L, "|i", &interval)) {
+		return ADE_RETURN_FALSE;
+	}
+
+	if (interval < 1) {
+		LuaError(L, "Sample interval must be at least 1, got %d!", interval);
+		return ADE_RETURN_FALSE;
+	}
+
+	// Always profile the main state so that hooks and coroutines are attributed correctly
+	return ade_set_args(L, "b", profiler::start(Script_system.GetLuaSession(), interval));
+}
+
+ADE_FUNC(stopLuaProfiler,
+	l_Engine,
+	"[string filename = \"lua_profile.folded\"]",
+	"Stops the Lua profiler and writes the collected samples to the specified file in the data directory. The file "
+	"uses the folded stacks format which can be turned into a flame graph by common tools like flamegraph.pl or "
+	"speedscope. A per-hook summary is written to the log.",
+	"boolean",
+	"true if the profiler was running and the output was written, false otherwise")
+{
+	const char* filename = "lua_profile.folded";
+	if (!ade_get_args(L, "|s", &filename)) {
+		return ADE_RETURN_FALSE;
+	}
+
+	if (!profiler::is_running()) {
+		return ADE_RETURN_FALSE;
+	}
+
+	profiler::stop();
+	profiler::print_summary();
+
+	return ade_set_args(L, "b", profiler::write_folded(filename));
+}
+
 ADE_FUNC(restartLog,
 	l_Engine,
 	"","Closes and reopens the fs2_open.log",nullptr,nullptr)
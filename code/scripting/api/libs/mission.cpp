@@ -432,7 +432,7 @@ ADE_INDEXER(l_Mission_Ships, "number/string IndexOrName", "Gets ship", "ship", "
 
 		int objnum = -1;
 		if (idx > 0)
-			objnum = object_subclass_at_index(Ships, MAX_SHIPS, idx);
+			objnum = object_subclass_at_index(Ships, Ships.size(), idx);
 
 		return ade_set_args(L, "o", l_Ship.Set(object_h(objnum)));
 	}
@@ -445,7 +445,7 @@ ADE_FUNC(__len, l_Mission_Ships, NULL,
 		 "number",
 		 "Number of ships in the mission, or 0 if ships haven't been initialized yet")
 {
-	return ade_set_args(L, "i", object_subclass_count(Ships, MAX_SHIPS));
+	return ade_set_args(L, "i", object_subclass_count(Ships, Ships.size()));
 }
 
 //****SUBLIBRARY: Mission/ParsedShips
@@ -576,13 +576,13 @@ ADE_INDEXER(l_Mission_Weapons, "number Index", "Gets handle to a weapon object i
 
 	int objnum = -1;
 	if (idx > 0)
-		objnum = object_subclass_at_index(Weapons, MAX_WEAPONS, idx);
+		objnum = object_subclass_at_index(Weapons, Weapons.size(), idx);
 
 	return ade_set_args(L, "o", l_Weapon.Set(object_h(objnum)));
 }
 ADE_FUNC(__len, l_Mission_Weapons, NULL, "Number of weapon objects in mission. Note that this is only accurate for one frame.", "number", "Number of weapon objects in mission")
 {
-	return ade_set_args(L, "i", object_subclass_count(Weapons, MAX_WEAPONS));
+	return ade_set_args(L, "i", object_subclass_count(Weapons, Weapons.size()));
 }
 
 //****SUBLIBRARY: Mission/Beams
@@ -2391,7 +2391,7 @@ ADE_FUNC(waitAsync,
 		}
 		void setResolver(Resolver resolver) override
 		{
-			// Keep checking the time until the timestamp is elapsed
+			// The executor holds this back until the timestamp has elapsed
 			auto self = shared_from_this();
 			auto cb = [this, self, resolver](
 						  executor::IExecutionContext::State contextState) {
@@ -2401,18 +2401,16 @@ ADE_FUNC(waitAsync,
 					return executor::Executor::CallbackResult::Done;
 				}
 
-				if (timestamp_elapsed(m_timestamp)) {
-					nprintf(("scripting", "waitAsync: Timestamp has elapsed for asynchronous context %d.\n", m_unique_id));
-					resolver(false, luacpp::LuaValueList());
-					return executor::Executor::CallbackResult::Done;
-				}
-
-				return executor::Executor::CallbackResult::Reschedule;
+				nprintf(("scripting", "waitAsync: Timestamp has elapsed for asynchronous context %d.\n", m_unique_id));
+				resolver(false, luacpp::LuaValueList());
+				return executor::Executor::CallbackResult::Done;
 			};
 
-			// Use an game state execution context here to clean up references to this as soon as possible
-			executor::OnSimulationExecutor->post(
-				executor::runInContext(executor::GameStateExecutionContext::captureContext(), std::move(cb)));
+			// Use an game state execution context here so a game state change does not resolve the promise normally.
+			// The executor watches the context as well so that a game state change aborts the wait right away.
+			auto context = executor::GameStateExecutionContext::captureContext();
+			executor::OnSimulationExecutor->postAt(TIMESTAMP(m_timestamp),
+				executor::runInContext(context, std::move(cb)), context);
 		}
 
 	  private:
@@ -143,7 +143,7 @@ sound_handle sound_h::getSignature()
 	return sig;
 }
 bool sound_h::IsSoundValid() {
-	if (!sig.isValid() || ds_get_channel(sig) < 0)
+	if (!sig.isValid() || (ds_get_channel(sig) < 0 && !ds_is_voice(sig)))
 		return false;
 
 	return true;
@@ -152,7 +152,7 @@ bool sound_h::IsValid() {
 	if(!sound_entry_h::IsValid())
 		return false;
 
-	if (!sig.isValid() || ds_get_channel(sig) < 0)
+	if (!sig.isValid() || (ds_get_channel(sig) < 0 && !ds_is_voice(sig)))
 		return false;
 
 	return true;
@@ -94,6 +94,8 @@ const char* ScriptStateReferenceName = "SCP_ScriptState";
 // *************************Housekeeping*************************
 
 static void *vm_lua_alloc(void*, void *ptr, size_t, size_t nsize) {
+	memory::TagScope tag(memory::Tag::Scripting);
+
 	if (nsize == 0)
 	{
 		vm_free(ptr);
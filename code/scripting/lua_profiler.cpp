@@ -0,0 +1,255 @@
+
+#include "scripting/lua_profiler.h"
+
+#include "cfile/cfile.h"
+#include "io/timer.h"
+#include "parse/parselo.h"
+#include "scripting/hook_api.h"
+#include "scripting/lua/LuaHeaders.h"
+
+#include <cinttypes>
+
+namespace {
+
+// Limits the amount of work done for a single sample in case a script recursed very deeply
+const int MAX_STACK_DEPTH = 64;
+
+const char* const NO_HOOK_NAME = "<no hook>";
+
+struct hook_timing {
+	std::uint64_t calls = 0;
+	std::uint64_t total_ns = 0;
+	std::uint64_t samples = 0;
+};
+
+lua_State* profiled_state = nullptr;
+int current_interval = scripting::profiler::DEFAULT_SAMPLE_INTERVAL;
+
+// Maps the folded stack string to the number of samples taken with that stack
+SCP_unordered_map<SCP_string, std::uint64_t> folded_samples;
+SCP_unordered_map<SCP_string, hook_timing> hook_timings;
+std::uint64_t total_samples = 0;
+
+// The hooks which are currently executing, outermost first
+SCP_vector<const char*> hook_stack;
+SCP_unordered_map<int, SCP_string> hook_names;
+
+// Reused between samples to avoid allocating for every sample
+SCP_string sample_buffer;
+SCP_vector<SCP_string> frame_buffer;
+
+void append_sanitized(SCP_string& out, const char* str)
+{
+	// ';' separates frames and the last space separates the count so those may not appear in the frame names
+	for (auto c = str; *c != '\0'; ++c) {
+		if (*c == ';') {
+			out += ':';
+		} else if (*c == '\n' || *c == '\r') {
+			out += ' ';
+		} else {
+			out += *c;
+		}
+	}
+}
+
+void format_frame(SCP_string& out, const lua_Debug& frame)
+{
+	out.clear();
+
+	if (frame.what != nullptr && !strcmp(frame.what, "C")) {
+		out += "[C] ";
+		append_sanitized(out, frame.name != nullptr ? frame.name : "<unknown>");
+		return;
+	}
+
+	if (frame.what != nullptr && !strcmp(frame.what, "main")) {
+		out += "<main chunk>";
+	} else {
+		append_sanitized(out, frame.name != nullptr ? frame.name : "<anonymous>");
+	}
+
+	out += " (";
+	append_sanitized(out, frame.short_src);
+	out += ":";
+	out += std::to_string(frame.linedefined);
+	out += ")";
+}
+
+void sample_hook(lua_State* L, lua_Debug* /*ar*/)
+{
+	// Coroutines which were created while the profiler ran still have their own copy of the hook
+	if (profiled_state == nullptr) {
+		lua_sethook(L, nullptr, 0, 0);
+		return;
+	}
+
+	lua_Debug frame;
+	int depth = 0;
+	while (depth < MAX_STACK_DEPTH && lua_getstack(L, depth, &frame)) {
+		if (frame_buffer.size() <= static_cast<size_t>(depth)) {
+			frame_buffer.emplace_back();
+		}
+
+		lua_getinfo(L, "Sn", &frame);
+		format_frame(frame_buffer[depth], frame);
+		++depth;
+	}
+
+	const char* hook_name = hook_stack.empty() ? NO_HOOK_NAME : hook_stack.front();
+
+	sample_buffer.clear();
+	append_sanitized(sample_buffer, hook_name);
+	// Lua returns the innermost frame first but flame graphs expect the root to be first
+	for (int i = depth - 1; i >= 0; --i) {
+		sample_buffer += ';';
+		sample_buffer += frame_buffer[i];
+	}
+
+	++folded_samples[sample_buffer];
+	++hook_timings[hook_name].samples;
+	++total_samples;
+}
+
+const char* get_hook_name(int hook_id)
+{
+	auto iter = hook_names.find(hook_id);
+	if (iter != hook_names.end()) {
+		return iter->second.c_str();
+	}
+
+	SCP_string name;
+	for (const auto& hook : scripting::getHooks()) {
+		if (hook->getHookId() == hook_id) {
+			name = hook->getHookName();
+			break;
+		}
+	}
+	if (name.empty()) {
+		sprintf(name, "<hook %d>", hook_id);
+	}
+
+	return hook_names.emplace(hook_id, std::move(name)).first->second.c_str();
+}
+
+} // namespace
+
+namespace scripting {
+namespace profiler {
+
+bool start(lua_State* L, int sample_interval)
+{
+	Assertion(L != nullptr, "Invalid Lua state passed to profiler!");
+
+	if (profiled_state != nullptr) {
+		return false;
+	}
+
+	if (sample_interval < 1) {
+		sample_interval = 1;
+	}
+
+	folded_samples.clear();
+	hook_timings.clear();
+	total_samples = 0;
+
+	profiled_state = L;
+	current_interval = sample_interval;
+
+	// Coroutines created after this point inherit the hook from this state
+	lua_sethook(L, sample_hook, LUA_MASKCOUNT, sample_interval);
+
+	mprintf(("LUA: Profiler started with a sample interval of %d instructions.\n", sample_interval));
+	return true;
+}
+
+void stop()
+{
+	if (profiled_state == nullptr) {
+		return;
+	}
+
+	lua_sethook(profiled_state, nullptr, 0, 0);
+	profiled_state = nullptr;
+
+	mprintf(("LUA: Profiler stopped after collecting %" PRIu64 " samples.\n", total_samples));
+}
+
+bool is_running(lua_State* L)
+{
+	if (L == nullptr) {
+		return profiled_state != nullptr;
+	}
+	return profiled_state == L;
+}
+
+bool write_folded(const char* filename)
+{
+	auto fp = cfopen(filename, "wt", CFILE_NORMAL, CF_TYPE_DATA);
+	if (fp == nullptr) {
+		mprintf(("LUA: Failed to open profiler output file '%s'!\n", filename));
+		return false;
+	}
+
+	SCP_string line;
+	for (const auto& entry : folded_samples) {
+		line = entry.first;
+		line += ' ';
+		line += std::to_string(entry.second);
+		line += '\n';
+		cfputs(line.c_str(), fp);
+	}
+
+	cfclose(fp);
+
+	mprintf(("LUA: Wrote " SIZE_T_ARG " distinct stacks to profiler output file '%s'.\n", folded_samples.size(), filename));
+	return true;
+}
+
+void print_summary()
+{
+	SCP_vector<std::pair<SCP_string, hook_timing>> sorted(hook_timings.begin(), hook_timings.end());
+	std::sort(sorted.begin(), sorted.end(), [](const std::pair<SCP_string, hook_timing>& left,
+												const std::pair<SCP_string, hook_timing>& right) {
+		return left.second.total_ns > right.second.total_ns;
+	});
+
+	mprintf(("LUA: Profiler summary (%" PRIu64 " samples every %d instructions):\n", total_samples, current_interval));
+	for (const auto& entry : sorted) {
+		const auto& timing = entry.second;
+		mprintf(("LUA:   %-40s %8" PRIu64 " calls %10.3f ms total %8.4f ms avg %8" PRIu64 " samples\n",
+			entry.first.c_str(),
+			timing.calls,
+			timing.total_ns / 1000000.0,
+			timing.calls > 0 ? (timing.total_ns / 1000000.0) / timing.calls : 0.0,
+			timing.samples));
+	}
+}
+
+HookScope::HookScope(int hook_id) : HookScope(profiled_state != nullptr ? get_hook_name(hook_id) : nullptr) {}
+
+HookScope::HookScope(const char* name)
+{
+	if (profiled_state == nullptr || name == nullptr) {
+		return;
+	}
+
+	hook_stack.push_back(name);
+	_active = true;
+	_start = timer_get_nanoseconds();
+}
+
+HookScope::~HookScope()
+{
+	if (!_active) {
+		return;
+	}
+
+	auto& timing = hook_timings[hook_stack.back()];
+	++timing.calls;
+	timing.total_ns += timer_get_nanoseconds() - _start;
+
+	hook_stack.pop_back();
+}
+
+} // namespace profiler
+} // namespace scripting
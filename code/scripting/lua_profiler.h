@@ -0,0 +1,83 @@
+#pragma once
+
+#include "globalincs/pstypes.h"
+
+struct lua_State;
+
+/** @file
+ *  A sampling profiler for the Lua scripts run by the engine.
+ *
+ *  The profiler installs a count hook into the Lua VM which fires every N VM instructions. Each time it fires the
+ *  current Lua call stack is captured and attributed to the engine hook that is currently being executed. The
+ *  collected samples can be written out in the "folded stacks" format which is understood by the common flame graph
+ *  tools (e.g. flamegraph.pl or speedscope).
+ */
+
+namespace scripting {
+namespace profiler {
+
+/**
+ * @brief The default number of Lua VM instructions between two samples
+ */
+const int DEFAULT_SAMPLE_INTERVAL = 1000;
+
+/**
+ * @brief Starts profiling the specified Lua state
+ *
+ * Any previously collected samples are discarded.
+ *
+ * @param L The Lua state to profile
+ * @param sample_interval The number of VM instructions between two samples. Higher values reduce the overhead.
+ * @return @c true if the profiler was started, @c false if it was already running
+ */
+bool start(lua_State* L, int sample_interval = DEFAULT_SAMPLE_INTERVAL);
+
+/**
+ * @brief Stops the profiler and removes the debug hook from the Lua state
+ *
+ * The collected samples are kept until the profiler is started again so that they can still be written out.
+ */
+void stop();
+
+/**
+ * @brief Checks if the profiler is currently collecting samples
+ *
+ * @param L If specified, only returns true if this specific state is being profiled
+ */
+bool is_running(lua_State* L = nullptr);
+
+/**
+ * @brief Writes the collected samples to a file in the folded stacks format
+ *
+ * Each line has the form "hook;frame;frame;... count" with the outermost frame first.
+ *
+ * @param filename The name of the file. It will be placed in the data directory.
+ * @return @c true if the file was written successfully
+ */
+bool write_folded(const char* filename);
+
+/**
+ * @brief Prints a short summary of the collected data to the log
+ */
+void print_summary();
+
+/**
+ * @brief Attributes the Lua code executed while this object is alive to the specified engine hook
+ *
+ * Also measures the wall time spent in the hook. This does nothing if the profiler is not running.
+ */
+class HookScope {
+	bool _active = false;
+	std::uint64_t _start = 0;
+
+  public:
+	explicit HookScope(int hook_id);
+	explicit HookScope(const char* name);
+	~HookScope();
+
+	HookScope(const HookScope&) = delete;
+	HookScope& operator=(const HookScope&) = delete;
+};
+
+} // namespace profiler
+} // namespace scripting
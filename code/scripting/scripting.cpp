@@ -19,6 +19,7 @@
 #include "scripting/doc_html.h"
 #include "scripting/doc_json.h"
 #include "scripting/global_hooks.h"
+#include "scripting/lua_profiler.h"
 #include "scripting/scripting_doc.h"
 #include "ship/ship.h"
 #include "tracing/tracing.h"
@@ -402,6 +403,7 @@ void script_state::UnloadImages()
 int script_state::RunCondition(int action_type, linb::any local_condition_data)
 {
 	TRACE_SCOPE(tracing::LuaHooks);
+	scripting::profiler::HookScope profile_scope(action_type);
 	int num = 0;
 
 	if (LuaState == nullptr) {
@@ -427,6 +429,7 @@ int script_state::RunCondition(int action_type, linb::any local_condition_data)
 
 bool script_state::IsConditionOverride(int action_type, linb::any local_condition_data)
 {
+	scripting::profiler::HookScope profile_scope(action_type);
 	auto action_it = ConditionalHooks.find(action_type);
 	if (action_it == ConditionalHooks.end())
 		return false;
@@ -451,6 +454,10 @@ void script_state::Clear()
 	AssayActions();
 
 	if (LuaState != nullptr) {
+		if (scripting::profiler::is_running(LuaState)) {
+			scripting::profiler::stop();
+		}
+
 		OnStateDestroy(LuaState);
 
 		lua_close(LuaState);
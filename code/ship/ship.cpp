@@ -130,7 +130,7 @@ int	Ship_auto_repair = 1;		// flag to indicate auto-repair of subsystem should o
 
 int	Num_wings = 0;
 int	Num_reinforcements = 0;
-ship	Ships[MAX_SHIPS];
+util::ChunkedPool<ship> Ships(MAX_SHIPS);
 
 ship	*Player_ship;
 int		*Player_cockpit_textures;
@@ -6107,11 +6107,12 @@ void ship_level_init()
 	// Reset everything between levels
 	Ships_exited.clear(); 
 	Ships_exited.reserve(100);
-	for (i=0; i<MAX_SHIPS; i++ )
+	for (i=0; i<static_cast<int>(Ships.size()); i++ )
 	{
 		Ships[i].ship_name[0] = '\0';
 		Ships[i].objnum = -1;
 	}
+	Ships.freeAll();
 
 	Num_wings = 0;
 	for (i = 0; i < MAX_WINGS; i++ )
@@ -8151,6 +8152,8 @@ void ship_delete( object * obj )
 		if (shipp->weapons.primary_bank_external_model_instance[i] >= 0)
 			model_delete_instance(shipp->weapons.primary_bank_external_model_instance[i]);
 	}
+
+	Ships.free(num);
 }
 
 /**
@@ -10519,13 +10522,8 @@ int ship_create(matrix* orient, vec3d* pos, int ship_type, const char* ship_name
 		}
 	}
 
-	for (n=0; n<MAX_SHIPS; n++){
-		if (Ships[n].objnum == -1){
-			break;
-		}
-	}
-
-	if (n == MAX_SHIPS){
+	n = Ships.allocate();
+	if (n < 0){
 		return -1;
 	}
 
@@ -10983,11 +10981,11 @@ void change_ship_type(int n, int ship_type, int by_sexp)
 			}
 		}
 
-		for (i = 0; i < MAX_WEAPONS; i++) {
-			if (Weapons[i].objnum == -1) {
+		for (auto weapon_idx : Weapons.usedIndices()) {
+			if (Weapons[weapon_idx].objnum == -1) {
 				continue;
 			}
-			weapon* wp = &Weapons[i];
+			weapon* wp = &Weapons[weapon_idx];
 			if (wp->homing_subsys && wp->homing_subsys->parent_objnum == objnum) {
 				homing_matches.push_back(wp);
 			}
@@ -11156,6 +11154,7 @@ void change_ship_type(int n, int ship_type, int by_sexp)
 	// point to new ship data
 	ship_model_change(n, ship_type);
 	sp->ship_info_index = ship_type;
+	turret_target_index_invalidate();
 
 	// create new model instance data
 	// note: this is needed for both subsystem stuff and submodel animation stuff
@@ -14246,7 +14245,7 @@ int ship_name_lookup(const char *name, int inc_players)
 {
 	Assertion(name != nullptr, "NULL name passed to ship_name_lookup");
 
-	for (int i=0; i<MAX_SHIPS; i++){
+	for (auto i : Ships.usedIndices()){
 		if (Ships[i].objnum >= 0){
 			if (Objects[Ships[i].objnum].type == OBJ_SHIP || (Objects[Ships[i].objnum].type == OBJ_START && inc_players)){
 				if (!stricmp(name, Ships[i].ship_name)){
@@ -15447,7 +15446,7 @@ void ship_close()
 {
 	int i;
 
-	for (i=0; i<MAX_SHIPS; i++ )	{
+	for (i=0; i<static_cast<int>(Ships.size()); i++ )	{
 		ship *shipp = &Ships[i];
 
 		if (shipp->ship_replacement_textures != NULL) {
@@ -17759,7 +17758,7 @@ void ship_page_in()
 	}
 	
 	// Mark any ships in the mission as used
-	for (i = 0; i < MAX_SHIPS; i++)	{
+	for (i = 0; i < static_cast<int>(Ships.size()); i++)	{
 		if (Ships[i].objnum < 0)
 			continue;
 	
@@ -18012,7 +18011,7 @@ void ship_page_in()
 	}
 
 	// page in replacement textures - Goober5000
-	for (i = 0; i < MAX_SHIPS; i++)
+	for (i = 0; i < static_cast<int>(Ships.size()); i++)
 	{
 		// is this a valid ship?
 		if (Ships[i].objnum >= 0)
@@ -27,6 +27,7 @@
 #include "radar/radarsetup.h"
 #include "render/3d.h"
 #include "species_defs/species_defs.h"
+#include "utils/ChunkedPool.h"
 #include "weapon/shockwave.h"
 #include "weapon/trails.h"
 #include "ship/ship_flags.h"
@@ -535,7 +536,7 @@ private:
 class ship
 {
 public:
-	int	objnum;
+	int	objnum = -1;		// -1 if this slot is unused
 	int	ai_index;			// Index in Ai_info of ai_info associated with this ship.
 	int	ship_info_index;	// Index in ship_info for this ship
 	int	hotkey;
@@ -1497,7 +1498,7 @@ extern flag_def_list_new<Model::Subsystem_Flags> Subsystem_flags[];
 extern const size_t Num_subsystem_flags;
 
 extern int Num_wings;
-extern ship Ships[MAX_SHIPS];
+extern util::ChunkedPool<ship> Ships;
 extern ship	*Player_ship;
 extern int	*Player_cockpit_textures;
 
@@ -1626,7 +1627,7 @@ extern SCP_vector<wing_formation> Wing_formations;
 // Use the below macros when you want to find the index of an array element in the
 // Wings[] or Ships[] arrays.
 #define WING_INDEX(wingp) ((int)(wingp-Wings))
-#define SHIP_INDEX(shipp) ((int)(shipp-Ships))
+#define SHIP_INDEX(shipp) Ships.indexOf(shipp)
 
 
 extern void ship_init();				// called once	at game start
@@ -19,11 +19,18 @@
 #include "sound/sound.h"
 #include "sound/openal.h"
 #include "gamesnd/eventmusic.h"
+#include "tracing/Monitor.h"
+#include "utils/SpscQueue.h"
 
 #ifdef WITH_FFMPEG
 #include "sound/ffmpeg/FFmpegWaveFile.h"
 #endif
 
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
+#include <thread>
+
 #define MAX_STREAM_BUFFERS 4
 
 // status
@@ -32,16 +39,7 @@
 
 // constants
 #define BIGBUF_SIZE					176400
-ubyte *Wavedata_load_buffer = NULL;		// buffer used for cueing audiostreams
-ubyte *Wavedata_service_buffer = NULL;	// buffer used for servicing audiostreams
-
-SDL_mutex* Global_service_lock;
-
-typedef bool (*TIMERCALLBACK)(ptr_u);
-
-#define COMPRESSED_BUFFER_SIZE	176400
-ubyte *Compressed_buffer = NULL;				// Used to load in compressed data during a cueing interval
-ubyte *Compressed_service_buffer = NULL;	// Used to read in compressed data during a service interval
+ubyte *Wavedata_buffer = NULL;		// buffer used for cueing and servicing audiostreams, only used by the streaming thread
 
 // Globalize the list of audio extensions for use in several sound related files
 const char *audio_ext_list[] = { ".ogg", ".wav" };
@@ -79,70 +77,121 @@ static std::unique_ptr<sound::IAudioFile> openAudioMem(const uint8_t* snddata, s
 
 int Audiostream_inited = 0;
 
-class Timer
-{
-public:
-	void constructor();
-	void destructor();
-	bool Create (uint nPeriod, uint nRes, ptr_u dwUser, TIMERCALLBACK pfnCallback);
-protected:
-	static uint TimeProc(uint interval, void *param);
-	TIMERCALLBACK m_pfnCallback;
-	ptr_u m_dwUser;
-	uint m_nPeriod;
-	uint m_nRes;
-	SDL_TimerID m_nIDTimer;
+namespace {
+
+/*
+ * All decoding and buffer handling happens on a dedicated streaming thread. The game thread never touches an
+ * AudioStream after it was opened, it only sends commands to the streaming thread and keeps its own view of the state
+ * of every stream which is updated from the status reports of the streaming thread. Both directions use lock free
+ * queues so the game thread never has to wait for a slow disk read or decoder.
+ */
+
+enum class stream_command_type {
+	Open,
+	Play,
+	Stop,
+	StopAndRewind,
+	SetVolume,
+	SetSampleCutoff,
+	FadeAndDestroy,
+	Destroy,
+};
+
+struct stream_command {
+	stream_command_type type = stream_command_type::Destroy;
+	int stream = -1;
+
+	// Open
+	sound::IAudioFile* file = nullptr; // ownership is passed to the streaming thread
+	int stream_type = ASF_NONE;
+	uint generation = 0;
+	uint buffer_size = 0;
+	ALuint source_id = 0;
+	ALuint buffer_ids[MAX_STREAM_BUFFERS] = {};
+
+	// Play and SetVolume
+	float volume = 0.0f;
+	// Play
+	int looping = 0;
+	// Stop
+	int paused = 0;
+	// SetSampleCutoff
+	uint sample_cutoff = 0;
+};
+
+// The state of a stream as seen by the streaming thread
+struct stream_status {
+	int stream = -1;
+	uint generation = 0;
+
+	// The number of commands which were processed, see audio_stream_slot
+	uint state_commands = 0;
+	uint volume_commands = 0;
+
+	bool destroyed = false;
+	bool playing = false;
+	bool paused = false;
+	bool cued = false;
+	bool past_limit = false;
+	float volume = 0.0f;
+	uint samples_committed = 0;
+
+	bool operator==(const stream_status& other) const
+	{
+		return stream == other.stream && generation == other.generation && state_commands == other.state_commands &&
+		       volume_commands == other.volume_commands && destroyed == other.destroyed && playing == other.playing &&
+		       paused == other.paused && cued == other.cued && past_limit == other.past_limit &&
+		       volume == other.volume && samples_committed == other.samples_committed;
+	}
+	bool operator!=(const stream_status& other) const { return !(*this == other); }
 };
 
+// How often the streaming thread checks the streams if it isn't woken up by a command
+const int STREAM_SERVICE_INTERVAL = 50;	// in msec
+
+const size_t STREAM_QUEUE_SIZE = 256;
+
+} // namespace
+
 class AudioStream
 {
 public:
-	AudioStream ();
-	~AudioStream ();
-	bool Create (char *pszFilename);
-	bool CreateMem (const uint8_t* snddata, size_t snd_len);
-	bool Destroy ();
+	void Open(const stream_command& cmd);
+	void Destroy();
 	void Play (float volume, int looping);
-	bool Is_Playing(){ return m_fPlaying; }
-	bool Is_Paused(){ return m_bIsPaused; }
-	bool Is_Past_Limit() { return m_bPastLimit; }
 	void Stop (int paused = 0);
 	void Stop_and_Rewind ();
 	void Fade_and_Destroy ();
 	void Fade_and_Stop();
 	void	Set_Volume(float vol);
-	float	Get_Volume();
-	double  Get_Duration();
 	void	Init_Data();
 	void	Set_Sample_Cutoff(uint sample_cutoff);
-	void	Set_Default_Volume(float vol) { m_lDefaultVolume = vol; }
-	float	Get_Default_Volume() { return m_lDefaultVolume; }
-	uint	Get_Samples_Committed();
-	int	Is_looping() { return m_bLooping; }
-	int	status;
-	int	type;
-	bool paused_via_sexp_or_script;
+	bool	ServiceBuffer ();
+	stream_status Get_Status();
+
+	bool	active;			// the stream is open on the streaming thread
+	int		stream_index;
+	uint	generation;		// changes every time this stream is opened
+	uint	state_commands;
+	uint	volume_commands;
+	bool	status_sent;	// the last status was handed to the game thread
+	stream_status last_status;
 
 protected:
-	bool prepareOpened(const char *filename);
 	void Cue ();
 	bool WriteWaveData (uint cbSize, uint *num_bytes_written, int service = 1);
 	uint GetMaxWriteSize ();
-	bool ServiceBuffer ();
-	static bool TimerCallback (ptr_u dwUser);
 	bool PlaybackDone();
 
 	ALuint m_source_id;	// name of openAL source
 	ALuint m_buffer_ids[MAX_STREAM_BUFFERS];	// names of buffers
 
-	Timer m_timer;			// ptr to Timer object
 	std::unique_ptr<sound::IAudioFile> m_pwavefile;	// ptr to WaveFile object
 	sound::AudioFileProperties m_fileProps;
 	bool m_fCued;			// semaphore (stream cued)
 	bool m_fPlaying;		// semaphore (stream playing)
 	uint m_cbBufOffset;		// last write position
 	uint m_cbBufSize;		// size of sound buffer in bytes
-	uint m_nBufService;		// service interval in msec
 	uint m_nTimeStarted;	// time (in system time) playback started
 
 	bool	m_bLooping;				// whether or not to loop playback
@@ -154,80 +203,43 @@ protected:
 	bool	m_bReadingDone;			// no more bytes to be read from disk, still have remaining buffer to play
 	uint	m_fade_timer_id;		// timestamp so we know when to start fade
 	uint	m_finished_id;			// timestamp so we know when we've played #bytes required
+	uint	m_next_fade_step;		// timestamp of the next volume reduction while fading
 	bool	m_bPastLimit;			// flag to show we've played past the number of bytes requred
-	float	m_lDefaultVolume;
 
 	size_t m_total_uncompressed_bytes_read;
 	size_t m_max_uncompressed_bytes_to_read;
-
-	SDL_mutex* write_lock;
-
 };
 
+// Files of destroyed streams which didn't fit into Stream_closed_files yet, only used by the streaming thread
+static SCP_vector<sound::IAudioFile*> Stream_files_to_close;
+
+// What the game thread knows about a stream
+struct audio_stream_slot {
+	int	status = ASF_FREE;
+	int	type = ASF_NONE;
+	bool paused_via_sexp_or_script = false;
+	float default_volume = 1.0f;
+
+	uint generation = 0;
+
+	// Commands which change the playback state or the volume are counted. A status report of the streaming thread
+	// only replaces the state set here once it has processed all of these commands, otherwise an older report could
+	// undo a change the game thread just made.
+	uint state_commands = 0;
+	uint volume_commands = 0;
+
+	bool playing = false;
+	bool paused = false;
+	bool cued = false;
+	bool looping = false;
+	bool past_limit = false;
+	float volume = 1.0f;
+	uint samples_committed = 0;
+
+	double duration = 0.0;
+	size_t sram = 0;
+};
 
-// Timer class implementation
-//
-////////////////////////////////////////////////////////////
-
-// constructor
-void Timer::constructor(void)
-{
-	m_nIDTimer = 0;
-}
-
-
-// Destructor
-void Timer::destructor(void)
-{
-	if (m_nIDTimer) {
-		SDL_RemoveTimer(m_nIDTimer);
-		m_nIDTimer = 0;
-	}
-}
-
-// Create
-bool Timer::Create (uint nPeriod, uint nRes, ptr_u dwUser, TIMERCALLBACK pfnCallback)
-{
-	bool bRtn = true;	// assume success
-
-	Assert(pfnCallback);
-	Assert(nPeriod > 10);
-	Assert(nPeriod >= nRes);
-
-	m_nPeriod = nPeriod;
-	m_nRes = nRes;
-	m_dwUser = dwUser;
-	m_pfnCallback = pfnCallback;
-
-	if ((m_nIDTimer = SDL_AddTimer(m_nPeriod, TimeProc, (void*)this)) == 0) {
-	  bRtn = false;
-	}
-
-	return (bRtn);
-}
-
-
-// Timer proc for multimedia timer callback set with timeSetTime().
-//
-// Calls procedure specified when Timer object was created. The 
-// dwUser parameter contains "this" pointer for associated Timer object.
-// 
-uint Timer::TimeProc(uint interval, void *dwUser)
-{
-	// dwUser contains ptr to Timer object
-	Timer * ptimer = (Timer *) dwUser;
-
-	// Call user-specified callback and pass back user specified data
-	(ptimer->m_pfnCallback) (ptimer->m_dwUser);
-
-	if (ptimer->m_nPeriod) {
-		return interval;
-	} else {
-		SDL_RemoveTimer(ptimer->m_nIDTimer);
-		ptimer->m_nIDTimer = 0;
-		return 0;
-	}
-}
 
 //
 // AudioStream class implementation
@@ -237,16 +249,16 @@ uint Timer::TimeProc(uint interval, void *dwUser)
 // The following constants are the defaults for our streaming buffer operation.
 const ushort DefBufferServiceInterval = 250;  // default buffer service interval in msec
 
-// Constructor
-AudioStream::AudioStream (void) : m_total_uncompressed_bytes_read(0), m_max_uncompressed_bytes_to_read(0)
+static uint audiostream_buffer_size(const sound::AudioFileProperties& props)
 {
-	write_lock = SDL_CreateMutex();
-}
+	uint size = (props.sample_rate * props.bytes_per_sample * props.num_channels) >> 2;
+	// make sure that we are a multiple of the frame size
+	size -= (size % (props.bytes_per_sample * props.num_channels));
+	size += (size % 12) << 1;
+	// if the requested buffer size is too big then cap it
+	size = (size > BIGBUF_SIZE) ? BIGBUF_SIZE : size;
 
-// Destructor
-AudioStream::~AudioStream (void)
-{
-	SDL_DestroyMutex( write_lock );
+	return size;
 }
 
 void AudioStream::Init_Data ()
@@ -255,6 +267,7 @@ void AudioStream::Init_Data ()
 	m_bFade = false;
 	m_fade_timer_id = 0;
 	m_finished_id = 0;
+	m_next_fade_step = 0;
 	m_bPastLimit = false;
 	
 	m_bDestroy_when_faded = false;
@@ -267,7 +280,6 @@ void AudioStream::Init_Data ()
 	m_fPlaying = m_fCued = false;
 	m_cbBufOffset = 0;
 	m_cbBufSize = 0;
-	m_nBufService = DefBufferServiceInterval;
 	m_nTimeStarted = 0;
 
 	memset(m_buffer_ids, 0, sizeof(m_buffer_ids));
@@ -275,107 +287,40 @@ void AudioStream::Init_Data ()
 
 	m_total_uncompressed_bytes_read = 0;
 	m_max_uncompressed_bytes_to_read = std::numeric_limits<size_t>::max();
-}
-
-
-bool AudioStream::prepareOpened(const char *filename)
-{
-	bool fRtn = true;
-
-	m_fileProps = m_pwavefile->getFileProperties();
-
-	m_cbBufSize = (m_fileProps.sample_rate * m_fileProps.bytes_per_sample * m_fileProps.num_channels) >> 2;
-	// make sure that we are a multiple of the frame size
-	m_cbBufSize -= (m_cbBufSize % (m_fileProps.bytes_per_sample * m_fileProps.num_channels));
-	m_cbBufSize += (m_cbBufSize % 12) << 1;
-	// if the requested buffer size is too big then cap it
-	m_cbBufSize = (m_cbBufSize > BIGBUF_SIZE) ? BIGBUF_SIZE : m_cbBufSize;
-
-	//				nprintf(("SOUND", "SOUND => Stream buffer created using %d bytes\n", m_cbBufSize));
 
-	OpenAL_ErrorCheck( alGenSources(1, &m_source_id), { fRtn = false; goto ErrorExit; } );
-
-	OpenAL_ErrorCheck( alGenBuffers(MAX_STREAM_BUFFERS, m_buffer_ids), { fRtn = false; goto ErrorExit; } );
-
-	OpenAL_ErrorPrint( alSourcef(m_source_id, AL_ROLLOFF_FACTOR, 1.0f) );
-	OpenAL_ErrorPrint( alSourcei(m_source_id, AL_SOURCE_RELATIVE, AL_TRUE) );
-
-	OpenAL_ErrorPrint( alSource3f(m_source_id, AL_POSITION, 0.0f, 0.0f, 0.0f) );
-	OpenAL_ErrorPrint( alSource3f(m_source_id, AL_VELOCITY, 0.0f, 0.0f, 0.0f) );
-
-	OpenAL_ErrorPrint( alSourcef(m_source_id, AL_GAIN, 1.0f) );
-	OpenAL_ErrorPrint( alSourcef(m_source_id, AL_PITCH, 1.0f) );
-
-	// maybe set EFX
-	if ( (type == ASF_SOUNDFX) && ds_eax_is_inited() ) {
-		extern ALuint AL_EFX_aux_id;
-		OpenAL_ErrorPrint( alSource3i(m_source_id, AL_AUXILIARY_SEND_FILTER, AL_EFX_aux_id, 0, AL_FILTER_NULL) );
-	}
-
-	Snd_sram += (m_cbBufSize * MAX_STREAM_BUFFERS);
-
-ErrorExit:
-	if ( (fRtn == false) && (m_pwavefile) ) {
-		mprintf(("AUDIOSTR => ErrorExit for ::prepareOpened() on wave file: %s\n", filename));
-
-		if (m_source_id)
-			OpenAL_ErrorPrint( alDeleteSources(1, &m_source_id) );
-
-		m_pwavefile = nullptr;
-	}
-
-	return fRtn;
+	active = false;
 }
 
-// Create
-bool AudioStream::Create (char *pszFilename)
+// Open
+//
+// Takes over the file and the OpenAL objects which were created by the game thread and fills the buffers so
+// that the stream can start right away once it is played.
+void AudioStream::Open(const stream_command& cmd)
 {
-	Assert(pszFilename);
-
 	Init_Data();
 
-	if ( ! pszFilename )
-		return false;
-	// make 100% sure we got a good filename
-	if ( !strlen(pszFilename) )
-		return false;
+	generation = cmd.generation;
 
-	// Create a new WaveFile object and open it
-	m_pwavefile = openAudioFile(pszFilename, (type == ASF_EVENTMUSIC));
-	if (m_pwavefile) {
-		return prepareOpened(pszFilename);
-	}
-	else {
-		// Error, unable to create WaveFile object
-		nprintf(("Sound", "SOUND => Failed to open wave file %s\n", pszFilename));
-		return false;
-	}
+	m_pwavefile.reset(cmd.file);
+	m_fileProps = m_pwavefile->getFileProperties();
+	m_cbBufSize = cmd.buffer_size;
 
-}
+	m_source_id = cmd.source_id;
+	memcpy(m_buffer_ids, cmd.buffer_ids, sizeof(m_buffer_ids));
 
-bool AudioStream::CreateMem (const uint8_t* snddata, size_t snd_len)
-{
-	Init_Data();
-	
-	// Create a new WaveFile object and open it
-	m_pwavefile = openAudioMem(snddata, snd_len);
-	if (m_pwavefile) {
-		return prepareOpened("in-memory");
-	}
-	else {
-		// Error, unable to create WaveFile object
-		nprintf(("Sound", "SOUND => Failed to open in-memory wave file \n"));
-		return false;
-	}
+	active = true;
+
+	Cue();
 }
 
 // Destroy
-bool AudioStream::Destroy (void)
+void AudioStream::Destroy (void)
 {
-	bool fRtn = true;
 	ALint buffers_processed = 0;
 
-	SDL_LockMutex(write_lock);
+	if ( !active ) {
+		return;
+	}
 
 	// Stop playback
 	Stop ();
@@ -392,16 +337,10 @@ bool AudioStream::Destroy (void)
 	OpenAL_ErrorPrint( alDeleteSources(1, &m_source_id) );
 	OpenAL_ErrorPrint( alDeleteBuffers(MAX_STREAM_BUFFERS, m_buffer_ids) );
 
-	Snd_sram -= (m_cbBufSize * MAX_STREAM_BUFFERS);
-
-	// Delete WaveFile object
-	m_pwavefile = nullptr;
-
-	status = ASF_FREE;
+	// The game thread closes the file, see audiostream_close_files()
+	Stream_files_to_close.push_back(m_pwavefile.release());
 
-	SDL_UnlockMutex(write_lock);
-
-	return fRtn;
+	active = false;
 }
 
 // WriteWaveData
@@ -411,7 +350,7 @@ bool AudioStream::Destroy (void)
 bool AudioStream::WriteWaveData (uint size, uint *num_bytes_written, int service)
 {
 	bool fRtn = true;
-	ubyte *uncompressed_wave_data;
+	ubyte *uncompressed_wave_data = Wavedata_buffer;
 
 	*num_bytes_written = 0;
 
@@ -423,16 +362,6 @@ bool AudioStream::WriteWaveData (uint size, uint *num_bytes_written, int service
 		return fRtn;
 	}
 
-	if ( service ) {
-		SDL_LockMutex(Global_service_lock);
-	}
-
-	if ( service ) {
-		uncompressed_wave_data = Wavedata_service_buffer;
-	} else {
-		uncompressed_wave_data = Wavedata_load_buffer;
-	}
-
 	int num_bytes_read = 0;
 
 	const auto alFormat = openal_get_format(m_fileProps.bytes_per_sample * 8, m_fileProps.num_channels);
@@ -491,10 +420,6 @@ bool AudioStream::WriteWaveData (uint size, uint *num_bytes_written, int service
 ErrorExit:
 	m_total_uncompressed_bytes_read += *num_bytes_written;
 
-	if ( service ) {
-		SDL_UnlockMutex(Global_service_lock);
-	}
-
 	return (fRtn);
 }
 
@@ -518,6 +443,8 @@ uint AudioStream::GetMaxWriteSize (void)
 	return (dwMaxSize);
 }
 
+static std::atomic<uint> Stream_underruns(0);
+
 #define VOLUME_ATTENUATION_BEFORE_CUTOFF			0.03f
 #define VOLUME_ATTENUATION							0.65f
 bool AudioStream::ServiceBuffer (void)
@@ -525,26 +452,20 @@ bool AudioStream::ServiceBuffer (void)
 	float vol;
 	bool fRtn = true;
 
-	if ( status != ASF_USED )
+	if ( !active || !m_fPlaying )
 		return false;
 
-	SDL_LockMutex( write_lock );
-
-	// status may have changed, so lets check once again
-	if ( status != ASF_USED ){
-		SDL_UnlockMutex( write_lock );
-
-		return false;
-	}
+	// the streams are checked more often than the fade steps should happen
+	if ( (m_bFade == true) && ((uint)timer_get_milliseconds() >= m_next_fade_step) ) {
+		m_next_fade_step = timer_get_milliseconds() + DefBufferServiceInterval;
 
-	if ( m_bFade == true ) {
 		if ( m_lCutoffVolume == 0.0f ) {
-			vol = Get_Volume();
+			vol = m_lVolume;
 //			nprintf(("Alan","Volume is: %d\n",vol));
 			m_lCutoffVolume = vol * VOLUME_ATTENUATION_BEFORE_CUTOFF;
 		}
 
-		vol = Get_Volume() * VOLUME_ATTENUATION;
+		vol = m_lVolume * VOLUME_ATTENUATION;
 //		nprintf(("Alan","Volume is now: %d\n",vol));
 		Set_Volume(vol);
 
@@ -555,16 +476,11 @@ bool AudioStream::ServiceBuffer (void)
 			m_lCutoffVolume = 0.0f;
 
 			if ( m_bDestroy_when_faded == true ) {
-				SDL_UnlockMutex( write_lock );
-
-				Destroy();	
-				// Reset reentrancy semaphore
+				Destroy();
 
 				return false;
 			} else {
 				Stop_and_Rewind();
-				// Reset reentrancy semaphore
-				SDL_UnlockMutex( write_lock );
 
 				return true;
 			}
@@ -602,10 +518,7 @@ bool AudioStream::ServiceBuffer (void)
 
 			if ( PlaybackDone() ) {
 				if ( m_bDestroy_when_faded == true ) {
-					SDL_UnlockMutex( write_lock );
-
 					Destroy();
-					// Reset reentrancy semaphore
 
 					return false;
 				}
@@ -615,6 +528,15 @@ bool AudioStream::ServiceBuffer (void)
 				} else {
 					Stop_and_Rewind();
 				}
+			} else if ( !m_bReadingDone ) {
+				// OpenAL stops a source which runs out of buffers, it has to be restarted once there is new data
+				ALint state = 0;
+				OpenAL_ErrorPrint( alGetSourcei(m_source_id, AL_SOURCE_STATE, &state) );
+
+				if ( state == AL_STOPPED ) {
+					++Stream_underruns;
+					OpenAL_ErrorPrint( alSourcePlay(m_source_id) );
+				}
 			}
 		}
 		else {
@@ -624,8 +546,6 @@ bool AudioStream::ServiceBuffer (void)
 		}
 	}
 
-	SDL_UnlockMutex( write_lock );
-
 	return (fRtn);
 }
 
@@ -687,6 +607,13 @@ void AudioStream::Play (float volume, int looping)
 		else
 			m_bLooping = 0;
 
+		// the stream was cued when it was opened without knowing about the loop flag, a sound which is shorter
+		// than the buffers has to be read again so that it loops
+		if ( m_bLooping && m_bReadingDone && m_fCued && !m_fPlaying && !m_bIsPaused ) {
+			OpenAL_ErrorPrint( alSourceStop(m_source_id) );
+			Stop_and_Rewind();
+		}
+
 		// Cue for playback if necessary
 		if ( !m_fCued )
 			Cue ();
@@ -696,26 +623,12 @@ void AudioStream::Play (float volume, int looping)
 		m_nTimeStarted = timer_get_milliseconds();
 		Set_Volume(volume);
 
-		// Kick off timer to service buffer
-		m_timer.constructor();
-
-		m_timer.Create (m_nBufService, m_nBufService, ptr_u (this), TimerCallback);
-
 		// Playback begun, no longer cued
 		m_fPlaying = true;
 		m_bIsPaused = false;
 	}
 }
 
-// Timer callback for Timer object created by ::Play method.
-bool AudioStream::TimerCallback (ptr_u dwUser)
-{
-	// dwUser contains ptr to AudioStream object
-	AudioStream * pas = (AudioStream *) dwUser;
-
-	return (pas->ServiceBuffer ());
-}
-
 void AudioStream::Set_Sample_Cutoff(unsigned int sample_cutoff)
 {
 	if ( m_pwavefile == NULL )
@@ -724,12 +637,23 @@ void AudioStream::Set_Sample_Cutoff(unsigned int sample_cutoff)
 	m_max_uncompressed_bytes_to_read = (sample_cutoff * m_fileProps.bytes_per_sample);
 }
 
-uint AudioStream::Get_Samples_Committed(void)
+stream_status AudioStream::Get_Status()
 {
-	if ( m_pwavefile == NULL )
-		return 0;
-
-	return (uint) (m_total_uncompressed_bytes_read / m_fileProps.bytes_per_sample);
+	stream_status status;
+
+	status.stream = stream_index;
+	status.generation = generation;
+	status.state_commands = state_commands;
+	status.volume_commands = volume_commands;
+	status.destroyed = !active;
+	status.playing = m_fPlaying;
+	status.paused = m_bIsPaused;
+	status.cued = m_fCued;
+	status.past_limit = m_bPastLimit;
+	status.volume = m_lVolume;
+	status.samples_committed = (m_pwavefile == nullptr) ? 0 : (uint) (m_total_uncompressed_bytes_read / m_fileProps.bytes_per_sample);
+
+	return status;
 }
 
 
@@ -769,9 +693,6 @@ void AudioStream::Stop(int paused)
 
 		m_fPlaying = false;
 		m_bIsPaused = (paused != 0);
-
-		// Delete Timer object
-		m_timer.destructor();
 	}
 }
 
@@ -782,9 +703,6 @@ void AudioStream::Stop_and_Rewind (void)
 		// Stop playback
 		OpenAL_ErrorPrint( alSourceStop(m_source_id) );
 
-		// Delete Timer object
-		m_timer.destructor();
-
 		m_fPlaying = false;
 		m_bIsPaused = false;
 	}
@@ -813,18 +731,6 @@ void AudioStream::Set_Volume(float vol)
 	m_lVolume = vol;
 }
 
-
-// Set_Volume
-float AudioStream::Get_Volume()
-{
-	return m_lVolume;
-}
-
-double AudioStream::Get_Duration()
-{
-	return m_fileProps.duration;
-}
-
 bool AudioStream::PlaybackDone()
 {
 	ALint state = 0;
@@ -837,51 +743,289 @@ bool AudioStream::PlaybackDone()
 }
 
 
-AudioStream Audio_streams[MAX_AUDIO_STREAMS];
+// Only used by the streaming thread once a stream was opened
+static AudioStream Audio_streams[MAX_AUDIO_STREAMS];
 
+// Only used by the game thread
+static audio_stream_slot Audio_stream_slots[MAX_AUDIO_STREAMS];
 
-void audiostream_init()
+static std::unique_ptr<util::SpscQueue<stream_command>> Stream_commands;
+static std::unique_ptr<util::SpscQueue<stream_status>> Stream_status;
+// Closing a CFILE changes the block list and the shared file mappings of cfile which are not thread safe, so the files
+// are closed by the game thread. Reading a file is safe since only the streaming thread uses it while the stream exists.
+static std::unique_ptr<util::SpscQueue<sound::IAudioFile*>> Stream_closed_files;
+
+// Commands which didn't fit into the queue, they are sent before any new command
+static SCP_deque<stream_command> Pending_stream_commands;
+
+static std::thread Stream_thread;
+static std::atomic<bool> Stream_thread_stop(false);
+
+// Only used to let the streaming thread sleep, sending a command never waits for this
+static std::mutex Stream_wake_mutex;
+static std::condition_variable Stream_wake_cond;
+static std::atomic<bool> Stream_wake_pending(false);
+
+// Set by the streaming thread when it took the commands out of the queue so the game thread can wait for room
+static std::mutex Stream_drained_mutex;
+static std::condition_variable Stream_drained_cond;
+static bool Stream_drained = false;
+
+MONITOR(AudioStreamUnderruns)
+
+// Both threads count the commands the same way, see audio_stream_slot
+static void count_command(stream_command_type type, uint& state_commands, uint& volume_commands)
 {
-	int i;
+	switch (type) {
+		case stream_command_type::SetVolume:
+			++volume_commands;
+			break;
 
-	if ( Audiostream_inited == 1 )
-		return;
+		case stream_command_type::SetSampleCutoff:
+			// only changes the state once the stream gets there
+			break;
 
-	// Allocate memory for the buffer which holds the uncompressed wave data that is streamed from the
-	// disk during a load/cue
-	if ( Wavedata_load_buffer == NULL ) {
-		Wavedata_load_buffer = (ubyte*)vm_malloc(BIGBUF_SIZE);
-		Assert(Wavedata_load_buffer != NULL);
+		case stream_command_type::Play:
+			++state_commands;
+			++volume_commands;
+			break;
+
+		default:
+			++state_commands;
+			break;
 	}
+}
+
+static void audiostream_execute(const stream_command& cmd)
+{
+	auto& stream = Audio_streams[cmd.stream];
+
+	switch (cmd.type) {
+		case stream_command_type::Open:
+			stream.Open(cmd);
+			break;
 
-	// Allocate memory for the buffer which holds the uncompressed wave data that is streamed from the
-	// disk during a service interval
-	if ( Wavedata_service_buffer == NULL ) {
-		Wavedata_service_buffer = (ubyte*)vm_malloc(BIGBUF_SIZE);
-		Assert(Wavedata_service_buffer != NULL);
+		case stream_command_type::Play:
+			if (stream.active) {
+				stream.Play(cmd.volume, cmd.looping);
+			}
+			break;
+
+		case stream_command_type::Stop:
+			if (stream.active) {
+				stream.Stop(cmd.paused);
+			}
+			break;
+
+		case stream_command_type::StopAndRewind:
+			if (stream.active) {
+				stream.Stop_and_Rewind();
+			}
+			break;
+
+		case stream_command_type::SetVolume:
+			if (stream.active) {
+				stream.Set_Volume(cmd.volume);
+			}
+			break;
+
+		case stream_command_type::SetSampleCutoff:
+			if (stream.active) {
+				stream.Set_Sample_Cutoff(cmd.sample_cutoff);
+			}
+			break;
+
+		case stream_command_type::FadeAndDestroy:
+			if (stream.active) {
+				stream.Fade_and_Destroy();
+			}
+			break;
+
+		case stream_command_type::Destroy:
+			stream.Destroy();
+			break;
+	}
+
+	count_command(cmd.type, stream.state_commands, stream.volume_commands);
+	stream.status_sent = false;
+}
+
+static void audiostream_thread_main()
+{
+	while (true) {
+		// commands which were sent before the thread was told to stop still have to be processed
+		auto stopping = Stream_thread_stop.load(std::memory_order_acquire);
+
+		stream_command cmd;
+		auto received = false;
+		while (Stream_commands->pop(cmd)) {
+			audiostream_execute(cmd);
+			received = true;
+		}
+
+		if (received) {
+			std::lock_guard<std::mutex> lock(Stream_drained_mutex);
+			Stream_drained = true;
+			Stream_drained_cond.notify_all();
+		}
+
+		for (auto& stream : Audio_streams) {
+			stream.ServiceBuffer();
+		}
+
+		// only changes are reported, a report which doesn't fit into the queue is sent the next time
+		for (auto& stream : Audio_streams) {
+			if (!stream.active && stream.status_sent) {
+				continue;
+			}
+
+			auto status = stream.Get_Status();
+			if (stream.status_sent && status == stream.last_status) {
+				continue;
+			}
+
+			if (Stream_status->push(status)) {
+				stream.last_status = status;
+				stream.status_sent = true;
+			}
+		}
+
+		while (!Stream_files_to_close.empty() && Stream_closed_files->push(Stream_files_to_close.back())) {
+			Stream_files_to_close.pop_back();
+		}
+
+		if (stopping) {
+			break;
+		}
+
+		// A wake up may be missed if the command arrives between the check and the wait, the interval limits how long
+		// the command has to wait in that case
+		std::unique_lock<std::mutex> lock(Stream_wake_mutex);
+		Stream_wake_cond.wait_for(lock, std::chrono::milliseconds(STREAM_SERVICE_INTERVAL),
+			[]() { return Stream_wake_pending.load(std::memory_order_acquire); });
+		Stream_wake_pending.store(false, std::memory_order_release);
 	}
+}
 
-	// Allocate memory for the buffer which holds the compressed wave data that is read from the hard disk
-	if ( Compressed_buffer == NULL ) {
-		Compressed_buffer = (ubyte*)vm_malloc(COMPRESSED_BUFFER_SIZE);
-		Assert(Compressed_buffer != NULL);
+static void audiostream_flush_commands()
+{
+	auto sent = false;
+
+	while (!Pending_stream_commands.empty()) {
+		if (!Stream_commands->push(Pending_stream_commands.front())) {
+			break;
+		}
+		Pending_stream_commands.pop_front();
+		sent = true;
 	}
 
-	if ( Compressed_service_buffer == NULL ) {
-		Compressed_service_buffer = (ubyte*)vm_malloc(COMPRESSED_BUFFER_SIZE);
-		Assert(Compressed_service_buffer != NULL);
+	if (sent) {
+		Stream_wake_pending.store(true, std::memory_order_release);
+		Stream_wake_cond.notify_one();
+	}
+}
+
+static void audiostream_send(const stream_command& cmd)
+{
+	auto& slot = Audio_stream_slots[cmd.stream];
+
+	count_command(cmd.type, slot.state_commands, slot.volume_commands);
+
+	// the order of the commands must be kept so nothing may skip the commands which are still waiting
+	Pending_stream_commands.push_back(cmd);
+	audiostream_flush_commands();
+}
+
+static void audiostream_close_files()
+{
+	sound::IAudioFile* file;
+	while (Stream_closed_files->pop(file)) {
+		delete file;
+	}
+}
+
+static void audiostream_release_slot(int i)
+{
+	auto& slot = Audio_stream_slots[i];
+
+	Snd_sram -= slot.sram;
+	slot.sram = 0;
+	slot.status = ASF_FREE;
+}
+
+// Takes over the state reported by the streaming thread
+static void audiostream_update_status()
+{
+	if ( !Audiostream_inited )
+		return;
+
+	audiostream_flush_commands();
+	audiostream_close_files();
+
+	stream_status status;
+	while (Stream_status->pop(status)) {
+		auto& slot = Audio_stream_slots[status.stream];
+
+		// reports for a stream which was closed in the mean time don't matter anymore
+		if ( (slot.status != ASF_USED) || (slot.generation != status.generation) ) {
+			continue;
+		}
+
+		if (status.destroyed) {
+			audiostream_release_slot(status.stream);
+			continue;
+		}
+
+		if (status.state_commands == slot.state_commands) {
+			slot.playing = status.playing;
+			slot.paused = status.paused;
+			slot.cued = status.cued;
+			slot.past_limit = status.past_limit;
+			slot.samples_committed = status.samples_committed;
+		}
+
+		if (status.volume_commands == slot.volume_commands) {
+			slot.volume = status.volume;
+		}
+	}
+
+	mon_AudioStreamUnderruns = static_cast<int>(Stream_underruns.load());
+}
+
+void audiostream_init()
+{
+	int i;
+
+	if ( Audiostream_inited == 1 )
+		return;
+
+	// Allocate memory for the buffer which holds the uncompressed wave data that is streamed from the disk
+	if ( Wavedata_buffer == NULL ) {
+		Wavedata_buffer = (ubyte*)vm_malloc(BIGBUF_SIZE);
+		Assert(Wavedata_buffer != NULL);
 	}
 
 	for ( i = 0; i < MAX_AUDIO_STREAMS; i++ ) {
 		Audio_streams[i].Init_Data();
-		Audio_streams[i].status = ASF_FREE;
-		Audio_streams[i].type = ASF_NONE;
-		Audio_streams[i].paused_via_sexp_or_script = false;
+		Audio_streams[i].stream_index = i;
+		Audio_streams[i].generation = 0;
+		Audio_streams[i].state_commands = 0;
+		Audio_streams[i].volume_commands = 0;
+		Audio_streams[i].status_sent = true;
+
+		Audio_stream_slots[i] = audio_stream_slot();
 	}
 
-	SDL_InitSubSystem(SDL_INIT_TIMER);
+	Stream_commands.reset(new util::SpscQueue<stream_command>(STREAM_QUEUE_SIZE));
+	Stream_status.reset(new util::SpscQueue<stream_status>(STREAM_QUEUE_SIZE));
+	Stream_closed_files.reset(new util::SpscQueue<sound::IAudioFile*>(STREAM_QUEUE_SIZE));
+	Pending_stream_commands.clear();
+	Stream_files_to_close.clear();
+	Stream_drained = false;
+	Stream_underruns = 0;
 
-	Global_service_lock = SDL_CreateMutex();
+	Stream_thread_stop = false;
+	Stream_thread = std::thread(audiostream_thread_main);
 
 	Audiostream_inited = 1;
 }
@@ -896,34 +1040,51 @@ void audiostream_close()
 	int i;
 
 	for ( i = 0; i < MAX_AUDIO_STREAMS; i++ ) {
-		if ( Audio_streams[i].status == ASF_USED ) {
-			Audio_streams[i].status = ASF_FREE;
-			Audio_streams[i].Destroy();
+		if ( Audio_stream_slots[i].status == ASF_USED ) {
+			stream_command cmd;
+			cmd.type = stream_command_type::Destroy;
+			cmd.stream = i;
+			audiostream_send(cmd);
+
+			audiostream_release_slot(i);
 		}
 	}
 
-	// free global buffers
-	if ( Wavedata_load_buffer ) {
-		vm_free(Wavedata_load_buffer);
-		Wavedata_load_buffer = NULL;
+	// everything has to reach the streaming thread before it can stop
+	while (!Pending_stream_commands.empty()) {
+		{
+			std::unique_lock<std::mutex> lock(Stream_drained_mutex);
+			Stream_drained_cond.wait(lock, []() { return Stream_drained; });
+			Stream_drained = false;
+		}
+		audiostream_flush_commands();
 	}
 
-	if ( Wavedata_service_buffer ) {
-		vm_free(Wavedata_service_buffer);
-		Wavedata_service_buffer = NULL;
-	}
+	Stream_thread_stop.store(true, std::memory_order_release);
+	Stream_wake_pending.store(true, std::memory_order_release);
+	Stream_wake_cond.notify_one();
+	Stream_thread.join();
 
-	if ( Compressed_buffer ) {
-		vm_free(Compressed_buffer);
-		Compressed_buffer = NULL;
+	// the streaming thread is gone so the files it couldn't hand over can be closed as well
+	audiostream_close_files();
+	for (auto file : Stream_files_to_close) {
+		delete file;
 	}
+	Stream_files_to_close.clear();
 
-	if ( Compressed_service_buffer ) {
-		vm_free(Compressed_service_buffer);
-		Compressed_service_buffer = NULL;
+	if (Stream_underruns > 0) {
+		mprintf(("AUDIOSTR => %u buffer underruns while streaming\n", Stream_underruns.load()));
 	}
 
-	SDL_DestroyMutex( Global_service_lock );
+	Stream_commands.reset();
+	Stream_status.reset();
+	Stream_closed_files.reset();
+
+	// free global buffers
+	if ( Wavedata_buffer ) {
+		vm_free(Wavedata_buffer);
+		Wavedata_buffer = NULL;
+	}
 
 	Audiostream_inited = 0;
 
@@ -934,9 +1095,12 @@ static int audiostream_use_next_free( int type )
 	if ( !Audiostream_inited || !snd_is_inited() )
 		return -1;
 
+	// slots of streams which faded out are only freed by the status of the streaming thread
+	audiostream_update_status();
+
 	int i;
 	for (i = 0; i < MAX_AUDIO_STREAMS; i++)
-		if (Audio_streams[i].status == ASF_FREE)
+		if (Audio_stream_slots[i].status == ASF_FREE)
 			break;
 
 	if (i == MAX_AUDIO_STREAMS) {
@@ -944,30 +1108,96 @@ static int audiostream_use_next_free( int type )
 		return -1;
 	}
 
-	Audio_streams[i].status = ASF_USED;
-	Audio_streams[i].type = type;
+	auto& slot = Audio_stream_slots[i];
+
+	slot.status = ASF_USED;
+	slot.type = type;
 
 	switch (type) {
 		case ASF_SOUNDFX: // As in: sound.cpp:590
-			Audio_streams[i].Set_Default_Volume(Master_sound_volume * aav_effect_volume);
+			slot.default_volume = Master_sound_volume * aav_effect_volume;
 			break;
 		case ASF_EVENTMUSIC: // As in: sexp.cpp:11562
-			Audio_streams[i].Set_Default_Volume(Master_event_music_volume * aav_music_volume);
+			slot.default_volume = Master_event_music_volume * aav_music_volume;
 			break;
 		case ASF_MENUMUSIC: // As in: mainhallmenu.cpp:1170
-			Audio_streams[i].Set_Default_Volume(Master_event_music_volume);
+			slot.default_volume = Master_event_music_volume;
 			break;
 		case ASF_VOICE: // As in: sound.cpp:590
-			Audio_streams[i].Set_Default_Volume(Master_voice_volume * aav_voice_volume);
+			slot.default_volume = Master_voice_volume * aav_voice_volume;
 			break;
 		default:
-			Audio_streams[i].status = ASF_FREE;
+			slot.status = ASF_FREE;
 			return -1;
 	}
 
 	return i;
 }
 
+// Creates the OpenAL objects of a stream and hands the opened file to the streaming thread which starts
+// decoding right away so that the stream is ready once it gets played.
+static bool audiostream_start_open(int i, std::unique_ptr<sound::IAudioFile> file, const char *filename)
+{
+	auto& slot = Audio_stream_slots[i];
+
+	auto props = file->getFileProperties();
+
+	stream_command cmd;
+	cmd.type = stream_command_type::Open;
+	cmd.stream = i;
+	cmd.stream_type = slot.type;
+	cmd.buffer_size = audiostream_buffer_size(props);
+
+	//				nprintf(("SOUND", "SOUND => Stream buffer created using %d bytes\n", cmd.buffer_size));
+
+	OpenAL_ErrorCheck( alGenSources(1, &cmd.source_id), goto ErrorExit );
+
+	OpenAL_ErrorCheck( alGenBuffers(MAX_STREAM_BUFFERS, cmd.buffer_ids), goto ErrorExit );
+
+	OpenAL_ErrorPrint( alSourcef(cmd.source_id, AL_ROLLOFF_FACTOR, 1.0f) );
+	OpenAL_ErrorPrint( alSourcei(cmd.source_id, AL_SOURCE_RELATIVE, AL_TRUE) );
+
+	OpenAL_ErrorPrint( alSource3f(cmd.source_id, AL_POSITION, 0.0f, 0.0f, 0.0f) );
+	OpenAL_ErrorPrint( alSource3f(cmd.source_id, AL_VELOCITY, 0.0f, 0.0f, 0.0f) );
+
+	OpenAL_ErrorPrint( alSourcef(cmd.source_id, AL_GAIN, 1.0f) );
+	OpenAL_ErrorPrint( alSourcef(cmd.source_id, AL_PITCH, 1.0f) );
+
+	// maybe set EFX
+	if ( (slot.type == ASF_SOUNDFX) && ds_eax_is_inited() ) {
+		extern ALuint AL_EFX_aux_id;
+		OpenAL_ErrorPrint( alSource3i(cmd.source_id, AL_AUXILIARY_SEND_FILTER, AL_EFX_aux_id, 0, AL_FILTER_NULL) );
+	}
+
+	slot.generation++;
+	cmd.generation = slot.generation;
+
+	slot.playing = false;
+	slot.paused = false;
+	slot.cued = true;
+	slot.looping = false;
+	slot.past_limit = false;
+	slot.volume = 1.0f;
+	slot.samples_committed = 0;
+	slot.duration = props.duration;
+
+	slot.sram = cmd.buffer_size * MAX_STREAM_BUFFERS;
+	Snd_sram += slot.sram;
+
+	cmd.file = file.release();
+	audiostream_send(cmd);
+
+	return true;
+
+ErrorExit:
+	mprintf(("AUDIOSTR => ErrorExit for ::prepareOpened() on wave file: %s\n", filename));
+
+	if (cmd.source_id)
+		OpenAL_ErrorPrint( alDeleteSources(1, &cmd.source_id) );
+
+	return false;
+}
+
 // Open a digital sound file for streaming
 //
 // input:	filename	=>	disk filename of sound file
@@ -1007,18 +1237,31 @@ int audiostream_open( const char *filename, int type )
 			break;
 
 		default:
-			Audio_streams[i].status = ASF_FREE;
+			Audio_stream_slots[i].status = ASF_FREE;
 			return -1;
 	}
 
-	int rc = Audio_streams[i].Create(fname);
+	// make 100% sure we got a good filename
+	if ( !strlen(fname) ) {
+		Audio_stream_slots[i].status = ASF_FREE;
+		return -1;
+	}
 
-	if ( rc == 0 ) {
-		Audio_streams[i].status = ASF_FREE;
+	// Create a new WaveFile object and open it
+	auto file = openAudioFile(fname, (type == ASF_EVENTMUSIC));
+	if ( !file ) {
+		// Error, unable to create WaveFile object
+		nprintf(("Sound", "SOUND => Failed to open wave file %s\n", fname));
+		Audio_stream_slots[i].status = ASF_FREE;
 		return -1;
-	} else {
-		return i;
 	}
+
+	if ( !audiostream_start_open(i, std::move(file), fname) ) {
+		Audio_stream_slots[i].status = ASF_FREE;
+		return -1;
+	}
+
+	return i;
 }
 
 // Open wave file contents previously loaded into memory for streaming
@@ -1039,14 +1282,21 @@ int audiostream_open_mem( const uint8_t* snddata, size_t snd_len, int type )
 	if ( i == -1 )
 		return -1;
 
-	int rc = Audio_streams[i].CreateMem(snddata, snd_len);
+	// Create a new WaveFile object and open it
+	auto file = openAudioMem(snddata, snd_len);
+	if ( !file ) {
+		// Error, unable to create WaveFile object
+		nprintf(("Sound", "SOUND => Failed to open in-memory wave file \n"));
+		Audio_stream_slots[i].status = ASF_FREE;
+		return -1;
+	}
 
-	if ( rc == 0 ) {
-		Audio_streams[i].status = ASF_FREE;
+	if ( !audiostream_start_open(i, std::move(file), "in-memory") ) {
+		Audio_stream_slots[i].status = ASF_FREE;
 		return -1;
-	} else {
-		return i;
 	}
+
+	return i;
 }
 
 void audiostream_close_file(int i, bool fade)
@@ -1059,11 +1309,22 @@ void audiostream_close_file(int i, bool fade)
 
 	Assert( i >= 0 && i < MAX_AUDIO_STREAMS );
 
-	if ( Audio_streams[i].status == ASF_USED ) {
-		if ( fade )
-			Audio_streams[i].Fade_and_Destroy();
-		else
-			Audio_streams[i].Destroy();
+	audiostream_update_status();
+
+	if ( Audio_stream_slots[i].status == ASF_USED ) {
+		stream_command cmd;
+		cmd.stream = i;
+
+		if ( fade ) {
+			// the slot stays in use until the stream has faded out
+			cmd.type = stream_command_type::FadeAndDestroy;
+			audiostream_send(cmd);
+		} else {
+			cmd.type = stream_command_type::Destroy;
+			audiostream_send(cmd);
+
+			audiostream_release_slot(i);
+		}
 	}
 
 }
@@ -1073,7 +1334,7 @@ void audiostream_close_all(bool fade)
 	int i;
 
 	for ( i = 0; i < MAX_AUDIO_STREAMS; i++ ) {
-		if ( Audio_streams[i].status == ASF_FREE )
+		if ( Audio_stream_slots[i].status == ASF_FREE )
 			continue;
 
 		audiostream_close_file(i, fade);
@@ -1091,16 +1352,40 @@ void audiostream_play(int i, float volume, int looping)
 	Assert(looping >= 0);
 	Assert( i >= 0 && i < MAX_AUDIO_STREAMS );
 
+	audiostream_update_status();
+
+	auto& slot = Audio_stream_slots[i];
+
 	if (volume == -1.0f) {
-		volume = Audio_streams[i].Get_Default_Volume();
+		volume = slot.default_volume;
 	}
 
 	Assert(volume >= 0.0f && volume <= 1.0f );
 	CAP(volume, 0.0f, 1.0f);
 
-	Assert( Audio_streams[i].status == ASF_USED );
-	Audio_streams[i].Set_Default_Volume(volume);
-	Audio_streams[i].Play(volume, looping);
+	Assert( slot.status == ASF_USED );
+	slot.default_volume = volume;
+
+	stream_command cmd;
+	cmd.type = stream_command_type::Play;
+	cmd.stream = i;
+	cmd.volume = volume;
+	cmd.looping = looping;
+	audiostream_send(cmd);
+
+	// same as AudioStream::Play() so the game sees the new state right away
+	if ( slot.playing && !slot.paused ) {
+		slot.cued = false;
+	}
+	if ( !slot.cued ) {
+		slot.past_limit = false;
+		slot.samples_committed = 0;
+		slot.cued = true;
+	}
+	slot.looping = (looping != 0);
+	slot.volume = volume;
+	slot.playing = true;
+	slot.paused = false;
 }
 
 // use as buffer service function
@@ -1111,10 +1396,12 @@ int audiostream_is_playing(int i)
 
 	Assert( i >= 0 && i < MAX_AUDIO_STREAMS );
 
-	if ( Audio_streams[i].status != ASF_USED )
+	audiostream_update_status();
+
+	if ( Audio_stream_slots[i].status != ASF_USED )
 		return 0;
 
-	return (int)Audio_streams[i].Is_Playing();
+	return (int)Audio_stream_slots[i].playing;
 }
 
 void audiostream_stop(int i, int rewind, int paused)
@@ -1126,12 +1413,45 @@ void audiostream_stop(int i, int rewind, int paused)
 		return;
 
 	Assert( i >= 0 && i < MAX_AUDIO_STREAMS );
-	Assert( Audio_streams[i].status == ASF_USED );
 
-	if ( rewind )
-		Audio_streams[i].Stop_and_Rewind();
-	else
-		Audio_streams[i].Stop(paused);
+	audiostream_update_status();
+
+	auto& slot = Audio_stream_slots[i];
+	Assert( slot.status == ASF_USED );
+
+	stream_command cmd;
+	cmd.stream = i;
+
+	if ( rewind ) {
+		cmd.type = stream_command_type::StopAndRewind;
+
+		slot.playing = false;
+		slot.paused = false;
+		slot.cued = false;
+	} else {
+		cmd.type = stream_command_type::Stop;
+		cmd.paused = paused;
+
+		if ( slot.playing ) {
+			slot.playing = false;
+			slot.paused = (paused != 0);
+		}
+	}
+
+	audiostream_send(cmd);
+}
+
+static void audiostream_send_volume(int i, float volume)
+{
+	CAP(volume, 0.0f, 1.0f);
+
+	stream_command cmd;
+	cmd.type = stream_command_type::SetVolume;
+	cmd.stream = i;
+	cmd.volume = volume;
+	audiostream_send(cmd);
+
+	Audio_stream_slots[i].volume = volume;
 }
 
 void audiostream_set_volume_all(float volume, int type)
@@ -1139,11 +1459,11 @@ void audiostream_set_volume_all(float volume, int type)
 	int i;
 
 	for ( i = 0; i < MAX_AUDIO_STREAMS; i++ ) {
-		if ( Audio_streams[i].status == ASF_FREE )
+		if ( Audio_stream_slots[i].status == ASF_FREE )
 			continue;
 
-		if ( (Audio_streams[i].type == type) || ((Audio_streams[i].type == ASF_MENUMUSIC) && (type == ASF_EVENTMUSIC)) ) {
-			Audio_streams[i].Set_Volume(volume);
+		if ( (Audio_stream_slots[i].type == type) || ((Audio_stream_slots[i].type == ASF_MENUMUSIC) && (type == ASF_EVENTMUSIC)) ) {
+			audiostream_send_volume(i, volume);
 		}
 	}
 }
@@ -1156,10 +1476,10 @@ void audiostream_set_volume(int i, float volume)
 	Assert( i >= 0 && i < MAX_AUDIO_STREAMS );
 	Assert( volume >= 0.0f && volume <= 1.0f);
 
-	if ( Audio_streams[i].status == ASF_FREE )
+	if ( Audio_stream_slots[i].status == ASF_FREE )
 		return;
 
-	Audio_streams[i].Set_Volume(volume);
+	audiostream_send_volume(i, volume);
 }
 
 int audiostream_is_paused(int i)
@@ -1169,10 +1489,12 @@ int audiostream_is_paused(int i)
 
 	Assert( i >= 0 && i < MAX_AUDIO_STREAMS );
 
-	if ( Audio_streams[i].status == ASF_FREE )
+	audiostream_update_status();
+
+	if ( Audio_stream_slots[i].status == ASF_FREE )
 		return -1;
 
-	return (int) Audio_streams[i].Is_Paused();
+	return (int) Audio_stream_slots[i].paused;
 }
 
 double audiostream_get_duration(int i)
@@ -1182,10 +1504,10 @@ double audiostream_get_duration(int i)
 
 	Assert(i >= 0 && i < MAX_AUDIO_STREAMS);
 
-	if (Audio_streams[i].status == ASF_FREE)
+	if (Audio_stream_slots[i].status == ASF_FREE)
 		return -1;
 	
-	return Audio_streams[i].Get_Duration();
+	return Audio_stream_slots[i].duration;
 }
 
 void audiostream_set_sample_cutoff(int i, uint cutoff)
@@ -1196,10 +1518,14 @@ void audiostream_set_sample_cutoff(int i, uint cutoff)
 	Assert( i >= 0 && i < MAX_AUDIO_STREAMS );
 	Assert( cutoff > 0 );
 
-	if ( Audio_streams[i].status == ASF_FREE )
+	if ( Audio_stream_slots[i].status == ASF_FREE )
 		return;
 
-	Audio_streams[i].Set_Sample_Cutoff(cutoff);
+	stream_command cmd;
+	cmd.type = stream_command_type::SetSampleCutoff;
+	cmd.stream = i;
+	cmd.sample_cutoff = cutoff;
+	audiostream_send(cmd);
 }
 
 uint audiostream_get_samples_committed(int i)
@@ -1209,10 +1535,12 @@ uint audiostream_get_samples_committed(int i)
 
 	Assert( i >= 0 && i < MAX_AUDIO_STREAMS );
 
-	if ( Audio_streams[i].status == ASF_FREE )
+	audiostream_update_status();
+
+	if ( Audio_stream_slots[i].status == ASF_FREE )
 		return 0;
 
-	return Audio_streams[i].Get_Samples_Committed();
+	return Audio_stream_slots[i].samples_committed;
 }
 
 int audiostream_done_reading(int i)
@@ -1222,10 +1550,12 @@ int audiostream_done_reading(int i)
 
 	Assert( i >= 0 && i < MAX_AUDIO_STREAMS );
 
-	if ( Audio_streams[i].status == ASF_FREE )
+	audiostream_update_status();
+
+	if ( Audio_stream_slots[i].status == ASF_FREE )
 		return 0;
 
-	return Audio_streams[i].Is_Past_Limit();
+	return Audio_stream_slots[i].past_limit;
 }
 
 int audiostream_is_inited()
@@ -1233,6 +1563,11 @@ int audiostream_is_inited()
 	return Audiostream_inited;
 }
 
+uint audiostream_get_underruns()
+{
+	return Stream_underruns.load();
+}
+
 void audiostream_pause(int i, bool via_sexp_or_script)
 {
 	if ( i == -1 )
@@ -1240,14 +1575,14 @@ void audiostream_pause(int i, bool via_sexp_or_script)
 
 	Assert( i >= 0 && i < MAX_AUDIO_STREAMS );
 
-	if ( Audio_streams[i].status == ASF_FREE )
+	if ( Audio_stream_slots[i].status == ASF_FREE )
 		return;
 
 	if ( audiostream_is_playing(i) == (int)true )
 		audiostream_stop(i, 0, 1);
 
 	if (via_sexp_or_script)
-		Audio_streams[i].paused_via_sexp_or_script = true;
+		Audio_stream_slots[i].paused_via_sexp_or_script = true;
 }
 
 void audiostream_unpause(int i, bool via_sexp_or_script)
@@ -1257,15 +1592,15 @@ void audiostream_unpause(int i, bool via_sexp_or_script)
 
 	Assert( i >= 0 && i < MAX_AUDIO_STREAMS );
 
-	if ( Audio_streams[i].status == ASF_FREE )
+	if ( Audio_stream_slots[i].status == ASF_FREE )
 		return;
 
 	if ( audiostream_is_paused(i) == (int)true ) {
-		audiostream_play(i, Audio_streams[i].Get_Volume(), Audio_streams[i].Is_looping());
+		audiostream_play(i, Audio_stream_slots[i].volume, Audio_stream_slots[i].looping);
 	}
 
 	if (via_sexp_or_script)
-		Audio_streams[i].paused_via_sexp_or_script = false;
+		Audio_stream_slots[i].paused_via_sexp_or_script = false;
 }
 
 void audiostream_pause_all(bool via_sexp_or_script)
@@ -1273,7 +1608,7 @@ void audiostream_pause_all(bool via_sexp_or_script)
 	int i;
 
 	for ( i = 0; i < MAX_AUDIO_STREAMS; i++ ) {
-		if ( Audio_streams[i].status == ASF_FREE )
+		if ( Audio_stream_slots[i].status == ASF_FREE )
 			continue;
 
 		audiostream_pause(i, via_sexp_or_script);
@@ -1285,11 +1620,11 @@ void audiostream_unpause_all(bool via_sexp_or_script)
 	int i;
 
 	for ( i = 0; i < MAX_AUDIO_STREAMS; i++ ) {
-		if ( Audio_streams[i].status == ASF_FREE )
+		if ( Audio_stream_slots[i].status == ASF_FREE )
 			continue;
 
 		// if we explicitly paused this and we are not explicitly unpausing, skip this stream
-		if ( Audio_streams[i].paused_via_sexp_or_script && !via_sexp_or_script )
+		if ( Audio_stream_slots[i].paused_via_sexp_or_script && !via_sexp_or_script )
 			continue;
 
 		audiostream_unpause(i, via_sexp_or_script);
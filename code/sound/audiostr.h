@@ -81,6 +81,9 @@ int audiostream_done_reading(int i);
 // return if audiostream has initialized ok
 int audiostream_is_inited();
 
+// return how often a stream ran out of data before the streaming thread could refill it
+unsigned int audiostream_get_underruns();
+
 void audiostream_pause(int i, bool via_sexp_or_script = false);	// pause a particular stream
 void audiostream_unpause(int i, bool via_sexp_or_script = false);	// unpause a particular stream
 
@@ -12,14 +12,17 @@
 #include "cfile/cfile.h"
 #include "cmdline/cmdline.h"
 #include "globalincs/pstypes.h"
+#include "io/timer.h"
 #include "osapi/osapi.h"
 #include "sound/audiostr.h"
 #include "sound/channel.h"
 #include "sound/ds.h"
 #include "sound/ds3d.h"
+#include "sound/ds_voices.h"
 #include "sound/dscap.h"
 #include "sound/openal.h"
 #include "sound/sound.h" // jg18 - for enhanced sound
+#include "tracing/Monitor.h"
 
 
 typedef struct sound_buffer
@@ -45,6 +48,10 @@ static int MAX_CHANNELS;		// initialized properly in ds_init_channels()
 channel *Channels = NULL;
 static int channel_next_sig = 1;
 
+static ds_voices Voices;
+static ds_voices::changes Voice_changes;
+static std::uint64_t Voices_last_update = 0;
+
 const int BUFFER_BUMP = 50;
 SCP_vector<sound_buffer> sound_buffers;
 
@@ -246,11 +253,37 @@ int ds_get_sid()
 	return (int)(sound_buffers.size() - 1);
 }
 
-int ds_load_buffer(int *sid, int  /*flags*/, sound::IAudioFile* file)
+bool ds_read_audio_data(sound::IAudioFile* file, SCP_vector<uint8_t>& audio_buffer)
 {
-	Assert(sid != NULL);
 	Assert(file != NULL);
 
+	const auto fileProps = file->getFileProperties();
+
+	audio_buffer.clear();
+	audio_buffer.reserve(fileProps.total_samples * fileProps.bytes_per_sample * fileProps.num_channels);
+
+	SCP_vector<uint8_t> buffer(fileProps.sample_rate * fileProps.bytes_per_sample * fileProps.num_channels);
+	if (buffer.empty()) {
+		return false;
+	}
+
+	int read;
+	while((read = file->Read(&buffer[0], buffer.size())) >= 0) {
+		if (read == 0) {
+			// buffer not large enough
+			buffer.resize(buffer.size() * 2);
+		} else {
+			audio_buffer.insert(audio_buffer.end(), buffer.begin(), std::next(buffer.begin(), read));
+		}
+	}
+
+	return true;
+}
+
+int ds_load_buffer(int *sid, int  /*flags*/, const sound::AudioFileProperties& fileProps, const SCP_vector<uint8_t>& audio_buffer)
+{
+	Assert(sid != NULL);
+
 	// All sounds are required to have a software buffer
 	*sid = ds_get_sid();
 	if (*sid == -1) {
@@ -261,10 +294,7 @@ int ds_load_buffer(int *sid, int  /*flags*/, sound::IAudioFile* file)
 	ALuint pi;
 	OpenAL_ErrorCheck(alGenBuffers(1, &pi), return -1);
 
-	const auto fileProps = file->getFileProperties();
-
 	ALenum format;
-	ALsizei size = fileProps.total_samples * fileProps.bytes_per_sample * fileProps.num_channels;
 	ALint n_channels = fileProps.num_channels;
 	ALsizei frequency;
 		
@@ -276,20 +306,6 @@ int ds_load_buffer(int *sid, int  /*flags*/, sound::IAudioFile* file)
 		return -1;
 	}
 
-	SCP_vector<uint8_t> audio_buffer;
-	audio_buffer.reserve(size);
-
-	SCP_vector<uint8_t> buffer(fileProps.sample_rate * fileProps.bytes_per_sample * fileProps.num_channels);
-	int read;
-	while((read = file->Read(&buffer[0], buffer.size())) >= 0) {
-		if (read == 0) {
-			// buffer not large enough
-			buffer.resize(buffer.size() * 2);
-		} else {
-			audio_buffer.insert(audio_buffer.end(), buffer.begin(), std::next(buffer.begin(), read));
-		}
-	}
-
 	Snd_sram += audio_buffer.size();
 
 	OpenAL_ErrorCheck(alBufferData(pi, format, audio_buffer.data(), (ALsizei)audio_buffer.size(), frequency), return -1; );
@@ -305,6 +321,20 @@ int ds_load_buffer(int *sid, int  /*flags*/, sound::IAudioFile* file)
 	return 0;
 }
 
+int ds_load_buffer(int *sid, int flags, sound::IAudioFile* file)
+{
+	Assert(sid != NULL);
+	Assert(file != NULL);
+
+	SCP_vector<uint8_t> audio_buffer;
+	if (!ds_read_audio_data(file, audio_buffer)) {
+		*sid = -1;
+		return -1;
+	}
+
+	return ds_load_buffer(sid, flags, file->getFileProperties(), audio_buffer);
+}
+
 /**
  * Initialise the ::Channels[] array dynamically based on system resources.
  */
@@ -552,6 +582,92 @@ AL_InitError:
 	return -1;
 }
 
+/**
+ * Called before a channel is freed, if a voice is playing on it the voice becomes virtual
+ */
+static void ds_voice_release_channel(int i)
+{
+	if (!Channels[i].sig.isValid()) {
+		return;
+	}
+
+	auto v = Voices.find(Channels[i].sig);
+	if (v == nullptr || v->channel != i) {
+		return;
+	}
+
+	ALint status = AL_STOPPED;
+	OpenAL_ErrorPrint( alGetSourcei(Channels[i].source_id, AL_SOURCE_STATE, &status) );
+
+	if ( (status == AL_PLAYING) || (status == AL_PAUSED) ) {
+		ALfloat offset = 0.0f;
+		OpenAL_ErrorPrint( alGetSourcef(Channels[i].source_id, AL_SEC_OFFSET, &offset) );
+
+		v->position = offset;
+		v->channel = -1;
+	} else {
+		// the sound finished on its channel
+		Voices.remove(v->sig);
+	}
+}
+
+/**
+ * Starts playing a voice on a free channel
+ *
+ * @return true if the voice is playing
+ */
+static bool ds_voice_bind(ds_voices::voice& v, int channel_id)
+{
+	auto source_id = Channels[channel_id].source_id;
+
+	ds3d_update_buffer(channel_id, v.min, v.max, &v.pos, v.has_vel ? &v.vel : nullptr);
+
+	OpenAL_ErrorPrint( alSourcef(source_id, AL_PITCH, v.pitch) );
+
+	OpenAL_ErrorPrint( alSourcef(source_id, AL_GAIN, v.gain) );
+
+	ALint status;
+	OpenAL_ErrorCheck( alGetSourcei(source_id, AL_SOURCE_STATE, &status), return false );
+
+	if (status == AL_PLAYING) {
+		OpenAL_ErrorPrint( alSourceStop(source_id) );
+	}
+
+	OpenAL_ErrorCheck( alSourcei(source_id, AL_BUFFER, sound_buffers[v.sid].buf_id), return false );
+
+	if (Ds_eax_inited) {
+		OpenAL_ErrorPrint( alSource3i(source_id, AL_AUXILIARY_SEND_FILTER, AL_EFX_aux_id, 0, AL_FILTER_NULL) );
+	}
+
+	OpenAL_ErrorPrint( alSourcei(source_id, AL_SOURCE_RELATIVE, AL_FALSE) );
+
+	OpenAL_ErrorPrint( alSourcei(source_id, AL_LOOPING, (v.looping) ? AL_TRUE : AL_FALSE) );
+
+	// a voice which was virtual continues where it would be by now
+	if (v.position > 0.0f) {
+		OpenAL_ErrorPrint( alSourcef(source_id, AL_SEC_OFFSET, v.position) );
+	}
+
+	OpenAL_ErrorPrint( alSourcePlay(source_id) );
+
+	sound_buffers[v.sid].channel_id = channel_id;
+
+	Channels[channel_id].sid = v.sid;
+	Channels[channel_id].snd_id = v.snd_id;
+	Channels[channel_id].sig = v.sig;
+	Channels[channel_id].last_position = 0;
+	Channels[channel_id].is_voice_msg = false;
+	Channels[channel_id].vol = v.gain;
+	Channels[channel_id].looping = v.looping ? TRUE : FALSE;
+	Channels[channel_id].priority = v.priority;
+	Channels[channel_id].is_ambient = v.is_ambient;
+
+	v.channel = channel_id;
+	v.dirty = false;
+
+	return true;
+}
+
 /**
  * Free a single channel
  */
@@ -562,6 +678,8 @@ void ds_close_channel(int i)
 	}
 
 	if ( (Channels[i].source_id != 0) && alIsSource(Channels[i].source_id) ) {
+		ds_voice_release_channel(i);
+
 		OpenAL_ErrorPrint( alSourceStop(Channels[i].source_id) );
 		OpenAL_ErrorPrint( alSourcei(Channels[i].source_id, AL_BUFFER, 0) );
 
@@ -589,6 +707,8 @@ void ds_close_channel_fast(int i)
 	}
 
 	if ( (Channels[i].source_id != 0) && alIsSource(Channels[i].source_id) ) {
+		ds_voice_release_channel(i);
+
 		OpenAL_ErrorPrint( alSourceStop(Channels[i].source_id) );
 		OpenAL_ErrorPrint( alSourcei(Channels[i].source_id, AL_BUFFER, 0) );
 
@@ -606,6 +726,24 @@ void ds_close_channel_fast(int i)
 	}
 }
 
+/**
+ * Removes a voice and stops its channel if it has one
+ */
+static void ds_voice_remove(ds_sound_handle sig)
+{
+	auto v = Voices.find(sig);
+	if (v == nullptr) {
+		return;
+	}
+
+	auto channel_id = v->channel;
+	Voices.remove(sig);
+
+	if (channel_id >= 0) {
+		ds_close_channel_fast(channel_id);
+	}
+}
+
 /**
  * Free all the channel buffers
  */
@@ -613,6 +751,8 @@ void ds_close_all_channels()
 {
 	int i;
 
+	Voices.clear();
+
 	for (i = 0; i < MAX_CHANNELS; i++) {
 		ds_close_channel(i);
 	}
@@ -627,6 +767,17 @@ void ds_unload_buffer(int sid)
 		return;
 	}
 
+	// voices playing this buffer may be on other channels or virtual
+	SCP_vector<ds_sound_handle> voices;
+	Voices.for_each([sid, &voices](const ds_voices::voice& v) {
+		if (v.sid == sid) {
+			voices.push_back(v.sig);
+		}
+	});
+	for (auto sig : voices) {
+		ds_voice_remove(sig);
+	}
+
 	if (sound_buffers[sid].channel_id >= 0) {
 		ds_close_channel_fast(sound_buffers[sid].channel_id);
 		sound_buffers[sid].channel_id = -1;
@@ -1186,6 +1337,8 @@ void ds_stop_channel_all()
 {
 	int i;
 
+	Voices.clear();
+
 	for ( i=0; i<MAX_CHANNELS; i++ ) {
 		if ( Channels[i].source_id != 0 ) {
 			OpenAL_ErrorPrint( alSourceStop(Channels[i].source_id) );
@@ -1265,9 +1418,79 @@ void ds_set_pitch(int channel_id, float pitch)
 	}
 }
 
+/**
+ * Find a channel which is not playing anything, without stopping any other sound
+ *
+ * @returns	Channel number, or -1 if all channels are busy
+ */
+static int ds_get_idle_channel()
+{
+	ALint status;
+
+	for (int i = 0; i < MAX_CHANNELS; i++) {
+		channel *chp = &Channels[i];
+
+		if (chp->source_id == 0) {
+			OpenAL_ErrorCheck( alGenSources(1, &chp->source_id), return -1 );
+			return i;
+		}
+
+		if (chp->sid == -1) {
+			return i;
+		}
+
+		OpenAL_ErrorCheck( alGetSourcei(chp->source_id, AL_SOURCE_STATE, &status), continue );
+
+		if ( (status == AL_INITIAL) || (status == AL_STOPPED) ) {
+			ds_close_channel_fast(i);
+			return i;
+		}
+	}
+
+	return -1;
+}
+
+/**
+ * Determines how important a voice is and how many instances of it may play at once
+ */
+static void ds_get_voice_priority(int priority, const EnhancedSoundData& enhanced_sound_data, int& voice_priority,
+	unsigned int& limit)
+{
+	if (!Cmdline_no_enhanced_sound) {
+		// same as ds_get_free_channel(), a retail must play sound is assumed to be important
+		voice_priority = (priority == DS_MUST_PLAY) ? SND_ENHANCED_PRIORITY_MUST_PLAY : enhanced_sound_data.priority;
+		limit = enhanced_sound_data.limit;
+		return;
+	}
+
+	// retail sounds only know the concurrency limits, everything else is decided by volume
+	voice_priority = (priority == DS_MUST_PLAY) ? SND_ENHANCED_PRIORITY_MUST_PLAY : SND_ENHANCED_PRIORITY_MEDIUM;
+
+	switch (priority) {
+		case DS_LIMIT_ONE:
+			limit = 1;
+			break;
+
+		case DS_LIMIT_TWO:
+			limit = 2;
+			break;
+
+		case DS_LIMIT_THREE:
+			limit = 3;
+			break;
+
+		default:
+			limit = 0;
+			break;
+	}
+}
+
 /**
  * Starts a ds3d sound playing
  *
+ * The sound becomes a virtual voice (see ds_voices) which is played right away if there is a free channel. Otherwise
+ * ds_do_frame() decides whether it is important enough to take the channel of another voice.
+ *
  * @param sid Software id for sound to play
  * @param snd_id Identifies what type of sound is playing
  * @param pos World pos of sound
@@ -1285,71 +1508,245 @@ ds_sound_handle ds3d_play(int sid, int snd_id, vec3d* pos, vec3d* vel, float min
                           float max_volume, float estimated_vol, const EnhancedSoundData* enhanced_sound_data,
                           int priority, bool is_ambient)
 {
-	int channel_id;
-	int enhanced_priority = SND_ENHANCED_PRIORITY_INVALID;
-
-
 	if (!ds_initialized) {
 		return ds_sound_handle::invalid();
 	}
 
-	channel_id = ds_get_free_channel(estimated_vol, snd_id, priority, enhanced_priority, *enhanced_sound_data);
-
-	if (channel_id < 0) {
+	if ( (sid < 0) || ((size_t)sid >= sound_buffers.size()) || (sound_buffers[sid].buf_id == 0) ) {
 		return ds_sound_handle::invalid();
 	}
 
-	if ( Channels[channel_id].source_id == 0 ) {
+	auto& buffer = sound_buffers[sid];
+
+	ds_voices::voice new_voice;
+	new_voice.sig = ds_sound_handle(channel_next_sig++);
+	new_voice.sid = sid;
+	new_voice.snd_id = snd_id;
+	if (pos) {
+		new_voice.pos = *pos;
+	}
+	if (vel) {
+		new_voice.vel = *vel;
+		new_voice.has_vel = true;
+	}
+	new_voice.min = min;
+	new_voice.max = max;
+	new_voice.gain = max_volume;
+	new_voice.looping = looping != 0;
+	new_voice.is_ambient = is_ambient;
+
+	int bytes_per_second = buffer.frequency * (buffer.bits_per_sample / 8) * buffer.nchannels;
+	if (bytes_per_second > 0) {
+		new_voice.duration = buffer.nbytes / (float)bytes_per_second;
+	}
+
+	ds_get_voice_priority(priority, *enhanced_sound_data, new_voice.priority, new_voice.limit);
+
+	if (channel_next_sig < 0 ) {
+		channel_next_sig = 1;
+	}
+
+	auto& v = Voices.add(new_voice);
+
+	if (estimated_vol < ds_voices::Min_audibility) {
+		return v.sig;
+	}
+
+	// don't exceed the concurrency limit here, the next update decides which instances are more important
+	if (v.limit > 0) {
+		unsigned int instances = 0;
+		Voices.for_each([&v, &instances](const ds_voices::voice& other) {
+			if ( (other.channel >= 0) && (other.snd_id == v.snd_id) ) {
+				++instances;
+			}
+		});
+
+		if (instances >= v.limit) {
+			return v.sig;
+		}
+	}
+
+	auto sig = v.sig;
+	auto channel_id = ds_get_idle_channel();
+
+	// getting a channel may have finished other voices which moves them around
+	auto added = Voices.find(sig);
+	Assertion(added != nullptr, "A voice which was just added could not be found!");
+
+	if ( (channel_id >= 0) && !ds_voice_bind(*added, channel_id) ) {
+		Voices.remove(sig);
 		return ds_sound_handle::invalid();
 	}
 
-	// set up 3D sound data here
-	ds3d_update_buffer(channel_id, min, max, pos, vel);
+	return sig;
+}
 
+bool ds_is_voice(ds_sound_handle sig)
+{
+	return Voices.find(sig) != nullptr;
+}
 
-	OpenAL_ErrorPrint( alSourcef(Channels[channel_id].source_id, AL_PITCH, 1.0f) );
+bool ds_voice_is_playing(ds_sound_handle sig)
+{
+	auto v = Voices.find(sig);
+	if (v == nullptr) {
+		return false;
+	}
 
-	OpenAL_ErrorPrint( alSourcef(Channels[channel_id].source_id, AL_GAIN, max_volume) );
+	if (v->channel < 0) {
+		return true;
+	}
 
-	ALint status;
-	OpenAL_ErrorCheck(alGetSourcei(Channels[channel_id].source_id, AL_SOURCE_STATE, &status),
-	                  return ds_sound_handle::invalid());
+	return ds_is_channel_playing(v->channel) == TRUE;
+}
 
-	if (status == AL_PLAYING) {
-		OpenAL_ErrorPrint( alSourceStop(Channels[channel_id].source_id) );
+void ds_voice_stop(ds_sound_handle sig)
+{
+	ds_voice_remove(sig);
+}
+
+void ds_voice_set_volume(ds_sound_handle sig, float vol)
+{
+	auto v = Voices.find(sig);
+	if (v == nullptr) {
+		return;
 	}
 
-	OpenAL_ErrorCheck(alSourcei(Channels[channel_id].source_id, AL_BUFFER, sound_buffers[sid].buf_id),
-	                  return ds_sound_handle::invalid());
+	CAP(vol, 0.0f, 1.0f);
+	v->gain = vol;
+	v->dirty = true;
+}
 
-	if (Ds_eax_inited) {
-		OpenAL_ErrorPrint( alSource3i(Channels[channel_id].source_id, AL_AUXILIARY_SEND_FILTER, AL_EFX_aux_id, 0, AL_FILTER_NULL) );
+float ds_voice_get_pitch(ds_sound_handle sig)
+{
+	auto v = Voices.find(sig);
+	if (v == nullptr) {
+		return -1.0f;
 	}
 
-	OpenAL_ErrorPrint( alSourcei(Channels[channel_id].source_id, AL_SOURCE_RELATIVE, AL_FALSE) );
+	return v->pitch;
+}
 
-	OpenAL_ErrorPrint( alSourcei(Channels[channel_id].source_id, AL_LOOPING, (looping) ? AL_TRUE : AL_FALSE) );
+void ds_voice_set_pitch(ds_sound_handle sig, float pitch)
+{
+	Assertion(pitch > 0.0f, "Pitch may not be less than zero!");
 
-	OpenAL_ErrorPrint( alSourcePlay(Channels[channel_id].source_id) );
+	auto v = Voices.find(sig);
+	if (v == nullptr) {
+		return;
+	}
 
+	v->pitch = pitch;
 
-	sound_buffers[sid].channel_id = channel_id;
+	// this is usually set right after the sound started so it shouldn't wait for the next frame
+	if (v->channel >= 0) {
+		OpenAL_ErrorPrint( alSourcef(Channels[v->channel].source_id, AL_PITCH, pitch) );
+	}
+}
 
-	Channels[channel_id].sid = sid;
-	Channels[channel_id].snd_id = snd_id;
-	Channels[channel_id].sig           = ds_sound_handle(channel_next_sig++);
-	Channels[channel_id].last_position = 0;
-	Channels[channel_id].is_voice_msg = false;
-	Channels[channel_id].vol = max_volume;
-	Channels[channel_id].looping = looping;
-	Channels[channel_id].priority = enhanced_priority;
-	Channels[channel_id].is_ambient = is_ambient;
+void ds_voice_update_3d(ds_sound_handle sig, float min, float max, const vec3d* pos, const vec3d* vel)
+{
+	auto v = Voices.find(sig);
+	if (v == nullptr) {
+		return;
+	}
 
-	if (channel_next_sig < 0 ) {
-		channel_next_sig = 1;
+	v->min = min;
+	v->max = max;
+	if (pos) {
+		v->pos = *pos;
+	}
+	if (vel) {
+		v->vel = *vel;
+		v->has_vel = true;
+	} else {
+		v->vel = vmd_zero_vector;
+		v->has_vel = false;
+	}
+	v->dirty = true;
+}
+
+MONITOR( NumVoices )
+MONITOR( NumBoundVoices )
+MONITOR( VoicePromotions )
+MONITOR( VoiceDemotions )
+
+/**
+ * Applies the changes of the bound voices and moves the channels to the most audible voices
+ */
+static void ds_update_voices()
+{
+	auto now = timer_get_microseconds();
+	float frametime = (Voices_last_update == 0) ? 0.0f : (now - Voices_last_update) / 1000000.0f;
+	Voices_last_update = now;
+
+	// bound voices which reached their end are done, the others get the parameters which changed since the last frame
+	SCP_vector<ds_sound_handle> finished;
+	Voices.for_each([&finished](ds_voices::voice& v) {
+		if (v.channel < 0) {
+			return;
+		}
+
+		if ( !ds_is_channel_playing(v.channel) ) {
+			finished.push_back(v.sig);
+			return;
+		}
+
+		if (v.dirty) {
+			auto source_id = Channels[v.channel].source_id;
+
+			ds3d_update_buffer(v.channel, v.min, v.max, &v.pos, v.has_vel ? &v.vel : nullptr);
+			OpenAL_ErrorPrint( alSourcef(source_id, AL_GAIN, v.gain) );
+			OpenAL_ErrorPrint( alSourcef(source_id, AL_PITCH, v.pitch) );
+
+			Channels[v.channel].vol = v.gain;
+			v.dirty = false;
+		}
+	});
+
+	for (auto sig : finished) {
+		ds_voice_remove(sig);
 	}
 
-	return Channels[channel_id].sig;
+	// channels which are playing other sounds can't be used
+	size_t num_channels = 0;
+	for (int i = 0; i < MAX_CHANNELS; i++) {
+		auto chp = &Channels[i];
+
+		if ( (chp->source_id == 0) || (chp->sid == -1) || !ds_is_channel_playing(i) ) {
+			++num_channels;
+		} else if (chp->sig.isValid() && (Voices.find(chp->sig) != nullptr)) {
+			++num_channels;
+		}
+	}
+
+	Voices.update(ds3d_get_listener_pos(), frametime, num_channels, Voice_changes);
+
+	for (auto sig : Voice_changes.demote) {
+		auto v = Voices.find(sig);
+		if ( (v != nullptr) && (v->channel >= 0) ) {
+			ds_close_channel_fast(v->channel);
+		}
+	}
+
+	for (auto sig : Voice_changes.promote) {
+		auto channel_id = ds_get_idle_channel();
+		if (channel_id < 0) {
+			break;
+		}
+
+		// getting a channel may have finished other voices
+		auto v = Voices.find(sig);
+		if ( (v != nullptr) && (v->channel < 0) && !ds_voice_bind(*v, channel_id) ) {
+			Voices.remove(sig);
+		}
+	}
+
+	auto& stats = Voices.get_stats();
+	mon_NumVoices = static_cast<int>(stats.num_voices);
+	mon_NumBoundVoices = static_cast<int>(stats.num_bound);
+	mon_VoicePromotions = static_cast<int>(stats.promotions);
+	mon_VoiceDemotions = static_cast<int>(stats.demotions);
 }
 
 /**
@@ -1834,6 +2231,10 @@ void ds_do_frame()
 	int i;
 	channel *cp = NULL;
 
+	if (!Cmdline_no_3d_sound) {
+		ds_update_voices();
+	}
+
 	for (i = 0; i < MAX_CHANNELS; i++) {
 		cp = &Channels[i];
 		Assert( cp != NULL );
@@ -59,6 +59,22 @@ using ds_sound_handle = ::util::ID<ds_sound_handle_tag, int, -1>;
 int ds_init();
 void ds_close();
 int ds_load_buffer(int *sid, int flags, sound::IAudioFile* file);
+
+/**
+ * @brief Decodes all audio data of a file into memory
+ *
+ * This does not touch any global state so it may be called from a worker thread as long as the file was opened from
+ * memory.
+ *
+ * @return @c false if the file has no valid audio format
+ */
+bool ds_read_audio_data(sound::IAudioFile* file, SCP_vector<uint8_t>& audio_buffer);
+
+/**
+ * @brief Uploads decoded audio data into a new sound buffer
+ * @return 0 on success, -1 on failure
+ */
+int ds_load_buffer(int *sid, int flags, const sound::AudioFileProperties& fileProps, const SCP_vector<uint8_t>& audio_buffer);
 void ds_unload_buffer(int sid);
 ds_sound_handle ds_play(int sid, int snd_id, int priority, const EnhancedSoundData* enhanced_sound_data, float volume,
                         float pan, int looping, bool is_voice_msg = false);
@@ -100,6 +116,19 @@ ds_sound_handle ds3d_play(int sid, int snd_id, vec3d* pos, vec3d* vel, float min
                           float max_volume, float estimated_vol, const EnhancedSoundData* enhanced_sound_data,
                           int priority = DS_MUST_PLAY, bool is_ambient = false);
 
+/*
+ * 3D sounds started with ds3d_play() are virtual voices which only get an OpenAL source while they are among the most
+ * audible sounds, see ds_voices. Their signature stays valid while they are virtual so these functions should be used
+ * for them instead of looking up their channel.
+ */
+bool ds_is_voice(ds_sound_handle sig);
+bool ds_voice_is_playing(ds_sound_handle sig);
+void ds_voice_stop(ds_sound_handle sig);
+void ds_voice_set_volume(ds_sound_handle sig, float vol);
+float ds_voice_get_pitch(ds_sound_handle sig);
+void ds_voice_set_pitch(ds_sound_handle sig, float pitch);
+void ds_voice_update_3d(ds_sound_handle sig, float min, float max, const vec3d* pos, const vec3d* vel);
+
 void ds_do_frame();
 
 // --------------------
@@ -18,6 +18,8 @@
 #include "sound/openal.h"
 #include "sound/sound.h"
 
+static vec3d Ds3d_listener_pos = vmd_zero_vector;
+
 
 // ---------------------------------------------------------------------------------------
 // ds3d_update_buffer()
@@ -98,6 +100,7 @@ int ds3d_update_listener(vec3d *pos, vec3d *vel, matrix *orient)
 
 	if (pos) {
 		OpenAL_ErrorPrint( alListener3f(AL_POSITION, pos->xyz.x, pos->xyz.y, -pos->xyz.z) );
+		Ds3d_listener_pos = *pos;
 	}
 
 	if (vel) {
@@ -121,3 +124,7 @@ int ds3d_update_listener(vec3d *pos, vec3d *vel, matrix *orient)
 	return 0;
 }
 
+const vec3d& ds3d_get_listener_pos()
+{
+	return Ds3d_listener_pos;
+}
@@ -15,4 +15,7 @@
 int	ds3d_update_listener(vec3d *pos, vec3d *vel, matrix *orient);
 int	ds3d_update_buffer(int channel, float min, float max, vec3d *pos, vec3d *vel);
 
+// The listener position of the last ds3d_update_listener() call
+const vec3d& ds3d_get_listener_pos();
+
 #endif /* __DS3D_H__ */
@@ -0,0 +1,166 @@
+
+#include "sound/ds_voices.h"
+
+#include <algorithm>
+
+const float ds_voices::Min_audibility = 0.01f;
+const float ds_voices::Hysteresis = 1.25f;
+
+float ds_voices::attenuation(float distance, float min, float max)
+{
+	if (distance > max) {
+		return 0.0f;
+	}
+
+	if (distance <= min || max <= min || min <= 0.0f) {
+		return 1.0f;
+	}
+
+	// OpenAL uses the inverse distance clamped model with the rolloff factor set up in ds3d_update_buffer()
+	const float min_gain = 0.05f;
+	auto rolloff = (min / max) / min_gain;
+
+	return min / (min + rolloff * (distance - min));
+}
+
+ds_voices::voice& ds_voices::add(const voice& new_voice)
+{
+	Assertion(new_voice.sig.isValid(), "Voices need a valid signature!");
+	Assertion(Indices.find(new_voice.sig.value()) == Indices.end(), "Voice %d was added twice!", new_voice.sig.value());
+
+	Indices[new_voice.sig.value()] = Voices.size();
+	Voices.push_back(new_voice);
+
+	return Voices.back();
+}
+
+void ds_voices::remove(ds_sound_handle sig)
+{
+	auto it = Indices.find(sig.value());
+	if (it == Indices.end()) {
+		return;
+	}
+
+	auto index = it->second;
+	Indices.erase(it);
+
+	if (index != Voices.size() - 1) {
+		Voices[index] = Voices.back();
+		Indices[Voices[index].sig.value()] = index;
+	}
+	Voices.pop_back();
+}
+
+void ds_voices::clear()
+{
+	Voices.clear();
+	Indices.clear();
+}
+
+ds_voices::voice* ds_voices::find(ds_sound_handle sig)
+{
+	auto it = Indices.find(sig.value());
+	if (it == Indices.end()) {
+		return nullptr;
+	}
+
+	return &Voices[it->second];
+}
+
+void ds_voices::update(const vec3d& listener, float frametime, size_t num_channels, changes& out)
+{
+	out.demote.clear();
+	out.promote.clear();
+
+	// Virtual voices keep playing without being heard
+	for (size_t i = 0; i < Voices.size();) {
+		auto& v = Voices[i];
+
+		if (v.channel < 0) {
+			v.position += frametime * v.pitch;
+
+			if (v.position >= v.duration) {
+				if (v.looping && v.duration > 0.0f) {
+					v.position = fmodf(v.position, v.duration);
+				} else {
+					remove(v.sig);
+					continue;
+				}
+			}
+		}
+
+		++i;
+	}
+
+	Order.clear();
+	for (size_t i = 0; i < Voices.size(); ++i) {
+		auto& v = Voices[i];
+
+		v.audibility = v.gain * attenuation(vm_vec_dist(&v.pos, &listener), v.min, v.max);
+		if (v.audibility >= Min_audibility) {
+			Order.push_back(i);
+		}
+	}
+
+	// The most important voices come first, bound voices get a bit of an advantage so that voices of about the same
+	// volume don't keep swapping their channels
+	std::sort(Order.begin(), Order.end(), [this](size_t left_index, size_t right_index) {
+		auto& left = Voices[left_index];
+		auto& right = Voices[right_index];
+
+		if (left.priority != right.priority) {
+			return left.priority < right.priority;
+		}
+
+		auto left_audibility = left.channel >= 0 ? left.audibility * Hysteresis : left.audibility;
+		auto right_audibility = right.channel >= 0 ? right.audibility * Hysteresis : right.audibility;
+		if (left_audibility != right_audibility) {
+			return left_audibility > right_audibility;
+		}
+
+		return left.sig.value() < right.sig.value();
+	});
+
+	Instances.clear();
+	SCP_vector<bool> selected(Voices.size(), false);
+	size_t num_selected = 0;
+
+	for (auto index : Order) {
+		if (num_selected >= num_channels) {
+			break;
+		}
+
+		auto& v = Voices[index];
+		auto& instances = Instances[v.snd_id];
+		if (v.limit > 0 && instances >= v.limit) {
+			continue;
+		}
+
+		++instances;
+		++num_selected;
+		selected[index] = true;
+	}
+
+	Stats.num_bound = 0;
+	for (size_t i = 0; i < Voices.size(); ++i) {
+		auto& v = Voices[i];
+
+		if (selected[i]) {
+			++Stats.num_bound;
+			if (v.channel < 0) {
+				out.promote.push_back(v.sig);
+			}
+		} else if (v.channel >= 0) {
+			out.demote.push_back(v.sig);
+		}
+	}
+
+	Stats.num_voices = Voices.size();
+	Stats.promotions = out.promote.size();
+	Stats.demotions = out.demote.size();
+}
+
+const ds_voices::stats& ds_voices::get_stats() const
+{
+	return Stats;
+}
@@ -0,0 +1,121 @@
+#pragma once
+
+#include "globalincs/pstypes.h"
+#include "math/vecmat.h"
+#include "sound/ds.h"
+
+/**
+ * @brief Decides which of the playing 3D sounds are bound to an OpenAL source
+ *
+ * Every 3D sound that is started becomes a voice. A voice only holds the parameters of the sound, so any amount of them
+ * may exist. Once per frame update() computes how audible every voice is for the listener and picks the most important
+ * ones for the available sources. Voices which lost their source keep track of their playback position so they can
+ * continue at the right spot once they become important enough again. Sounds which are not looping end while they are
+ * virtual if their duration has passed.
+ *
+ * This class only does the bookkeeping, binding the voices to sources and stopping them is done by the caller.
+ */
+class ds_voices {
+  public:
+	struct voice {
+		ds_sound_handle sig;
+		int sid = -1;    //!< The sound buffer to play
+		int snd_id = -1; //!< Which kind of sound this is, used for the instance limit
+
+		vec3d pos = vmd_zero_vector;
+		vec3d vel = vmd_zero_vector;
+		bool has_vel = false; //!< Without a velocity the doppler effect is turned off, see ds3d_update_buffer()
+		float min = 0.0f; //!< Distance at which the sound doesn't get any louder
+		float max = 0.0f; //!< Distance at which the sound becomes inaudible
+
+		float gain = 1.0f;
+		float pitch = 1.0f;
+
+		int priority = 0;        //!< Lower values are more important, see EnhancedSoundPriority
+		unsigned int limit = 0;  //!< How many voices of the same kind may be bound at once, 0 means no limit
+		bool looping = false;
+		bool is_ambient = false;
+
+		float duration = 0.0f; //!< In seconds
+		float position = 0.0f; //!< Playback position in seconds while the voice is virtual
+
+		int channel = -1;      //!< The channel this is bound to or -1 if the voice is virtual
+		bool dirty = false;    //!< The parameters changed since they were last applied to the channel
+
+		float audibility = 0.0f;
+	};
+
+	struct changes {
+		SCP_vector<ds_sound_handle> demote;  //!< Bound voices which should give up their channel
+		SCP_vector<ds_sound_handle> promote; //!< Virtual voices which should get a channel
+	};
+
+	struct stats {
+		size_t num_voices = 0;
+		size_t num_bound = 0;
+		size_t promotions = 0; //!< In the last update
+		size_t demotions = 0;  //!< In the last update
+	};
+
+  private:
+	SCP_vector<voice> Voices;
+	SCP_unordered_map<int, size_t> Indices; //!< Maps the signature of a voice to its index in Voices
+
+	SCP_vector<size_t> Order;
+	SCP_unordered_map<int, unsigned int> Instances;
+
+	stats Stats;
+
+  public:
+	/**
+	 * @brief Audibility below which a voice never gets a channel
+	 */
+	static const float Min_audibility;
+
+	/**
+	 * @brief How much more audible a virtual voice has to be than a bound one to take its channel
+	 */
+	static const float Hysteresis;
+
+	/**
+	 * @brief The volume of a voice at a distance, uses the distance model of ds3d_update_buffer()
+	 */
+	static float attenuation(float distance, float min, float max);
+
+	voice& add(const voice& new_voice);
+
+	void remove(ds_sound_handle sig);
+
+	void clear();
+
+	/**
+	 * @return The voice or nullptr if the signature does not belong to a voice
+	 */
+	voice* find(ds_sound_handle sig);
+
+	/**
+	 * @brief Calls the function for every voice, the voices must not be added or removed while doing that
+	 */
+	template <typename Func>
+	void for_each(Func&& func)
+	{
+		for (auto& v : Voices) {
+			func(v);
+		}
+	}
+
+	/**
+	 * @brief Advances the virtual voices and decides which voices should be bound
+	 *
+	 * Virtual voices which are not looping and reached their end are removed. The caller should remove bound voices
+	 * whose source stopped before calling this. The channels of the voices are not changed by this function.
+	 *
+	 * @param listener The position of the listener
+	 * @param frametime The time since the last update in seconds
+	 * @param num_channels How many channels may be used by voices
+	 * @param out The voices which should be demoted and promoted
+	 */
+	void update(const vec3d& listener, float frametime, size_t num_channels, changes& out);
+
+	const stats& get_stats() const;
+};
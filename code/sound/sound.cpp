@@ -15,6 +15,7 @@
 #include "globalincs/alphacolors.h"
 #include "globalincs/pstypes.h"
 #include "globalincs/vmallocator.h"
+#include "io/timer.h"
 #include "menuui/mainhallmenu.h"
 #include "mod_table/mod_table.h"
 #include "options/Option.h"
@@ -26,12 +27,14 @@
 #include "sound/dscap.h"
 #include "tracing/Monitor.h"
 #include "tracing/tracing.h"
+#include "utils/ThreadPool.h"
 
 #ifdef WITH_FFMPEG
 #include "sound/ffmpeg/FFmpegWaveFile.h"
 #endif
 
 #include <climits>
+#include <future>
 
 #define SND_F_USED			(1<<0)		// Sounds[] element is used
 
@@ -47,6 +50,9 @@ struct loaded_sound {
 
 SCP_vector<loaded_sound> Sounds;
 
+// Maps the filename of a loaded sound and whether it can be used as a 3D sound to its index in Sounds[]
+static SCP_unordered_map<SCP_string, int> Sound_registry;
+
 int Sound_enabled = FALSE;				// global flag to turn sound on/off
 size_t Snd_sram;								// mem (in bytes) used up by storing sounds in system memory
 
@@ -152,6 +158,7 @@ int ds_priority(int priority)
 void snd_clear()
 {
 	Sounds.clear();
+	Sound_registry.clear();
 
 	// reset how much storage sounds are taking up in memory
 	Snd_sram = 0;
@@ -277,6 +284,54 @@ void snd_spew_debug_info()
 	gr_printf_no_resize(sx, sy, "Total sounds : %d\n", game_sounds + interface_sounds + message_sounds);
 }
 
+static SCP_string snd_registry_key(const char* filename, bool usable_3d)
+{
+	SCP_string key(filename);
+	SCP_tolower(key);
+	key += usable_3d ? "|3d" : "|2d";
+	return key;
+}
+
+static void snd_registry_add(size_t n)
+{
+	auto& snd = Sounds[n];
+	auto result = Sound_registry.emplace(snd_registry_key(snd.filename, snd.info.n_channels == 1), static_cast<int>(n));
+	Assertion(result.second, "Sound '%s' was loaded twice in the same mode!", snd.filename);
+}
+
+static void snd_registry_remove(size_t n)
+{
+	auto& snd = Sounds[n];
+	auto it = Sound_registry.find(snd_registry_key(snd.filename, snd.info.n_channels == 1));
+	if (it != Sound_registry.end() && it->second == static_cast<int>(n)) {
+		Sound_registry.erase(it);
+	}
+}
+
+// Finds an already loaded sound which may be used in the requested mode
+//
+// NOTE: this will allow a duplicate 3D entry if 2D stereo entry exists,
+//       but will not load a duplicate 2D entry to get stereo if 3D
+//       version already loaded
+static int snd_find_loaded(const char* filename, bool use_3d)
+{
+	int n = -1;
+
+	auto it = Sound_registry.find(snd_registry_key(filename, true));
+	if (it != Sound_registry.end()) {
+		n = it->second;
+	}
+
+	if (!use_3d) {
+		it = Sound_registry.find(snd_registry_key(filename, false));
+		if (it != Sound_registry.end() && (n < 0 || it->second < n)) {
+			n = it->second;
+		}
+	}
+
+	return n;
+}
+
 static std::unique_ptr<sound::IAudioFile> openAudioFile(const char* fileName)
 {
 #ifdef WITH_FFMPEG
@@ -292,6 +347,163 @@ static std::unique_ptr<sound::IAudioFile> openAudioFile(const char* fileName)
 	return nullptr;
 }
 
+// Reads the whole file into memory so that it can be decoded without touching cfile
+static std::unique_ptr<sound::IAudioFile> openAudioFileMem(const char* fileName)
+{
+#ifdef WITH_FFMPEG
+	auto res = cf_find_file_location_ext(fileName, NUM_AUDIO_EXT, audio_ext_list, CF_TYPE_ANY);
+	if (!res.found) {
+		mprintf(("SOUND ==> Could not find wave file %s\n", fileName));
+		return nullptr;
+	}
+
+	auto cfp = cfopen_special(res, "rb", CF_TYPE_ANY);
+	if (cfp == nullptr) {
+		mprintf(("SOUND ==> Could not open wave file %s\n", fileName));
+		return nullptr;
+	}
+
+	SCP_vector<uint8_t> data(cfilelength(cfp));
+	auto read_ok = data.empty() || cfread(data.data(), static_cast<int>(data.size()), 1, cfp) == 1;
+	cfclose(cfp);
+
+	if (!read_ok) {
+		mprintf(("SOUND ==> Could not read wave file %s\n", fileName));
+		return nullptr;
+	}
+
+	std::unique_ptr<sound::IAudioFile> audio_file(new sound::ffmpeg::FFmpegWaveFile());
+	if (audio_file->OpenMem(data.data(), data.size())) {
+		return audio_file;
+	}
+
+	mprintf(("SOUND ==> Could not decode wave file %s\n", fileName));
+#else
+	SCP_UNUSED(fileName);
+#endif
+
+	return nullptr;
+}
+
+// Sets up the conversion of an opened sound file for the mode it is loaded in
+static void snd_prepare_audio_file(sound::IAudioFile* audio_file, const game_snd_entry* entry, const int* flags)
+{
+	if (!(flags && *flags & GAME_SND_USE_DS3D)) {
+		return;
+	}
+
+	auto fileProps = audio_file->getFileProperties();
+	if (fileProps.num_channels <= 1) {
+		return;
+	}
+
+	// We need to resample the audio down to one channel
+	sound::ResampleProperties resample;
+	resample.num_channels = 1;
+
+	audio_file->setResamplingProperties(resample);
+
+#ifndef NDEBUG
+	// Retail has a few sounds that triggers this warning so we need to ignore those
+	const char* warning_ignore_list[] = {
+		"l_hit.wav",
+		"m_hit.wav",
+		"s_hit_2.wav",
+		"Pirate.wav",
+	};
+
+	bool show_warning = true;
+	for (auto& name : warning_ignore_list) {
+		if (!stricmp(name, entry->filename)) {
+			show_warning = false;
+			break;
+		}
+	}
+
+	if (show_warning) {
+		if (mod_supports_version(3, 8, 0)) {
+			// This warning was introduced in 3.8.0 and caused a few issues since a lot of mods use 3D sounds
+			// with more than one channel. This will silence the warnings for any mod that does not support
+			// 3.8.0.
+			Warning(LOCATION,
+					"Sound '%s' has more than one channel but is used as a 3D sound! 3D sounds may only have "
+					"one channel.",
+					entry->filename);
+		} else {
+			mprintf(("Warning: Sound '%s' has more than one channel but is used as a 3D sound! 3D sounds may "
+					 "only have one channel.\n",
+					 entry->filename));
+		}
+	}
+#else
+	SCP_UNUSED(entry);
+#endif
+}
+
+// Creates the Sounds[] entry of a decoded sound
+static sound_load_id snd_create_loaded_sound(game_snd_entry* entry, int* flags,
+	const sound::AudioFileProperties& fileProps, const SCP_vector<uint8_t>& audio_data)
+{
+	size_t n;
+
+	for (n = 0; n < Sounds.size(); n++) {
+		if ( !(Sounds[n].flags & SND_F_USED) ) {
+			break;
+		}
+	}
+
+	if ( n == Sounds.size() ) {
+		loaded_sound new_sound;
+		new_sound.sid   = -1;
+		new_sound.flags = 0;
+
+		Sounds.push_back(new_sound);
+	}
+
+	auto snd = &Sounds[n];
+	auto si = &snd->info;
+
+	int type = 0;
+	if (flags && *flags & GAME_SND_USE_DS3D) {
+		type |= DS_3D;
+	}
+
+	// Load was a success
+	si->n_channels        = fileProps.num_channels; // 16-bit channel count (nChannels)
+	si->sample_rate       = fileProps.sample_rate;  // 32-bit sample rate (nSamplesPerSec)
+	si->avg_bytes_per_sec = fileProps.sample_rate * fileProps.bytes_per_sample *
+							fileProps.num_channels; // 32-bit average bytes per second (nAvgBytesPerSec)
+	si->bits = fileProps.bytes_per_sample * 8;      // Read 16-bit bits per sample
+	si->size = fileProps.total_samples * fileProps.bytes_per_sample * fileProps.num_channels;
+
+	snd->uncompressed_size = si->size;
+
+	auto rc = ds_load_buffer(&snd->sid, type, fileProps, audio_data);
+	if (rc == -1) {
+		nprintf(("Sound", "SOUND ==> Failed to load '%s'\n", entry->filename));
+		if (flags)
+			*flags |= GAME_SND_NOT_VALID;
+		return sound_load_id::invalid();
+	}
+
+	// NOTE: "si" values can change once loaded in the buffer
+	snd->duration = fl2i(1000.0f * fileProps.duration);
+
+	strcpy_s( snd->filename, entry->filename );
+	snd->flags = SND_F_USED;
+
+	snd->sig = snd_next_sig++;
+	if (snd_next_sig < 0 ) snd_next_sig = 1;
+	entry->id_sig = snd->sig;
+	entry->id     = sound_load_id(static_cast<int>(n));
+
+	snd_registry_add(n);
+
+	nprintf(("Sound", "SOUND ==> Finished loading '%s'\n", entry->filename));
+
+	return sound_load_id(static_cast<int>(n));
+}
+
 // ---------------------------------------------------------------------------------------
 // snd_load() 
 //
@@ -310,10 +522,7 @@ static std::unique_ptr<sound::IAudioFile> openAudioFile(const char* fileName)
 //int snd_load( char *filename, int hardware, int use_ds3d, int *sig)
 sound_load_id snd_load(game_snd_entry* entry, int *flags, int /*allow_hardware_load*/)
 {
-	int type;
-	sound_info* si;
-	loaded_sound* snd;
-	size_t n;
+	memory::TagScope tag(memory::Tag::Sound);
 
 	if (!ds_initialized)
 		return sound_load_id::invalid();
@@ -324,33 +533,11 @@ sound_load_id snd_load(game_snd_entry* entry, int *flags, int /*allow_hardware_l
 	if (flags && *flags & GAME_SND_NOT_VALID)
 		return sound_load_id::invalid();
 
-	for (n = 0; n < Sounds.size(); n++) {
-		if ( !(Sounds[n].flags & SND_F_USED) ) {
-			break;
-		} else if ( !stricmp( Sounds[n].filename, entry->filename) ) {
-			// extra check: make sure the sound is actually loaded in a compatible way (2D vs. 3D)
-			//
-			// NOTE: this will allow a duplicate 3D entry if 2D stereo entry exists,
-			//       but will not load a duplicate 2D entry to get stereo if 3D
-			//       version already loaded
-			if ( (Sounds[n].info.n_channels == 1) || !(flags && *flags & GAME_SND_USE_DS3D) ) {
-				return sound_load_id(static_cast<int>(n));
-			}
-		}
+	auto existing = snd_find_loaded(entry->filename, flags && *flags & GAME_SND_USE_DS3D);
+	if (existing >= 0) {
+		return sound_load_id(existing);
 	}
 
-	if ( n == Sounds.size() ) {
-		loaded_sound new_sound;
-		new_sound.sid   = -1;
-		new_sound.flags = 0;
-
-		Sounds.push_back(new_sound);
-	}
-
-	snd = &Sounds[n];
-
-	si = &snd->info;
-
 	TRACE_SCOPE(tracing::LoadSound);
 
 	nprintf(("Sound", "SOUND ==> Loading '%s'\n", entry->filename));
@@ -363,88 +550,150 @@ sound_load_id snd_load(game_snd_entry* entry, int *flags, int /*allow_hardware_l
 		return sound_load_id::invalid();
 	}
 
-	auto fileProps = audio_file->getFileProperties();
+	snd_prepare_audio_file(audio_file.get(), entry, flags);
 
-	type = 0;
-	if (flags && *flags & GAME_SND_USE_DS3D) {
-		type |= DS_3D;
+	SCP_vector<uint8_t> audio_data;
+	if (!ds_read_audio_data(audio_file.get(), audio_data)) {
+		nprintf(("Sound", "SOUND ==> Failed to load '%s'\n", entry->filename));
+		if (flags)
+			*flags |= GAME_SND_NOT_VALID;
+		return sound_load_id::invalid();
+	}
 
-		if (fileProps.num_channels > 1) {
-			// We need to resample the audio down to one channel
-			sound::ResampleProperties resample;
-			resample.num_channels = 1;
+	return snd_create_loaded_sound(entry, flags, audio_file->getFileProperties(), audio_data);
+}
 
-			audio_file->setResamplingProperties(resample);
-			fileProps = audio_file->getFileProperties(); // Refresh properties so that we have accurate information
+// ---------------------------------------------------------------------------------------
+// snd_load_all()
+//
+// Load a set of sounds, see the declaration in sound.h.  While the main thread reads the next
+// files the previous ones are decoded on the worker pool.  The amount of decoded sounds
+// which wait for their buffer is limited so that the memory use stays bounded.
+//
+SCP_vector<sound_load_id> snd_load_all(const SCP_vector<snd_load_request>& requests, const std::function<void()>& on_loaded)
+{
+	memory::TagScope tag(memory::Tag::Sound);
 
-#ifndef NDEBUG
-			// Retail has a few sounds that triggers this warning so we need to ignore those
-			const char* warning_ignore_list[] = {
-				"l_hit.wav",
-				"m_hit.wav",
-				"s_hit_2.wav",
-				"Pirate.wav",
-			};
-
-			bool show_warning = true;
-			for (auto& name : warning_ignore_list) {
-				if (!stricmp(name, entry->filename)) {
-					show_warning = false;
-					break;
-				}
-			}
+	SCP_vector<sound_load_id> results(requests.size(), sound_load_id::invalid());
 
-			if (show_warning) {
-				if (mod_supports_version(3, 8, 0)) {
-					// This warning was introduced in 3.8.0 and caused a few issues since a lot of mods use 3D sounds
-					// with more than one channel. This will silence the warnings for any mod that does not support
-					// 3.8.0.
-					Warning(LOCATION,
-							"Sound '%s' has more than one channel but is used as a 3D sound! 3D sounds may only have "
-							"one channel.",
-							entry->filename);
-				} else {
-					mprintf(("Warning: Sound '%s' has more than one channel but is used as a 3D sound! 3D sounds may "
-							 "only have one channel.\n",
-							 entry->filename));
-				}
+	if (!ds_initialized || requests.empty())
+		return results;
+
+	TRACE_SCOPE(tracing::LoadSound);
+
+	struct pending_sound {
+		size_t request;
+		std::unique_ptr<sound::IAudioFile> audio_file; //!< nullptr if this is a duplicate of an earlier request
+		SCP_vector<uint8_t> audio_data;
+		std::future<bool> decoded;
+	};
+
+	auto& pool = util::get_thread_pool();
+	const size_t max_pending = 2 * pool.numThreads() + 2;
+
+	auto start_time = timer_get_microseconds();
+	std::uint64_t wait_time = 0;
+	size_t num_decoded = 0;
+	size_t decoded_bytes = 0;
+
+	SCP_deque<std::unique_ptr<pending_sound>> pending;
+	SCP_unordered_set<SCP_string> batch_keys;
+
+	auto finish_oldest = [&]() {
+		auto sound = std::move(pending.front());
+		pending.pop_front();
+
+		auto& request = requests[sound->request];
+		auto& result = results[sound->request];
+
+		bool decoded = false;
+		if (sound->audio_file != nullptr) {
+			auto wait_start = timer_get_microseconds();
+			decoded = sound->decoded.get();
+			wait_time += timer_get_microseconds() - wait_start;
+		}
+
+		if (request.flags && *request.flags & GAME_SND_NOT_VALID) {
+			// An earlier entry of the same game sound failed to load
+		} else {
+			auto existing = snd_find_loaded(request.entry->filename, request.flags && *request.flags & GAME_SND_USE_DS3D);
+			if (existing >= 0) {
+				result = sound_load_id(existing);
+			} else if (decoded) {
+				result = snd_create_loaded_sound(request.entry, request.flags, sound->audio_file->getFileProperties(),
+					sound->audio_data);
+
+				++num_decoded;
+				decoded_bytes += sound->audio_data.size();
+			} else {
+				// Duplicates are finished after the first request of their file, so that one failed as well
+				nprintf(("Sound", "SOUND ==> Failed to load '%s'\n", request.entry->filename));
+				if (request.flags)
+					*request.flags |= GAME_SND_NOT_VALID;
 			}
-#endif
 		}
-	}
 
-	// Load was a success
-	si->n_channels        = fileProps.num_channels; // 16-bit channel count (nChannels)
-	si->sample_rate       = fileProps.sample_rate;  // 32-bit sample rate (nSamplesPerSec)
-	si->avg_bytes_per_sec = fileProps.sample_rate * fileProps.bytes_per_sample *
-							fileProps.num_channels; // 32-bit average bytes per second (nAvgBytesPerSec)
-	si->bits = fileProps.bytes_per_sample * 8;      // Read 16-bit bits per sample
-	si->size = fileProps.total_samples * fileProps.bytes_per_sample * fileProps.num_channels;
+		if (on_loaded) {
+			on_loaded();
+		}
+	};
 
-	snd->uncompressed_size = si->size;
+	for (size_t i = 0; i < requests.size(); ++i) {
+		auto entry = requests[i].entry;
+		auto flags = requests[i].flags;
 
-	auto rc = ds_load_buffer(&snd->sid, type, audio_file.get());
-	if (rc == -1) {
-		nprintf(("Sound", "SOUND ==> Failed to load '%s'\n", entry->filename));
-		if (flags)
-			*flags |= GAME_SND_NOT_VALID;
-		return sound_load_id::invalid();
-	}
+		if (!VALID_FNAME(entry->filename))
+			continue;
 
-	// NOTE: "si" values can change once loaded in the buffer
-	snd->duration = fl2i(1000.0f * fileProps.duration);
+		if (flags && *flags & GAME_SND_NOT_VALID)
+			continue;
 
-	strcpy_s( snd->filename, entry->filename );
-	snd->flags = SND_F_USED;
+		bool use_3d = flags && *flags & GAME_SND_USE_DS3D;
 
-	snd->sig = snd_next_sig++;
-	if (snd_next_sig < 0 ) snd_next_sig = 1;
-	entry->id_sig = snd->sig;
-	entry->id     = sound_load_id(static_cast<int>(n));
+		auto existing = snd_find_loaded(entry->filename, use_3d);
+		if (existing >= 0) {
+			results[i] = sound_load_id(existing);
+			continue;
+		}
 
-	nprintf(("Sound", "SOUND ==> Finished loading '%s'\n", entry->filename));
+		std::unique_ptr<pending_sound> sound(new pending_sound());
+		sound->request = i;
 
-	return sound_load_id(static_cast<int>(n));
+		// The same file is often used by several game sounds, that is resolved once the first one is loaded
+		if (batch_keys.insert(snd_registry_key(entry->filename, use_3d)).second) {
+			nprintf(("Sound", "SOUND ==> Loading '%s'\n", entry->filename));
+
+			sound->audio_file = openAudioFileMem(entry->filename);
+
+			if (sound->audio_file == nullptr) {
+				if (flags)
+					*flags |= GAME_SND_NOT_VALID;
+				continue;
+			}
+
+			snd_prepare_audio_file(sound->audio_file.get(), entry, flags);
+
+			auto file = sound->audio_file.get();
+			auto audio_data = &sound->audio_data;
+			sound->decoded = pool.submit([file, audio_data]() { return ds_read_audio_data(file, *audio_data); });
+		}
+
+		pending.push_back(std::move(sound));
+
+		while (pending.size() > max_pending) {
+			finish_oldest();
+		}
+	}
+
+	while (!pending.empty()) {
+		finish_oldest();
+	}
+
+	mprintf(("SOUND ==> Loaded " SIZE_T_ARG " of " SIZE_T_ARG " sounds (%.2f MB) in %.3f ms, %.3f ms spent waiting for the decoder\n",
+		num_decoded, requests.size(), decoded_bytes / (1024.0 * 1024.0), (timer_get_microseconds() - start_time) / 1000.0,
+		wait_time / 1000.0));
+
+	return results;
 }
 
 // ---------------------------------------------------------------------------------------
@@ -468,6 +717,10 @@ int snd_unload(sound_load_id n)
 
 	auto& snd = Sounds[n.value()];
 
+	if (snd.flags & SND_F_USED) {
+		snd_registry_remove(n.value());
+	}
+
 	ds_unload_buffer(snd.sid);
 
 	if (snd.sid != -1) {
@@ -508,6 +761,7 @@ void snd_close(void)
 	snd_stop_all();
 	if (!ds_initialized) return;
 	snd_unload_all();		// free the sound data stored in DirectSound secondary buffers
+	audiostream_close();	// stop the streaming thread while OpenAL is still around
 	dscap_close();	// Close DirectSoundCapture
 	ds_close();		// Close DirectSound off
 }
@@ -790,15 +1044,21 @@ void snd_update_3d_pos(sound_handle soundnum, game_snd* gs, vec3d* new_pos, floa
 
 		Assertion( gs != NULL, "*gs was NULL in snd_update_3d_pos(); get a coder!\n" );
 
+		float min_range = (float) (fl2i( (gs->min) * range_factor));
+		float max_range = (float) ((int)std::lround((gs->max) * range_factor));
+
+		// the position of virtual voices is only applied once they get a channel
+		if (ds_is_voice(soundnum)) {
+			ds_voice_update_3d(soundnum, min_range, max_range, new_pos, nullptr);
+			return;
+		}
+
 		channel = ds_get_channel(soundnum);
 		if (channel == -1) {
 			nprintf(( "Sound", "WARNING: Trying to set position for a non-playing sound.\n" ));
 			return;
 		}
 
-		float min_range = (float) (fl2i( (gs->min) * range_factor));
-		float max_range = (float) ((int)std::lround((gs->max) * range_factor));
-
 		ds3d_update_buffer(channel, min_range, max_range, new_pos, NULL);
 	}
 }
@@ -955,6 +1215,12 @@ void snd_stop(sound_handle sig)
 	if (!sig.isValid())
 		return;
 
+	if (ds_is_voice(sig)) {
+		remove_looping_sound(currentlyLooping3dSoundInfos, sig);
+		ds_voice_stop(sig);
+		return;
+	}
+
 	channel = ds_get_channel(sig);
 	if ( channel == -1 )
 		return;
@@ -988,6 +1254,16 @@ SCP_list<LoopingSoundInfo>::iterator find_looping_sound(SCP_list<LoopingSoundInf
 	});
 }
 
+// Sets the volume of a sound which may be a virtual voice, the volume is in linear scale
+static void snd_set_playing_volume(sound_handle sig, float volume)
+{
+	if (ds_is_voice(sig)) {
+		ds_voice_set_volume(sig, volume);
+	} else {
+		ds_set_volume(ds_get_channel(sig), volume);
+	}
+}
+
 /**
  * Set the volume of a currently playing sound
  *
@@ -1006,7 +1282,7 @@ void snd_set_volume(sound_handle sig, float volume)
 		return;
 
 	channel = ds_get_channel(sig);
-	if ( channel == -1 ) {
+	if ( (channel == -1) && !ds_is_voice(sig) ) {
 		nprintf(( "Sound", "WARNING: Trying to set volume for a non-playing sound.\n" ));
 		return;
 	}
@@ -1029,7 +1305,7 @@ void snd_set_volume(sound_handle sig, float volume)
 	//looping sound volumes are updated in snd_do_frame
 	if(!isLoopingSound) {
 		new_volume = volume * (Master_sound_volume * aav_effect_volume);
-		ds_set_volume( channel, new_volume );
+		snd_set_playing_volume(sig, new_volume);
 	}
 }
 
@@ -1079,6 +1355,9 @@ float snd_get_pitch(sound_handle sig)
 	if (!sig.isValid())
 		return -1;
 
+	if (ds_is_voice(sig))
+		return ds_voice_get_pitch(sig);
+
 	channel = ds_get_channel(sig);
 	if ( channel == -1 ) {
 		nprintf(( "Sound", "WARNING: Trying to get pitch for a non-playing sound.\n" ));
@@ -1104,6 +1383,11 @@ void snd_set_pitch(sound_handle sig, float pitch)
 	if (!sig.isValid())
 		return;
 
+	if (ds_is_voice(sig)) {
+		ds_voice_set_pitch(sig, pitch);
+		return;
+	}
+
 	channel = ds_get_channel(sig);
 	if ( channel == -1 ) {
 		nprintf(( "Sound", "WARNING: Trying to set pitch for a non-playing sound.\n" ));
@@ -1133,6 +1417,10 @@ int snd_is_playing(sound_handle sig)
 	if (!sig.isValid())
 		return 0;
 
+	// a virtual voice is still playing even though it can't be heard
+	if (ds_is_voice(sig))
+		return ds_voice_is_playing(sig) ? 1 : 0;
+
 	channel = ds_get_channel(sig);
 	if ( channel == -1 )
 		return 0;
@@ -1489,7 +1777,7 @@ void update_looping_sound_volumes(SCP_list<LoopingSoundInfo> &looping_sounds)
 	for (auto &looping_sound : looping_sounds) {
 		const float new_volume =
 			looping_sound.m_defaultVolume * looping_sound.m_dynamicVolume * (Master_sound_volume * aav_effect_volume);
-		ds_set_volume(ds_get_channel(looping_sound.m_dsHandle), new_volume);
+		snd_set_playing_volume(looping_sound.m_dsHandle, new_volume);
 	}
 }
 
@@ -127,6 +127,17 @@ void snd_set_voice_volume(float volume);
 //int	snd_load( char *filename, int hardware=0, int three_d=0, int *sig=NULL );
 sound_load_id snd_load(game_snd_entry* entry, int* flags, int allow_hardware_load = 0);
 
+struct snd_load_request {
+	game_snd_entry* entry;
+	int* flags; //!< can be nullptr, see snd_load()
+};
+
+// Loads a set of sounds at once. The files are read on the calling thread and decoded in parallel on the worker pool,
+// the sound buffers are then created in the order of the requests. The result for every request is the same as a call
+// to snd_load() would return. on_loaded is called after every finished request, e.g. for animating a loading screen.
+SCP_vector<sound_load_id> snd_load_all(const SCP_vector<snd_load_request>& requests,
+                                       const std::function<void()>& on_loaded = nullptr);
+
 int snd_unload(sound_load_id sndnum);
 void	snd_unload_all();
 
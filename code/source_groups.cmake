@@ -81,11 +81,15 @@ add_file_folder("AI"
 	ai/aiinternal.h
 	ai/ailua.cpp
 	ai/ailua.h
+	ai/aischeduler.cpp
+	ai/aischeduler.h
 	ai/aiturret.cpp
 )
 
 # Anim files
 add_file_folder("Anim"
+	anim/anim_frame_cache.cpp
+	anim/anim_frame_cache.h
 	anim/animplay.cpp
 	anim/animplay.h
 	anim/packunpack.cpp
@@ -106,7 +110,13 @@ add_file_folder("Autopilot"
 
 # Bmpman files
 add_file_folder("Bmpman"
+	bmpman/bm_convert.cpp
+	bmpman/bm_convert.h
 	bmpman/bm_internal.h
+	bmpman/bm_name_index.cpp
+	bmpman/bm_name_index.h
+	bmpman/bm_residency.cpp
+	bmpman/bm_residency.h
 	bmpman/bmpman.cpp
 	bmpman/bmpman.h
 )
@@ -413,6 +423,8 @@ ENDIF(WIN32)
 add_file_folder("GlobalIncs\\\\Memory"
 	globalincs/memory/memory.h
 	globalincs/memory/memory.cpp
+	globalincs/memory/tracking.cpp
+	globalincs/memory/tracking.h
 	globalincs/memory/utils.h
 )
 
@@ -533,6 +545,8 @@ add_file_folder("Graphics\\\\SoftwareGr\\\\Font"
 	graphics/software/FontManager.cpp
 	graphics/software/FSFont.h
 	graphics/software/FSFont.cpp
+	graphics/software/GlyphAtlas.h
+	graphics/software/GlyphAtlas.cpp
 	graphics/software/NVGFont.h
 	graphics/software/NVGFont.cpp
 	graphics/software/VFNTFont.h
@@ -732,6 +746,8 @@ add_file_folder("Libs\\\\RenderDoc"
 
 # Lighting files
 add_file_folder("Lighting"
+	lighting/light_grid.cpp
+	lighting/light_grid.h
 	lighting/lighting.cpp
 	lighting/lighting.h
 	lighting/lighting_profiles.cpp
@@ -1220,6 +1236,8 @@ add_file_folder("Scripting"
 	scripting/hook_conditions.cpp
 	scripting/hook_conditions.h
 	scripting/lua.cpp
+	scripting/lua_profiler.cpp
+	scripting/lua_profiler.h
 	scripting/scripting.cpp
 	scripting/scripting.h
 	scripting/scripting_doc.h
@@ -1493,6 +1511,8 @@ add_file_folder("Sound"
 	sound/ds.h
 	sound/ds3d.cpp
 	sound/ds3d.h
+	sound/ds_voices.cpp
+	sound/ds_voices.h
 	sound/dscap.cpp
 	sound/dscap.h
 	sound/fsspeech.cpp
@@ -1571,8 +1591,11 @@ add_file_folder("Tracing"
 	tracing/MainFrameTimer.cpp
 	tracing/Monitor.h
 	tracing/Monitor.cpp
+	tracing/PerfStats.cpp
+	tracing/PerfStats.h
 	tracing/scopes.cpp
 	tracing/scopes.h
+	tracing/ThreadedEventProcessor.cpp
 	tracing/ThreadedEventProcessor.h
 	tracing/TraceEventWriter.h
 	tracing/TraceEventWriter.cpp
@@ -1601,12 +1624,17 @@ add_file_folder("Ui"
 )
 
 add_file_folder("Utils"
+	utils/AssetRetention.cpp
+	utils/AssetRetention.h
 	utils/base64.cpp
 	utils/base64.h
+	utils/ChunkedPool.h
 	utils/encoding.cpp
 	utils/encoding.h
 	utils/event.h
 	utils/finally.h
+	utils/FrameArena.cpp
+	utils/FrameArena.h
 	utils/HeapAllocator.cpp
 	utils/HeapAllocator.h
 	utils/id.h
@@ -1614,9 +1642,13 @@ add_file_folder("Utils"
 	utils/Random.cpp
 	utils/Random.h
 	utils/RandomRange.h
+	utils/SpscQueue.h
 	utils/string_utils.cpp
 	utils/string_utils.h
 	utils/strings.h
+	utils/ThreadPool.cpp
+	utils/ThreadPool.h
+	utils/TimerWheel.h
 	utils/tuples.h
 	utils/unicode.cpp
 	utils/unicode.h
@@ -14,6 +14,7 @@
 #include "globalincs/pstypes.h"
 #include "tgautils/tgautils.h"
 #include "cfile/cfile.h"
+#include "bmpman/bm_convert.h"
 #include "bmpman/bmpman.h"
 #include "graphics/2d.h"
 #include "cmdline/cmdline.h"
@@ -282,6 +283,33 @@ static void targa_read_pixel( int num_pixels, ubyte **dst, ubyte **src, int byte
 	ubyte r, g, b;
 	ubyte al = 0;
 
+	bool converted = false;
+
+#if BYTE_ORDER != BIG_ENDIAN
+	// 24 and 32 bit pixels only need to be copied or expanded
+	if ( (bytes_per_pixel >= 3) && (bytes_per_pixel == dest_size) ) {
+		memcpy(*dst, *src, num_pixels * bytes_per_pixel);
+		converted = true;
+	} else if ( (bytes_per_pixel == 3) && (dest_size == 4) ) {
+		bm_expand_24_to_32(*dst, *src, num_pixels);
+		converted = true;
+	}
+#endif
+
+	// 16 bit pixels can be converted all at once if they are meant for a 1555 texture, alpha textures use the same
+	// function with 4444 masks
+	if ( !converted && (bytes_per_pixel == 2) && (dest_size == 2) && (bm_set_components == bm_set_components_argb_16_tex)
+		&& (Gr_current_red == &Gr_t_red) ) {
+		bm_convert_1555_to_tex((ushort*)*dst, *src, num_pixels);
+		converted = true;
+	}
+
+	if ( converted ) {
+		(*dst) += num_pixels * dest_size;
+		(*src) += num_pixels * bytes_per_pixel;
+		return;
+	}
+
 	for(idx=0; idx<num_pixels; idx++){
 		// 24 or 32 bit
 		if ( (bytes_per_pixel == 3) || (bytes_per_pixel == 4) ) {
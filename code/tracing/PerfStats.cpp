@@ -0,0 +1,275 @@
+
+#include "tracing/PerfStats.h"
+
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+using namespace tracing;
+
+const std::uint64_t NANOSECONDS_PER_SECOND = 1000000000;
+
+// The HUD does not need a fresh summary every frame
+const std::uint64_t SUMMARY_INTERVAL = NANOSECONDS_PER_SECOND / 4;
+
+const size_t FRAME_STAT = 0;
+
+// Counter events of other categories (e.g. the monitors) are not made for per-frame statistics
+bool is_perf_counter(const Category* category)
+{
+	return category == &PerfObjects || category == &PerfCollisionPairs || category == &PerfParticles ||
+	       category == &PerfDrawCalls;
+}
+
+const char* stat_type_name(PerfStatType type)
+{
+	switch (type) {
+	case PerfStatType::Frame:
+		return "frame";
+	case PerfStatType::Scope:
+		return "scope";
+	case PerfStatType::Counter:
+		return "counter";
+	default:
+		UNREACHABLE("Invalid statistic type!");
+		return "";
+	}
+}
+
+SCP_string escape_json(const SCP_string& str)
+{
+	SCP_string out;
+	out.reserve(str.size());
+
+	for (auto c : str) {
+		if (c == '"' || c == '\\') {
+			out += '\\';
+		}
+		out += c;
+	}
+
+	return out;
+}
+
+// Nearest-rank percentile of sorted values
+float percentile(const SCP_vector<float>& sorted, float p)
+{
+	auto rank = static_cast<size_t>(std::ceil(p * sorted.size()));
+	return sorted[std::max(rank, static_cast<size_t>(1)) - 1];
+}
+
+} // namespace
+
+namespace tracing {
+
+const size_t PerfStats::HISTORY_SIZE;
+
+PerfStats::stat_history::stat_history(const char* stat_name, PerfStatType stat_type)
+	: name(stat_name), type(stat_type), values(HISTORY_SIZE, 0.0f)
+{
+}
+
+void PerfStats::stat_history::push(float value)
+{
+	values[next] = value;
+	next = (next + 1) % HISTORY_SIZE;
+
+	filled = std::min(filled + 1, HISTORY_SIZE);
+}
+
+PerfStats::PerfStats(int export_interval_seconds)
+	: _exportInterval(static_cast<std::uint64_t>(export_interval_seconds) * NANOSECONDS_PER_SECOND)
+{
+	_stats.emplace_back("Frame", PerfStatType::Frame);
+
+	if (_exportInterval > 0) {
+		_csvOut.open("perf_stats.csv");
+		_jsonOut.open("perf_stats.json");
+
+		_csvOut << "time_s,stat,type,frames,p50,p95,p99,max\n";
+	}
+}
+
+PerfStats::~PerfStats()
+{
+	// Don't lose the frames since the last export
+	if (_exportInterval > 0 && !_stats[FRAME_STAT].export_values.empty()) {
+		exportStats(_frameBegin);
+	}
+}
+
+PerfStats::stat_history& PerfStats::getStat(const Category* category, PerfStatType type)
+{
+	auto iter = _statIndices.find(category);
+	if (iter != _statIndices.end()) {
+		return _stats[iter->second];
+	}
+
+	_statIndices.emplace(category, _stats.size());
+	_stats.emplace_back(category->getName(), type);
+
+	// A new statistic did not exist in the earlier frames so it is only recorded from now on
+	return _stats.back();
+}
+
+void PerfStats::processEvent(const trace_event* event)
+{
+	switch (event->type) {
+	case EventType::Complete:
+		if (event->pid == GPU_PID) {
+			// GPU timestamps are not on the same time line as the frame boundaries
+			return;
+		}
+
+		getStat(event->category, PerfStatType::Scope).frame_value += event->duration / 1000000.0f;
+		break;
+	case EventType::Counter:
+		if (is_perf_counter(event->category)) {
+			getStat(event->category, PerfStatType::Counter).frame_value = event->value;
+		}
+		break;
+	case EventType::AsyncBegin:
+		if (event->scope == &MainFrameScope && event->category == &MainFrame) {
+			_inFrame = true;
+			_frameBegin = event->timestamp;
+		}
+		break;
+	case EventType::AsyncEnd:
+		if (event->scope == &MainFrameScope && event->category == &MainFrame && _inFrame) {
+			endFrame(event->timestamp);
+		}
+		break;
+	default:
+		// Ignore everything else
+		break;
+	}
+}
+
+void PerfStats::endFrame(std::uint64_t timestamp)
+{
+	_stats[FRAME_STAT].frame_value = (timestamp - _frameBegin) / 1000000.0f;
+	_inFrame = false;
+
+	for (auto& stat : _stats) {
+		stat.push(stat.frame_value);
+
+		if (_exportInterval > 0) {
+			stat.export_values.push_back(stat.frame_value);
+		}
+
+		// Counters keep their value until they are changed again
+		if (stat.type != PerfStatType::Counter) {
+			stat.frame_value = 0.0f;
+		}
+	}
+
+	if (timestamp - _lastSummary >= SUMMARY_INTERVAL) {
+		_lastSummary = timestamp;
+		updateSummary();
+	}
+
+	if (_exportInterval > 0 && timestamp - _lastExport >= _exportInterval) {
+		exportStats(timestamp);
+	}
+}
+
+perf_stat_summary PerfStats::summarize(const stat_history& stat, size_t frames)
+{
+	// The most recent values are the ones right before the write position of the ring
+	_sortBuffer.clear();
+	for (size_t i = 0; i < frames; ++i) {
+		_sortBuffer.push_back(stat.values[(stat.next + HISTORY_SIZE - frames + i) % HISTORY_SIZE]);
+	}
+
+	return summarizeSortBuffer(stat);
+}
+
+perf_stat_summary PerfStats::summarizeSortBuffer(const stat_history& stat)
+{
+	perf_stat_summary summary;
+	summary.name = stat.name;
+	summary.type = stat.type;
+	summary.frames = _sortBuffer.size();
+
+	if (_sortBuffer.empty()) {
+		return summary;
+	}
+
+	std::sort(_sortBuffer.begin(), _sortBuffer.end());
+
+	summary.p50 = percentile(_sortBuffer, 0.50f);
+	summary.p95 = percentile(_sortBuffer, 0.95f);
+	summary.p99 = percentile(_sortBuffer, 0.99f);
+	summary.max = _sortBuffer.back();
+
+	return summary;
+}
+
+void PerfStats::updateSummary()
+{
+	SCP_vector<perf_stat_summary> summary;
+	summary.reserve(_stats.size());
+
+	for (const auto& stat : _stats) {
+		summary.push_back(summarize(stat, stat.filled));
+	}
+
+	std::stable_sort(summary.begin(), summary.end(), [](const perf_stat_summary& left, const perf_stat_summary& right) {
+		if (left.type != right.type) {
+			return left.type < right.type;
+		}
+		return left.type == PerfStatType::Scope && left.p95 > right.p95;
+	});
+
+	std::lock_guard<std::mutex> guard(_summaryMutex);
+	_summary = std::move(summary);
+}
+
+void PerfStats::exportStats(std::uint64_t timestamp)
+{
+	_lastExport = timestamp;
+
+	auto seconds = static_cast<double>(timestamp) / NANOSECONDS_PER_SECOND;
+
+	_jsonOut << "{\"time_s\":" << seconds << ",\"stats\":[";
+
+	bool first = true;
+	for (auto& stat : _stats) {
+		_sortBuffer.assign(stat.export_values.begin(), stat.export_values.end());
+		// Keeps the capacity so the next interval does not have to allocate again
+		stat.export_values.clear();
+
+		auto summary = summarizeSortBuffer(stat);
+
+		if (summary.frames == 0) {
+			continue;
+		}
+
+		_csvOut << seconds << ",\"" << summary.name << "\"," << stat_type_name(summary.type) << "," << summary.frames
+		        << "," << summary.p50 << "," << summary.p95 << "," << summary.p99 << "," << summary.max << "\n";
+
+		if (!first) {
+			_jsonOut << ",";
+		}
+		first = false;
+
+		_jsonOut << "{\"name\":\"" << escape_json(summary.name) << "\",\"type\":\"" << stat_type_name(summary.type)
+		         << "\",\"frames\":" << summary.frames << ",\"p50\":" << summary.p50 << ",\"p95\":" << summary.p95
+		         << ",\"p99\":" << summary.p99 << ",\"max\":" << summary.max << "}";
+	}
+
+	_jsonOut << "]}\n";
+
+	// Make the data available to anything that watches the files while the game is running
+	_csvOut.flush();
+	_jsonOut.flush();
+}
+
+SCP_vector<perf_stat_summary> PerfStats::getSummary()
+{
+	std::lock_guard<std::mutex> guard(_summaryMutex);
+	return _summary;
+}
+
+} // namespace tracing
@@ -0,0 +1,133 @@
+#pragma once
+
+#include "globalincs/pstypes.h"
+#include "tracing/tracing.h"
+
+#include "tracing/ThreadedEventProcessor.h"
+
+#include <fstream>
+#include <mutex>
+
+/** @file
+ *  @ingroup tracing
+ */
+
+namespace tracing {
+
+/**
+ * @brief The kind of values a performance statistic is made of
+ */
+enum class PerfStatType {
+	Frame,   //!< The time between two main frame boundaries in milliseconds
+	Counter, //!< The last value of a per-frame counter in a frame
+	Scope,   //!< The time spent in a tracing category per frame in milliseconds
+};
+
+/**
+ * @brief The distribution of one statistic over the recent frames
+ */
+struct perf_stat_summary {
+	SCP_string name;
+	PerfStatType type = PerfStatType::Scope;
+
+	size_t frames = 0;
+
+	float p50 = 0.0f;
+	float p95 = 0.0f;
+	float p99 = 0.0f;
+	float max = 0.0f;
+};
+
+/**
+ * @brief Keeps rolling per-frame histories of the frame time, scope times and frame counters
+ *
+ * Every statistic has a fixed size ring buffer with one value per frame so the memory usage does not depend on the
+ * length of the session. The frame boundaries are taken from the asynchronous main frame events. The times of all
+ * scopes which ended in a frame are added up so nested and repeated scopes are included in the value of their category.
+ *
+ * A summary of the recent frames is refreshed a few times per second for the HUD. If an export interval is set the
+ * percentiles of the frames since the last export are appended to perf_stats.csv and perf_stats.json, one JSON object
+ * per line, so the files stay valid no matter when the game is closed. The values of the export are collected apart
+ * from the ring buffers so an export covers every frame of its interval, the memory used for them only depends on the
+ * length of the interval.
+ */
+class PerfStats {
+  public:
+	/**
+	 * @brief The number of frames kept per statistic for the HUD summary
+	 */
+	static const size_t HISTORY_SIZE = 1024;
+
+  private:
+	struct stat_history {
+		SCP_string name;
+		PerfStatType type;
+
+		SCP_vector<float> values;
+		size_t next = 0;
+		size_t filled = 0;
+
+		// Every value since the last export, only used if the export is enabled
+		SCP_vector<float> export_values;
+
+		float frame_value = 0.0f;
+
+		stat_history(const char* stat_name, PerfStatType stat_type);
+
+		void push(float value);
+	};
+
+	SCP_vector<stat_history> _stats;
+	SCP_unordered_map<const Category*, size_t> _statIndices;
+
+	bool _inFrame = false;
+	std::uint64_t _frameBegin = 0;
+
+	std::uint64_t _exportInterval;
+	std::uint64_t _lastExport = 0;
+	std::ofstream _csvOut;
+	std::ofstream _jsonOut;
+
+	std::uint64_t _lastSummary = 0;
+	std::mutex _summaryMutex;
+	SCP_vector<perf_stat_summary> _summary;
+
+	SCP_vector<float> _sortBuffer;
+
+	stat_history& getStat(const Category* category, PerfStatType type);
+
+	perf_stat_summary summarize(const stat_history& stat, size_t frames);
+
+	perf_stat_summary summarizeSortBuffer(const stat_history& stat);
+
+	void endFrame(std::uint64_t timestamp);
+
+	void updateSummary();
+
+	void exportStats(std::uint64_t timestamp);
+
+  public:
+	/**
+	 * @param export_interval_seconds The time between two exports, 0 disables the export
+	 */
+	explicit PerfStats(int export_interval_seconds);
+	~PerfStats();
+
+	void processEvent(const trace_event* event);
+
+	/**
+	 * @brief Gets the statistics of the recent frames, may be called from any thread
+	 *
+	 * The frame time comes first, followed by the counters and the scopes sorted by their 95th percentile.
+	 */
+	SCP_vector<perf_stat_summary> getSummary();
+};
+
+typedef ThreadedEventProcessor<PerfStats> ThreadedPerfStats;
+
+/**
+ * @brief Gets the statistics of the recent frames, requires -perf_stats or -perf_stats_export
+ */
+SCP_vector<perf_stat_summary> get_perf_stats();
+
+} // namespace tracing
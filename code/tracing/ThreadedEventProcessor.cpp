@@ -0,0 +1,97 @@
+
+#include "tracing/ThreadedEventProcessor.h"
+
+#include <algorithm>
+
+namespace {
+
+// Ids are never reused so a stale cache entry of a destroyed set can never match a new one
+std::atomic<std::uint64_t> next_ring_set_id{1};
+
+struct thread_ring_entry {
+	std::uint64_t set_id;
+	tracing::EventRing* ring;
+};
+
+thread_local SCP_vector<thread_ring_entry> thread_rings;
+
+} // namespace
+
+namespace tracing {
+
+EventRing::EventRing(size_t capacity) : _events(capacity), _mask(capacity - 1)
+{
+	Assertion(capacity > 0 && (capacity & (capacity - 1)) == 0, "Event buffer capacity " SIZE_T_ARG " is not a power of two!", capacity);
+}
+
+std::uint64_t EventRing::dropped() const
+{
+	return _dropped.load(std::memory_order_relaxed);
+}
+
+EventRingSet::EventRingSet(size_t capacity) : _id(next_ring_set_id++), _capacity(capacity)
+{
+	for (auto& ring : _rings) {
+		ring.store(nullptr, std::memory_order_relaxed);
+	}
+}
+
+EventRingSet::~EventRingSet()
+{
+	for (auto iter = thread_rings.begin(); iter != thread_rings.end(); ++iter) {
+		if (iter->set_id == _id) {
+			thread_rings.erase(iter);
+			break;
+		}
+	}
+}
+
+EventRing* EventRingSet::registerThread()
+{
+	std::lock_guard<std::mutex> guard(_registerMutex);
+
+	auto index = _numRings.load(std::memory_order_relaxed);
+	if (index >= MAX_THREADS) {
+		// Remember that this thread has no buffer so the lock is not taken again for every event
+		thread_rings.push_back({_id, nullptr});
+		return nullptr;
+	}
+
+	_ownedRings.emplace_back(new EventRing(_capacity));
+	auto ring = _ownedRings.back().get();
+
+	// The consumer only looks at the rings below _numRings so the pointer has to be visible first
+	_rings[index].store(ring, std::memory_order_release);
+	_numRings.store(index + 1, std::memory_order_release);
+
+	thread_rings.push_back({_id, ring});
+	return ring;
+}
+
+bool EventRingSet::push(const trace_event& evt)
+{
+	auto iter = std::find_if(thread_rings.begin(), thread_rings.end(),
+		[this](const thread_ring_entry& entry) { return entry.set_id == _id; });
+
+	auto ring = iter != thread_rings.end() ? iter->ring : registerThread();
+	if (ring == nullptr) {
+		_unregisteredDropped.fetch_add(1, std::memory_order_relaxed);
+		return false;
+	}
+
+	return ring->push(evt);
+}
+
+std::uint64_t EventRingSet::dropped()
+{
+	auto dropped = _unregisteredDropped.load(std::memory_order_relaxed);
+
+	auto numRings = _numRings.load(std::memory_order_acquire);
+	for (size_t i = 0; i < numRings; ++i) {
+		dropped += _rings[i].load(std::memory_order_acquire)->dropped();
+	}
+
+	return dropped;
+}
+
+} // namespace tracing
@@ -3,8 +3,11 @@
 #include "globalincs/pstypes.h"
 #include "tracing/tracing.h"
 
-#include "utils/boost/syncboundedqueue.h"
-
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cinttypes>
+#include <mutex>
 #include <thread>
 
 
@@ -14,6 +17,149 @@
 
 namespace tracing {
 
+/**
+ * @brief A fixed size ring buffer of trace events with one producer and one consumer thread
+ *
+ * Neither side ever blocks. If the buffer is full the event is dropped and counted instead.
+ */
+class EventRing {
+	SCP_vector<trace_event> _events;
+	size_t _mask;
+
+	// Written by the producer
+	std::atomic<size_t> _head{0};
+	std::atomic<std::uint64_t> _dropped{0};
+
+	// Written by the consumer
+	std::atomic<size_t> _tail{0};
+
+  public:
+	/**
+	 * @param capacity The number of events the buffer can hold, must be a power of two
+	 */
+	explicit EventRing(size_t capacity);
+
+	EventRing(const EventRing&) = delete;
+	EventRing& operator=(const EventRing&) = delete;
+
+	/**
+	 * @brief Adds an event to the buffer, may only be called by the producer thread
+	 * @return @c false if the buffer was full and the event was dropped
+	 */
+	bool push(const trace_event& evt)
+	{
+		auto head = _head.load(std::memory_order_relaxed);
+		auto tail = _tail.load(std::memory_order_acquire);
+
+		if (head - tail >= _events.size()) {
+			// Only the producer writes this so there is no need for an atomic increment
+			_dropped.store(_dropped.load(std::memory_order_relaxed) + 1, std::memory_order_relaxed);
+			return false;
+		}
+
+		_events[head & _mask] = evt;
+		_head.store(head + 1, std::memory_order_release);
+		return true;
+	}
+
+	/**
+	 * @brief Passes up to max_events events to func, may only be called by the consumer thread
+	 *
+	 * The slots are only released after all events of the batch have been processed.
+	 *
+	 * @return The number of processed events
+	 */
+	template <typename Func>
+	size_t drain(Func&& func, size_t max_events)
+	{
+		auto tail = _tail.load(std::memory_order_relaxed);
+		auto head = _head.load(std::memory_order_acquire);
+
+		auto count = std::min(head - tail, max_events);
+		for (size_t i = 0; i < count; ++i) {
+			func(&_events[(tail + i) & _mask]);
+		}
+
+		_tail.store(tail + count, std::memory_order_release);
+		return count;
+	}
+
+	/**
+	 * @brief The number of events which were dropped because the buffer was full
+	 */
+	std::uint64_t dropped() const;
+};
+
+/**
+ * @brief A set of event buffers with one buffer for every thread which submits events
+ *
+ * Submitting an event only touches the buffer of the calling thread so producers never contend with each other or
+ * with the consumer. A thread gets its buffer the first time it submits an event.
+ */
+class EventRingSet {
+  public:
+	/**
+	 * @brief The maximum number of producer threads, events of further threads are dropped
+	 */
+	static const size_t MAX_THREADS = 64;
+
+  private:
+	std::uint64_t _id;
+	size_t _capacity;
+
+	std::array<std::atomic<EventRing*>, MAX_THREADS> _rings;
+	std::atomic<size_t> _numRings{0};
+
+	// Only used when a thread submits its first event
+	std::mutex _registerMutex;
+	SCP_vector<std::unique_ptr<EventRing>> _ownedRings;
+
+	std::atomic<std::uint64_t> _unregisteredDropped{0};
+
+	EventRing* registerThread();
+
+  public:
+	/**
+	 * @param capacity The capacity of every per-thread buffer, must be a power of two
+	 */
+	explicit EventRingSet(size_t capacity);
+	~EventRingSet();
+
+	EventRingSet(const EventRingSet&) = delete;
+	EventRingSet& operator=(const EventRingSet&) = delete;
+
+	/**
+	 * @brief Adds an event to the buffer of the calling thread
+	 * @return @c false if the event was dropped
+	 */
+	bool push(const trace_event& evt);
+
+	/**
+	 * @brief Passes the pending events of all threads to func, may only be called by the consumer thread
+	 *
+	 * @param func The function to call for every event
+	 * @param max_events_per_ring The maximum number of events taken from one buffer
+	 * @return The number of processed events
+	 */
+	template <typename Func>
+	size_t drain(Func&& func, size_t max_events_per_ring)
+	{
+		size_t processed = 0;
+
+		auto numRings = _numRings.load(std::memory_order_acquire);
+		for (size_t i = 0; i < numRings; ++i) {
+			processed += _rings[i].load(std::memory_order_acquire)->drain(func, max_events_per_ring);
+		}
+
+		return processed;
+	}
+
+	/**
+	 * @brief The total number of dropped events of all threads
+	 */
+	std::uint64_t dropped();
+};
+
 /**
  * @brief A multi-threaded event processor
  *
@@ -26,51 +172,75 @@ namespace tracing {
  *
  * This function will be called in a background-thread whenever a new event arrives.
  *
+ * Every thread which submits events gets its own lock-free buffer which the background thread drains in batches. If a
+ * buffer is full the event is dropped rather than blocking the thread that is being measured. The number of dropped
+ * events is written to the log when the processor is destroyed.
+ *
  * @tparam Processor Your processor implementation
- * @tparam QUEUE_SIZE The maximum size of the internal event buffer
+ * @tparam BUFFER_SIZE The number of events that can be buffered per thread, must be a power of two
  */
-template<class Processor, size_t QUEUE_SIZE = 200>
+template<class Processor, size_t BUFFER_SIZE = 8192>
 class ThreadedEventProcessor {
-	sync_bounded_queue<trace_event> _event_queue;
+	static const size_t DRAIN_BATCH_SIZE = 512;
 
-	std::thread _worker_thread;
+	EventRingSet _rings;
+
+	std::atomic<bool> _stopping{false};
 
 	Processor _processor;
 
-	void workerThread() {
-		while (!_event_queue.closed()) {
-			try {
-				trace_event evt;
-				auto status = _event_queue.wait_pull_front(evt);
+	std::thread _worker_thread;
 
-				if (status != success) {
-					break;
-				}
+	size_t drainEvents() {
+		return _rings.drain([this](const trace_event* evt) { _processor.processEvent(evt); }, DRAIN_BATCH_SIZE);
+	}
 
-				_processor.processEvent(&evt);
-			}
-			catch (const sync_queue_is_closed&) {
-				// We are done here
-				break;
+	void workerThread() {
+		while (!_stopping.load(std::memory_order_acquire)) {
+			if (drainEvents() == 0) {
+				// Nothing to do, give the producers some time to fill the buffers
+				std::this_thread::sleep_for(std::chrono::milliseconds(1));
 			}
 		}
+
+		// Process everything that was submitted before the processor was stopped
+		while (drainEvents() > 0) {
+		}
 	}
  public:
 	template<typename... Params>
 	explicit ThreadedEventProcessor(Params&& ... params)
-		: _event_queue(QUEUE_SIZE), _worker_thread(&ThreadedEventProcessor<Processor>::workerThread, this),
-		  _processor(std::forward<Params>(params)...) {}
+		: _rings(BUFFER_SIZE), _processor(std::forward<Params>(params)...),
+		  _worker_thread(&ThreadedEventProcessor::workerThread, this) {}
 	~ThreadedEventProcessor() {
-		_event_queue.close();
+		_stopping.store(true, std::memory_order_release);
 		_worker_thread.join();
+
+		auto dropped = _rings.dropped();
+		if (dropped > 0) {
+			mprintf(("Tracing: %" PRIu64 " events were dropped because the event buffers were full.\n", dropped));
+		}
 	}
 
+	ThreadedEventProcessor(const ThreadedEventProcessor&) = delete;
+	ThreadedEventProcessor& operator=(const ThreadedEventProcessor&) = delete;
+
 	void processEvent(const trace_event* event) {
-		try {
-			_event_queue.wait_push_back(*event);
-		} catch (const sync_queue_is_closed&) {
-			mprintf(("Stream queue was closed in processEvent! This should not be possible...\n"));
-		}
+		_rings.push(*event);
+	}
+
+	/**
+	 * @brief The number of events which were dropped so far because the buffers were full
+	 */
+	std::uint64_t droppedEvents() {
+		return _rings.dropped();
+	}
+
+	/**
+	 * @brief The wrapped processor, state shared with the background thread must be synchronized by the processor
+	 */
+	Processor& processor() {
+		return _processor;
 	}
 };
 
@@ -51,6 +51,9 @@ Category PreMove("Pre Move", false);
 Category Physics("Physics", false);
 Category PostMove("Post Move", false);
 Category CollisionDetection("Collision Detection", false);
+Category TurretTargetIndex("Build turret target index", false);
+Category AIDecisions("AI decisions", false);
+Category AIScheduler("Schedule AI decisions", false);
 
 Category RenderBuffer("Render Buffer", true);
 
@@ -145,4 +148,9 @@ Category GpuHeapAllocate("GPU heap allocate", false);
 Category GpuHeapDeallocate("GPU heap deallocate", false);
 
 Category ProgramStepOne("Step one program", false);
+
+Category PerfObjects("Objects", false);
+Category PerfCollisionPairs("Collision pairs", false);
+Category PerfParticles("Particles", false);
+Category PerfDrawCalls("Draw calls", false);
 }
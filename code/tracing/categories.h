@@ -64,6 +64,9 @@ extern Category PreMove;
 extern Category Physics;
 extern Category PostMove;
 extern Category CollisionDetection;
+extern Category TurretTargetIndex;
+extern Category AIDecisions;
+extern Category AIScheduler;
 
 extern Category RenderBuffer;
 
@@ -161,6 +164,12 @@ extern Category GpuHeapDeallocate;
 
 extern Category ProgramStepOne;
 
+// Per-frame counters of the performance statistics
+extern Category PerfObjects;
+extern Category PerfCollisionPairs;
+extern Category PerfParticles;
+extern Category PerfDrawCalls;
+
 }
 
 #endif // _TRACING_CATEGORIES_H
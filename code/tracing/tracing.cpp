@@ -7,7 +7,9 @@
 #include "TraceEventWriter.h"
 #include "MainFrameTimer.h"
 #include "FrameProfiler.h"
+#include "PerfStats.h"
 
+#include <atomic>
 #include <cinttypes>
 #include <fstream>
 #include <future>
@@ -18,36 +20,47 @@
 #define WIN32_LEAN_AND_MEAN
 #include <windows.h>
 
-static int64_t get_tid() {
+static int64_t query_tid() {
     return (int64_t) GetCurrentThreadId();
 }
 #elif __LINUX__
 #include <sys/syscall.h>
-static int64_t get_tid() {
+static int64_t query_tid() {
 	return (int64_t) syscall(SYS_gettid);
 }
 #else
 #include <pthread.h>
 
-static int64_t get_tid() {
+static int64_t query_tid() {
 // This is not a reliable way of getting the tid but it's better than nothing
     return (int64_t) pthread_self();
 }
 #endif
 
+// The id is needed for every event so only do the system call once per thread
+static int64_t get_tid() {
+	thread_local int64_t tid = query_tid();
+	return tid;
+}
+
 // A function for getting the id of the current process
 #ifdef WIN32
-static int64_t get_pid() {
+static int64_t query_pid() {
     return (int64_t)GetCurrentProcessId();
 }
 #else
 #include <unistd.h>
 
-static int64_t get_pid() {
+static int64_t query_pid() {
 	return (int64_t) getpid();
 }
 #endif
 
+static int64_t get_pid() {
+	static int64_t pid = query_pid();
+	return pid;
+}
+
 namespace {
 
 using namespace tracing;
@@ -55,6 +68,7 @@ using namespace tracing;
 std::unique_ptr<ThreadedTraceEventWriter> traceEventWriter;
 std::unique_ptr<ThreadedMainFrameTimer> mainFrameTimer;
 std::unique_ptr<FrameProfiler> frameProfiler;
+std::unique_ptr<ThreadedPerfStats> perfStats;
 
 SCP_vector<int> query_objects;
 // The GPU timestamp queries use an internal free list to reduce the number of graphics API calls
@@ -98,21 +112,32 @@ SCP_queue<gpu_trace_event> gpu_events;
 bool initialized = false;
 
 bool do_trace_events = false;
+// Only some consumers want the GPU side of the scopes, the others should not pay for the timestamp queries
+bool do_gpu_trace_events = false;
 bool do_async_events = false;
 bool do_counter_events = false;
 std::int64_t main_thread_id = -1;
 
 int gpu_start_query = -1;
 std::uint64_t gpu_start_time = 0;
-std::uint64_t cpu_start_time = 0;
+std::uint64_t cpu_start_ticks = 0;
 
-std::uint64_t current_id = 0;
+// Events may be generated by any thread
+std::atomic<std::uint64_t> current_id{0};
+
+std::uint64_t next_event_id() {
+	return current_id.fetch_add(1, std::memory_order_relaxed) + 1;
+}
 
 void submit_event(trace_event* evt) {
 	if (evt->pid == GPU_PID) {
 		evt->timestamp -= gpu_start_time;
 	} else {
-		evt->timestamp -= cpu_start_time;
+		// CPU events are measured in raw timer ticks since those are cheaper to get
+		evt->timestamp = timer_ticks_to_nanoseconds(evt->timestamp - cpu_start_ticks);
+		if (evt->type == EventType::Complete) {
+			evt->duration = timer_ticks_to_nanoseconds(evt->duration);
+		}
 	}
 
 	if (traceEventWriter) {
@@ -127,6 +152,10 @@ void submit_event(trace_event* evt) {
 	if (frameProfiler) {
 		frameProfiler->processEvent(evt);
 	}
+
+	if (perfStats) {
+		perfStats->processEvent(evt);
+	}
 }
 
 void process_gpu_events() {
@@ -202,7 +231,7 @@ void process_gpu_events() {
 void init_event(const Category& category, trace_event* evt) {
 	evt->category = &category;
 
-	evt->timestamp = timer_get_nanoseconds();
+	evt->timestamp = timer_get_ticks();
 
 	evt->pid = get_pid();
 	evt->tid = get_tid();
@@ -212,12 +241,14 @@ void init_event(const Category& category, trace_event* evt) {
 namespace tracing {
 void init() {
 	do_trace_events = false;
+	do_gpu_trace_events = false;
 	do_async_events = false;
 	do_counter_events = false;
 
 	if (Cmdline_json_profiling) {
 		traceEventWriter.reset(new ThreadedTraceEventWriter());
 		do_trace_events = true;
+		do_gpu_trace_events = true;
 		do_async_events = true;
 		do_counter_events = true;
 	}
@@ -228,14 +259,22 @@ void init() {
 	if (Cmdline_frame_profile) {
 		frameProfiler.reset(new FrameProfiler());
 		do_trace_events = true;
+		do_gpu_trace_events = true;
+	}
+	if (Cmdline_perf_stats || Cmdline_perf_stats_export > 0) {
+		// The statistics ignore GPU events so this does not need do_gpu_trace_events
+		perfStats.reset(new ThreadedPerfStats(Cmdline_perf_stats_export));
+		do_trace_events = true;
+		do_async_events = true;
+		do_counter_events = true;
 	}
 
-	do_gpu_queries = gr_is_capable(CAPABILITY_TIMESTAMP_QUERY);
+	do_gpu_queries = do_gpu_trace_events && gr_is_capable(CAPABILITY_TIMESTAMP_QUERY);
 
 	if (do_gpu_queries) {
 		gpu_start_query = get_gpu_timestamp_query();
 	}
-	cpu_start_time = timer_get_nanoseconds();
+	cpu_start_ticks = timer_get_ticks();
 
 	main_thread_id = get_tid();
 
@@ -260,6 +299,12 @@ SCP_string get_frame_profile_output() {
 	return frameProfiler->getContent();
 }
 
+SCP_vector<perf_stat_summary> get_perf_stats() {
+	Assertion(perfStats, "Performance statistics must be enabled for this function!");
+
+	return perfStats->processor().getSummary();
+}
+
 void shutdown() {
 	while (!gpu_events.empty()) {
 		process_events();
@@ -275,6 +320,7 @@ void shutdown() {
 
 	mainFrameTimer = nullptr;
 	traceEventWriter = nullptr;
+	perfStats = nullptr;
 
 	initialized = false;
 }
@@ -295,7 +341,7 @@ void start(const Category& category, trace_event* evt) {
 
 	evt->duration = 0;
 	evt->type = EventType::Complete;
-	evt->event_id = ++current_id;
+	evt->event_id = next_event_id();
 
 	if (do_gpu_queries && category.usesGPUCounter()) {
 		Assertion(get_tid() == main_thread_id, "This function must be called from the main thread!");
@@ -326,8 +372,8 @@ void end(trace_event* evt) {
 	Assertion(evt->pid == get_pid(), "Complete events must be generated from the same process!");
 	Assertion(evt->tid == get_tid(), "Complete events must be generated from the same thread!");
 
-	evt->duration = timer_get_nanoseconds() - evt->timestamp;
-	evt->end_event_id = ++current_id;
+	evt->duration = timer_get_ticks() - evt->timestamp;
+	evt->end_event_id = next_event_id();
 
 	// Process CPU events
 	submit_event(evt);
@@ -363,7 +409,7 @@ void begin(const Category& category, const Scope& async_scope) {
 
 	evt.type = EventType::AsyncBegin;
 	evt.scope = &async_scope;
-	evt.event_id = ++current_id;
+	evt.event_id = next_event_id();
 
 	submit_event(&evt);
 }
@@ -378,7 +424,7 @@ void step(const Category& category, const Scope& async_scope) {
 
 	evt.type = EventType::AsyncStep;
 	evt.scope = &async_scope;
-	evt.event_id = ++current_id;
+	evt.event_id = next_event_id();
 
 	submit_event(&evt);
 }
@@ -393,7 +439,7 @@ void end(const Category& category, const Scope& async_scope) {
 
 	evt.type = EventType::AsyncEnd;
 	evt.scope = &async_scope;
-	evt.event_id = ++current_id;
+	evt.event_id = next_event_id();
 
 	submit_event(&evt);
 }
@@ -411,7 +457,7 @@ void value(const Category& category, float value) {
 	init_event(category, &evt);
 	evt.type = EventType::Counter;
 	evt.value = value;
-	evt.event_id = ++current_id;
+	evt.event_id = next_event_id();
 
 	submit_event(&evt);
 }
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "globalincs/pstypes.h"
+#include "globalincs/memory/tracking.h"
 #include "tracing/categories.h"
 #include "tracing/scopes.h"
 
@@ -44,6 +45,7 @@ struct trace_event {
 	const Scope* scope = nullptr;
 	EventType type = EventType::Invalid;
 
+	// In nanoseconds once the event reaches a processor
 	std::uint64_t timestamp = 0;
 	std::uint64_t duration = 0;
 
@@ -102,8 +104,11 @@ void end(trace_event* evt);
 class ScopedCompleteEvent {
 	trace_event _evt;
 
+	// Attributes the allocations in this scope to the category for the allocation hot spot report
+	memory::AllocationSite _allocationSite;
+
  public:
-	explicit ScopedCompleteEvent(const Category& category) {
+	explicit ScopedCompleteEvent(const Category& category) : _allocationSite(category.getName()) {
 		start(category, &_evt);
 	}
 	~ScopedCompleteEvent() {
@@ -0,0 +1,140 @@
+
+#include "utils/AssetRetention.h"
+
+#include <algorithm>
+
+namespace util {
+
+void AssetRetention::erase(SCP_unordered_map<int, asset>::iterator iter)
+{
+	_stats.retained_bytes -= iter->second.bytes;
+	_assets.erase(iter);
+	_stats.num_retained = _assets.size();
+}
+
+void AssetRetention::setBudget(size_t bytes)
+{
+	_budget = bytes;
+}
+
+size_t AssetRetention::getBudget() const
+{
+	return _budget;
+}
+
+void AssetRetention::startGeneration()
+{
+	++_generation;
+
+	_stats.reused = 0;
+	_stats.evictions = 0;
+}
+
+bool AssetRetention::markUsed(int id)
+{
+	auto iter = _assets.find(id);
+	if (iter == _assets.end()) {
+		return false;
+	}
+
+	erase(iter);
+	++_stats.reused;
+
+	return true;
+}
+
+void AssetRetention::retain(int id, size_t bytes)
+{
+	auto iter = _assets.find(id);
+	if (iter != _assets.end()) {
+		_stats.retained_bytes -= iter->second.bytes;
+		iter->second.bytes = bytes;
+		_stats.retained_bytes += bytes;
+		return;
+	}
+
+	asset entry;
+	entry.bytes = bytes;
+	entry.last_used = _generation - 1;
+
+	_assets.emplace(id, entry);
+	_stats.retained_bytes += bytes;
+	_stats.num_retained = _assets.size();
+}
+
+void AssetRetention::remove(int id)
+{
+	auto iter = _assets.find(id);
+	if (iter != _assets.end()) {
+		erase(iter);
+	}
+}
+
+void AssetRetention::clear()
+{
+	_assets.clear();
+	_stats = stats();
+}
+
+bool AssetRetention::contains(int id) const
+{
+	return _assets.find(id) != _assets.end();
+}
+
+void AssetRetention::evict(SCP_vector<int>& evicted)
+{
+	if (_stats.retained_bytes <= _budget) {
+		return;
+	}
+
+	SCP_vector<std::pair<int, asset>> candidates(_assets.begin(), _assets.end());
+	// Oldest first, the bigger asset goes first if both were used in the same generation
+	std::sort(candidates.begin(), candidates.end(),
+		[](const std::pair<int, asset>& left, const std::pair<int, asset>& right) {
+			if (left.second.last_used != right.second.last_used) {
+				return left.second.last_used < right.second.last_used;
+			}
+			if (left.second.bytes != right.second.bytes) {
+				return left.second.bytes > right.second.bytes;
+			}
+			return left.first < right.first;
+		});
+
+	for (auto& candidate : candidates) {
+		if (_stats.retained_bytes <= _budget) {
+			break;
+		}
+
+		remove(candidate.first);
+		evicted.push_back(candidate.first);
+		++_stats.evictions;
+	}
+}
+
+bool AssetRetention::evictOldest(int& id)
+{
+	auto oldest = _assets.end();
+	for (auto iter = _assets.begin(); iter != _assets.end(); ++iter) {
+		if (oldest == _assets.end() || iter->second.last_used < oldest->second.last_used ||
+			(iter->second.last_used == oldest->second.last_used && iter->first < oldest->first)) {
+			oldest = iter;
+		}
+	}
+
+	if (oldest == _assets.end()) {
+		return false;
+	}
+
+	id = oldest->first;
+	erase(oldest);
+	++_stats.evictions;
+
+	return true;
+}
+
+const AssetRetention::stats& AssetRetention::getStats() const
+{
+	return _stats;
+}
+
+} // namespace util
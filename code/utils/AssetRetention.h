@@ -0,0 +1,96 @@
+#pragma once
+
+#include "globalincs/pstypes.h"
+
+namespace util {
+
+/**
+ * @brief Decides which assets stay loaded when the next mission does not use them
+ *
+ * Loading a mission unloads every asset the new mission does not reference. If the player goes through a campaign the
+ * following mission often needs those assets again so they have to be read from disk a second time. This class tracks
+ * the assets which are kept loaded although the current mission does not use them. As long as they fit into the memory
+ * budget they stay loaded, otherwise the assets which were used the longest time ago are evicted first.
+ *
+ * Every page-in starts a new generation. Assets which are used in a generation are not tracked, retain() is called for
+ * the assets which were left over once the page-in is done.
+ *
+ * This class only does the bookkeeping, the evicted assets have to be unloaded by the caller.
+ */
+class AssetRetention {
+  public:
+	struct stats {
+		size_t retained_bytes = 0;
+		size_t num_retained = 0;
+		size_t reused = 0;    //!< Retained assets which were used again in the current generation
+		size_t evictions = 0; //!< Assets which were evicted in the current generation
+	};
+
+  private:
+	struct asset {
+		size_t bytes = 0;
+		int last_used = 0; //!< The generation which used this asset last
+	};
+
+	SCP_unordered_map<int, asset> _assets;
+
+	size_t _budget = 0;
+	int _generation = 0;
+	stats _stats;
+
+	void erase(SCP_unordered_map<int, asset>::iterator iter);
+
+  public:
+	/**
+	 * @brief Sets how many bytes the retained assets may use, 0 disables retention
+	 */
+	void setBudget(size_t bytes);
+
+	size_t getBudget() const;
+
+	/**
+	 * @brief Starts the page-in of the next mission
+	 */
+	void startGeneration();
+
+	/**
+	 * @brief Records that the current mission uses an asset
+	 * @return @c true if the asset was retained from an earlier mission
+	 */
+	bool markUsed(int id);
+
+	/**
+	 * @brief Keeps an asset which is not used by the current mission
+	 *
+	 * Assets which were not tracked before count as used by the previous generation.
+	 */
+	void retain(int id, size_t bytes);
+
+	/**
+	 * @brief Stops tracking an asset which was unloaded by something else
+	 */
+	void remove(int id);
+
+	void clear();
+
+	bool contains(int id) const;
+
+	/**
+	 * @brief Evicts the least recently used assets until the retained assets fit into the budget
+	 *
+	 * @param[out] evicted The assets which have to be unloaded
+	 */
+	void evict(SCP_vector<int>& evicted);
+
+	/**
+	 * @brief Evicts the least recently used asset regardless of the budget
+	 *
+	 * @param[out] id The asset which has to be unloaded
+	 * @return @c false if no asset is retained
+	 */
+	bool evictOldest(int& id);
+
+	const stats& getStats() const;
+};
+
+} // namespace util
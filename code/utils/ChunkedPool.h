@@ -0,0 +1,204 @@
+#pragma once
+
+#include "globalincs/pstypes.h"
+
+#include <algorithm>
+#include <functional>
+#include <memory>
+#include <new>
+#include <type_traits>
+
+namespace util {
+
+/**
+ * @brief A pool of objects with stable indices which grows with the number of used slots
+ *
+ * The memory for the maximum number of slots is reserved as one block when the pool is created but the slots are only
+ * constructed in chunks once all existing slots are in use. Memory which is never used by a mission is never touched,
+ * neither the index nor the address of a slot changes while the pool grows and the index of an object can be computed
+ * from its address like it could for a plain array.
+ *
+ * The lowest free index is handed out first, so the slots are used in the same order as a search through a fixed
+ * array would use them. The indices of all used slots are kept in a dense list so walking the used slots costs as much
+ * as there are used slots instead of the capacity of the pool. The order of that list changes when slots are freed.
+ *
+ * Freed slots are not destroyed or reset, the owner of the pool is responsible for the state of a slot. New slots are
+ * value initialized. Owners which keep track of the free slots themselves only use grow() and never allocate().
+ */
+template <typename T, size_t ChunkSize = 256>
+class ChunkedPool {
+	typedef typename std::aligned_storage<sizeof(T), alignof(T)>::type slot_storage;
+
+	std::unique_ptr<slot_storage[]> _storage;
+
+	size_t _maxSize;
+	size_t _size = 0;
+
+	SCP_vector<int> _freeIndices; //!< A min-heap of the free slots
+	SCP_vector<int> _usedIndices;
+	SCP_vector<int> _usedPositions; //!< The position of every slot in _usedIndices or -1 if the slot is free
+
+	T* slots() { return reinterpret_cast<T*>(_storage.get()); }
+	const T* slots() const { return reinterpret_cast<const T*>(_storage.get()); }
+
+	void destroySlots()
+	{
+		for (size_t i = 0; i < _size; ++i) {
+			slots()[i].~T();
+		}
+		_size = 0;
+	}
+
+  public:
+	/**
+	 * @param max_size The most slots the pool may have
+	 */
+	explicit ChunkedPool(size_t max_size) : _storage(new slot_storage[max_size]), _maxSize(max_size) {}
+
+	~ChunkedPool() { destroySlots(); }
+
+	ChunkedPool(const ChunkedPool&) = delete;
+	ChunkedPool& operator=(const ChunkedPool&) = delete;
+
+	T& operator[](size_t index)
+	{
+		Assertion(index < _size, "Pool index " SIZE_T_ARG " is out of range!", index);
+		return slots()[index];
+	}
+
+	const T& operator[](size_t index) const
+	{
+		Assertion(index < _size, "Pool index " SIZE_T_ARG " is out of range!", index);
+		return slots()[index];
+	}
+
+	/**
+	 * @brief Constructs the next chunk of slots, they are free until they are allocated
+	 * @return @c false if the pool reached its maximum size
+	 */
+	bool grow()
+	{
+		if (_size >= _maxSize) {
+			return false;
+		}
+
+		auto first = _size;
+		auto last = std::min(_size + ChunkSize, _maxSize);
+
+		for (auto i = first; i < last; ++i) {
+			new (&slots()[i]) T();
+			_usedPositions.push_back(-1);
+			_freeIndices.push_back(static_cast<int>(i));
+			std::push_heap(_freeIndices.begin(), _freeIndices.end(), std::greater<int>());
+		}
+		_size = last;
+
+		return true;
+	}
+
+	/**
+	 * @brief Marks the free slot with the lowest index as used, the pool grows if all slots are used
+	 * @return The index of the slot or -1 if the pool reached its maximum size
+	 */
+	int allocate()
+	{
+		if (_freeIndices.empty() && !grow()) {
+			return -1;
+		}
+
+		std::pop_heap(_freeIndices.begin(), _freeIndices.end(), std::greater<int>());
+		auto index = _freeIndices.back();
+		_freeIndices.pop_back();
+
+		_usedPositions[index] = static_cast<int>(_usedIndices.size());
+		_usedIndices.push_back(index);
+
+		return index;
+	}
+
+	/**
+	 * @brief Marks a slot as free so it can be returned by allocate again
+	 */
+	void free(int index)
+	{
+		Assertion(isUsed(index), "Freeing pool slot %d which is not in use!", index);
+
+		// Move the last used index into the gap
+		auto position = _usedPositions[index];
+		auto last = _usedIndices.back();
+		_usedIndices[position] = last;
+		_usedPositions[last] = position;
+		_usedIndices.pop_back();
+
+		_usedPositions[index] = -1;
+		_freeIndices.push_back(index);
+		std::push_heap(_freeIndices.begin(), _freeIndices.end(), std::greater<int>());
+	}
+
+	/**
+	 * @brief Marks all slots as free without destroying them so pointers to the slots stay valid
+	 */
+	void freeAll()
+	{
+		// An ascending list is a valid min-heap
+		_freeIndices.clear();
+		for (size_t i = 0; i < _size; ++i) {
+			_freeIndices.push_back(static_cast<int>(i));
+		}
+
+		_usedIndices.clear();
+		std::fill(_usedPositions.begin(), _usedPositions.end(), -1);
+	}
+
+	/**
+	 * @brief Destroys all slots so the pool starts out empty again
+	 *
+	 * The reserved memory is kept so the addresses of the slots stay the same.
+	 */
+	void clear()
+	{
+		destroySlots();
+		_freeIndices.clear();
+		_usedIndices.clear();
+		_usedPositions.clear();
+	}
+
+	/**
+	 * @brief Checks if a slot is in use
+	 */
+	bool isUsed(int index) const
+	{
+		return index >= 0 && static_cast<size_t>(index) < _size && _usedPositions[index] >= 0;
+	}
+
+	/**
+	 * @brief Gets the index of an object of this pool
+	 *
+	 * Like the pointer arithmetic on a plain array this does not check if the object is part of the pool.
+	 */
+	int indexOf(const T* ptr) const { return static_cast<int>(ptr - slots()); }
+
+	/**
+	 * @brief The indices of all used slots, this changes when slots are allocated or freed
+	 */
+	const SCP_vector<int>& usedIndices() const { return _usedIndices; }
+
+	/**
+	 * @brief The number of used slots
+	 */
+	size_t numUsed() const { return _usedIndices.size(); }
+
+	/**
+	 * @brief The number of slots the pool currently has, all of them may be accessed
+	 */
+	size_t size() const { return _size; }
+
+	size_t maxSize() const { return _maxSize; }
+
+	T* begin() { return slots(); }
+	T* end() { return slots() + _size; }
+	const T* begin() const { return slots(); }
+	const T* end() const { return slots() + _size; }
+};
+
+} // namespace util
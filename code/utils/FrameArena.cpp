@@ -0,0 +1,166 @@
+
+#include "utils/FrameArena.h"
+
+#include "tracing/Monitor.h"
+
+#include <algorithm>
+
+namespace {
+
+tracing::Monitor<float> Frame_arena_peak_kb("FrameArenaPeakKB", 0.0f);
+tracing::Monitor<int> Frame_arena_heap_allocations("FrameArenaHeapAllocs", 0);
+
+} // namespace
+
+namespace util {
+
+const size_t FrameArena::DEFAULT_CHUNK_SIZE;
+
+FrameArena::FrameArena(size_t chunk_size) : _chunkSize(chunk_size)
+{
+	Assertion(chunk_size > 0, "The chunk size of a frame arena must not be zero!");
+}
+
+FrameArena::~FrameArena()
+{
+	freeChunks();
+}
+
+void FrameArena::addChunk(size_t min_size)
+{
+	chunk new_chunk;
+	new_chunk.size = std::max(_chunkSize, min_size);
+	new_chunk.memory = static_cast<std::uint8_t*>(vm_malloc(new_chunk.size));
+
+	_chunks.push_back(new_chunk);
+	_currentChunk = _chunks.size() - 1;
+	_offset = 0;
+
+	++_frameHeapAllocations;
+}
+
+void FrameArena::rewind()
+{
+	_currentChunk = 0;
+	_offset = 0;
+	_chunkBase = 0;
+}
+
+void FrameArena::freeChunks()
+{
+	for (auto& c : _chunks) {
+		vm_free(c.memory);
+	}
+	_chunks.clear();
+
+	rewind();
+}
+
+void* FrameArena::allocate(size_t size, size_t alignment)
+{
+	Assertion(alignment > 0 && (alignment & (alignment - 1)) == 0, "The alignment must be a power of two!");
+
+	while (true) {
+		if (_currentChunk >= _chunks.size()) {
+			addChunk(size + alignment);
+		}
+
+		auto& c = _chunks[_currentChunk];
+
+		auto base = reinterpret_cast<std::uintptr_t>(c.memory);
+		auto aligned = (base + _offset + alignment - 1) & ~(static_cast<std::uintptr_t>(alignment) - 1);
+		auto end = static_cast<size_t>(aligned - base) + size;
+
+		if (end <= c.size) {
+			_offset = end;
+			++_liveAllocations;
+
+			_framePeak = std::max(_framePeak, _chunkBase + _offset);
+
+			return reinterpret_cast<void*>(aligned);
+		}
+
+		// Continue with the next chunk, the rest of this one stays unused until the arena rewinds
+		_chunkBase += _offset;
+		++_currentChunk;
+		_offset = 0;
+	}
+}
+
+void FrameArena::deallocate(void* ptr, size_t size)
+{
+	Assertion(_liveAllocations > 0, "Freeing more memory than was allocated from this frame arena!");
+
+	--_liveAllocations;
+
+	if (_liveAllocations == 0) {
+		rewind();
+		return;
+	}
+
+	// Only the most recent allocation can be given back directly
+	auto& c = _chunks[_currentChunk];
+	auto mem = static_cast<std::uint8_t*>(ptr);
+	if (mem + size == c.memory + _offset) {
+		_offset = static_cast<size_t>(mem - c.memory);
+	}
+}
+
+void FrameArena::endFrame()
+{
+	_lastFramePeak = _framePeak;
+	_lastFrameHeapAllocations = _frameHeapAllocations;
+
+	_framePeak = _chunkBase + _offset;
+	_frameHeapAllocations = 0;
+
+	// Memory which is still in use would be overwritten if the chunks were replaced
+	if (_liveAllocations == 0 && _chunks.size() > 1) {
+		auto size = capacity();
+
+		freeChunks();
+		addChunk(size);
+		rewind();
+	}
+}
+
+size_t FrameArena::liveAllocations() const
+{
+	return _liveAllocations;
+}
+
+size_t FrameArena::lastFramePeak() const
+{
+	return _lastFramePeak;
+}
+
+size_t FrameArena::lastFrameHeapAllocations() const
+{
+	return _lastFrameHeapAllocations;
+}
+
+size_t FrameArena::capacity() const
+{
+	size_t size = 0;
+	for (auto& c : _chunks) {
+		size += c.size;
+	}
+	return size;
+}
+
+FrameArena& frame_arena()
+{
+	thread_local FrameArena arena;
+	return arena;
+}
+
+void frame_arena_end_frame()
+{
+	auto& arena = frame_arena();
+	arena.endFrame();
+
+	Frame_arena_peak_kb = arena.lastFramePeak() / 1024.0f;
+	Frame_arena_heap_allocations = static_cast<int>(arena.lastFrameHeapAllocations());
+}
+
+} // namespace util
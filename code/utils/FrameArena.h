@@ -0,0 +1,164 @@
+#pragma once
+
+#include "globalincs/pstypes.h"
+
+#include <vector>
+
+namespace util {
+
+/**
+ * @brief A bump allocator for temporary memory which does not outlive the current frame
+ *
+ * Memory is handed out from large chunks by advancing an offset so an allocation is only a few instructions and does not
+ * touch the heap. Freeing the most recent allocation gives its memory back, everything else is only returned once all
+ * allocations of the arena are freed. At that point the arena rewinds to the start of its first chunk.
+ *
+ * If a frame needed more than one chunk, the chunks are replaced by a single chunk big enough for all of them at the end
+ * of the frame. After a few frames the arena does not need the heap at all anymore.
+ *
+ * An arena must only be used by one thread, use frame_arena() to get the arena of the current thread.
+ */
+class FrameArena {
+  public:
+	/**
+	 * @brief The size of the first chunk of an arena
+	 */
+	static const size_t DEFAULT_CHUNK_SIZE = 256 * 1024;
+
+  private:
+	struct chunk {
+		std::uint8_t* memory;
+		size_t size;
+	};
+
+	SCP_vector<chunk> _chunks;
+	size_t _chunkSize;
+
+	size_t _currentChunk = 0;
+	size_t _offset = 0;
+	size_t _chunkBase = 0; //!< The bytes used by the chunks before the current one
+
+	size_t _liveAllocations = 0;
+
+	size_t _framePeak = 0;
+	size_t _frameHeapAllocations = 0;
+
+	size_t _lastFramePeak = 0;
+	size_t _lastFrameHeapAllocations = 0;
+
+	void addChunk(size_t min_size);
+
+	void rewind();
+
+	void freeChunks();
+
+  public:
+	explicit FrameArena(size_t chunk_size = DEFAULT_CHUNK_SIZE);
+	~FrameArena();
+
+	FrameArena(const FrameArena&) = delete;
+	FrameArena& operator=(const FrameArena&) = delete;
+
+	/**
+	 * @brief Allocates memory from the arena
+	 * @param size The size of the memory block
+	 * @param alignment The alignment of the block, must be a power of two
+	 * @return The allocated memory
+	 */
+	void* allocate(size_t size, size_t alignment);
+
+	/**
+	 * @brief Frees memory of this arena
+	 * @param ptr The pointer returned by allocate
+	 * @param size The size which was passed to allocate
+	 */
+	void deallocate(void* ptr, size_t size);
+
+	/**
+	 * @brief Finishes a frame of this arena
+	 *
+	 * Updates the frame statistics and merges the chunks of the frame into one chunk if nothing is allocated anymore.
+	 */
+	void endFrame();
+
+	/**
+	 * @brief The number of allocations which were not freed yet
+	 */
+	size_t liveAllocations() const;
+
+	/**
+	 * @brief The most memory which was in use at once in the last frame
+	 */
+	size_t lastFramePeak() const;
+
+	/**
+	 * @brief The number of chunks which had to be allocated from the heap in the last frame
+	 */
+	size_t lastFrameHeapAllocations() const;
+
+	/**
+	 * @brief The total size of all chunks of the arena
+	 */
+	size_t capacity() const;
+};
+
+/**
+ * @brief Gets the frame arena of the calling thread
+ */
+FrameArena& frame_arena();
+
+/**
+ * @brief Ends the frame of the arena of the main thread and publishes its statistics
+ *
+ * Must be called once per frame from the main thread.
+ */
+void frame_arena_end_frame();
+
+/**
+ * @brief A standard allocator which allocates from a frame arena
+ *
+ * The arena of the thread which created the allocator is used. Containers using this must be destroyed on that thread
+ * and before the end of the frame.
+ */
+template <typename T>
+class FrameAllocator {
+	FrameArena* _arena;
+
+	template <typename U>
+	friend class FrameAllocator;
+
+  public:
+	typedef T value_type;
+
+	FrameAllocator() : _arena(&frame_arena()) {}
+	explicit FrameAllocator(FrameArena& arena) : _arena(&arena) {}
+
+	template <typename U>
+	FrameAllocator(const FrameAllocator<U>& other) : _arena(other._arena)
+	{
+	}
+
+	T* allocate(size_t n) { return static_cast<T*>(_arena->allocate(n * sizeof(T), alignof(T))); }
+
+	void deallocate(T* ptr, size_t n) { _arena->deallocate(ptr, n * sizeof(T)); }
+
+	template <typename U>
+	bool operator==(const FrameAllocator<U>& other) const
+	{
+		return _arena == other._arena;
+	}
+
+	template <typename U>
+	bool operator!=(const FrameAllocator<U>& other) const
+	{
+		return _arena != other._arena;
+	}
+};
+
+/**
+ * @brief A vector for per-frame temporaries
+ */
+template <typename T>
+using FrameVector = std::vector<T, FrameAllocator<T>>;
+
+} // namespace util
@@ -0,0 +1,118 @@
+#pragma once
+
+#include "globalincs/pstypes.h"
+
+#include <atomic>
+
+namespace util {
+
+/**
+ * @brief A fixed size queue with exactly one producer and one consumer thread
+ *
+ * Neither side ever blocks or takes a lock. If the queue is full push() fails and the producer has to decide what to
+ * do with the element. The elements must be default constructible since the storage is allocated up front.
+ */
+template <typename T>
+class SpscQueue {
+	SCP_vector<T> _elements;
+	size_t _mask;
+
+	// Written by the producer
+	std::atomic<size_t> _head{0};
+
+	// Written by the consumer
+	std::atomic<size_t> _tail{0};
+
+  public:
+	/**
+	 * @param capacity The number of elements the queue can hold, must be a power of two
+	 */
+	explicit SpscQueue(size_t capacity) : _elements(capacity), _mask(capacity - 1)
+	{
+		Assertion(capacity > 0 && (capacity & (capacity - 1)) == 0, "Queue capacity " SIZE_T_ARG " is not a power of two!",
+			capacity);
+	}
+
+	SpscQueue(const SpscQueue&) = delete;
+	SpscQueue& operator=(const SpscQueue&) = delete;
+
+	/**
+	 * @brief Adds an element to the queue, may only be called by the producer thread
+	 * @return @c false if the queue was full, the element is not added in that case
+	 */
+	bool push(const T& element)
+	{
+		auto head = _head.load(std::memory_order_relaxed);
+		auto tail = _tail.load(std::memory_order_acquire);
+
+		if (head - tail >= _elements.size()) {
+			return false;
+		}
+
+		_elements[head & _mask] = element;
+		_head.store(head + 1, std::memory_order_release);
+		return true;
+	}
+
+	/**
+	 * @brief Moves an element into the queue, may only be called by the producer thread
+	 * @return @c false if the queue was full, the element is left untouched in that case
+	 */
+	bool push(T&& element)
+	{
+		auto head = _head.load(std::memory_order_relaxed);
+		auto tail = _tail.load(std::memory_order_acquire);
+
+		if (head - tail >= _elements.size()) {
+			return false;
+		}
+
+		_elements[head & _mask] = std::move(element);
+		_head.store(head + 1, std::memory_order_release);
+		return true;
+	}
+
+	/**
+	 * @brief Takes the oldest element from the queue, may only be called by the consumer thread
+	 * @return @c false if the queue was empty
+	 */
+	bool pop(T& element)
+	{
+		auto tail = _tail.load(std::memory_order_relaxed);
+		auto head = _head.load(std::memory_order_acquire);
+
+		if (head == tail) {
+			return false;
+		}
+
+		element = std::move(_elements[tail & _mask]);
+		_tail.store(tail + 1, std::memory_order_release);
+		return true;
+	}
+
+	/**
+	 * @brief Checks if there are no elements in the queue
+	 *
+	 * This is only a snapshot since the other thread may change the queue at any time.
+	 */
+	bool empty() const
+	{
+		return _head.load(std::memory_order_acquire) == _tail.load(std::memory_order_acquire);
+	}
+
+	/**
+	 * @brief The number of elements in the queue
+	 *
+	 * This is only a snapshot. The producer may see a bigger and the consumer a smaller value than the real one.
+	 */
+	size_t size() const
+	{
+		// The tail has to be read first, otherwise it could have moved past the head value
+		auto tail = _tail.load(std::memory_order_acquire);
+		return _head.load(std::memory_order_acquire) - tail;
+	}
+
+	size_t capacity() const { return _elements.size(); }
+};
+
+} // namespace util
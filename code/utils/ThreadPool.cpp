@@ -0,0 +1,160 @@
+
+#include "utils/ThreadPool.h"
+
+#include <atomic>
+
+namespace {
+
+struct parallel_for_state {
+	std::atomic<size_t> next{0};
+	size_t end = 0;
+
+	std::mutex mutex;
+	std::condition_variable finished_cond;
+	size_t finished = 0;
+	size_t total = 0;
+
+	std::exception_ptr exception;
+
+	const std::function<void(size_t)>* func = nullptr;
+
+	// Processes indices until none are left. Returns once this thread can not claim any more work.
+	void run()
+	{
+		size_t done = 0;
+		std::exception_ptr local_exception;
+
+		for (auto index = next++; index < end; index = next++) {
+			try {
+				(*func)(index);
+			} catch (...) {
+				if (!local_exception) {
+					local_exception = std::current_exception();
+				}
+			}
+			++done;
+		}
+
+		if (done == 0) {
+			return;
+		}
+
+		std::lock_guard<std::mutex> guard(mutex);
+		if (local_exception && !exception) {
+			exception = local_exception;
+		}
+		finished += done;
+		if (finished == total) {
+			finished_cond.notify_all();
+		}
+	}
+};
+
+} // namespace
+
+namespace util {
+
+ThreadPool::ThreadPool(size_t numThreads)
+{
+	_threads.reserve(numThreads);
+	for (size_t i = 0; i < numThreads; ++i) {
+		_threads.emplace_back(&ThreadPool::workerLoop, this);
+	}
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> guard(_mutex);
+		_stopping = true;
+	}
+	_taskAvailable.notify_all();
+
+	for (auto& thread : _threads) {
+		thread.join();
+	}
+}
+
+void ThreadPool::workerLoop()
+{
+	while (true) {
+		std::function<void()> task;
+		{
+			std::unique_lock<std::mutex> lock(_mutex);
+			_taskAvailable.wait(lock, [this]() { return _stopping || !_tasks.empty(); });
+
+			// Pending tasks are still finished when stopping so that no future is left without a value
+			if (_tasks.empty()) {
+				return;
+			}
+
+			task = std::move(_tasks.front());
+			_tasks.pop_front();
+		}
+
+		task();
+	}
+}
+
+void ThreadPool::enqueue(std::function<void()> task)
+{
+	if (_threads.empty()) {
+		task();
+		return;
+	}
+
+	{
+		std::lock_guard<std::mutex> guard(_mutex);
+		_tasks.push_back(std::move(task));
+	}
+	_taskAvailable.notify_one();
+}
+
+size_t ThreadPool::numThreads() const
+{
+	return _threads.size();
+}
+
+ThreadPool& get_thread_pool()
+{
+	static ThreadPool pool([]() -> size_t {
+		auto hardware_threads = std::thread::hardware_concurrency();
+		return hardware_threads > 1 ? hardware_threads - 1 : 0;
+	}());
+
+	return pool;
+}
+
+void parallel_for(size_t begin, size_t end, const std::function<void(size_t)>& func)
+{
+	if (begin >= end) {
+		return;
+	}
+
+	auto& pool = get_thread_pool();
+	auto count = end - begin;
+
+	// The state is shared since helper tasks may only get to run after this function returned if all workers are busy
+	auto state = std::make_shared<parallel_for_state>();
+	state->next = begin;
+	state->end = end;
+	state->total = count;
+	state->func = &func;
+
+	auto helpers = std::min(pool.numThreads(), count - 1);
+	for (size_t i = 0; i < helpers; ++i) {
+		pool.submit([state]() { state->run(); });
+	}
+
+	// This thread helps with the work so that progress is guaranteed even if all workers are occupied
+	state->run();
+
+	std::unique_lock<std::mutex> lock(state->mutex);
+	state->finished_cond.wait(lock, [&state]() { return state->finished == state->total; });
+
+	if (state->exception) {
+		std::rethrow_exception(state->exception);
+	}
+}
+
+} // namespace util
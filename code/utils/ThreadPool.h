@@ -0,0 +1,88 @@
+#pragma once
+
+#include "globalincs/pstypes.h"
+
+#include <condition_variable>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+
+namespace util {
+
+/**
+ * @brief A simple fixed size pool of worker threads
+ *
+ * Tasks are executed in the order they were submitted. This is meant for CPU-bound work that does not touch global
+ * engine state (e.g. decoding or text processing). Most of the engine is not thread safe so tasks must not call into
+ * systems like cfile, bmpman or the renderer unless those explicitly state that they may be used from other threads.
+ */
+class ThreadPool {
+	std::mutex _mutex;
+	std::condition_variable _taskAvailable;
+	SCP_deque<std::function<void()>> _tasks;
+	SCP_vector<std::thread> _threads;
+	bool _stopping = false;
+
+	void workerLoop();
+
+	void enqueue(std::function<void()> task);
+
+  public:
+	/**
+	 * @brief Creates a pool with the specified amount of worker threads
+	 * @param numThreads The number of threads. If 0 the tasks are executed directly in submit().
+	 */
+	explicit ThreadPool(size_t numThreads);
+	~ThreadPool();
+
+	ThreadPool(const ThreadPool&) = delete;
+	ThreadPool& operator=(const ThreadPool&) = delete;
+
+	/**
+	 * @brief Submits a task to the pool
+	 * @param func The function to execute
+	 * @return A future which will contain the result of the function
+	 */
+	template <typename Func>
+	std::future<typename std::result_of<Func()>::type> submit(Func&& func)
+	{
+		typedef typename std::result_of<Func()>::type result_type;
+
+		// std::function requires a copyable type so the task needs to be wrapped
+		auto task = std::make_shared<std::packaged_task<result_type()>>(std::forward<Func>(func));
+		auto future = task->get_future();
+
+		enqueue([task]() { (*task)(); });
+
+		return future;
+	}
+
+	/**
+	 * @brief The number of worker threads in this pool
+	 */
+	size_t numThreads() const;
+};
+
+/**
+ * @brief Gets the global worker pool
+ *
+ * The pool is created on first use with one thread less than the number of hardware threads so that the main thread
+ * still has a core available.
+ */
+ThreadPool& get_thread_pool();
+
+/**
+ * @brief Calls the function for every index in [begin, end) using the global worker pool
+ *
+ * The calling thread participates in the work and this function only returns once all calls have finished. The order
+ * in which the indices are processed is unspecified. If a call throws an exception, the first exception is rethrown
+ * after all other calls have finished.
+ *
+ * @param begin The first index
+ * @param end One past the last index
+ * @param func The function to call for every index
+ */
+void parallel_for(size_t begin, size_t end, const std::function<void(size_t)>& func);
+
+} // namespace util
@@ -0,0 +1,315 @@
+#pragma once
+
+#include "globalincs/pstypes.h"
+
+#include <algorithm>
+
+namespace util {
+
+/**
+ * @brief A hierarchical timer wheel which dispatches values once their deadline has passed
+ *
+ * Every level of the wheel has 64 slots. The first level has one slot per time unit, every following level covers the
+ * whole range of the previous one per slot. A timer is put into the slot of the lowest level that covers its deadline and
+ * is moved down a level whenever the wheel reaches its slot on the higher level. Scheduling and cancelling a timer are
+ * constant time and advancing the wheel only touches the timers which expire or move down a level, no matter how many
+ * timers are registered.
+ *
+ * The time unit is up to the user, the executors use milliseconds. Deadlines further away than the range of the wheel
+ * (2^30 units) are kept in the last slot and moved back to the right place when that slot is reached.
+ *
+ * @note This class is not thread safe.
+ */
+template <typename T>
+class TimerWheel {
+  public:
+	/**
+	 * @brief Identifies a scheduled timer, 0 is never a valid identifier
+	 */
+	typedef std::uint64_t TimerId;
+
+  private:
+	static const int SLOT_BITS = 6;
+	static const int NUM_SLOTS = 1 << SLOT_BITS;
+	static const int NUM_LEVELS = 5;
+
+	// Timers which were already due when they were scheduled are kept in an extra slot
+	static const int DUE_SLOT = NUM_LEVELS * NUM_SLOTS;
+
+	static const std::int64_t SLOT_MASK = NUM_SLOTS - 1;
+	static const std::int64_t MAX_DELTA = (static_cast<std::int64_t>(1) << (SLOT_BITS * NUM_LEVELS)) - 1;
+
+	struct timer_node {
+		T value;
+		std::int64_t deadline = 0;
+
+		int slot = -1; //!< The slot this is in or -1 if the node is free
+		int prev = -1;
+		int next = -1;
+
+		std::uint32_t generation = 0;
+	};
+
+	SCP_vector<timer_node> _nodes;
+	SCP_vector<int> _freeNodes;
+
+	int _slots[NUM_LEVELS * NUM_SLOTS + 1];
+	size_t _levelCounts[NUM_LEVELS + 1];
+
+	size_t _numTimers = 0;
+
+	std::int64_t _current; //!< The next time which has not been processed
+
+	SCP_vector<T> _expired;
+
+	void link(int index)
+	{
+		auto& node = _nodes[index];
+
+		auto delta = node.deadline - _current;
+
+		int level = 0;
+		int slot;
+		if (delta < 0) {
+			level = NUM_LEVELS;
+			slot = DUE_SLOT;
+		} else {
+			if (delta > MAX_DELTA) {
+				delta = MAX_DELTA;
+			}
+			while (level < NUM_LEVELS - 1 && delta >= (static_cast<std::int64_t>(1) << (SLOT_BITS * (level + 1)))) {
+				++level;
+			}
+			slot = level * NUM_SLOTS + static_cast<int>(((_current + delta) >> (SLOT_BITS * level)) & SLOT_MASK);
+		}
+
+		node.slot = slot;
+		node.prev = -1;
+		node.next = _slots[slot];
+		if (node.next >= 0) {
+			_nodes[node.next].prev = index;
+		}
+		_slots[slot] = index;
+
+		++_levelCounts[level];
+	}
+
+	void unlink(int index)
+	{
+		auto& node = _nodes[index];
+
+		if (node.prev >= 0) {
+			_nodes[node.prev].next = node.next;
+		} else {
+			_slots[node.slot] = node.next;
+		}
+		if (node.next >= 0) {
+			_nodes[node.next].prev = node.prev;
+		}
+
+		--_levelCounts[node.slot / NUM_SLOTS];
+		node.slot = -1;
+	}
+
+	int findNode(TimerId id) const
+	{
+		auto index = static_cast<int>(id & 0xFFFFFFFF) - 1;
+		auto generation = static_cast<std::uint32_t>(id >> 32);
+
+		if (index < 0 || index >= static_cast<int>(_nodes.size())) {
+			return -1;
+		}
+
+		const auto& node = _nodes[index];
+		if (node.slot < 0 || node.generation != generation) {
+			return -1;
+		}
+
+		return index;
+	}
+
+	void freeNode(int index)
+	{
+		auto& node = _nodes[index];
+		node.value = T();
+		++node.generation;
+		_freeNodes.push_back(index);
+		--_numTimers;
+	}
+
+	// Moves the timers of a slot one level down, returns the index of that slot in its level
+	int cascade(int level)
+	{
+		auto slot_index = static_cast<int>((_current >> (SLOT_BITS * level)) & SLOT_MASK);
+		auto slot = level * NUM_SLOTS + slot_index;
+
+		auto index = _slots[slot];
+		while (index >= 0) {
+			auto next = _nodes[index].next;
+			unlink(index);
+			link(index);
+			index = next;
+		}
+
+		return slot_index;
+	}
+
+	void expireSlot(int slot)
+	{
+		auto index = _slots[slot];
+		while (index >= 0) {
+			auto next = _nodes[index].next;
+
+			unlink(index);
+			_expired.push_back(std::move(_nodes[index].value));
+			freeNode(index);
+
+			index = next;
+		}
+	}
+
+	void processCurrent()
+	{
+		// Whenever a level wraps around the next slot of the level above needs to be spread over the levels below
+		if ((_current & SLOT_MASK) == 0) {
+			for (int level = 1; level < NUM_LEVELS; ++level) {
+				if (cascade(level) != 0) {
+					break;
+				}
+			}
+		}
+
+		expireSlot(static_cast<int>(_current & SLOT_MASK));
+
+		++_current;
+	}
+
+  public:
+	/**
+	 * @param start The time at which the wheel starts
+	 */
+	explicit TimerWheel(std::int64_t start = 0) : _current(start)
+	{
+		for (auto& slot : _slots) {
+			slot = -1;
+		}
+		for (auto& count : _levelCounts) {
+			count = 0;
+		}
+	}
+
+	/**
+	 * @brief Schedules a value to be dispatched once the wheel advanced past the deadline
+	 *
+	 * Deadlines in the past are dispatched by the next advance.
+	 *
+	 * @return The identifier of the timer
+	 */
+	TimerId schedule(std::int64_t deadline, T value)
+	{
+		int index;
+		if (!_freeNodes.empty()) {
+			index = _freeNodes.back();
+			_freeNodes.pop_back();
+		} else {
+			index = static_cast<int>(_nodes.size());
+			_nodes.emplace_back();
+		}
+
+		auto& node = _nodes[index];
+		node.value = std::move(value);
+		node.deadline = deadline;
+		link(index);
+
+		++_numTimers;
+
+		return (static_cast<TimerId>(node.generation) << 32) | static_cast<TimerId>(index + 1);
+	}
+
+	/**
+	 * @brief Checks if a timer is still waiting to be dispatched
+	 */
+	bool isScheduled(TimerId id) const { return findNode(id) >= 0; }
+
+	/**
+	 * @brief Removes a timer before it is dispatched
+	 * @return @c true if the timer was removed, @c false if it was already dispatched or cancelled
+	 */
+	bool cancel(TimerId id)
+	{
+		auto index = findNode(id);
+		if (index < 0) {
+			return false;
+		}
+
+		unlink(index);
+		freeNode(index);
+		return true;
+	}
+
+	/**
+	 * @brief Removes a timer before it is dispatched and hands its value to the caller
+	 * @return @c true if the timer was removed and @c value was set, @c false if it was already dispatched or cancelled
+	 */
+	bool cancel(TimerId id, T& value)
+	{
+		auto index = findNode(id);
+		if (index < 0) {
+			return false;
+		}
+
+		value = std::move(_nodes[index].value);
+		unlink(index);
+		freeNode(index);
+		return true;
+	}
+
+	/**
+	 * @brief Dispatches all timers with a deadline up to and including the specified time
+	 *
+	 * The timers are dispatched in the order of their deadlines after all of them were removed from the wheel, so
+	 * dispatching may schedule new timers. Those are dispatched by the next advance even if they are already due.
+	 *
+	 * @param now The current time, the wheel never goes back in time
+	 * @param dispatch Called with every expired value
+	 * @return The number of dispatched timers
+	 */
+	template <typename Func>
+	size_t advance(std::int64_t now, Func&& dispatch)
+	{
+		// These are older than anything else in the wheel
+		expireSlot(DUE_SLOT);
+
+		while (_current <= now) {
+			if (_numTimers == 0) {
+				_current = now + 1;
+				break;
+			}
+
+			processCurrent();
+
+			// Without timers on the first level nothing happens until that level wraps around
+			if (_levelCounts[0] == 0 && (_current & SLOT_MASK) != 0) {
+				auto wrap = (_current | SLOT_MASK) + 1;
+				_current = std::min(wrap, now + 1);
+			}
+		}
+
+		auto num_expired = _expired.size();
+		for (auto& value : _expired) {
+			dispatch(std::move(value));
+		}
+		_expired.clear();
+
+		return num_expired;
+	}
+
+	/**
+	 * @brief The number of scheduled timers
+	 */
+	size_t size() const { return _numTimers; }
+
+	bool empty() const { return _numTimers == 0; }
+};
+
+} // namespace util
@@ -25,6 +25,8 @@
 #include "model/model.h"
 #include "model/modelanimation.h"
 #include "particle/ParticleManager.h"
+#include "utils/ChunkedPool.h"
+#include "utils/FrameArena.h"
 #include "weapon/beam.h"
 #include "weapon/shockwave.h"
 #include "weapon/swarm.h"
@@ -100,8 +102,8 @@ struct WeaponStateHash {
 };
 
 typedef struct weapon {
-	int		weapon_info_index;			// index into weapon_info array
-	int		objnum;							// object number for this weapon
+	int		weapon_info_index = -1;		// index into weapon_info array, -1 if this slot is unused
+	int		objnum = -1;					// object number for this weapon
 	int		model_instance_num;				// model instance number, if we have any intrinsic-moving submodels
 	int		team;								// The team of the ship that fired this
 	int		species;							// The species of the ship that fired thisz
@@ -294,7 +296,7 @@ typedef struct spawn_weapon_info
 #define BEAM_FAR_LENGTH				30000.0f
 
 
-extern weapon Weapons[MAX_WEAPONS];
+extern util::ChunkedPool<weapon> Weapons;
 
 #define WEAPON_TITLE_LEN			48
 
@@ -683,7 +685,7 @@ extern int Default_cmeasure_index;
 
 extern SCP_vector<int> Player_weapon_precedence;	// Vector of weapon types, precedence list for player weapon selection
 
-#define WEAPON_INDEX(wp)			(int)(wp-Weapons)
+#define WEAPON_INDEX(wp)			Weapons.indexOf(wp)
 
 
 int weapon_info_lookup(const char *name);
@@ -743,7 +745,7 @@ int	weapon_area_calc_damage(object *objp, vec3d *pos, float inner_rad, float out
 										float *blast, float *damage, float limit);
 
 missile_obj *missile_obj_return_address(int index);
-void find_homing_object_cmeasures(const SCP_vector<object*> &cmeasure_list);
+void find_homing_object_cmeasures(const util::FrameVector<object*> &cmeasure_list);
 
 // THE FOLLOWING FUNCTION IS IN SHIP.CPP!!!!
 // JAS - figure out which thruster bitmap will get rendered next
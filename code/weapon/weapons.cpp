@@ -85,7 +85,7 @@ DCF_BOOL( weapon_flyby, Weapon_flyby_sound_enabled )
 
 static int Weapon_flyby_sound_timer;	
 
-weapon Weapons[MAX_WEAPONS];
+util::ChunkedPool<weapon> Weapons(MAX_WEAPONS);
 SCP_vector<weapon_info> Weapon_info;
 
 #define		MISSILE_OBJ_USED	(1<<0)			// flag used in missile_obj struct
@@ -4456,10 +4456,7 @@ void weapon_level_init()
 
 	// Reset everything between levels
 	Num_weapons = 0;
-	for (i=0; i<MAX_WEAPONS; i++)	{
-		Weapons[i].objnum = -1;
-		Weapons[i].weapon_info_index = -1;
-	}
+	Weapons.clear();
 
 	for (i = 0; i < weapon_info_size(); i++) {
 		Weapon_info[i].damage_type_idx = Weapon_info[i].damage_type_idx_sav;
@@ -4569,6 +4566,7 @@ void weapon_delete(object *obj)
 	}
 
 	wp->objnum = -1;
+	Weapons.free(num);
 	Num_weapons--;
 	Assert(Num_weapons >= 0);
 }
@@ -4788,7 +4786,7 @@ void find_homing_object(object *weapon_objp, int num)
 /**
  * For all homing weapons, see if they should be decoyed by a countermeasure.
  */
-void find_homing_object_cmeasures(const SCP_vector<object*> &cmeasure_list)
+void find_homing_object_cmeasures(const util::FrameVector<object*> &cmeasure_list)
 {
 	for (object *weapon_objp = GET_FIRST(&obj_used_list); weapon_objp != END_OF_LIST(&obj_used_list); weapon_objp = GET_NEXT(weapon_objp) ) {
 		if (weapon_objp->flags[Object::Object_Flags::Should_be_dead])
@@ -6160,19 +6158,6 @@ int weapon_create( vec3d * pos, matrix * porient, int weapon_type, int parent_ob
 		}
 	}
 
-	if (Num_weapons == MAX_WEAPONS) {
-		mprintf(("Can't fire due to lack of weapon slots"));
-		return -1;
-	}
-
-	for (n=0; n<MAX_WEAPONS; n++ ){
-		if (Weapons[n].weapon_info_index < 0){
-			break;
-		}
-	}
-
-	Assertion(n != MAX_WEAPONS, "Somehow tried to create weapons despite being at max weapons");
-
 	// make sure we are loaded and useable
 	if ( (wip->render_type == WRT_POF) && (wip->model_num < 0) ) {
 		wip->model_num = model_load(wip->pofbitmap_name, 0, NULL);
@@ -6224,11 +6209,18 @@ int weapon_create( vec3d * pos, matrix * porient, int weapon_type, int parent_ob
 	if (wip->wi_flags[Weapon::Info_Flags::Can_damage_shooter])
 		default_flags.set(Object::Object_Flags::Collides_with_parent);
 
+	n = Weapons.allocate();
+	if (n < 0) {
+		mprintf(("Can't fire due to lack of weapon slots\n"));
+		return -1;
+	}
+
 	// mark this object creation as essential, if it is created by a player.  
 	// You don't want players mysteriously wondering why they aren't firing.
 	objnum = obj_create( OBJ_WEAPON, parent_objnum, n, orient, pos, 2.0f, default_flags, (parent_objp != nullptr && parent_objp->flags[Object::Object_Flags::Player_ship]));
 
 	if (objnum < 0) {
+		Weapons.free(n);
 		mprintf(("A weapon failed to be created because FSO is running out of object slots!\n"));
 		return -1;
 	}
@@ -8424,7 +8416,7 @@ float weapon_get_damage_scale(weapon_info *wip, object *wep, object *target)
 
 void pause_in_flight_sounds()
 {
-	for (int i = 0; i < MAX_WEAPONS; i++)
+	for (auto i : Weapons.usedIndices())
 	{
 		if (Weapons[i].objnum != -1)
 		{
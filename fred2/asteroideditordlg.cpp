@@ -734,7 +734,7 @@ void asteroid_editor::OnAddFieldTarget()
 	CString str;
 
 	// add any ship in the mission
-	for (int i = 0; i < MAX_SHIPS; i++)
+	for (int i = 0; i < static_cast<int>(Ships.size()); i++)
 	{
 		if (Ships[i].objnum >= 0)
 			targets.push_back(Ships[i].ship_name);
@@ -797,7 +797,7 @@ Assert((flag == 0) || (flag == 1));
 
 //	Find highest used object if writing.
 if (flag == 1) {
-for (i=MAX_OBJECTS-1; i>0; i--)
+for (i=static_cast<int>(Objects.size())-1; i>0; i--)
 if (Objects[i].type != OBJ_NONE) {
 highest_object_index = i;
 break;
@@ -820,7 +820,7 @@ Num_objects++;
 
 //	Read/write ships
 if (flag == 1) {
-for (i=MAX_SHIPS-1; i>0; i--)
+for (i=static_cast<int>(Ships.size())-1; i>0; i--)
 if (Ships[i].objnum) {
 highest_ship_index = i;
 break;
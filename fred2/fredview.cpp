@@ -2567,7 +2567,7 @@ int CFREDView::global_error_check()
 	}
 
 	count = 0;
-	for (i=0; i<MAX_SHIPS; i++) {
+	for (i=0; i<static_cast<int>(Ships.size()); i++) {
 		if (Ships[i].objnum >= 0) {  // is ship being used?
 			count++;
 			if (!query_valid_object(Ships[i].objnum)){
@@ -2862,7 +2862,7 @@ int CFREDView::global_error_check()
 
 	for (i=0; i<Num_reinforcements; i++) {
 		z = 0;
-		for (ship=0; ship<MAX_SHIPS; ship++){
+		for (ship=0; ship<static_cast<int>(Ships.size()); ship++){
 			if ((Ships[ship].objnum >= 0) && !stricmp(Ships[ship].ship_name, Reinforcements[i].name)) {
 				z = 1;
 				break;
@@ -2897,7 +2897,7 @@ int CFREDView::global_error_check()
 				return -1;
 	}*/
 
-	Assert((Player_start_shipnum >= 0) && (Player_start_shipnum < MAX_SHIPS) && (Ships[Player_start_shipnum].objnum >= 0));
+	Assert((Player_start_shipnum >= 0) && (Player_start_shipnum < static_cast<int>(Ships.size())) && (Ships[Player_start_shipnum].objnum >= 0));
 	i = global_error_check_player_wings(multi);
 	if (i){
 		return i;
@@ -4087,7 +4087,7 @@ void CFREDView::OnSetGroup(UINT nID)
 	int i, err = 0, n = 1 << (nID - ID_SET_GROUP1);
 	object *objp;
 
-	for (i=0; i<MAX_SHIPS; i++)
+	for (i=0; i<static_cast<int>(Ships.size()); i++)
 		Ships[i].group &= ~n;
 
 	objp = GET_FIRST(&obj_used_list);
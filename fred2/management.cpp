@@ -618,7 +618,7 @@ int query_ship_name_duplicate(int ship)
 {
 	int i;
 
-	for (i=0; i<MAX_SHIPS; i++)
+	for (i=0; i<static_cast<int>(Ships.size()); i++)
 		if ((i != ship) && (Ships[i].objnum != -1))
 			if (!stricmp(Ships[i].ship_name, Ships[ship].ship_name))
 				return 1;
@@ -1465,7 +1465,7 @@ void unmark_all()
 	int i;
 
 	if (Marked) {
-		for (i=0; i<MAX_OBJECTS; i++){
+		for (i=0; i<static_cast<int>(Objects.size()); i++){
             Objects[i].flags.remove(Object::Object_Flags::Marked);
 		}
 
@@ -1782,7 +1782,7 @@ int internal_integrity_check()
 			verify_sexp_tree(Wings[i].departure_cue);
 		}
 
-	for (i=0; i<MAX_SHIPS; i++)
+	for (i=0; i<static_cast<int>(Ships.size()); i++)
 		if (Ships[i].objnum >= 0) {
 			verify_sexp_tree(Ships[i].arrival_cue);
 			verify_sexp_tree(Ships[i].departure_cue);
@@ -2266,7 +2266,7 @@ void object_moved(object *objp)
 	if ((objp->type == OBJ_SHIP) || (objp->type == OBJ_START)) // do we have a ship?
 	{
 		// reset the already-handled flag (inefficient, but it's FRED, so who cares)
-        for (int i = 0; i < MAX_OBJECTS; i++)
+        for (int i = 0; i < static_cast<int>(Objects.size()); i++)
             Objects[i].flags.remove(Object::Object_Flags::Docked_already_handled);
 
 		// move all docked objects docked to me
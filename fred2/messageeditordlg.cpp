@@ -134,7 +134,7 @@ BOOL CMessageEditorDlg::OnInitDialog()
 		box->AddString( Personas[i].name );
 
 	box = (CComboBox *) GetDlgItem(IDC_SENDER);
-	for (i=0; i<MAX_SHIPS; i++)
+	for (i=0; i<static_cast<int>(Ships.size()); i++)
 		if ((Ships[i].objnum >= 0) && (Objects[Ships[i].objnum].type == OBJ_SHIP))
 			box->AddString(Ships[i].ship_name);
 
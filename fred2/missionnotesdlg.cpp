@@ -438,7 +438,7 @@ BOOL CMissionNotesDlg::OnInitDialog()
 
 	box = (CComboBox *) GetDlgItem(IDC_COMMAND_SENDER);
 	box->AddString(DEFAULT_COMMAND);
-	for (i=0; i<MAX_SHIPS; i++){
+	for (i=0; i<static_cast<int>(Ships.size()); i++){
 		if (Ships[i].objnum >= 0)
 			if (Ship_info[Ships[i].ship_info_index].is_huge_ship())
 				box->AddString(Ships[i].ship_name);
@@ -3190,7 +3190,7 @@ int CFred_mission_save::save_objects()
 	parse_comments(2);
 	fout("\t\t;! %d total\n", ship_get_num_ships());
 
-	for (i = z = 0; i < MAX_SHIPS; i++) {
+	for (i = z = 0; i < static_cast<int>(Ships.size()); i++) {
 		if (Ships[i].objnum < 0) {
 			continue;
 		}
@@ -4168,7 +4168,7 @@ int CFred_mission_save::save_reinforcements()
 		fout(" %s", Reinforcements[i].name);
 
 		type = TYPE_ATTACK_PROTECT;
-		for (j = 0; j < MAX_SHIPS; j++)
+		for (j = 0; j < static_cast<int>(Ships.size()); j++)
 			if ((Ships[j].objnum != -1) && !stricmp(Ships[j].ship_name, Reinforcements[i].name)) {
 				if (Ship_info[Ships[j].ship_info_index].flags[Ship::Info_Flags::Support])
 					type = TYPE_REPAIR_REARM;
@@ -190,14 +190,14 @@ void reinforcement_editor_dlg::OnOK()
 				break;
 
 		if (j == Num_reinforcements) {
-			for (j=0; j<MAX_SHIPS; j++)
+			for (j=0; j<static_cast<int>(Ships.size()); j++)
 				if ((Ships[j].objnum != -1) && !stricmp(m_reinforcements[i].name, Ships[j].ship_name)) {
 					//free_sexp2(Ships[j].arrival_cue);
 					//Ships[j].arrival_cue = Locked_sexp_false;
 					break;
 				}
 
-			if (j == MAX_SHIPS) {
+			if (j == static_cast<int>(Ships.size())) {
 				for (j=0; j<MAX_WINGS; j++)
 					if (Wings[j].wave_count && !stricmp(m_reinforcements[i].name, Wings[j].name)) {
 						//free_sexp2(Wings[j].arrival_cue);
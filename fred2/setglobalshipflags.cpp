@@ -48,7 +48,7 @@ void SetGlobalShipFlags::OnNoShields()
 {
 	int i;
 	
-	for (i=0; i<MAX_SHIPS; i++)
+	for (i=0; i<static_cast<int>(Ships.size()); i++)
 	{
 		if (Ships[i].objnum >= 0)
 		{
@@ -61,7 +61,7 @@ void SetGlobalShipFlags::OnNoSubspaceDrive()
 {
 	int i;
 	
-	for (i=0; i<MAX_SHIPS; i++)
+	for (i=0; i<static_cast<int>(Ships.size()); i++)
 	{
 		if (Ships[i].objnum >= 0)
 		{
@@ -75,7 +75,7 @@ void SetGlobalShipFlags::OnPrimitiveSensors()
 {
 	int i;
 	
-	for (i=0; i<MAX_SHIPS; i++)
+	for (i=0; i<static_cast<int>(Ships.size()); i++)
 	{
 		if (Ships[i].objnum >= 0)
 		{
@@ -89,7 +89,7 @@ void SetGlobalShipFlags::OnAffectedByGravity()
 {
 	int i;
 	
-	for (i=0; i<MAX_SHIPS; i++)
+	for (i=0; i<static_cast<int>(Ships.size()); i++)
 	{
 		if (Ships[i].objnum >= 0)
 		{
@@ -68,7 +68,7 @@ BOOL shield_sys_dlg::OnInitDialog()
 	for (i=0; i<MAX_SHIP_CLASSES; i++)
 		types[i] = 0;
 
-	for (i=0; i<MAX_SHIPS; i++)
+	for (i=0; i<static_cast<int>(Ships.size()); i++)
 		if (Ships[i].objnum >= 0) {
 			z = (Objects[Ships[i].objnum].flags[Object::Object_Flags::No_shields]) ? 1 : 0;
 			if (!teams[Ships[i].team])
@@ -109,7 +109,7 @@ void shield_sys_dlg::OnOK()
 
 	OnSelchangeTeam();
 	OnSelchangeType();
-	for (i=0; i<MAX_SHIPS; i++)
+	for (i=0; i<static_cast<int>(Ships.size()); i++)
 		if (Ships[i].objnum >= 0) {
 			z = Shield_sys_teams[Ships[i].team];
 			if (!Shield_sys_types[Ships[i].ship_info_index])
@@ -349,7 +349,7 @@ int find_free_wing()
 int get_free_objnum(void) {
 	int	i;
 
-	for (i = 1; i<MAX_OBJECTS; i++)
+	for (i = 1; i<static_cast<int>(Objects.size()); i++)
 		if (Objects[i].type == OBJ_NONE)
 			return i;
 
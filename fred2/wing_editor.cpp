@@ -338,7 +338,7 @@ void wing_editor::initialize_data_safe(int full_update)
 				player_enabled = 0;
 		}
 
-		if ((Player_start_shipnum >= 0) && (Player_start_shipnum < MAX_SHIPS) && (Ships[Player_start_shipnum].objnum >= 0))
+		if ((Player_start_shipnum >= 0) && (Player_start_shipnum < static_cast<int>(Ships.size())) && (Ships[Player_start_shipnum].objnum >= 0))
 			if (Ships[Player_start_shipnum].wingnum == cur_wing)
 				player_wing = 1;
 
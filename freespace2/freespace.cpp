@@ -185,7 +185,9 @@
 #include "stats/medals.h"
 #include "stats/stats.h"
 #include "tracing/Monitor.h"
+#include "tracing/PerfStats.h"
 #include "tracing/tracing.h"
+#include "utils/FrameArena.h"
 #include "utils/Random.h"
 #include "weapon/beam.h"
 #include "weapon/emp.h"
@@ -300,6 +302,16 @@ int	Framerate_cap = 120;
 // for the model page in system
 extern void model_page_in_start();
 
+// gameplay sounds which were kept loaded for the next mission, see -asset_retention
+static size_t Retained_sound_bytes = 0;
+// how long the sound preload of the current mission took, retained sounds don't have to be loaded again
+static std::uint64_t Sound_preload_time = 0;
+
+static size_t game_get_retention_budget()
+{
+	return (size_t)Cmdline_asset_retention * 1024 * 1024;
+}
+
 int	Show_cpu = 0;
 int	Show_target_debug_info = 0;
 int	Show_target_weapons = 0;
@@ -853,7 +865,16 @@ void game_level_close()
 		game_stop_looped_sounds();
 		snd_stop_all();
 		obj_snd_level_close();					// uninit object-linked persistant sounds
-		gamesnd_unload_gameplay_sounds();	// unload gameplay sounds from memory
+
+		// the next mission loads the same gameplay sounds again so keep them if they fit into the retention budget
+		auto retention_budget = game_get_retention_budget();
+		auto gameplay_sound_bytes = (retention_budget > 0) ? gamesnd_get_gameplay_sounds_size() : 0;
+		if ((retention_budget > 0) && (gameplay_sound_bytes <= retention_budget)) {
+			Retained_sound_bytes = gameplay_sound_bytes;
+		} else {
+			Retained_sound_bytes = 0;
+			gamesnd_unload_gameplay_sounds();	// unload gameplay sounds from memory
+		}
 		anim_level_close();						// stop and clean up any anim instances
 		message_mission_shutdown();			// called after anim_level_close() to make sure instances are clear
 		shockwave_level_close();
@@ -975,6 +996,10 @@ void game_level_init()
 	obj_init();						// Must be inited before the other systems
 
 	if ( !(Game_mode & GM_STANDALONE_SERVER) ) {
+		// models unused by this mission may stay loaded with whatever the kept sounds left of the budget
+		auto retention_budget = game_get_retention_budget();
+		model_set_retention_budget(retention_budget > Retained_sound_bytes ? retention_budget - Retained_sound_bytes : 0);
+
 		model_page_in_start();		// mark any existing models as unused but don't unload them yet
 		mprintf(( "Beginning level bitmap paging...\n" ));
 		bm_page_in_start();
@@ -1275,12 +1300,14 @@ void freespace_mission_load_stuff()
 
 		{
 			TRACE_SCOPE(tracing::PreloadMissionSounds);
+			auto preload_start = timer_get_microseconds();
 
 			game_busy( NOX("** preloading common game sounds **") );
 			gamesnd_preload_common_sounds();			// load in sounds that are expected to play
 
 			game_busy( NOX("** preloading gameplay sounds **") );
 			gamesnd_load_gameplay_sounds();			// preload in gameplay sounds if wanted
+			Sound_preload_time = timer_get_microseconds() - preload_start;
 
 			game_busy( NOX("** assigning sound environment for mission **") );
 			ship_assign_sound_all();	// assign engine sounds to ships
@@ -1456,6 +1483,10 @@ bool game_start_mission()
 	int e1 __UNUSED = timer_get_milliseconds();
 
 	mprintf(("Level load took %f seconds.\n", (e1 - s1) / 1000.0f ));
+	mprintf(("Sound preload took %.1f ms\n", Sound_preload_time / 1000.0));
+	if (Cmdline_asset_retention > 0) {
+		mprintf(("Asset retention: %d KB of gameplay sounds were kept from the previous mission\n", (int)(Retained_sound_bytes / 1024)));
+	}
 	return true;
 }
 
@@ -2061,6 +2092,34 @@ void game_get_framerate()
 	Framecount++;
 }
 
+// The number of scopes shown by -perf_stats, the ones with the highest 95th percentile come first
+const size_t PERF_STATS_HUD_SCOPES = 12;
+
+/**
+ * Show the rolling performance statistics of -perf_stats
+ */
+static void game_show_perf_stats(int line_height)
+{
+	int sx = gr_screen.center_offset_x + gr_screen.center_w - 400;
+	int sy = gr_screen.center_offset_y + 100;
+
+	gr_string(sx, sy, "p50 / p95 / p99", GR_RESIZE_NONE);
+	sy += line_height;
+
+	size_t num_scopes = 0;
+	for (const auto& stat : tracing::get_perf_stats()) {
+		if (stat.type == tracing::PerfStatType::Counter) {
+			gr_printf_no_resize(sx, sy, "%s: %.0f / %.0f / %.0f", stat.name.c_str(), stat.p50, stat.p95, stat.p99);
+		} else {
+			if (stat.type == tracing::PerfStatType::Scope && num_scopes++ >= PERF_STATS_HUD_SCOPES) {
+				break;
+			}
+			gr_printf_no_resize(sx, sy, "%s: %.2f / %.2f / %.2f ms", stat.name.c_str(), stat.p50, stat.p95, stat.p99);
+		}
+		sy += line_height;
+	}
+}
+
 /**
  * Show FPS within game
  */
@@ -2133,6 +2192,11 @@ void game_show_framerate()
 		}
 	}
 
+	if (Cmdline_perf_stats && HUD_draw) {
+		gr_set_color_fast(&HUD_color_debug);
+		game_show_perf_stats(line_height);
+	}
+
 	// possibly show control checking info
 	control_check_indicate();
 
@@ -2194,7 +2258,6 @@ void game_show_framerate()
 
 		{
 
-			extern int Num_pairs;		// Number of object pairs that were checked.
 			gr_printf_no_resize( sx, sy, NOX("PAIRS: %d"), Num_pairs );
 			sy += line_height;
 
@@ -3490,11 +3553,25 @@ void game_render_frame( camid cid )
 	g3_end_frame();
 }
 
-//	Flip the page and time how long it took.
-void game_flip_page_and_time_it()
+// Ends the traced main frame and submits the per-frame counters of the performance and memory statistics
+static void game_trace_frame_boundary()
 {
+	tracing::counter::value(tracing::PerfObjects, i2fl(Num_objects));
+	tracing::counter::value(tracing::PerfCollisionPairs, i2fl(Num_pairs));
+	tracing::counter::value(tracing::PerfParticles, static_cast<float>(particle::get_num_particles()));
+	tracing::counter::value(tracing::PerfDrawCalls, i2fl(Gr_draw_calls));
+
+	memory::tracking_frame();
+	util::frame_arena_end_frame();
+
 	tracing::async::end(tracing::MainFrame, tracing::MainFrameScope);
 	tracing::async::begin(tracing::MainFrame, tracing::MainFrameScope);
+}
+
+//	Flip the page and time how long it took.
+void game_flip_page_and_time_it()
+{
+	game_trace_frame_boundary();
 
 	fix t1 = timer_get_fixed_seconds();
 	gr_flip();
@@ -4132,6 +4209,8 @@ void game_frame(bool paused)
 			}
 
 		} else {
+			// The standalone server never flips but its frames should still show up in the statistics
+			game_trace_frame_boundary();
 			game_show_standalone_framerate();
 		}
 	}
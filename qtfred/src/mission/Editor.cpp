@@ -332,7 +332,7 @@ bool Editor::loadMission(const std::string& mission_name, int flags) {
 }
 void Editor::unmark_all() {
 	if (numMarked > 0) {
-		for (auto i = 0; i < MAX_OBJECTS; i++) {
+		for (auto i = 0; i < static_cast<int>(Objects.size()); i++) {
 			Objects[i].flags.remove(Object::Object_Flags::Marked);
 			if (Objects[i].type != OBJ_NONE) {
 				// Only emit signals for valid objects
@@ -692,7 +692,7 @@ int Editor::create_ship(matrix* orient, vec3d* pos, int ship_type) {
 bool Editor::query_ship_name_duplicate(int ship) {
 	int i;
 
-	for (i = 0; i < MAX_SHIPS; i++) {
+	for (i = 0; i < static_cast<int>(Ships.size()); i++) {
 		if ((i != ship) && (Ships[i].objnum != -1)) {
 			if (!stricmp(Ships[i].ship_name, Ships[ship].ship_name)) {
 				return true;
@@ -1994,7 +1994,7 @@ int Editor::global_error_check_impl() {
 	}
 
 	count = 0;
-	for (i = 0; i < MAX_SHIPS; i++) {
+	for (i = 0; i < static_cast<int>(Ships.size()); i++) {
 		if (Ships[i].objnum >= 0) {  // is ship being used?
 			count++;
 			if (!query_valid_object(Ships[i].objnum)) {
@@ -2305,7 +2305,7 @@ int Editor::global_error_check_impl() {
 
 	for (i = 0; i < Num_reinforcements; i++) {
 		z = 0;
-		for (ship = 0; ship < MAX_SHIPS; ship++) {
+		for (ship = 0; ship < static_cast<int>(Ships.size()); ship++) {
 			if ((Ships[ship].objnum >= 0) && !stricmp(Ships[ship].ship_name, Reinforcements[i].name)) {
 				z = 1;
 				break;
@@ -2341,7 +2341,7 @@ int Editor::global_error_check_impl() {
 	}*/
 
 	Assert(
-		(Player_start_shipnum >= 0) && (Player_start_shipnum < MAX_SHIPS) && (Ships[Player_start_shipnum].objnum >= 0));
+		(Player_start_shipnum >= 0) && (Player_start_shipnum < static_cast<int>(Ships.size())) && (Ships[Player_start_shipnum].objnum >= 0));
 	i = global_error_check_player_wings(multi);
 	if (i) {
 		return i;
@@ -3101,7 +3101,7 @@ void Editor::importShieldSysData(const std::vector<int>& teams, const std::vecto
 	Shield_sys_teams = teams;
 	Shield_sys_types = types;
 
-	for (int i = 0; i < MAX_SHIPS; i++) {
+	for (int i = 0; i < static_cast<int>(Ships.size()); i++) {
 		if (Ships[i].objnum >= 0) {
 			int z = Shield_sys_teams[Ships[i].team];
 			if (!Shield_sys_types[Ships[i].ship_info_index])
@@ -3123,7 +3123,7 @@ void Editor::normalizeShieldSysData() {
 	std::vector<int> teams(Iff_info.size(), 0);
 	std::vector<int> types(MAX_SHIP_CLASSES, 0);
 
-	for (int i = 0; i < MAX_SHIPS; i++) {
+	for (int i = 0; i < static_cast<int>(Ships.size()); i++) {
 		if (Ships[i].objnum >= 0) {
 			int z = (Objects[Ships[i].objnum].flags[Object::Object_Flags::No_shields]) ? 1 : 0;
 			if (!teams[Ships[i].team])
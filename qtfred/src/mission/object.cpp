@@ -17,7 +17,7 @@ void object_moved(object *objp)
 	if ((objp->type == OBJ_SHIP) || (objp->type == OBJ_START)) // do we have a ship?
 	{
 		// reset the already-handled flag (inefficient, but it's FRED, so who cares)
-		for (int i = 0; i < MAX_OBJECTS; i++)
+		for (int i = 0; i < static_cast<int>(Objects.size()); i++)
 			Objects[i].flags.set(Object::Object_Flags::Docked_already_handled);
 
 		// move all docked objects docked to me
@@ -1046,7 +1046,7 @@ void FredView::onGroupSelected(int group) {
 void FredView::onSetGroup(int group) {
 	bool err = false;
 
-	for (auto i = 0; i < MAX_SHIPS; i++) {
+	for (auto i = 0; i < static_cast<int>(Ships.size()); i++) {
 		Ships[i].group &= ~group;
 	}
 
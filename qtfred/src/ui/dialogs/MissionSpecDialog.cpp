@@ -195,7 +195,7 @@ void MissionSpecDialog::updateCmdMessage() {
 	auto sender = _model->getCommandSender();
 	ui->senderCombBox->clear();
 	ui->senderCombBox->addItem(DEFAULT_COMMAND, QVariant(QString(DEFAULT_COMMAND)));
-	for (i = 0; i < MAX_SHIPS; i++) {
+	for (i = 0; i < static_cast<int>(Ships.size()); i++) {
 		if (Ships[i].objnum >= 0)
 			if (Ship_info[Ships[i].ship_info_index].is_huge_ship())
 				ui->senderCombBox->addItem(Ships[i].ship_name, QVariant(QString(Ships[i].ship_name)));
@@ -0,0 +1,118 @@
+
+#include <gtest/gtest.h>
+
+#include "anim/anim_frame_cache.h"
+#include "anim/packunpack.h"
+
+namespace {
+
+anim_frame_cache::frame_key make_key(const anim* ani, int offset)
+{
+	anim_frame_cache::frame_key key;
+	key.ani = ani;
+	key.offset = offset;
+	key.bpp = 32;
+
+	return key;
+}
+
+anim_frame_cache::frame make_frame(size_t size, int next_offset)
+{
+	anim_frame_cache::frame new_frame;
+	new_frame.pixels.assign(size, static_cast<ubyte>(next_offset));
+	new_frame.next_offset = next_offset;
+
+	return new_frame;
+}
+
+} // namespace
+
+TEST(AnimFrameCacheTests, findsInsertedFrames)
+{
+	anim ani;
+	anim_frame_cache cache;
+	cache.set_budget(1024);
+
+	ASSERT_EQ(nullptr, cache.find(make_key(&ani, 0)));
+	cache.insert(make_key(&ani, 0), make_frame(100, 10));
+
+	auto frame = cache.find(make_key(&ani, 0));
+	ASSERT_NE(nullptr, frame);
+	ASSERT_EQ(10, frame->next_offset);
+	ASSERT_EQ((size_t)100, frame->pixels.size());
+
+	// The same data decoded in another format is a different frame
+	auto other_format = make_key(&ani, 0);
+	other_format.aabitmap = true;
+	other_format.bpp = 8;
+	ASSERT_FALSE(cache.contains(other_format));
+
+	ASSERT_EQ((size_t)1, cache.get_stats().hits);
+	ASSERT_EQ((size_t)1, cache.get_stats().misses);
+	ASSERT_EQ((size_t)100, cache.get_stats().bytes);
+}
+
+TEST(AnimFrameCacheTests, evictsUnusedFramesFirst)
+{
+	anim ani;
+	anim_frame_cache cache;
+	cache.set_budget(300);
+
+	auto in_use = cache.insert(make_key(&ani, 0), make_frame(100, 10));
+	cache.insert(make_key(&ani, 10), make_frame(100, 20));
+	cache.insert(make_key(&ani, 20), make_frame(100, 30));
+
+	// The oldest frame is still referenced so the next one has to go
+	cache.insert(make_key(&ani, 30), make_frame(100, 40));
+	ASSERT_TRUE(cache.contains(make_key(&ani, 0)));
+	ASSERT_FALSE(cache.contains(make_key(&ani, 10)));
+	ASSERT_TRUE(cache.contains(make_key(&ani, 30)));
+	ASSERT_EQ((size_t)1, cache.get_stats().evictions);
+	ASSERT_LE(cache.get_stats().bytes, (size_t)300);
+
+	// Finding a frame makes it the most recently used one
+	in_use.reset();
+	cache.find(make_key(&ani, 0));
+	cache.insert(make_key(&ani, 50), make_frame(100, 60));
+	ASSERT_TRUE(cache.contains(make_key(&ani, 0)));
+	ASSERT_FALSE(cache.contains(make_key(&ani, 20)));
+	ASSERT_EQ((size_t)2, cache.get_stats().evictions);
+
+	// Frames which are too big are still handed out
+	auto too_big = cache.insert(make_key(&ani, 40), make_frame(400, 50));
+	ASSERT_NE(nullptr, too_big);
+	ASSERT_FALSE(cache.contains(make_key(&ani, 40)));
+}
+
+TEST(AnimFrameCacheTests, collectsPrefetchedFrames)
+{
+	anim first;
+	anim second;
+	anim_frame_cache cache;
+	cache.set_budget(1024);
+
+	std::promise<anim_frame_cache::prefetch_result> promise;
+	cache.add_pending(make_key(&first, 10), promise.get_future());
+	ASSERT_TRUE(cache.is_prefetching(make_key(&first, 50)));
+	ASSERT_FALSE(cache.is_prefetching(make_key(&second, 10)));
+
+	cache.collect();
+	ASSERT_FALSE(cache.contains(make_key(&first, 10)));
+
+	anim_frame_cache::prefetch_result result;
+	result.emplace_back(make_key(&first, 10), make_frame(100, 20));
+	result.emplace_back(make_key(&first, 20), make_frame(100, 30));
+	promise.set_value(std::move(result));
+
+	cache.collect();
+	ASSERT_FALSE(cache.is_prefetching(make_key(&first, 10)));
+	ASSERT_TRUE(cache.contains(make_key(&first, 10)));
+	ASSERT_TRUE(cache.contains(make_key(&first, 20)));
+	ASSERT_EQ((size_t)2, cache.get_stats().prefetched);
+
+	cache.insert(make_key(&second, 0), make_frame(100, 10));
+	cache.remove_anim(&first);
+	ASSERT_FALSE(cache.contains(make_key(&first, 10)));
+	ASSERT_TRUE(cache.contains(make_key(&second, 0)));
+	ASSERT_EQ((size_t)100, cache.get_stats().bytes);
+}
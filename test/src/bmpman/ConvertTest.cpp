@@ -0,0 +1,286 @@
+
+#include <gtest/gtest.h>
+
+#include "bmpman/bm_convert.h"
+#include "cfile/cfile.h"
+#include "pngutils/pngutils.h"
+
+#include "util/FSTestFixture.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <random>
+
+namespace {
+
+// Odd sizes so the scalar tails of the kernels are used as well
+const size_t NUM_PIXELS = 1021;
+
+SCP_vector<ubyte> random_bytes(size_t count, unsigned int seed)
+{
+	std::mt19937 rng(seed);
+	std::uniform_int_distribution<int> dist(0, 255);
+
+	SCP_vector<ubyte> bytes(count);
+	for (auto& byte : bytes) {
+		byte = static_cast<ubyte>(dist(rng));
+	}
+
+	return bytes;
+}
+
+// Restores the threshold after a test changed it
+class parallel_threshold {
+	size_t _old;
+
+  public:
+	explicit parallel_threshold(size_t pixels) : _old(Bm_convert_parallel_pixels)
+	{
+		Bm_convert_parallel_pixels = pixels;
+	}
+	~parallel_threshold() { Bm_convert_parallel_pixels = _old; }
+};
+
+} // namespace
+
+TEST(BmConvertTests, swapRedBlue)
+{
+	for (int bpp = 3; bpp <= 4; ++bpp) {
+		auto pixels = random_bytes(NUM_PIXELS * bpp, 1);
+		auto expected = pixels;
+		for (size_t i = 0; i < NUM_PIXELS; ++i) {
+			std::swap(expected[i * bpp], expected[i * bpp + 2]);
+		}
+
+		bm_swap_red_blue(pixels.data(), NUM_PIXELS, bpp);
+		ASSERT_EQ(expected, pixels);
+	}
+}
+
+TEST(BmConvertTests, expand24To32)
+{
+	auto src = random_bytes(NUM_PIXELS * 3, 2);
+	SCP_vector<ubyte> dst(NUM_PIXELS * 4);
+
+	bm_expand_24_to_32(dst.data(), src.data(), NUM_PIXELS);
+
+	for (size_t i = 0; i < NUM_PIXELS; ++i) {
+		ASSERT_EQ(src[i * 3], dst[i * 4]);
+		ASSERT_EQ(src[i * 3 + 1], dst[i * 4 + 1]);
+		ASSERT_EQ(src[i * 3 + 2], dst[i * 4 + 2]);
+		ASSERT_EQ(255, dst[i * 4 + 3]);
+	}
+}
+
+TEST(BmConvertTests, premultiplyAlpha)
+{
+	auto pixels = random_bytes(NUM_PIXELS * 4, 3);
+	auto expected = pixels;
+	for (size_t i = 0; i < NUM_PIXELS; ++i) {
+		auto alpha = expected[i * 4 + 3];
+		for (int c = 0; c < 3; ++c) {
+			expected[i * 4 + c] = static_cast<ubyte>((expected[i * 4 + c] * alpha + 127) / 255);
+		}
+	}
+
+	bm_premultiply_alpha(pixels.data(), NUM_PIXELS);
+	ASSERT_EQ(expected, pixels);
+}
+
+TEST(BmConvertTests, convert1555ToTex)
+{
+	auto src = random_bytes(NUM_PIXELS * 2, 4);
+	// Pure green with and without the unused bit
+	src[10] = 0xe0;
+	src[11] = 0x03;
+	src[100] = 0xe0;
+	src[101] = 0x83;
+
+	SCP_vector<ushort> dst(NUM_PIXELS);
+	bm_convert_1555_to_tex(dst.data(), src.data(), NUM_PIXELS);
+
+	for (size_t i = 0; i < NUM_PIXELS; ++i) {
+		auto pixel = static_cast<ushort>(src[i * 2] | (src[i * 2 + 1] << 8));
+		auto expected = ((pixel & 0x7fff) == 0x03e0) ? 0 : (pixel | 0x8000);
+		ASSERT_EQ(expected, dst[i]);
+	}
+	ASSERT_EQ(0, dst[5]);
+	ASSERT_EQ(0, dst[50]);
+}
+
+TEST(BmConvertTests, replace16)
+{
+	SCP_vector<ushort> pixels(NUM_PIXELS);
+	for (size_t i = 0; i < NUM_PIXELS; ++i) {
+		pixels[i] = static_cast<ushort>(i % 3);
+	}
+
+	bm_replace_16(pixels.data(), NUM_PIXELS, 1, 0xbeef);
+
+	for (size_t i = 0; i < NUM_PIXELS; ++i) {
+		ASSERT_EQ((i % 3 == 1) ? 0xbeef : (i % 3), pixels[i]);
+	}
+}
+
+TEST(BmConvertTests, mipmapChain)
+{
+	ASSERT_EQ(1, bm_get_mipmap_levels(1, 1));
+	ASSERT_EQ(9, bm_get_mipmap_levels(256, 256));
+	ASSERT_EQ(9, bm_get_mipmap_levels(256, 3));
+	ASSERT_EQ((size_t)(4 * 4 * 4 + 2 * 2 * 4 + 4), bm_get_mipmap_chain_size(4, 4, 4, 3));
+	ASSERT_EQ((size_t)(5 * 3 * 3 + 2 * 1 * 3 + 1 * 1 * 3), bm_get_mipmap_chain_size(5, 3, 3, 3));
+}
+
+TEST(BmConvertTests, generateMipmaps)
+{
+	for (int bpp = 3; bpp <= 4; ++bpp) {
+		const int w = 37;
+		const int h = 21;
+		auto levels = bm_get_mipmap_levels(w, h);
+
+		SCP_vector<ubyte> data(bm_get_mipmap_chain_size(w, h, bpp, levels));
+		auto image = random_bytes(static_cast<size_t>(w * h * bpp), 5);
+		std::copy(image.begin(), image.end(), data.begin());
+
+		bm_generate_mipmaps(data.data(), w, h, bpp, levels);
+
+		// Every level has to be the 2x2 average of the previous one
+		auto src = data.data();
+		int src_w = w;
+		int src_h = h;
+		for (int level = 1; level < levels; ++level) {
+			auto dst = src + src_w * src_h * bpp;
+			auto dst_w = std::max(1, src_w / 2);
+			auto dst_h = std::max(1, src_h / 2);
+
+			for (int y = 0; y < dst_h; ++y) {
+				auto y0 = std::min(2 * y, src_h - 1);
+				auto y1 = std::min(2 * y + 1, src_h - 1);
+				for (int x = 0; x < dst_w; ++x) {
+					auto x0 = std::min(2 * x, src_w - 1);
+					auto x1 = std::min(2 * x + 1, src_w - 1);
+					for (int c = 0; c < bpp; ++c) {
+						int sum = src[(y0 * src_w + x0) * bpp + c] + src[(y0 * src_w + x1) * bpp + c] +
+						          src[(y1 * src_w + x0) * bpp + c] + src[(y1 * src_w + x1) * bpp + c];
+						ASSERT_EQ((sum + 2) >> 2, dst[(y * dst_w + x) * bpp + c]);
+					}
+				}
+			}
+
+			src = dst;
+			src_w = dst_w;
+			src_h = dst_h;
+		}
+		ASSERT_EQ(1, src_w);
+		ASSERT_EQ(1, src_h);
+	}
+}
+
+TEST(BmConvertTests, parallelMatchesSerial)
+{
+	const int w = 512;
+	const int h = 512;
+	const size_t num_pixels = w * h;
+	auto levels = bm_get_mipmap_levels(w, h);
+
+	auto source = random_bytes(bm_get_mipmap_chain_size(w, h, 4, levels), 6);
+	auto serial = source;
+	auto parallel = source;
+
+	{
+		parallel_threshold threshold(0);
+		bm_swap_red_blue(serial.data(), num_pixels, 4);
+		bm_premultiply_alpha(serial.data(), num_pixels);
+		bm_generate_mipmaps(serial.data(), w, h, 4, levels);
+	}
+	{
+		parallel_threshold threshold(1);
+		bm_swap_red_blue(parallel.data(), num_pixels, 4);
+		bm_premultiply_alpha(parallel.data(), num_pixels);
+		bm_generate_mipmaps(parallel.data(), w, h, 4, levels);
+	}
+
+	ASSERT_EQ(serial, parallel);
+}
+
+class BmConvertBenchmark : public test::FSTestFixture {
+  public:
+	BmConvertBenchmark() : test::FSTestFixture(INIT_CFILE) {}
+};
+
+// Converts the PNG maps of a mod. Set FSO_TEXTURE_BENCHMARK_DIR to the root directory of the mod and run it with
+// --gtest_also_run_disabled_tests.
+TEST_F(BmConvertBenchmark, DISABLED_modTextures)
+{
+	auto dir = getenv("FSO_TEXTURE_BENCHMARK_DIR");
+	if (dir == nullptr) {
+		std::cout << "[ SKIPPED  ] FSO_TEXTURE_BENCHMARK_DIR is not set" << std::endl;
+		return;
+	}
+
+	cfile_close();
+
+	SCP_string root(dir);
+	root += DIR_SEPARATOR_CHAR;
+	root += "test"; // Cfile expects something after the path
+	ASSERT_EQ(0, cfile_init(root.c_str()));
+
+	SCP_vector<SCP_string> files;
+	cf_get_file_list(files, CF_TYPE_MAPS, "*.png", CF_SORT_NAME);
+
+	struct image {
+		int w;
+		int h;
+		SCP_vector<ubyte> data;
+	};
+	SCP_vector<image> images;
+	size_t total_pixels = 0;
+
+	for (auto& name : files) {
+		auto filename = name + ".png";
+
+		int w, h, bpp;
+		if (png_read_header(filename.c_str(), nullptr, &w, &h, &bpp) != PNG_ERROR_NONE || bpp != 32) {
+			continue;
+		}
+
+		image img;
+		img.w = w;
+		img.h = h;
+		img.data.resize(bm_get_mipmap_chain_size(w, h, 4, bm_get_mipmap_levels(w, h)));
+		if (png_read_bitmap(filename.c_str(), img.data.data(), &bpp, 4, CF_TYPE_MAPS) != PNG_ERROR_NONE) {
+			continue;
+		}
+
+		total_pixels += static_cast<size_t>(w) * h;
+		images.push_back(std::move(img));
+	}
+
+	if (images.empty()) {
+		std::cout << "[ SKIPPED  ] No 32 bit PNG maps found in " << dir << std::endl;
+		return;
+	}
+
+	auto run = [&images](size_t threshold) {
+		parallel_threshold guard(threshold);
+
+		auto start = std::chrono::high_resolution_clock::now();
+		for (auto& img : images) {
+			auto num_pixels = static_cast<size_t>(img.w) * img.h;
+			bm_swap_red_blue(img.data.data(), num_pixels, 4);
+			bm_premultiply_alpha(img.data.data(), num_pixels);
+			bm_generate_mipmaps(img.data.data(), img.w, img.h, 4, bm_get_mipmap_levels(img.w, img.h));
+		}
+		auto time = std::chrono::high_resolution_clock::now() - start;
+
+		return std::chrono::duration_cast<std::chrono::microseconds>(time).count() / 1000.0;
+	};
+
+	auto serial = run(0);
+	auto parallel = run(Bm_convert_parallel_pixels);
+
+	std::cout << "[ BENCH    ] " << images.size() << " textures (" << total_pixels / (1024 * 1024)
+	          << " MPixels), single threaded: " << serial << " ms" << std::endl;
+	std::cout << "[ BENCH    ] " << images.size() << " textures (" << total_pixels / (1024 * 1024)
+	          << " MPixels), worker pool: " << parallel << " ms" << std::endl;
+}
@@ -0,0 +1,142 @@
+
+#include <gtest/gtest.h>
+
+#include "bmpman/bm_name_index.h"
+#include "parse/parselo.h"
+
+#include <chrono>
+#include <random>
+
+namespace {
+
+struct fake_slot {
+	SCP_string filename;
+	int dir_type = -1;
+	bool animated = false;
+	bool used = false;
+};
+
+// What bmpman did before it had an index
+int find_by_scan(const SCP_vector<fake_slot>& slots, const char* filename, int dir_type, bool animated)
+{
+	for (size_t i = 0; i < slots.size(); ++i) {
+		auto& slot = slots[i];
+		if (!slot.used || slot.dir_type != dir_type || slot.animated != animated) {
+			continue;
+		}
+		if (!strextcmp(filename, slot.filename.c_str())) {
+			return static_cast<int>(i);
+		}
+	}
+	return -1;
+}
+
+SCP_string make_name(std::mt19937& rng, int num_names)
+{
+	std::uniform_int_distribution<int> name_dist(0, num_names - 1);
+	std::uniform_int_distribution<int> ext_dist(0, 2);
+
+	static const char* prefixes[] = {"fighter2t-01", "Fighter2T-01", "capital01-glow", "explosion"};
+	static const char* extensions[] = {"", ".dds", ".PNG"};
+
+	auto name = name_dist(rng);
+	return SCP_string(prefixes[name % 4]) + "_" + std::to_string(name / 4) + extensions[ext_dist(rng)];
+}
+
+} // namespace
+
+TEST(BmNameIndexTests, sameResultAsScanningAllSlots)
+{
+	std::mt19937 rng(11);
+	std::uniform_int_distribution<int> action_dist(0, 9);
+	std::uniform_int_distribution<int> dir_dist(-1, 1);
+
+	SCP_vector<fake_slot> slots(200);
+	bm_name_index index;
+
+	for (int i = 0; i < 20000; ++i) {
+		auto name = make_name(rng, 100);
+		auto dir_type = dir_dist(rng);
+		auto animated = action_dist(rng) == 0;
+
+		ASSERT_EQ(find_by_scan(slots, name.c_str(), dir_type, animated), index.find(name.c_str(), dir_type, animated));
+
+		auto action = action_dist(rng);
+		if (action < 5) {
+			// Load into a free slot, sometimes as a duplicate
+			for (size_t slot_index = 0; slot_index < slots.size(); ++slot_index) {
+				auto& slot = slots[(slot_index * 37 + i) % slots.size()];
+				if (!slot.used) {
+					slot.filename = name;
+					slot.dir_type = dir_type;
+					slot.animated = animated;
+					slot.used = true;
+					index.add(name.c_str(), dir_type, animated, static_cast<int>((slot_index * 37 + i) % slots.size()));
+					break;
+				}
+			}
+		} else if (action < 9) {
+			// Release a random slot
+			auto slot_index = static_cast<int>(rng() % slots.size());
+			auto& slot = slots[slot_index];
+			if (slot.used) {
+				index.remove(slot.filename.c_str(), slot.dir_type, slot.animated, slot_index);
+				slot.used = false;
+			}
+		}
+	}
+}
+
+// Only measures the time, run it with --gtest_also_run_disabled_tests
+TEST(BmNameIndexTests, DISABLED_pageInOverhead)
+{
+	// A mission page-in where a lot of the textures are shared between models
+	const int NUM_LOADS = 8000;
+	const int NUM_NAMES = 3000;
+
+	std::mt19937 rng(5);
+	SCP_vector<SCP_string> loads;
+	for (int i = 0; i < NUM_LOADS; ++i) {
+		loads.push_back(make_name(rng, NUM_NAMES));
+	}
+
+	SCP_vector<fake_slot> slots;
+	int scan_duplicates = 0;
+	auto start = std::chrono::high_resolution_clock::now();
+	for (auto& name : loads) {
+		if (find_by_scan(slots, name.c_str(), -1, false) >= 0) {
+			++scan_duplicates;
+			continue;
+		}
+		fake_slot slot;
+		slot.filename = name;
+		slot.used = true;
+		slots.push_back(slot);
+	}
+	auto scan_time = std::chrono::high_resolution_clock::now() - start;
+
+	bm_name_index index;
+	int next_handle = 0;
+	int index_duplicates = 0;
+	start = std::chrono::high_resolution_clock::now();
+	for (auto& name : loads) {
+		if (index.find(name.c_str(), -1, false) >= 0) {
+			++index_duplicates;
+			continue;
+		}
+		index.add(name.c_str(), -1, false, next_handle++);
+	}
+	auto index_time = std::chrono::high_resolution_clock::now() - start;
+
+	ASSERT_EQ(scan_duplicates, index_duplicates);
+	ASSERT_EQ(slots.size(), index.size());
+
+	auto ms = [](std::chrono::high_resolution_clock::duration time) {
+		return std::chrono::duration_cast<std::chrono::microseconds>(time).count() / 1000.0;
+	};
+
+	std::cout << "[ BENCH    ] page-in of " << NUM_LOADS << " loads (" << slots.size() << " bitmaps), scanning slots: "
+	          << ms(scan_time) << " ms" << std::endl;
+	std::cout << "[ BENCH    ] page-in of " << NUM_LOADS << " loads (" << slots.size() << " bitmaps), name index: "
+	          << ms(index_time) << " ms" << std::endl;
+}
@@ -0,0 +1,149 @@
+
+#include <gtest/gtest.h>
+
+#include "bmpman/bm_residency.h"
+
+namespace {
+
+// A 4096x4096 texture with a full mipmap chain of 4 bytes per pixel
+const int TEX_SIZE = 4096;
+const int TEX_MIPMAPS = 13;
+const size_t TEX_BYTES = static_cast<size_t>(TEX_SIZE) * TEX_SIZE * 4 * 4 / 3;
+
+size_t level_bytes(int level)
+{
+	return TEX_BYTES >> (2 * level);
+}
+
+} // namespace
+
+TEST(BmResidencyTests, startsWithLowMipmaps)
+{
+	bm_residency residency;
+	residency.set_min_resident_size(256);
+
+	ASSERT_EQ(4, residency.add(1, TEX_SIZE, TEX_SIZE, TEX_MIPMAPS, TEX_BYTES));
+	ASSERT_EQ(0, residency.add(2, 128, 128, 8, 128 * 128 * 4));
+	ASSERT_EQ(-1, residency.base_level(3));
+
+	ASSERT_EQ(level_bytes(4) + 128 * 128 * 4, residency.get_stats().resident_bytes);
+
+	residency.remove(1);
+	ASSERT_EQ((size_t)1, residency.get_stats().num_textures);
+	ASSERT_EQ((size_t)(128 * 128 * 4), residency.get_stats().resident_bytes);
+}
+
+TEST(BmResidencyTests, upgradesRequestedTextures)
+{
+	bm_residency residency;
+	residency.set_min_resident_size(256);
+	residency.add(1, TEX_SIZE, TEX_SIZE, TEX_MIPMAPS, TEX_BYTES);
+	residency.add(2, TEX_SIZE, TEX_SIZE, TEX_MIPMAPS, TEX_BYTES);
+
+	// The biggest request of a frame counts
+	residency.request(1, 300.0f);
+	residency.request(1, 1100.0f);
+	residency.request(2, 100.0f);
+
+	SCP_vector<bm_residency::level_change> changes;
+	residency.update(changes);
+
+	ASSERT_EQ((size_t)1, changes.size());
+	ASSERT_EQ(1, changes[0].handle);
+	ASSERT_EQ(1, changes[0].base_level);
+	ASSERT_EQ(1, residency.base_level(1));
+	ASSERT_EQ(4, residency.base_level(2));
+
+	// Nothing changes without new requests
+	changes.clear();
+	residency.update(changes);
+	ASSERT_TRUE(changes.empty());
+}
+
+TEST(BmResidencyTests, evictsLeastRecentlyUsed)
+{
+	bm_residency residency;
+	residency.set_min_resident_size(256);
+	for (int handle = 1; handle <= 3; ++handle) {
+		residency.add(handle, TEX_SIZE, TEX_SIZE, TEX_MIPMAPS, TEX_BYTES);
+	}
+
+	// Room for two textures at full detail
+	residency.set_budget(2 * level_bytes(0) + level_bytes(4));
+
+	SCP_vector<bm_residency::level_change> changes;
+	residency.request(1, 5000.0f);
+	residency.update(changes);
+	residency.request(2, 5000.0f);
+	residency.update(changes);
+	ASSERT_EQ(0, residency.base_level(1));
+	ASSERT_EQ(0, residency.base_level(2));
+
+	// Texture 1 was used longest ago so it makes room for texture 3
+	changes.clear();
+	residency.request(2, 5000.0f);
+	residency.request(3, 5000.0f);
+	residency.update(changes);
+
+	ASSERT_EQ(4, residency.base_level(1));
+	ASSERT_EQ(0, residency.base_level(2));
+	ASSERT_EQ(0, residency.base_level(3));
+	ASSERT_EQ((size_t)1, residency.get_stats().evictions);
+	ASSERT_EQ((size_t)2, changes.size());
+	ASSERT_LE(residency.get_stats().resident_bytes, 2 * level_bytes(0) + level_bytes(4));
+
+	// Textures in use are never evicted, even if that means the request can't be served
+	changes.clear();
+	residency.request(1, 5000.0f);
+	residency.request(2, 5000.0f);
+	residency.request(3, 5000.0f);
+	residency.update(changes);
+	ASSERT_TRUE(changes.empty());
+	ASSERT_EQ(4, residency.base_level(1));
+}
+
+TEST(BmResidencyTests, limitsUpgradesPerUpdate)
+{
+	bm_residency residency;
+	residency.set_min_resident_size(256);
+	residency.set_max_upgrades_per_update(2);
+	for (int handle = 1; handle <= 5; ++handle) {
+		residency.add(handle, TEX_SIZE, TEX_SIZE, TEX_MIPMAPS, TEX_BYTES);
+		residency.request(handle, 2048.0f);
+	}
+
+	SCP_vector<bm_residency::level_change> changes;
+	residency.update(changes);
+	ASSERT_EQ((size_t)2, changes.size());
+	ASSERT_EQ((size_t)2, residency.get_stats().upgrades);
+}
+
+TEST(BmResidencyTests, keepsUnrequestedTexturesComplete)
+{
+	bm_residency residency;
+	residency.set_min_resident_size(256);
+	residency.set_budget(level_bytes(0) + level_bytes(4));
+
+	// Textures nobody requested are not tracked, bmpman uploads them completely
+	ASSERT_EQ(-1, residency.base_level(1));
+	residency.request(1, 100.0f);
+	ASSERT_FALSE(residency.contains(1));
+
+	// A texture which was created before its first request keeps its levels while it is in use
+	ASSERT_EQ(0, residency.add(2, TEX_SIZE, TEX_SIZE, TEX_MIPMAPS, TEX_BYTES, true));
+	ASSERT_EQ(level_bytes(0), residency.get_stats().resident_bytes);
+
+	SCP_vector<bm_residency::level_change> changes;
+	residency.request(2, 100.0f);
+	residency.update(changes);
+	ASSERT_TRUE(changes.empty());
+	ASSERT_EQ(0, residency.base_level(2));
+
+	// It is dropped to its low levels once it is unused and another texture needs the room
+	residency.add(3, TEX_SIZE, TEX_SIZE, TEX_MIPMAPS, TEX_BYTES, true);
+	residency.request(3, 5000.0f);
+	residency.update(changes);
+	ASSERT_EQ(4, residency.base_level(2));
+	ASSERT_EQ(0, residency.base_level(3));
+	ASSERT_EQ((size_t)1, residency.get_stats().evictions);
+}
@@ -5,6 +5,10 @@
 
 #include "util/FSTestFixture.h"
 
+#include <chrono>
+#include <functional>
+#include <iostream>
+
 class CFileInitTest : public test::FSTestFixture {
  public:
 	CFileInitTest() : test::FSTestFixture(INIT_NONE) {
@@ -211,4 +215,108 @@ TEST_F(CFileTest, subfolder_list)
 	table_files.clear();
 	ASSERT_EQ(2, cf_get_file_list(table_files, CF_TYPE_TABLES, "*\\*.tbl", CF_SORT_NAME));
 	ASSERT_TRUE(table_files.back().substr(0, 6) == "folder");
-}
\ No newline at end of file
+}
+
+namespace {
+
+struct read_pattern {
+	const char* name;
+	std::function<void(CFILE*, SCP_vector<char>&)> read;
+};
+
+SCP_vector<read_pattern> compressed_read_patterns(int length)
+{
+	SCP_vector<read_pattern> patterns;
+
+	// Reading the entire file at once
+	patterns.push_back({"whole file", [length](CFILE* fp, SCP_vector<char>& out) {
+		cfseek(fp, 0, CF_SEEK_SET);
+		ASSERT_EQ(1, cfread(out.data(), length, 1, fp));
+	}});
+
+	// Small sequential reads like the ones done by the model loader
+	patterns.push_back({"sequential", [length](CFILE* fp, SCP_vector<char>& out) {
+		cfseek(fp, 0, CF_SEEK_SET);
+		for (int pos = 0; pos < length; pos += 4) {
+			ASSERT_EQ(1, cfread(out.data() + pos, 4, 1, fp));
+		}
+	}});
+
+	// Random reads of varying sizes. The read size is capped so that the reads stay within the file.
+	patterns.push_back({"random", [length](CFILE* fp, SCP_vector<char>& out) {
+		uint state = 1;
+		for (int i = 0; i < 2000; ++i) {
+			state = state * 1103515245u + 12345u;
+			auto pos = static_cast<int>((state >> 8) % length);
+			state = state * 1103515245u + 12345u;
+			auto size = std::min(1 + static_cast<int>((state >> 8) % 512), length - pos);
+
+			cfseek(fp, pos, CF_SEEK_SET);
+			ASSERT_EQ(1, cfread(out.data() + pos, size, 1, fp));
+		}
+	}});
+
+	return patterns;
+}
+
+} // namespace
+
+// The VP contains the same 128 KiB of data twice, once as an LZ41 compressed file with 4 KiB blocks and once
+// uncompressed.
+TEST_F(CFileTest, compressed_reads)
+{
+	auto compressed = cfopen("compressed.pof", "rb", CFILE_NORMAL, CF_TYPE_MODELS);
+	ASSERT_TRUE(compressed != nullptr);
+	auto uncompressed = cfopen("uncompressed.pof", "rb", CFILE_NORMAL, CF_TYPE_MODELS);
+	ASSERT_TRUE(uncompressed != nullptr);
+
+	auto length = cfilelength(uncompressed);
+	ASSERT_EQ(131072, length);
+	ASSERT_EQ(length, cfilelength(compressed));
+
+	SCP_vector<char> expected(length);
+	SCP_vector<char> actual(length);
+
+	for (auto& pattern : compressed_read_patterns(length)) {
+		std::fill(expected.begin(), expected.end(), 0);
+		std::fill(actual.begin(), actual.end(), 0);
+
+		pattern.read(uncompressed, expected);
+		pattern.read(compressed, actual);
+		ASSERT_EQ(expected, actual) << pattern.name;
+	}
+
+	cfclose(compressed);
+	cfclose(uncompressed);
+}
+
+// Only prints how long the reads of compressed_reads take, run it with --gtest_also_run_disabled_tests
+TEST_F(CFileTest, DISABLED_compressed_read_speed)
+{
+	auto compressed = cfopen("compressed.pof", "rb", CFILE_NORMAL, CF_TYPE_MODELS);
+	ASSERT_TRUE(compressed != nullptr);
+	auto uncompressed = cfopen("uncompressed.pof", "rb", CFILE_NORMAL, CF_TYPE_MODELS);
+	ASSERT_TRUE(uncompressed != nullptr);
+
+	auto length = cfilelength(uncompressed);
+	SCP_vector<char> buffer(length);
+
+	auto time_reads = [&](CFILE* fp, const read_pattern& pattern) {
+		auto start = std::chrono::high_resolution_clock::now();
+		for (int i = 0; i < 10; ++i) {
+			pattern.read(fp, buffer);
+		}
+		auto end = std::chrono::high_resolution_clock::now();
+		return std::chrono::duration_cast<std::chrono::microseconds>(end - start).count() / 10;
+	};
+
+	for (auto& pattern : compressed_read_patterns(length)) {
+		auto compressed_us = time_reads(compressed, pattern);
+		auto uncompressed_us = time_reads(uncompressed, pattern);
+		std::cout << "[ BENCH    ] " << pattern.name << ": compressed " << compressed_us << "us, uncompressed "
+		          << uncompressed_us << "us" << std::endl;
+	}
+
+	cfclose(compressed);
+	cfclose(uncompressed);
+}
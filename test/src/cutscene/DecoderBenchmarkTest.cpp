@@ -0,0 +1,83 @@
+
+#include <gtest/gtest.h>
+
+#include "cfile/cfile.h"
+#include "cutscene/ffmpeg/FFMPEGDecoder.h"
+#include "libs/ffmpeg/FFmpeg.h"
+
+#include "util/FSTestFixture.h"
+
+#include <chrono>
+#include <cstdlib>
+#include <thread>
+
+using namespace cutscene;
+
+class CutsceneDecoderBenchmark : public test::FSTestFixture {
+  public:
+	CutsceneDecoderBenchmark() : test::FSTestFixture(INIT_CFILE) {}
+};
+
+// Decodes a movie as fast as possible. Set FSO_MOVIE_BENCHMARK_FILE to the path of the movie and run it with
+// --gtest_also_run_disabled_tests.
+TEST_F(CutsceneDecoderBenchmark, DISABLED_decodeSpeed)
+{
+	auto path = getenv("FSO_MOVIE_BENCHMARK_FILE");
+	if (path == nullptr) {
+		std::cout << "[ SKIPPED  ] FSO_MOVIE_BENCHMARK_FILE is not set" << std::endl;
+		return;
+	}
+
+	SCP_string file(path);
+	auto separator = file.find_last_of("/\\");
+	ASSERT_NE(SCP_string::npos, separator);
+
+	// Make the directory of the movie the root directory
+	cfile_close();
+	auto root = file.substr(0, separator + 1) + "test"; // Cfile expects something after the path
+	ASSERT_EQ(0, cfile_init(root.c_str()));
+
+	libs::ffmpeg::initialize();
+
+	PlaybackProperties properties;
+	properties.with_audio = false;
+
+	ffmpeg::FFMPEGDecoder decoder;
+	ASSERT_TRUE(decoder.initialize(file.substr(separator + 1), properties));
+
+	auto movie = decoder.getProperties();
+
+	auto start = std::chrono::high_resolution_clock::now();
+	std::thread decoder_thread([&decoder]() { decoder.startDecoding(); });
+
+	size_t frames = 0;
+	size_t checksum = 0;
+	while (decoder.isDecoding() || decoder.isVideoFrameAvailable()) {
+		VideoFramePtr frame;
+		if (!decoder.tryPopVideoFrame(frame)) {
+			std::this_thread::yield();
+			continue;
+		}
+
+		// Touch the data like the presenter would
+		for (size_t i = 0; i < frame->getPlaneNumber(); ++i) {
+			auto size = frame->getPlaneSize(i);
+			auto data = static_cast<const ubyte*>(frame->getPlaneData(i));
+			for (size_t y = 0; y < size.height; ++y) {
+				checksum += data[y * size.stride];
+			}
+		}
+		++frames;
+	}
+
+	decoder_thread.join();
+	auto time = std::chrono::high_resolution_clock::now() - start;
+	decoder.close();
+
+	ASSERT_GT(frames, (size_t)0);
+
+	auto seconds = std::chrono::duration_cast<std::chrono::microseconds>(time).count() / 1000000.0;
+	std::cout << "[ BENCH    ] " << movie.size.width << "x" << movie.size.height << " @ " << movie.fps << " FPS, "
+	          << frames << " frames in " << seconds << " s: " << frames / seconds << " FPS (checksum " << checksum
+	          << ")" << std::endl;
+}
@@ -0,0 +1,133 @@
+
+#include <gtest/gtest.h>
+
+#include "cfile/cfile.h"
+#include "graphics/software/GlyphAtlas.h"
+
+extern "C" {
+#include "graphics/paths/nanovg/fontstash.h"
+}
+
+#include "util/FSTestFixture.h"
+
+class GlyphAtlasTest : public test::FSTestFixture {
+  public:
+	GlyphAtlasTest() : test::FSTestFixture(INIT_CFILE)
+	{
+		pushModDir("graphics");
+		pushModDir("fonts");
+	}
+
+  protected:
+	SCP_vector<ubyte> _fontData;
+
+	void SetUp() override
+	{
+		test::FSTestFixture::SetUp();
+
+		auto fp = cfopen("arial.ttf", "rb", CFILE_NORMAL, CF_TYPE_ANY);
+		ASSERT_NE(nullptr, fp);
+
+		_fontData.resize(static_cast<size_t>(cfilelength(fp)));
+		ASSERT_EQ(1, cfread(_fontData.data(), static_cast<int>(_fontData.size()), 1, fp));
+		cfclose(fp);
+	}
+};
+
+TEST_F(GlyphAtlasTest, serializeRoundTrip)
+{
+	font::GlyphAtlas atlas;
+	ASSERT_TRUE(atlas.build(_fontData.data(), _fontData.size(), 120));
+
+	SCP_vector<ubyte> data;
+	atlas.serialize(data);
+
+	font::GlyphAtlas loaded;
+	ASSERT_TRUE(loaded.deserialize(data.data(), data.size()));
+
+	ASSERT_EQ(atlas.getSize(), loaded.getSize());
+	ASSERT_EQ(atlas.getFontChecksum(), loaded.getFontChecksum());
+	ASSERT_EQ(atlas.getNumGlyphs(), loaded.getNumGlyphs());
+	ASSERT_EQ(atlas.getPixels(), loaded.getPixels());
+
+	SCP_vector<ubyte> reserialized;
+	loaded.serialize(reserialized);
+	ASSERT_EQ(data.size(), reserialized.size());
+
+	// Truncated or corrupted data must be rejected
+	ASSERT_FALSE(loaded.deserialize(data.data(), data.size() - 1));
+	data[0] ^= 0xFF;
+	ASSERT_FALSE(loaded.deserialize(data.data(), data.size()));
+}
+
+TEST_F(GlyphAtlasTest, layoutMatchesFontstash)
+{
+	const char* const strings[] = {"AVATAR Wave 1", "Tjy, To. Ty; fi", "Speed: 75 m/s", "\xC3\x84rger \xC3\xBC" "ber \xC2\xA9"};
+
+	for (auto size : {80, 123, 250}) {
+		font::GlyphAtlas atlas;
+		ASSERT_TRUE(atlas.build(_fontData.data(), _fontData.size(), size));
+
+		FONSparams params;
+		memset(&params, 0, sizeof(params));
+		params.width = 512;
+		params.height = 512;
+		params.flags = FONS_ZERO_TOPLEFT;
+		auto stash = fonsCreateInternal(&params);
+		ASSERT_NE(nullptr, stash);
+
+		auto handle = fonsAddFontMem(stash, "test", _fontData.data(), static_cast<int>(_fontData.size()), 0);
+		fonsSetFont(stash, handle);
+		fonsSetSize(stash, (size + 0.5f) / 10.0f);
+		fonsSetSpacing(stash, 1.5f);
+		fonsSetAlign(stash, FONS_ALIGN_LEFT | FONS_ALIGN_TOP);
+
+		for (auto text : strings) {
+			auto end = text + strlen(text);
+
+			SCP_vector<font::GlyphQuad> quads;
+			float advance;
+			ASSERT_TRUE(atlas.layout(text, end, 3.0f, 7.0f, 1.5f, quads, &advance));
+
+			FONStextIter iter;
+			FONSquad expected;
+			ASSERT_TRUE(fonsTextIterInit(stash, &iter, 3.0f, 7.0f, text, end) != 0);
+
+			size_t i = 0;
+			while (fonsTextIterNext(stash, &iter, &expected)) {
+				if (expected.x1 == expected.x0 || expected.y1 == expected.y0) {
+					continue;
+				}
+
+				// fontstash computes the right and bottom edges from its own atlas which adds a tiny rounding error
+				ASSERT_LT(i, quads.size());
+				ASSERT_NEAR(expected.x0, quads[i].x0, 0.001f) << text;
+				ASSERT_NEAR(expected.y0, quads[i].y0, 0.001f) << text;
+				ASSERT_NEAR(expected.x1, quads[i].x1, 0.001f) << text;
+				ASSERT_NEAR(expected.y1, quads[i].y1, 0.001f) << text;
+				++i;
+			}
+			ASSERT_EQ(quads.size(), i);
+			ASSERT_FLOAT_EQ(iter.nextx, advance) << text;
+		}
+
+		fonsDeleteInternal(stash);
+	}
+}
+
+TEST_F(GlyphAtlasTest, layoutRejectsMissingGlyphs)
+{
+	font::GlyphAtlas atlas;
+	ASSERT_TRUE(atlas.build(_fontData.data(), _fontData.size(), 120));
+
+	SCP_vector<font::GlyphQuad> quads;
+	float advance;
+	// Outside of Latin-1
+	const char euro[] = "\xE2\x82\xAC";
+	ASSERT_FALSE(atlas.layout(euro, euro + 3, 0.0f, 0.0f, 0.0f, quads, &advance));
+	// Invalid UTF-8
+	const char invalid[] = "A\xC3";
+	ASSERT_FALSE(atlas.layout(invalid, invalid + 2, 0.0f, 0.0f, 0.0f, quads, &advance));
+	const char control[] = "\x01";
+	ASSERT_FALSE(atlas.layout(control, control + 1, 0.0f, 0.0f, 0.0f, quads, &advance));
+}
@@ -0,0 +1,176 @@
+
+#include <gtest/gtest.h>
+
+#include "lighting/lighting.h"
+#include "math/vecmat.h"
+
+#include <chrono>
+#include <random>
+
+namespace {
+
+light make_point_light(std::mt19937& rng, float extent)
+{
+	std::uniform_real_distribution<float> pos_dist(-extent, extent);
+	std::uniform_real_distribution<float> range_dist(20.0f, 300.0f);
+
+	light l;
+	memset(&l, 0, sizeof(l));
+	l.type = Light_Type::Point;
+	l.vec.xyz.x = pos_dist(rng);
+	l.vec.xyz.y = pos_dist(rng);
+	l.vec.xyz.z = pos_dist(rng);
+	l.rada = l.radb = range_dist(rng);
+	return l;
+}
+
+light make_tube_light(std::mt19937& rng, float extent)
+{
+	auto l = make_point_light(rng, extent);
+	l.type = Light_Type::Tube;
+	l.vec2 = l.vec;
+	l.vec2.xyz.z += 1000.0f;
+	return l;
+}
+
+// A battle with a lot of explosions and weapon lights, some beams and a sun
+SCP_vector<light> make_scene(std::mt19937& rng, size_t num_lights, float extent)
+{
+	SCP_vector<light> lights;
+
+	light sun;
+	memset(&sun, 0, sizeof(sun));
+	sun.type = Light_Type::Directional;
+	lights.push_back(sun);
+
+	for (size_t i = 0; i < num_lights; ++i) {
+		lights.push_back(i % 20 == 0 ? make_tube_light(rng, extent) : make_point_light(rng, extent));
+	}
+
+	return lights;
+}
+
+void query_all(const SCP_vector<light>& lights, const vec3d* pos, float rad, util::FrameVector<size_t>& out)
+{
+	for (size_t i = 0; i < lights.size(); ++i) {
+		if (light_affects_sphere(lights[i], pos, rad)) {
+			out.push_back(i);
+		}
+	}
+}
+
+} // namespace
+
+TEST(LightGridTests, sameResultAsTestingAllLights)
+{
+	std::mt19937 rng(42);
+	std::uniform_real_distribution<float> pos_dist(-3000.0f, 3000.0f);
+	std::uniform_real_distribution<float> rad_dist(1.0f, 2000.0f);
+
+	for (size_t num_lights : {5, 50, 500}) {
+		auto lights = make_scene(rng, num_lights, 2000.0f);
+
+		light_grid grid;
+		grid.build(lights.data(), lights.size());
+
+		util::FrameVector<size_t> expected;
+		util::FrameVector<size_t> found;
+		for (int i = 0; i < 1000; ++i) {
+			vec3d pos;
+			pos.xyz.x = pos_dist(rng);
+			pos.xyz.y = pos_dist(rng);
+			pos.xyz.z = pos_dist(rng);
+			auto rad = rad_dist(rng);
+
+			expected.clear();
+			found.clear();
+			query_all(lights, &pos, rad, expected);
+			grid.query(&pos, rad, found);
+
+			ASSERT_EQ(expected, found);
+		}
+	}
+}
+
+// Queries which cover most of the cell coordinate range must not overflow the cell counts
+TEST(LightGridTests, hugeQueries)
+{
+	std::mt19937 rng(7);
+	auto lights = make_scene(rng, 50, 2000.0f);
+
+	light_grid grid;
+	grid.build(lights.data(), lights.size());
+
+	util::FrameVector<size_t> expected;
+	util::FrameVector<size_t> found;
+	for (float rad : {1.0e6f, 1.5e9f, 1.0e12f}) {
+		vec3d pos = vmd_zero_vector;
+
+		expected.clear();
+		found.clear();
+		query_all(lights, &pos, rad, expected);
+		grid.query(&pos, rad, found);
+
+		ASSERT_EQ(expected, found);
+	}
+}
+
+// Only measures the time, run it with --gtest_also_run_disabled_tests
+TEST(LightGridTests, DISABLED_filterOverhead)
+{
+	const size_t NUM_LIGHTS = 500;
+	const size_t NUM_OBJECTS = 500;
+	const int NUM_FRAMES = 20;
+
+	std::mt19937 rng(1);
+	auto lights = make_scene(rng, NUM_LIGHTS, 5000.0f);
+
+	std::uniform_real_distribution<float> pos_dist(-5000.0f, 5000.0f);
+	std::uniform_real_distribution<float> rad_dist(5.0f, 200.0f);
+
+	SCP_vector<std::pair<vec3d, float>> objects;
+	for (size_t i = 0; i < NUM_OBJECTS; ++i) {
+		vec3d pos;
+		pos.xyz.x = pos_dist(rng);
+		pos.xyz.y = pos_dist(rng);
+		pos.xyz.z = pos_dist(rng);
+		objects.emplace_back(pos, rad_dist(rng));
+	}
+
+	util::FrameVector<size_t> filtered;
+	size_t all_found = 0;
+	size_t grid_found = 0;
+
+	auto start = std::chrono::high_resolution_clock::now();
+	for (int frame = 0; frame < NUM_FRAMES; ++frame) {
+		for (auto& obj : objects) {
+			filtered.clear();
+			query_all(lights, &obj.first, obj.second, filtered);
+			all_found += filtered.size();
+		}
+	}
+	auto all_time = std::chrono::high_resolution_clock::now() - start;
+
+	// The grid is built every frame, just like in the game
+	start = std::chrono::high_resolution_clock::now();
+	for (int frame = 0; frame < NUM_FRAMES; ++frame) {
+		light_grid grid;
+		grid.build(lights.data(), lights.size());
+
+		for (auto& obj : objects) {
+			filtered.clear();
+			grid.query(&obj.first, obj.second, filtered);
+			grid_found += filtered.size();
+		}
+	}
+	auto grid_time = std::chrono::high_resolution_clock::now() - start;
+
+	ASSERT_EQ(all_found, grid_found);
+
+	auto per_frame = [](std::chrono::high_resolution_clock::duration time) {
+		return std::chrono::duration_cast<std::chrono::microseconds>(time).count() / static_cast<double>(NUM_FRAMES);
+	};
+
+	std::cout << "[ BENCH    ] testing all lights: " << per_frame(all_time) << " us/frame" << std::endl;
+	std::cout << "[ BENCH    ] light grid: " << per_frame(grid_time) << " us/frame" << std::endl;
+}
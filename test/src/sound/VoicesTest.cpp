@@ -0,0 +1,190 @@
+
+#include <gtest/gtest.h>
+
+#include "sound/ds_voices.h"
+
+#include <chrono>
+#include <random>
+
+namespace {
+
+int next_sig = 1;
+
+ds_voices::voice make_voice(float distance, int snd_id = 0, unsigned int limit = 0)
+{
+	ds_voices::voice v;
+	v.sig = ds_sound_handle(next_sig++);
+	v.sid = 0;
+	v.snd_id = snd_id;
+	v.limit = limit;
+	v.pos.xyz.x = distance;
+	v.min = 10.0f;
+	v.max = 1000.0f;
+	v.duration = 2.0f;
+	return v;
+}
+
+// Binds the voices the same way ds_update_voices() does, using the index of the voice as the channel
+void apply(ds_voices& voices, const ds_voices::changes& changes)
+{
+	for (auto sig : changes.demote) {
+		voices.find(sig)->channel = -1;
+	}
+	int channel = 0;
+	for (auto sig : changes.promote) {
+		voices.find(sig)->channel = channel++;
+	}
+}
+
+} // namespace
+
+TEST(DsVoicesTests, attenuation)
+{
+	ASSERT_FLOAT_EQ(1.0f, ds_voices::attenuation(5.0f, 10.0f, 1000.0f));
+	ASSERT_FLOAT_EQ(0.0f, ds_voices::attenuation(1001.0f, 10.0f, 1000.0f));
+	ASSERT_NEAR(0.05f, ds_voices::attenuation(1000.0f, 10.0f, 1000.0f), 0.01f);
+	ASSERT_GT(ds_voices::attenuation(100.0f, 10.0f, 1000.0f), ds_voices::attenuation(200.0f, 10.0f, 1000.0f));
+}
+
+TEST(DsVoicesTests, bindsMostAudible)
+{
+	ds_voices voices;
+	auto far_away = voices.add(make_voice(2000.0f)).sig;
+	auto quiet = voices.add(make_voice(800.0f)).sig;
+	auto loud = voices.add(make_voice(20.0f)).sig;
+	auto medium = voices.add(make_voice(100.0f)).sig;
+
+	ds_voices::changes changes;
+	voices.update(vmd_zero_vector, 0.0f, 2, changes);
+
+	ASSERT_TRUE(changes.demote.empty());
+	ASSERT_EQ(SCP_vector<ds_sound_handle>({loud, medium}), changes.promote);
+	apply(voices, changes);
+
+	// Voices out of range are never bound, even if there is room for them
+	voices.update(vmd_zero_vector, 0.0f, 10, changes);
+	ASSERT_EQ(SCP_vector<ds_sound_handle>({quiet}), changes.promote);
+	ASSERT_EQ(-1, voices.find(far_away)->channel);
+	ASSERT_EQ((size_t)3, voices.get_stats().num_bound);
+	ASSERT_EQ((size_t)4, voices.get_stats().num_voices);
+}
+
+TEST(DsVoicesTests, hysteresis)
+{
+	ds_voices voices;
+	auto first = voices.add(make_voice(100.0f)).sig;
+	auto second = voices.add(make_voice(105.0f)).sig;
+
+	ds_voices::changes changes;
+	voices.update(vmd_zero_vector, 0.0f, 1, changes);
+	ASSERT_EQ(SCP_vector<ds_sound_handle>({first}), changes.promote);
+	apply(voices, changes);
+
+	// Slightly louder isn't enough to take the channel
+	voices.find(second)->pos.xyz.x = 95.0f;
+	voices.update(vmd_zero_vector, 0.0f, 1, changes);
+	ASSERT_TRUE(changes.promote.empty());
+	ASSERT_TRUE(changes.demote.empty());
+
+	// ...but a lot louder is
+	voices.find(second)->pos.xyz.x = 20.0f;
+	voices.update(vmd_zero_vector, 0.0f, 1, changes);
+	ASSERT_EQ(SCP_vector<ds_sound_handle>({first}), changes.demote);
+	ASSERT_EQ(SCP_vector<ds_sound_handle>({second}), changes.promote);
+}
+
+TEST(DsVoicesTests, priorityAndLimit)
+{
+	ds_voices voices;
+	auto important = make_voice(900.0f);
+	important.priority = 0;
+	important.sig = voices.add(important).sig;
+
+	SCP_vector<ds_sound_handle> limited;
+	for (int i = 0; i < 4; ++i) {
+		auto v = make_voice(20.0f + i, 1, 2);
+		v.priority = 2;
+		limited.push_back(voices.add(v).sig);
+	}
+	auto other = make_voice(500.0f, 2);
+	other.priority = 2;
+	other.sig = voices.add(other).sig;
+
+	ds_voices::changes changes;
+	voices.update(vmd_zero_vector, 0.0f, 4, changes);
+
+	// Only two of the limited sounds may play so the quieter sound gets the remaining channel
+	ASSERT_EQ(SCP_vector<ds_sound_handle>({important.sig, limited[0], limited[1], other.sig}), changes.promote);
+}
+
+TEST(DsVoicesTests, virtualVoicesAdvance)
+{
+	ds_voices voices;
+	auto one_shot = voices.add(make_voice(20.0f)).sig;
+	auto looping_voice = make_voice(30.0f);
+	looping_voice.looping = true;
+	auto looping = voices.add(looping_voice).sig;
+
+	ds_voices::changes changes;
+	voices.update(vmd_zero_vector, 1.5f, 0, changes);
+	ASSERT_FLOAT_EQ(1.5f, voices.find(one_shot)->position);
+	ASSERT_FLOAT_EQ(1.5f, voices.find(looping)->position);
+
+	// Bound voices are advanced by OpenAL
+	voices.find(looping)->channel = 0;
+	voices.update(vmd_zero_vector, 1.0f, 1, changes);
+	ASSERT_EQ(nullptr, voices.find(one_shot));
+	ASSERT_FLOAT_EQ(1.5f, voices.find(looping)->position);
+
+	voices.find(looping)->channel = -1;
+	voices.update(vmd_zero_vector, 1.0f, 0, changes);
+	ASSERT_FLOAT_EQ(0.5f, voices.find(looping)->position);
+	ASSERT_EQ((size_t)1, voices.get_stats().num_voices);
+}
+
+// Only measures the time, run it with --gtest_also_run_disabled_tests
+TEST(DsVoicesTests, DISABLED_battleOverhead)
+{
+	const int NUM_VOICES = 1000;
+	const int NUM_FRAMES = 1000;
+	const size_t NUM_CHANNELS = 64;
+
+	std::mt19937 rng(9);
+	std::uniform_real_distribution<float> pos_dist(-3000.0f, 3000.0f);
+
+	ds_voices voices;
+	for (int i = 0; i < NUM_VOICES; ++i) {
+		auto v = make_voice(0.0f, i % 20, 3);
+		v.pos.xyz.x = pos_dist(rng);
+		v.pos.xyz.y = pos_dist(rng);
+		v.pos.xyz.z = pos_dist(rng);
+		v.looping = true;
+		voices.add(v);
+	}
+
+	ds_voices::changes changes;
+	size_t swaps = 0;
+	auto start = std::chrono::high_resolution_clock::now();
+	for (int frame = 0; frame < NUM_FRAMES; ++frame) {
+		vec3d listener;
+		listener.xyz.x = frame * 2.0f;
+		listener.xyz.y = 0.0f;
+		listener.xyz.z = 0.0f;
+
+		voices.update(listener, 0.016f, NUM_CHANNELS, changes);
+		swaps += changes.demote.size();
+
+		for (auto sig : changes.demote) {
+			voices.find(sig)->channel = -1;
+		}
+		for (auto sig : changes.promote) {
+			voices.find(sig)->channel = 0;
+		}
+		ASSERT_LE(voices.get_stats().num_bound, NUM_CHANNELS);
+	}
+	auto time = std::chrono::high_resolution_clock::now() - start;
+
+	std::cout << "[ BENCH    ] " << NUM_VOICES << " voices on " << NUM_CHANNELS << " channels: "
+	          << std::chrono::duration_cast<std::chrono::microseconds>(time).count() / static_cast<double>(NUM_FRAMES)
+	          << " us/frame (" << swaps << " demotions)" << std::endl;
+}
@@ -13,10 +13,24 @@ add_file_folder("Actions\\\\Expression"
 	actions/expression/test_ExpressionParser.cpp
 )
 
+add_file_folder("Anim"
+    anim/FrameCacheTest.cpp
+)
+
+add_file_folder("Bmpman"
+    bmpman/ConvertTest.cpp
+    bmpman/NameIndexTest.cpp
+    bmpman/ResidencyTest.cpp
+)
+
 add_file_folder("CFile"
     cfile/cfile.cpp
 )
 
+add_file_folder("Cutscene"
+    cutscene/DecoderBenchmarkTest.cpp
+)
+
 add_file_folder("Globalincs"
     globalincs/test_flagset.cpp
     globalincs/test_safe_strings.cpp
@@ -24,9 +38,14 @@ add_file_folder("Globalincs"
 )
 
 add_file_folder("Graphics"
+	   graphics/GlyphAtlasTest.cpp
 	   graphics/test_font.cpp
 )
 
+add_file_folder("Lighting"
+    lighting/LightGridTest.cpp
+)
+
 add_file_folder("Math"
     math/test_vecmat.cpp
 )
@@ -81,6 +100,15 @@ add_file_folder("Scripting\\\\Lua"
     scripting/lua/Value.cpp
 )
 
+add_file_folder("Sound"
+    sound/VoicesTest.cpp
+)
+
+add_file_folder("Tracing"
+    tracing/PerfStatsTest.cpp
+    tracing/ThreadedEventProcessorTest.cpp
+)
+
 add_file_folder("Test Util"
     util/FSTestFixture.cpp
     util/FSTestFixture.h
@@ -88,7 +116,13 @@ add_file_folder("Test Util"
 )
 
 add_file_folder("Utils"
+    utils/AssetRetentionTest.cpp
+    utils/ChunkedPoolTest.cpp
+    utils/FrameArenaTest.cpp
     utils/HeapAllocatorTest.cpp
+    utils/SpscQueueTest.cpp
+    utils/ThreadPoolTest.cpp
+    utils/TimerWheelTest.cpp
 )
 
 add_file_folder("Weapon"
@@ -0,0 +1,162 @@
+
+#include <gtest/gtest.h>
+
+#include "tracing/PerfStats.h"
+
+#include <cstdio>
+#include <fstream>
+#include <sstream>
+
+using namespace tracing;
+
+namespace {
+
+const std::uint64_t MILLISECOND = 1000000;
+
+trace_event make_frame_event(EventType type, std::uint64_t timestamp)
+{
+	trace_event evt;
+	evt.type = type;
+	evt.category = &MainFrame;
+	evt.scope = &MainFrameScope;
+	evt.timestamp = timestamp;
+	return evt;
+}
+
+trace_event make_scope_event(const Category& category, std::uint64_t duration)
+{
+	trace_event evt;
+	evt.type = EventType::Complete;
+	evt.category = &category;
+	evt.duration = duration;
+	return evt;
+}
+
+trace_event make_counter_event(const Category& category, float value)
+{
+	trace_event evt;
+	evt.type = EventType::Counter;
+	evt.category = &category;
+	evt.value = value;
+	return evt;
+}
+
+const perf_stat_summary* find_stat(const SCP_vector<perf_stat_summary>& stats, const char* name)
+{
+	for (const auto& stat : stats) {
+		if (stat.name == name) {
+			return &stat;
+		}
+	}
+	return nullptr;
+}
+
+} // namespace
+
+TEST(PerfStatsTests, percentilesOfFrames)
+{
+	PerfStats stats(0);
+
+	// 100 frames of 10 ms, the scope takes 1 to 100 ms spread over two events. The counter only changes every 10 frames.
+	for (std::uint64_t frame = 0; frame < 100; ++frame) {
+		auto begin = make_frame_event(EventType::AsyncBegin, frame * 10 * MILLISECOND);
+		stats.processEvent(&begin);
+
+		auto first = make_scope_event(Simulation, (frame + 1) * MILLISECOND / 2);
+		stats.processEvent(&first);
+		auto second = make_scope_event(Simulation, (frame + 1) * MILLISECOND / 2);
+		stats.processEvent(&second);
+
+		if (frame % 10 == 0) {
+			auto counter = make_counter_event(PerfObjects, static_cast<float>(frame));
+			stats.processEvent(&counter);
+		}
+
+		auto end = make_frame_event(EventType::AsyncEnd, (frame + 1) * 10 * MILLISECOND);
+		stats.processEvent(&end);
+	}
+
+	auto summary = stats.getSummary();
+	ASSERT_EQ((size_t)3, summary.size());
+
+	// The frame time comes first, then the counters and then the scopes
+	ASSERT_EQ(PerfStatType::Frame, summary[0].type);
+	ASSERT_EQ(PerfStatType::Counter, summary[1].type);
+	ASSERT_EQ(PerfStatType::Scope, summary[2].type);
+
+	ASSERT_EQ((size_t)100, summary[0].frames);
+	ASSERT_FLOAT_EQ(10.0f, summary[0].p50);
+	ASSERT_FLOAT_EQ(10.0f, summary[0].max);
+
+	auto scope = find_stat(summary, Simulation.getName());
+	ASSERT_NE(nullptr, scope);
+	ASSERT_FLOAT_EQ(50.0f, scope->p50);
+	ASSERT_FLOAT_EQ(95.0f, scope->p95);
+	ASSERT_FLOAT_EQ(99.0f, scope->p99);
+	ASSERT_FLOAT_EQ(100.0f, scope->max);
+
+	// The counter keeps its value in the frames where it was not changed
+	auto counter = find_stat(summary, PerfObjects.getName());
+	ASSERT_NE(nullptr, counter);
+	ASSERT_FLOAT_EQ(40.0f, counter->p50);
+	ASSERT_FLOAT_EQ(90.0f, counter->p99);
+}
+
+TEST(PerfStatsTests, historyIsLimited)
+{
+	PerfStats stats(0);
+
+	// Only the recent frames are kept so the long frames at the start are forgotten. The summary is not refreshed every
+	// frame so there are more short frames than fit into the history.
+	std::uint64_t time = 0;
+	for (size_t frame = 0; frame < PerfStats::HISTORY_SIZE * 3; ++frame) {
+		auto begin = make_frame_event(EventType::AsyncBegin, time);
+		stats.processEvent(&begin);
+
+		time += (frame < PerfStats::HISTORY_SIZE ? 100 : 5) * MILLISECOND;
+
+		auto end = make_frame_event(EventType::AsyncEnd, time);
+		stats.processEvent(&end);
+	}
+
+	auto summary = stats.getSummary();
+	ASSERT_FALSE(summary.empty());
+	ASSERT_EQ((size_t)PerfStats::HISTORY_SIZE, summary[0].frames);
+	ASSERT_FLOAT_EQ(5.0f, summary[0].max);
+}
+
+TEST(PerfStatsTests, exportCoversWholeInterval)
+{
+	{
+		PerfStats stats(60);
+
+		// More frames than fit into the history but less than the export interval, all of them are exported when the
+		// statistics are destroyed
+		std::uint64_t time = 0;
+		for (size_t frame = 0; frame < PerfStats::HISTORY_SIZE * 3; ++frame) {
+			auto begin = make_frame_event(EventType::AsyncBegin, time);
+			stats.processEvent(&begin);
+
+			time += (frame < PerfStats::HISTORY_SIZE ? 10 : 5) * MILLISECOND;
+
+			auto end = make_frame_event(EventType::AsyncEnd, time);
+			stats.processEvent(&end);
+		}
+	}
+
+	std::ifstream csv("perf_stats.csv");
+	ASSERT_TRUE(csv.good());
+
+	SCP_string header;
+	SCP_string line;
+	std::getline(csv, header);
+	std::getline(csv, line);
+
+	std::ostringstream expected;
+	expected << ",\"Frame\",frame," << PerfStats::HISTORY_SIZE * 3 << ",5,10,10,10";
+	ASSERT_NE(SCP_string::npos, line.find(expected.str()));
+
+	csv.close();
+	std::remove("perf_stats.csv");
+	std::remove("perf_stats.json");
+}
@@ -0,0 +1,168 @@
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <chrono>
+#include <iostream>
+#include <thread>
+
+#include "tracing/ThreadedEventProcessor.h"
+#include "utils/boost/syncboundedqueue.h"
+
+using namespace tracing;
+
+namespace {
+
+struct processor_state {
+	std::atomic<size_t> processed{0};
+	std::atomic<bool> blocked{false};
+	std::atomic<bool> entered{false};
+
+	// The last event id seen for each producer, events of one producer must arrive in order
+	std::int64_t last_ids[8] = {};
+	bool in_order = true;
+};
+
+class TestProcessor {
+	processor_state* _state;
+
+  public:
+	explicit TestProcessor(processor_state* state) : _state(state) {}
+
+	void processEvent(const trace_event* event)
+	{
+		_state->entered = true;
+		while (_state->blocked) {
+			std::this_thread::yield();
+		}
+
+		auto& last_id = _state->last_ids[event->tid];
+		if (static_cast<std::int64_t>(event->event_id) <= last_id) {
+			_state->in_order = false;
+		}
+		last_id = static_cast<std::int64_t>(event->event_id);
+
+		++_state->processed;
+	}
+};
+
+trace_event make_event(std::int64_t tid, std::uint64_t id)
+{
+	trace_event evt;
+	evt.type = EventType::Counter;
+	evt.tid = tid;
+	evt.event_id = id;
+	return evt;
+}
+
+} // namespace
+
+TEST(ThreadedEventProcessorTests, eventsOfAllThreadsAreProcessed)
+{
+	const size_t NUM_THREADS = 4;
+	const size_t EVENTS_PER_THREAD = 20000;
+
+	processor_state state;
+	size_t dropped;
+	{
+		ThreadedEventProcessor<TestProcessor> processor(&state);
+
+		SCP_vector<std::thread> threads;
+		for (size_t t = 0; t < NUM_THREADS; ++t) {
+			threads.emplace_back([&processor, t]() {
+				for (size_t i = 1; i <= EVENTS_PER_THREAD; ++i) {
+					auto evt = make_event(static_cast<std::int64_t>(t), i);
+					processor.processEvent(&evt);
+				}
+			});
+		}
+		for (auto& thread : threads) {
+			thread.join();
+		}
+
+		dropped = static_cast<size_t>(processor.droppedEvents());
+	}
+
+	// Everything that was not dropped must be processed before the destructor returns
+	ASSERT_EQ(NUM_THREADS * EVENTS_PER_THREAD, state.processed + dropped);
+	ASSERT_TRUE(state.in_order);
+}
+
+TEST(ThreadedEventProcessorTests, fullBufferDropsInsteadOfBlocking)
+{
+	const size_t BUFFER_SIZE = 64;
+
+	processor_state state;
+	state.blocked = true;
+
+	ThreadedEventProcessor<TestProcessor, BUFFER_SIZE> processor(&state);
+
+	auto first = make_event(0, 1);
+	processor.processEvent(&first);
+
+	while (!state.entered) {
+		std::this_thread::yield();
+	}
+
+	// The first event is still occupying its slot while it is being processed
+	for (size_t i = 0; i < BUFFER_SIZE + 100; ++i) {
+		auto evt = make_event(0, i + 2);
+		processor.processEvent(&evt);
+	}
+
+	ASSERT_EQ((std::uint64_t)101, processor.droppedEvents());
+
+	state.blocked = false;
+}
+
+// Only measures the time, run it with --gtest_also_run_disabled_tests
+TEST(ThreadedEventProcessorTests, DISABLED_eventOverhead)
+{
+	const size_t NUM_EVENTS = 1 << 20;
+	const size_t BURST_SIZE = 4096;
+
+	processor_state state;
+	ThreadedEventProcessor<TestProcessor> processor(&state);
+
+	// Events are submitted in bursts which fit into the buffer so that only the cost of storing an event is measured
+	std::chrono::high_resolution_clock::duration ring_time(0);
+	for (size_t burst = 0; burst < NUM_EVENTS / BURST_SIZE; ++burst) {
+		auto start = std::chrono::high_resolution_clock::now();
+		for (size_t i = 1; i <= BURST_SIZE; ++i) {
+			auto evt = make_event(0, burst * BURST_SIZE + i);
+			processor.processEvent(&evt);
+		}
+		ring_time += std::chrono::high_resolution_clock::now() - start;
+
+		while (state.processed < (burst + 1) * BURST_SIZE) {
+			std::this_thread::yield();
+		}
+	}
+
+	// The previous implementation, for comparison. A consumer thread keeps the queue from blocking all the time.
+	sync_bounded_queue<trace_event> queue(200);
+	std::thread consumer([&queue]() {
+		trace_event evt;
+		while (queue.wait_pull_front(evt) == success) {
+		}
+	});
+
+	auto start = std::chrono::high_resolution_clock::now();
+	for (size_t i = 1; i <= NUM_EVENTS; ++i) {
+		auto evt = make_event(0, i);
+		queue.wait_push_back(evt);
+	}
+	auto queue_time = std::chrono::high_resolution_clock::now() - start;
+
+	queue.close();
+	consumer.join();
+
+	auto per_event = [](std::chrono::high_resolution_clock::duration time) {
+		return std::chrono::duration_cast<std::chrono::nanoseconds>(time).count() / static_cast<double>(NUM_EVENTS);
+	};
+
+	ASSERT_EQ((std::uint64_t)0, processor.droppedEvents());
+
+	std::cout << "[ BENCH    ] per-thread ring buffer: " << per_event(ring_time) << " ns/event" << std::endl;
+	std::cout << "[ BENCH    ] sync_bounded_queue: " << per_event(queue_time) << " ns/event" << std::endl;
+}
@@ -0,0 +1,87 @@
+
+#include <gtest/gtest.h>
+
+#include "utils/AssetRetention.h"
+
+using namespace util;
+
+TEST(AssetRetentionTests, keepsAssetsWithinBudget)
+{
+	AssetRetention retention;
+	retention.setBudget(1000);
+
+	retention.startGeneration();
+	retention.retain(1, 400);
+	retention.retain(2, 500);
+
+	SCP_vector<int> evicted;
+	retention.evict(evicted);
+	ASSERT_TRUE(evicted.empty());
+	ASSERT_EQ((size_t)900, retention.getStats().retained_bytes);
+	ASSERT_EQ((size_t)2, retention.getStats().num_retained);
+
+	// The next mission uses one of them again
+	retention.startGeneration();
+	ASSERT_TRUE(retention.markUsed(2));
+	ASSERT_FALSE(retention.markUsed(3));
+	ASSERT_FALSE(retention.contains(2));
+	ASSERT_EQ((size_t)1, retention.getStats().reused);
+	ASSERT_EQ((size_t)400, retention.getStats().retained_bytes);
+}
+
+TEST(AssetRetentionTests, evictsLeastRecentlyUsed)
+{
+	AssetRetention retention;
+	retention.setBudget(1000);
+
+	retention.startGeneration();
+	retention.retain(1, 300);
+
+	retention.startGeneration();
+	retention.retain(2, 300);
+	retention.retain(3, 500);
+
+	// Asset 1 was used two missions ago so it goes first, then the bigger one of the same generation
+	SCP_vector<int> evicted;
+	retention.evict(evicted);
+	ASSERT_EQ(SCP_vector<int>({1}), evicted);
+	ASSERT_EQ((size_t)800, retention.getStats().retained_bytes);
+	ASSERT_EQ((size_t)1, retention.getStats().evictions);
+
+	retention.setBudget(400);
+	evicted.clear();
+	retention.evict(evicted);
+	ASSERT_EQ(SCP_vector<int>({3}), evicted);
+	ASSERT_TRUE(retention.contains(2));
+
+	// Retaining an asset again keeps the generation it was used in last
+	retention.startGeneration();
+	retention.retain(4, 100);
+	retention.retain(2, 300);
+	int id;
+	ASSERT_TRUE(retention.evictOldest(id));
+	ASSERT_EQ(2, id);
+	ASSERT_TRUE(retention.evictOldest(id));
+	ASSERT_EQ(4, id);
+	ASSERT_FALSE(retention.evictOldest(id));
+	ASSERT_EQ((size_t)0, retention.getStats().retained_bytes);
+}
+
+TEST(AssetRetentionTests, zeroBudgetEvictsEverything)
+{
+	AssetRetention retention;
+
+	retention.startGeneration();
+	retention.retain(1, 10);
+	retention.retain(2, 20);
+
+	SCP_vector<int> evicted;
+	retention.evict(evicted);
+	ASSERT_EQ((size_t)2, evicted.size());
+	ASSERT_EQ((size_t)0, retention.getStats().num_retained);
+
+	retention.retain(5, 10);
+	retention.remove(5);
+	ASSERT_FALSE(retention.contains(5));
+	ASSERT_EQ((size_t)0, retention.getStats().retained_bytes);
+}
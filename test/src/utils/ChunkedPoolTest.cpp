@@ -0,0 +1,111 @@
+
+#include <gtest/gtest.h>
+
+#include "utils/ChunkedPool.h"
+
+#include <algorithm>
+
+using namespace util;
+
+namespace {
+
+struct pool_entry {
+	int value = -1;
+};
+
+} // namespace
+
+TEST(ChunkedPoolTests, growsWithStableAddresses)
+{
+	ChunkedPool<pool_entry, 4> pool(10);
+	ASSERT_EQ((size_t)0, pool.size());
+
+	SCP_vector<pool_entry*> entries;
+	for (int i = 0; i < 10; ++i) {
+		auto index = pool.allocate();
+		ASSERT_EQ(i, index);
+
+		pool[index].value = i;
+		entries.push_back(&pool[index]);
+	}
+
+	// The pool does not grow beyond its maximum size even if the last chunk has space left
+	ASSERT_EQ(-1, pool.allocate());
+	ASSERT_EQ((size_t)10, pool.size());
+
+	for (int i = 0; i < 10; ++i) {
+		ASSERT_EQ(entries[i], &pool[i]);
+		ASSERT_EQ(i, pool[i].value);
+		ASSERT_EQ(i, pool.indexOf(entries[i]));
+	}
+}
+
+TEST(ChunkedPoolTests, usedIndices)
+{
+	ChunkedPool<pool_entry, 4> pool(100);
+
+	for (int i = 0; i < 6; ++i) {
+		pool.allocate();
+	}
+
+	pool.free(1);
+	pool.free(4);
+	ASSERT_FALSE(pool.isUsed(1));
+	ASSERT_TRUE(pool.isUsed(2));
+
+	auto used = pool.usedIndices();
+	std::sort(used.begin(), used.end());
+	ASSERT_EQ(SCP_vector<int>({0, 2, 3, 5}), used);
+
+	// Freed slots are reused before the pool grows, the lowest one first
+	ASSERT_EQ(1, pool.allocate());
+	ASSERT_EQ(4, pool.allocate());
+	ASSERT_EQ(6, pool.allocate());
+	ASSERT_EQ((size_t)7, pool.numUsed());
+
+	pool.clear();
+	ASSERT_EQ((size_t)0, pool.size());
+	ASSERT_EQ(0, pool.allocate());
+}
+
+TEST(ChunkedPoolTests, growWithoutAllocating)
+{
+	ChunkedPool<pool_entry, 4> pool(6);
+
+	ASSERT_TRUE(pool.grow());
+	ASSERT_EQ((size_t)4, pool.size());
+	ASSERT_EQ((size_t)0, pool.numUsed());
+
+	ASSERT_TRUE(pool.grow());
+	ASSERT_FALSE(pool.grow());
+	ASSERT_EQ((size_t)6, pool.size());
+
+	// New slots are value initialized and can be walked like an array
+	int count = 0;
+	for (auto& entry : pool) {
+		ASSERT_EQ(-1, entry.value);
+		ASSERT_EQ(count, pool.indexOf(&entry));
+		++count;
+	}
+	ASSERT_EQ(6, count);
+}
+
+TEST(ChunkedPoolTests, freeAllKeepsSlots)
+{
+	ChunkedPool<pool_entry, 4> pool(100);
+
+	for (int i = 0; i < 6; ++i) {
+		pool[pool.allocate()].value = i;
+	}
+	auto entry = &pool[5];
+
+	pool.freeAll();
+	ASSERT_EQ((size_t)0, pool.numUsed());
+	ASSERT_EQ((size_t)8, pool.size());
+	ASSERT_FALSE(pool.isUsed(5));
+
+	// The slots keep their state and are handed out from the lowest index again
+	ASSERT_EQ(5, entry->value);
+	ASSERT_EQ(0, pool.allocate());
+	ASSERT_EQ(1, pool.allocate());
+}
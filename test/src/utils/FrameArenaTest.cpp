@@ -0,0 +1,68 @@
+
+#include <gtest/gtest.h>
+
+#include "utils/FrameArena.h"
+
+using namespace util;
+
+TEST(FrameArenaTests, rewindsWhenEmpty)
+{
+	FrameArena arena(1024);
+
+	auto first = arena.allocate(100, 8);
+	auto second = arena.allocate(100, 8);
+	ASSERT_NE(first, second);
+	ASSERT_EQ((size_t)2, arena.liveAllocations());
+
+	// The most recent allocation is given back right away
+	arena.deallocate(second, 100);
+	ASSERT_EQ(second, arena.allocate(100, 8));
+
+	arena.deallocate(first, 100);
+	arena.deallocate(second, 100);
+	ASSERT_EQ((size_t)0, arena.liveAllocations());
+
+	// Everything was freed so the memory is used again from the start
+	ASSERT_EQ(first, arena.allocate(100, 8));
+	arena.deallocate(first, 100);
+}
+
+TEST(FrameArenaTests, alignment)
+{
+	FrameArena arena(1024);
+
+	arena.allocate(1, 1);
+	auto ptr = arena.allocate(16, 16);
+	ASSERT_EQ((std::uintptr_t)0, reinterpret_cast<std::uintptr_t>(ptr) % 16);
+}
+
+TEST(FrameArenaTests, chunksAreMergedAtFrameEnd)
+{
+	FrameArena arena(1024);
+
+	// The first frame needs more than one chunk
+	{
+		FrameVector<int> values{FrameAllocator<int>(arena)};
+		for (int i = 0; i < 1000; ++i) {
+			values.push_back(i);
+		}
+		ASSERT_EQ(999, values.back());
+	}
+	arena.endFrame();
+	ASSERT_LT((size_t)1, arena.lastFrameHeapAllocations());
+
+	// The merged chunk is allocated during the frame end so it is counted in the next frame
+	arena.endFrame();
+
+	// The same work does not need the heap anymore
+	for (int frame = 0; frame < 3; ++frame) {
+		{
+			FrameVector<int> values{FrameAllocator<int>(arena)};
+			for (int i = 0; i < 1000; ++i) {
+				values.push_back(i);
+			}
+		}
+		arena.endFrame();
+		ASSERT_EQ((size_t)0, arena.lastFrameHeapAllocations());
+	}
+}
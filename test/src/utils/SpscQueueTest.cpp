@@ -0,0 +1,85 @@
+
+#include <gtest/gtest.h>
+
+#include "utils/SpscQueue.h"
+
+#include <memory>
+#include <thread>
+
+using namespace util;
+
+TEST(SpscQueueTests, fullQueueRejects)
+{
+	SpscQueue<int> queue(4);
+	ASSERT_TRUE(queue.empty());
+
+	for (int i = 0; i < 4; ++i) {
+		ASSERT_TRUE(queue.push(i));
+	}
+	ASSERT_FALSE(queue.push(4));
+
+	int value = -1;
+	ASSERT_TRUE(queue.pop(value));
+	ASSERT_EQ(0, value);
+	ASSERT_TRUE(queue.push(4));
+
+	for (int i = 1; i <= 4; ++i) {
+		ASSERT_TRUE(queue.pop(value));
+		ASSERT_EQ(i, value);
+	}
+	ASSERT_FALSE(queue.pop(value));
+	ASSERT_TRUE(queue.empty());
+}
+
+TEST(SpscQueueTests, keepsOrderAcrossThreads)
+{
+	const int NUM_ELEMENTS = 1000000;
+
+	SpscQueue<int> queue(64);
+
+	std::thread producer([&queue]() {
+		for (int i = 0; i < NUM_ELEMENTS; ++i) {
+			while (!queue.push(i)) {
+				std::this_thread::yield();
+			}
+		}
+	});
+
+	int expected = 0;
+	while (expected < NUM_ELEMENTS) {
+		int value;
+		if (!queue.pop(value)) {
+			std::this_thread::yield();
+			continue;
+		}
+
+		ASSERT_EQ(expected, value);
+		++expected;
+	}
+
+	producer.join();
+	ASSERT_TRUE(queue.empty());
+}
+
+TEST(SpscQueueTests, movesElements)
+{
+	SpscQueue<std::unique_ptr<int>> queue(2);
+
+	std::unique_ptr<int> element(new int(1));
+	ASSERT_TRUE(queue.push(std::move(element)));
+	ASSERT_EQ(nullptr, element);
+
+	element.reset(new int(2));
+	ASSERT_TRUE(queue.push(std::move(element)));
+	ASSERT_EQ((size_t)2, queue.size());
+
+	// A rejected element stays with the caller
+	element.reset(new int(3));
+	ASSERT_FALSE(queue.push(std::move(element)));
+	ASSERT_NE(nullptr, element);
+
+	std::unique_ptr<int> value;
+	ASSERT_TRUE(queue.pop(value));
+	ASSERT_EQ(1, *value);
+	ASSERT_EQ((size_t)1, queue.size());
+}
@@ -0,0 +1,59 @@
+
+#include <gtest/gtest.h>
+
+#include <atomic>
+
+#include "utils/ThreadPool.h"
+
+using namespace util;
+
+TEST(ThreadPoolTests, submitReturnsResult) {
+	ThreadPool pool(2);
+
+	auto first = pool.submit([]() { return 21; });
+	auto second = pool.submit([]() { return 42; });
+
+	ASSERT_EQ(21, first.get());
+	ASSERT_EQ(42, second.get());
+}
+
+TEST(ThreadPoolTests, noThreadsRunsInline) {
+	ThreadPool pool(0);
+
+	ASSERT_EQ((size_t)0, pool.numThreads());
+
+	auto result = pool.submit([]() { return 5; });
+
+	ASSERT_EQ(std::future_status::ready, result.wait_for(std::chrono::seconds(0)));
+	ASSERT_EQ(5, result.get());
+}
+
+TEST(ThreadPoolTests, parallelForVisitsEveryIndexOnce) {
+	const size_t count = 1000;
+	std::unique_ptr<std::atomic<int>[]> visited(new std::atomic<int>[count]);
+	for (size_t i = 0; i < count; ++i) {
+		visited[i] = 0;
+	}
+
+	parallel_for(0, count, [&visited](size_t i) { ++visited[i]; });
+
+	for (size_t i = 0; i < count; ++i) {
+		ASSERT_EQ(1, visited[i].load());
+	}
+}
+
+TEST(ThreadPoolTests, parallelForRethrowsException) {
+	std::atomic<int> calls(0);
+
+	ASSERT_THROW(parallel_for(0, 100,
+		[&calls](size_t i) {
+			++calls;
+			if (i == 50) {
+				throw std::runtime_error("test");
+			}
+		}),
+		std::runtime_error);
+
+	// All other indices must still be processed
+	ASSERT_EQ(100, calls.load());
+}
@@ -0,0 +1,165 @@
+
+#include <gtest/gtest.h>
+
+#include "utils/TimerWheel.h"
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+
+using namespace util;
+
+TEST(TimerWheelTests, dispatchesInDeadlineOrder)
+{
+	std::mt19937 rng(7);
+	std::uniform_int_distribution<int> deadline_dist(0, 20000000);
+
+	TimerWheel<int> wheel;
+	SCP_vector<int> deadlines;
+	for (int i = 0; i < 5000; ++i) {
+		auto deadline = deadline_dist(rng);
+		deadlines.push_back(deadline);
+		wheel.schedule(deadline, deadline);
+	}
+	std::sort(deadlines.begin(), deadlines.end());
+
+	SCP_vector<int> dispatched;
+	std::int64_t now = 0;
+	while (!wheel.empty()) {
+		now += 1 + deadline_dist(rng) % 5000;
+		wheel.advance(now, [&](int deadline) {
+			// Nothing may be dispatched before its time
+			ASSERT_LE(deadline, now);
+			dispatched.push_back(deadline);
+		});
+
+		// ...or stay in the wheel after it
+		auto due = std::upper_bound(deadlines.begin(), deadlines.end(), now) - deadlines.begin();
+		ASSERT_EQ(static_cast<size_t>(due), dispatched.size());
+	}
+
+	ASSERT_EQ(deadlines, dispatched);
+}
+
+TEST(TimerWheelTests, cancel)
+{
+	TimerWheel<int> wheel(100);
+
+	auto first = wheel.schedule(150, 1);
+	auto second = wheel.schedule(150, 2);
+	auto third = wheel.schedule(5000, 3);
+	ASSERT_EQ((size_t)3, wheel.size());
+
+	ASSERT_TRUE(wheel.cancel(second));
+	ASSERT_FALSE(wheel.cancel(second));
+	ASSERT_FALSE(wheel.cancel(0));
+
+	SCP_vector<int> dispatched;
+	auto dispatch = [&](int value) { dispatched.push_back(value); };
+
+	ASSERT_EQ((size_t)1, wheel.advance(200, dispatch));
+	ASSERT_EQ(SCP_vector<int>({1}), dispatched);
+	ASSERT_FALSE(wheel.cancel(first));
+
+	// The slot of the first timer is reused but the old identifier stays invalid
+	auto fourth = wheel.schedule(300, 4);
+	ASSERT_NE(first, fourth);
+	ASSERT_FALSE(wheel.cancel(first));
+	ASSERT_TRUE(wheel.cancel(third));
+
+	// Deadlines in the past are dispatched right away
+	wheel.schedule(10, 5);
+	ASSERT_EQ((size_t)1, wheel.advance(200, dispatch));
+	ASSERT_EQ((size_t)1, wheel.advance(1000000, dispatch));
+	ASSERT_EQ(SCP_vector<int>({1, 5, 4}), dispatched);
+	ASSERT_TRUE(wheel.empty());
+}
+
+TEST(TimerWheelTests, cancelTakesValue)
+{
+	TimerWheel<SCP_string> wheel(100);
+
+	auto first = wheel.schedule(150, "first");
+	auto second = wheel.schedule(5000, "second");
+	ASSERT_TRUE(wheel.isScheduled(first));
+	ASSERT_TRUE(wheel.isScheduled(second));
+
+	SCP_string value;
+	ASSERT_TRUE(wheel.cancel(second, value));
+	ASSERT_EQ("second", value);
+	ASSERT_FALSE(wheel.isScheduled(second));
+
+	value.clear();
+	ASSERT_FALSE(wheel.cancel(second, value));
+	ASSERT_TRUE(value.empty());
+
+	ASSERT_EQ((size_t)1, wheel.advance(200, [](SCP_string&&) {}));
+	ASSERT_FALSE(wheel.isScheduled(first));
+	ASSERT_FALSE(wheel.cancel(first, value));
+	ASSERT_TRUE(wheel.empty());
+}
+
+// Only measures the time, run it with --gtest_also_run_disabled_tests
+TEST(TimerWheelTests, DISABLED_expiryOverhead)
+{
+	const int NUM_TIMERS = 10000;
+	const int NUM_FRAMES = 2000;
+	const int FRAME_TIME = 16;
+
+	std::mt19937 rng(3);
+	std::uniform_int_distribution<int> delay_dist(0, 60000);
+
+	// Compares the wheel against checking every timestamp every frame, a timer is renewed once it expired
+	SCP_vector<int> stamps;
+	for (int i = 0; i < NUM_TIMERS; ++i) {
+		stamps.push_back(delay_dist(rng));
+	}
+	auto wheel_stamps = stamps;
+
+	size_t polled = 0;
+	auto start = std::chrono::high_resolution_clock::now();
+	for (int frame = 1; frame <= NUM_FRAMES; ++frame) {
+		auto now = frame * FRAME_TIME;
+		for (auto& stamp : stamps) {
+			if (stamp <= now) {
+				stamp = now + delay_dist(rng);
+				++polled;
+			}
+		}
+	}
+	auto poll_time = std::chrono::high_resolution_clock::now() - start;
+
+	rng.seed(3);
+	for (int i = 0; i < NUM_TIMERS; ++i) {
+		delay_dist(rng);
+	}
+
+	size_t expired = 0;
+	start = std::chrono::high_resolution_clock::now();
+	TimerWheel<int> wheel;
+	for (int i = 0; i < NUM_TIMERS; ++i) {
+		wheel.schedule(wheel_stamps[i], i);
+	}
+	SCP_vector<int> renew;
+	for (int frame = 1; frame <= NUM_FRAMES; ++frame) {
+		auto now = frame * FRAME_TIME;
+		renew.clear();
+		expired += wheel.advance(now, [&](int index) { renew.push_back(index); });
+		for (auto index : renew) {
+			wheel.schedule(now + delay_dist(rng), index);
+		}
+	}
+	auto wheel_time = std::chrono::high_resolution_clock::now() - start;
+
+	ASSERT_GT(expired, (size_t)0);
+	ASSERT_EQ(NUM_TIMERS, static_cast<int>(wheel.size()));
+
+	auto per_frame = [](std::chrono::high_resolution_clock::duration time) {
+		return std::chrono::duration_cast<std::chrono::microseconds>(time).count() / static_cast<double>(NUM_FRAMES);
+	};
+
+	std::cout << "[ BENCH    ] polling timestamps: " << per_frame(poll_time) << " us/frame (" << polled << " expired)"
+	          << std::endl;
+	std::cout << "[ BENCH    ] timer wheel: " << per_frame(wheel_time) << " us/frame (" << expired << " expired)"
+	          << std::endl;
+}